@@ -1,7 +1,7 @@
 // Copyright (c) 2015-2015 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
-#include "lfsr.h"
+#include "LfsrScrambler.hpp"
 #include <Pothos/Framework.hpp>
 #include <iostream>
 #include <cstring>
@@ -63,6 +63,7 @@ struct Descrambler : public Pothos::Block
     {
         _polynom = polynomial;
         GLFSR_init(&_lfsr, _polynom, _seed_value);
+        _scrambler.init(_lfsr, this->feedback());
     }
 
     int64_t poly(void) const
@@ -74,6 +75,7 @@ struct Descrambler : public Pothos::Block
     {
         _seed_value = seed;
         GLFSR_init(&_lfsr, _polynom, _seed_value);
+        _scrambler.init(_lfsr, this->feedback());
     }
 
     int64_t seed(void) const
@@ -86,6 +88,7 @@ struct Descrambler : public Pothos::Block
         if (mode == "additive") _mode = MODE_ADD;
         else if (mode == "multiplicative") _mode = MODE_MULT;
         else throw Pothos::InvalidArgumentException("Descrambler::set_mode()", "unknown mode: " + mode);
+        _scrambler.init(_lfsr, this->feedback());
     }
 
     std::string mode(void) const
@@ -119,11 +122,16 @@ struct Descrambler : public Pothos::Block
         return _sync_word;
     }
 
+    LfsrScrambler::Feedback feedback(void) const
+    {
+        if (_mode == MODE_ADD) return LfsrScrambler::FEEDBACK_NONE;
+        else return LfsrScrambler::FEEDBACK_INPUT;
+    }
+
     void work(void);
-    unsigned char additive_bit_work(const unsigned char in);
-    unsigned char multiplicative_bit_work(const unsigned char in);
 
     lfsr_t _lfsr;
+    LfsrScrambler _scrambler;
     lfsr_data_t _polynom;
     lfsr_data_t _seed_value;
     enum {MODE_ADD, MODE_MULT} _mode;
@@ -132,23 +140,6 @@ struct Descrambler : public Pothos::Block
     long _count_down_to_sync_word;
 };
 
-unsigned char Descrambler::additive_bit_work(const unsigned char in)
-{
-    const unsigned char ret = GLFSR_next(&_lfsr);
-    const unsigned char out = in ^ ret;
-    return out;
-}
-
-unsigned char Descrambler::multiplicative_bit_work(const unsigned char in)
-{
-    const unsigned char ret = GLFSR_next(&_lfsr);
-    const unsigned char out = in ^ ret;
-    //input bit becomes the next bit0
-    _lfsr.data &= ~lfsr_data_t(0x1);
-    _lfsr.data |= in;
-    return out;
-}
-
 void Descrambler::work(void)
 {
     auto inPort = this->input(0);
@@ -158,21 +149,7 @@ void Descrambler::work(void)
     auto in = inPort->buffer().as<const unsigned char *>();
     auto out = outPort->buffer().as<unsigned char *>();
 
-    //The main work loop deals with input bit by bit.
-    if (_mode == MODE_ADD)
-    {
-        for (size_t i = 0; i < n; i++)
-        {
-            out[i] = this->additive_bit_work(in[i] & 0x1);
-        }
-    }
-    if (_mode == MODE_MULT)
-    {
-        for (size_t i = 0; i < n; i++)
-        {
-            out[i] = this->multiplicative_bit_work(in[i] & 0x1);
-        }
-    }
+    _scrambler.work(_lfsr, in, out, n);
 
     inPort->consume(n);
     outPort->produce(n);
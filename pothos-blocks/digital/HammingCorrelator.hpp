@@ -0,0 +1,178 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring> //memcpy
+#include <vector>
+
+/***********************************************************************
+ * Packed-bit sliding Hamming distance
+ *
+ * The unpacked input bits are packed 64 to a word (first bit in the LSB),
+ * and the window at each position is shifted out of two adjacent words
+ * so that one XOR and one popcount compare 64 bits of the pattern.
+ * The distances are computed for blocks of 64 consecutive positions
+ * which share the same input words; the loop over the positions
+ * in a block vectorizes with variable shifts and a vector popcount.
+ **********************************************************************/
+typedef void (*HammingFcn)(int *, uint64_t *, const unsigned char *, const size_t,
+    const uint64_t *, const uint64_t *, const size_t, const size_t);
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POTHOS_HAMMING_X86
+#define POTHOS_TARGET_POPCNT __attribute__((target("popcnt")))
+#define POTHOS_TARGET_AVX512_POPCNT __attribute__((target("popcnt,avx2,avx512f,avx512bw,avx512vl,avx512vpopcntdq")))
+#endif
+
+#if defined(__GNUC__)
+#define POTHOS_HAMMING_INLINE inline __attribute__((always_inline))
+#define POTHOS_HAMMING_RESTRICT __restrict__
+#define POTHOS_HAMMING_POPCOUNT(x) __builtin_popcountll(x)
+#else
+#define POTHOS_HAMMING_INLINE inline
+#define POTHOS_HAMMING_RESTRICT
+static inline int POTHOS_HAMMING_POPCOUNT(uint64_t x)
+{
+    int n = 0;
+    for (; x != 0; x &= x - 1) n++;
+    return n;
+}
+#endif
+
+static const size_t HAMMING_BLOCK_SIZE = 64;
+
+/*!
+ * Pack unpacked bits into words, first bit in the LSB.
+ * Only the LSB of each input byte is used.
+ * A partial last word is padded with zeros.
+ */
+static POTHOS_HAMMING_INLINE void hammingPack(uint64_t *POTHOS_HAMMING_RESTRICT out, const unsigned char *POTHOS_HAMMING_RESTRICT in, const size_t numBits)
+{
+    const size_t numWords = numBits/64;
+    for (size_t j = 0; j < numWords; j++)
+    {
+        uint64_t v = 0;
+        #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        for (size_t b = 0; b < 64; b++) v |= uint64_t(in[64*j+b] & 0x1) << b;
+        #else
+        //the multiply gathers the LSB of 8 bytes into the top byte
+        for (size_t b = 0; b < 8; b++)
+        {
+            uint64_t x; std::memcpy(&x, in+64*j+8*b, sizeof(x));
+            v |= (((x & 0x0101010101010101ull)*0x0102040810204080ull) >> 56) << (8*b);
+        }
+        #endif
+        out[j] = v;
+    }
+    if (numWords*64 == numBits) return;
+    uint64_t v = 0;
+    for (size_t b = numWords*64; b < numBits; b++) v |= uint64_t(in[b] & 0x1) << (b%64);
+    out[numWords] = v;
+}
+
+/*!
+ * Compute the distances of numBlocks*64 window positions.
+ * The packed input needs numBlocks + numWords + 1 words.
+ */
+static POTHOS_HAMMING_INLINE void hammingDistances(int *POTHOS_HAMMING_RESTRICT dist, const uint64_t *packed,
+    const uint64_t *pattern, const uint64_t *mask, const size_t numWords, const size_t numBlocks)
+{
+    for (size_t q = 0; q < numBlocks; q++)
+    {
+        int *POTHOS_HAMMING_RESTRICT d = dist + q*HAMMING_BLOCK_SIZE;
+        for (size_t r = 0; r < HAMMING_BLOCK_SIZE; r++) d[r] = 0;
+        for (size_t k = 0; k < numWords; k++)
+        {
+            //the window at offset r is the top of a and the bottom of b
+            //(b is pre-shifted so that the shift count is never 64)
+            const uint64_t a = packed[q+k], b = packed[q+k+1] << 1, p = pattern[k], m = mask[k];
+            for (size_t r = 0; r < HAMMING_BLOCK_SIZE; r++)
+            {
+                d[r] += POTHOS_HAMMING_POPCOUNT((((a >> r) | (b << (63 - r))) ^ p) & m);
+            }
+        }
+    }
+}
+
+#define POTHOS_HAMMING_KERNEL(name, target) \
+    static target void name(int *dist, uint64_t *packed, const unsigned char *in, const size_t numBits, \
+        const uint64_t *pattern, const uint64_t *mask, const size_t numWords, const size_t numBlocks) \
+    { \
+        hammingPack(packed, in, numBits); \
+        hammingDistances(dist, packed, pattern, mask, numWords, numBlocks); \
+    }
+
+POTHOS_HAMMING_KERNEL(hammingKernelDefault, )
+#if defined(POTHOS_HAMMING_X86)
+POTHOS_HAMMING_KERNEL(hammingKernelPopcnt, POTHOS_TARGET_POPCNT)
+POTHOS_HAMMING_KERNEL(hammingKernelAvx512, POTHOS_TARGET_AVX512_POPCNT)
+#endif
+
+//! Get the best kernel for the host CPU
+static inline HammingFcn getHammingKernel(void)
+{
+    #if defined(POTHOS_HAMMING_X86)
+    if (__builtin_cpu_supports("avx512vpopcntdq") and __builtin_cpu_supports("avx512bw") and
+        __builtin_cpu_supports("avx512vl")) return &hammingKernelAvx512;
+    if (__builtin_cpu_supports("popcnt")) return &hammingKernelPopcnt;
+    #endif
+    return &hammingKernelDefault;
+}
+
+/*!
+ * Sliding Hamming distance between a bit pattern and an unpacked bit stream.
+ * Any pattern length is supported, 64 bits per packed word.
+ */
+class HammingCorrelator
+{
+public:
+    HammingCorrelator(void):
+        _kernel(getHammingKernel()),
+        _size(0)
+    {
+        return;
+    }
+
+    //! Set the pattern of unpacked bits (only the LSB of each byte is used)
+    void setPattern(const std::vector<unsigned char> &bits)
+    {
+        _size = bits.size();
+        const size_t numWords = (_size + 63)/64;
+        _pattern.assign(numWords, 0);
+        _mask.assign(numWords, ~uint64_t(0));
+        for (size_t i = 0; i < _size; i++) _pattern[i/64] |= uint64_t(bits[i] & 0x1) << (i%64);
+        if (_size%64 != 0) _mask.back() = (uint64_t(1) << (_size%64)) - 1;
+    }
+
+    //! The number of bits in the pattern
+    size_t size(void) const
+    {
+        return _size;
+    }
+
+    /*!
+     * Compute the distance at the first num positions of the input.
+     * The input must hold num + size() - 1 bits.
+     * The returned array is valid until the next call.
+     */
+    const int *distances(const unsigned char *in, const size_t num)
+    {
+        const size_t numBlocks = (num + HAMMING_BLOCK_SIZE - 1)/HAMMING_BLOCK_SIZE;
+        _packed.assign(numBlocks + _pattern.size() + 1, 0);
+        _distances.resize(numBlocks*HAMMING_BLOCK_SIZE);
+        _kernel(_distances.data(), _packed.data(), in, num + _size - 1,
+            _pattern.data(), _mask.data(), _pattern.size(), numBlocks);
+        return _distances.data();
+    }
+
+private:
+    HammingFcn _kernel;
+    size_t _size;
+    std::vector<uint64_t> _pattern;
+    std::vector<uint64_t> _mask;
+    std::vector<uint64_t> _packed;
+    std::vector<int> _distances;
+};
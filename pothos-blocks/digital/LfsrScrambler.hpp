@@ -0,0 +1,198 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include "lfsr.h"
+#include <Pothos/Config.hpp>
+#include <cstdint>
+#include <cstring> //memcpy
+#include <vector>
+
+/***********************************************************************
+ * Table-driven LFSR scrambling, 64 bits per step
+ *
+ * Once the register holds no bits at or above the polynomial degree,
+ * the Galois LFSR and the multiplicative feedback are linear over GF(2)
+ * in the register and the input bits. So the next register value and
+ * the 64 output bits after 64 steps are the XOR of the contributions
+ * of each byte of the register and each byte of the input.
+ * The contributions of all 256 values of each byte are precomputed
+ * by running the bit-serial step on basis vectors, which makes the
+ * output identical to the bit-serial path for any polynomial.
+ *
+ * A register that is not in that form (a seed with bits above the degree)
+ * is stepped bit by bit until it is, as is an unsupported polynomial
+ * and the remainder that does not fill 64 bits.
+ **********************************************************************/
+class LfsrScrambler
+{
+public:
+    //! What enters bit 0 of the register after each step
+    enum Feedback
+    {
+        FEEDBACK_NONE, //!< additive mode
+        FEEDBACK_OUTPUT, //!< multiplicative scrambler
+        FEEDBACK_INPUT, //!< multiplicative descrambler
+    };
+
+    LfsrScrambler(void):
+        _feedback(FEEDBACK_NONE),
+        _mask(0),
+        _numStateBytes(0)
+    {
+        return;
+    }
+
+    //! One bit-serial step of the register
+    static unsigned char step(lfsr_t &lfsr, const Feedback feedback, const unsigned char in)
+    {
+        const unsigned char ret = GLFSR_next(&lfsr);
+        const unsigned char out = in ^ ret;
+        if (feedback == FEEDBACK_OUTPUT)
+        {
+            //output bit becomes the next bit0
+            lfsr.data &= ~lfsr_data_t(0x1);
+            lfsr.data |= out;
+        }
+        if (feedback == FEEDBACK_INPUT)
+        {
+            //input bit becomes the next bit0
+            lfsr.data &= ~lfsr_data_t(0x1);
+            lfsr.data |= in;
+        }
+        return out;
+    }
+
+    /*!
+     * Build the tables for the polynomial of the register.
+     * Call after every initialization of the register or change of the feedback.
+     */
+    void init(const lfsr_t &lfsr, const Feedback feedback)
+    {
+        _feedback = feedback;
+        _mask = 0;
+        _tables.clear();
+
+        //the mask selects the degree bit and above, and the polynomial ends at the degree
+        const uint64_t mask = uint64_t(lfsr.mask), poly = uint64_t(lfsr.polynomial);
+        if (mask == 0 or (mask & 0x1) != 0) return;
+        size_t degree = 0;
+        while (((mask >> degree) & 0x1) == 0) degree++;
+        if (mask != ~((uint64_t(1) << degree) - 1)) return;
+        if ((poly >> degree) != 1) return;
+
+        //the register bytes followed by the input bytes
+        _numStateBytes = (degree + 7)/8;
+        _tables.resize((_numStateBytes + 8)*256);
+        lfsr_t basis = lfsr;
+        for (size_t t = 0; t < _numStateBytes + 8; t++)
+        {
+            Entry *table = _tables.data() + t*256;
+            Entry bits[8];
+            for (size_t b = 0; b < 8; b++)
+            {
+                const size_t stateBit = (t < _numStateBytes)?(t*8 + b):degree;
+                const size_t inputBit = (t < _numStateBytes)?64:((t - _numStateBytes)*8 + b);
+                basis.data = (stateBit < degree)?lfsr_data_t(uint64_t(1) << stateBit):0;
+                bits[b].out = 0;
+                for (size_t i = 0; i < 64; i++)
+                {
+                    const uint64_t out = step(basis, feedback, (i == inputBit)?1:0);
+                    bits[b].out |= out << i;
+                }
+                bits[b].state = uint64_t(basis.data);
+            }
+            table[0].state = table[0].out = 0;
+            for (size_t v = 1; v < 256; v++)
+            {
+                size_t low = 0;
+                while (((v >> low) & 0x1) == 0) low++;
+                table[v].state = table[v & (v - 1)].state ^ bits[low].state;
+                table[v].out = table[v & (v - 1)].out ^ bits[low].out;
+            }
+        }
+        _mask = mask;
+    }
+
+    //! Process unpacked bits (only the LSB of each input byte is used)
+    void work(lfsr_t &lfsr, const unsigned char *in, unsigned char *out, const size_t num) const
+    {
+        size_t i = 0;
+        while (i < num)
+        {
+            if (_mask != 0 and (uint64_t(lfsr.data) & _mask) == 0)
+            {
+                for (; i + 64 <= num; i += 64) unpack(out+i, this->jump(lfsr, pack(in+i)));
+            }
+            if (i == num) break;
+            out[i] = step(lfsr, _feedback, in[i] & 0x1);
+            i++;
+        }
+    }
+
+private:
+    //! 64 steps: the input and output bits are packed with the first bit in the LSB
+    uint64_t jump(lfsr_t &lfsr, const uint64_t in) const
+    {
+        const uint64_t data = uint64_t(lfsr.data);
+        const Entry *table = _tables.data();
+        uint64_t state = 0, out = 0;
+        for (size_t j = 0; j < _numStateBytes; j++, table += 256)
+        {
+            const Entry &e = table[(data >> (8*j)) & 0xff];
+            state ^= e.state;
+            out ^= e.out;
+        }
+        if (_feedback == FEEDBACK_NONE) out ^= in; //the input only passes through
+        else for (size_t j = 0; j < 8; j++, table += 256)
+        {
+            const Entry &e = table[(in >> (8*j)) & 0xff];
+            state ^= e.state;
+            out ^= e.out;
+        }
+        lfsr.data = lfsr_data_t(state);
+        return out;
+    }
+
+    static uint64_t pack(const unsigned char *in)
+    {
+        uint64_t v = 0;
+        #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        for (size_t b = 0; b < 64; b++) v |= uint64_t(in[b] & 0x1) << b;
+        #else
+        //the multiply gathers the LSB of 8 bytes into the top byte
+        for (size_t b = 0; b < 8; b++)
+        {
+            uint64_t x; std::memcpy(&x, in+8*b, sizeof(x));
+            v |= (((x & 0x0101010101010101ull)*0x0102040810204080ull) >> 56) << (8*b);
+        }
+        #endif
+        return v;
+    }
+
+    static void unpack(unsigned char *out, const uint64_t v)
+    {
+        #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        for (size_t b = 0; b < 64; b++) out[b] = (v >> b) & 0x1;
+        #else
+        //copy a byte into every lane, keep bit i in lane i, and move it to the LSB
+        for (size_t b = 0; b < 8; b++)
+        {
+            uint64_t x = (((v >> (8*b)) & 0xff)*0x0101010101010101ull) & 0x8040201008040201ull;
+            x = ((x + 0x7f7f7f7f7f7f7f7full) >> 7) & 0x0101010101010101ull;
+            std::memcpy(out+8*b, &x, sizeof(x));
+        }
+        #endif
+    }
+
+    struct Entry
+    {
+        uint64_t state;
+        uint64_t out;
+    };
+
+    Feedback _feedback;
+    uint64_t _mask;
+    size_t _numStateBytes;
+    std::vector<Entry> _tables;
+};
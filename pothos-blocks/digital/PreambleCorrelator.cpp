@@ -1,6 +1,7 @@
 // Copyright (c) 2015-2015 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "HammingCorrelator.hpp"
 #include <Pothos/Framework.hpp>
 #include <cstdint>
 #include <complex>
@@ -16,6 +17,11 @@
  *
  * http://en.wikipedia.org/wiki/Hamming_distance
  *
+ * The input bits are packed into words and compared with the preamble
+ * 64 bits at a time with XOR and popcount, using the vector popcount
+ * instructions when the CPU supports them.
+ * The preamble may be any length, and the threshold may be changed at any time.
+ *
  * |category /Digital
  * |keywords bit preamble correlate
  *
@@ -62,6 +68,7 @@ public:
     {
         if (preamble.empty()) throw Pothos::InvalidArgumentException("PreambleCorrelator::setPreamble()", "taps cannot be empty");
         _preamble = preamble;
+        _correlator.setPattern(preamble);
     }
 
     std::vector<unsigned char> getPreamble(void) const
@@ -119,25 +126,18 @@ public:
         }
 
         // Calculate Hamming distance
-        auto in = inputPort->buffer().template as<unsigned char *>();
+        auto in = inputPort->buffer().template as<const unsigned char *>();
+        const int *dist = _correlator.distances(in, N);
         //auto distance = outputDistance->buffer().template as<int *>();
         for (size_t n = 0; n < N; n++)
         {
-            int dist = 0;
-
-            // Count the number of bits set
-            for (size_t i = 0; i < _preamble.size(); i++)
-            {
-                // A bit is set, so increment the distance
-                dist += _preamble[i] ^ in[n+i];
-            }
             // Emit a label if within the distance threshold
-            if (dist <= _threshold)
+            if (dist[n] <= _threshold)
             {
                 outputPort->postLabel(Pothos::Label(_label, Pothos::Object(), n + _preamble.size()));
             }
 
-            //distance[n] = dist;
+            //distance[n] = dist[n];
         }
         //outputDistance->produce(N);
     }
@@ -146,6 +146,7 @@ private:
     int _threshold;
     std::string _label;
     std::vector<unsigned char> _preamble;
+    HammingCorrelator _correlator;
 };
 
 /***********************************************************************
@@ -4,8 +4,12 @@
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
-#include <iostream>
+#include <Pothos/Plugin.hpp>
+#include <Poco/JSON/Object.h>
+#include "HammingCorrelator.hpp"
+#include <chrono>
 #include <complex>
+#include <random>
 
 POTHOS_TEST_BLOCK("/blocks/tests", test_preamble_correlator)
 {
@@ -49,3 +53,138 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_preamble_correlator)
     POTHOS_TEST_EQUAL(labels.size(), 1);
     for (auto label : labels) POTHOS_TEST_EQUAL(label.index, preambleIndex + preamble.size());
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_preamble_correlator_distances)
+{
+    std::mt19937 gen;
+    std::uniform_int_distribution<int> bit(0, 1);
+    HammingCorrelator correlator;
+
+    //compare against the bytewise distance for lengths around the word boundaries
+    for (const size_t length : {1, 2, 7, 31, 63, 64, 65, 100, 127, 128, 129, 200})
+    {
+        std::vector<unsigned char> pattern(length);
+        for (auto &b : pattern) b = bit(gen);
+        correlator.setPattern(pattern);
+        POTHOS_TEST_EQUAL(correlator.size(), length);
+
+        for (const size_t num : {1, 63, 64, 65, 1000})
+        {
+            std::vector<unsigned char> in(num + length - 1);
+            for (auto &b : in) b = bit(gen);
+            const int *dist = correlator.distances(in.data(), num);
+            for (size_t n = 0; n < num; n++)
+            {
+                int expected = 0;
+                for (size_t i = 0; i < length; i++) expected += pattern[i] ^ in[n+i];
+                POTHOS_TEST_EQUAL(dist[n], expected);
+            }
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_preamble_correlator_long)
+{
+    auto registry = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    auto feeder = registry.callProxy("/blocks/feeder_source", "unsigned char");
+    auto correlator = registry.callProxy("/blocks/preamble_correlator");
+    auto collector = registry.callProxy("/blocks/collector_sink", "unsigned char");
+
+    //a preamble longer than a word with a few errors at each match
+    std::mt19937 gen;
+    std::uniform_int_distribution<int> bit(0, 1);
+    std::vector<unsigned char> preamble(100);
+    for (auto &b : preamble) b = bit(gen);
+    correlator.callProxy("setPreamble", preamble);
+    correlator.callProxy("setThreshold", 3);
+
+    const size_t testLength = 10000;
+    const size_t preambleIndexes[] = {100, 2345, 7777};
+    auto b0 = Pothos::BufferChunk(testLength * sizeof(unsigned char));
+    auto p0 = b0.as<unsigned char *>();
+    for (size_t i = 0; i < testLength; i++) p0[i] = bit(gen);
+    for (const auto index : preambleIndexes)
+    {
+        for (size_t i = 0; i < preamble.size(); i++) p0[i + index] = preamble[i];
+        for (size_t i = 0; i < 3; i++) p0[index + i*33] ^= 1;
+    }
+    feeder.callProxy("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, correlator, 0);
+        topology.connect(correlator, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the collector buffer matches input
+    auto buff = collector.call<Pothos::BufferChunk>("getBuffer");
+    auto pb = buff.as<const unsigned char *>();
+    POTHOS_TEST_TRUE(buff.length >= testLength - preamble.size());
+    for (size_t i = 0; i < buff.length; i++) POTHOS_TEST_EQUAL(pb[i], p0[i]);
+
+    //check for the preamble labels
+    auto labels = collector.call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(labels.size(), 3);
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+        POTHOS_TEST_EQUAL(labels[i].index, preambleIndexes[i] + preamble.size());
+    }
+}
+
+/***********************************************************************
+ * Bytewise versus packed distance for a 64 bit preamble,
+ * run with PothosUtil --bench=blocks/preamble_correlator_throughput
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchPreambleCorrelator(void)
+{
+    std::mt19937 gen;
+    std::uniform_int_distribution<int> bit(0, 1);
+    std::vector<unsigned char> preamble(64);
+    for (auto &b : preamble) b = bit(gen);
+    const size_t num = 1 << 14, iters = 100;
+    std::vector<unsigned char> in(num + preamble.size());
+    for (auto &b : in) b = bit(gen);
+
+    //the bytewise distance
+    size_t matches0 = 0;
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t it = 0; it < iters; it++)
+    {
+        for (size_t n = 0; n < num; n++)
+        {
+            int dist = 0;
+            for (size_t i = 0; i < preamble.size(); i++) dist += preamble[i] ^ in[n+i];
+            if (dist <= 20) matches0++;
+        }
+    }
+
+    //the packed distance
+    HammingCorrelator correlator;
+    correlator.setPattern(preamble);
+    size_t matches1 = 0;
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    for (size_t it = 0; it < iters; it++)
+    {
+        const int *dist = correlator.distances(in.data(), num);
+        for (size_t n = 0; n < num; n++) if (dist[n] <= 20) matches1++;
+    }
+    const auto t2 = std::chrono::high_resolution_clock::now();
+
+    const double byteTime = std::chrono::duration<double>(t1 - t0).count();
+    const double packedTime = std::chrono::duration<double>(t2 - t1).count();
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("bytewiseBitsPerSec", num*iters/byteTime);
+    metrics->set("packedBitsPerSec", num*iters/packedTime);
+    metrics->set("bytewiseMatches", double(matches0));
+    metrics->set("packedMatches", double(matches1));
+    return metrics;
+}
+
+pothos_static_block(pothosBlocksRegisterBenchPreambleCorrelator)
+{
+    Pothos::PluginRegistry::add("/bench/blocks/preamble_correlator_throughput", Pothos::Callable(&benchPreambleCorrelator));
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Poco/JSON/Object.h>
+#include "LfsrScrambler.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//the bit-serial scrambler step, as the blocks implemented it
+static unsigned char serialStep(lfsr_t &lfsr, const LfsrScrambler::Feedback feedback, const unsigned char in)
+{
+    const unsigned char out = in ^ GLFSR_next(&lfsr);
+    if (feedback == LfsrScrambler::FEEDBACK_OUTPUT) lfsr.data = (lfsr.data & ~lfsr_data_t(0x1)) | out;
+    if (feedback == LfsrScrambler::FEEDBACK_INPUT) lfsr.data = (lfsr.data & ~lfsr_data_t(0x1)) | in;
+    return out;
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_scrambler_tables)
+{
+    std::mt19937 gen;
+    std::uniform_int_distribution<int> bit(0, 1);
+    std::vector<unsigned char> in(5000), out(in.size());
+    for (auto &b : in) b = bit(gen);
+
+    const long long polys[] = {
+        0x19, 0x3, 0x89, 0x11021, 0x18005, 0x80027,
+        0x100400007ll, 0x4000000000000003ll, (long long)(0x800000000000000dull),
+        0x1, 0x0, -1};
+    const long long seeds[] = {0x1, 0x0, 0x5a5a, 0x123456789abcdefll, -1};
+    const LfsrScrambler::Feedback feedbacks[] = {
+        LfsrScrambler::FEEDBACK_NONE, LfsrScrambler::FEEDBACK_OUTPUT, LfsrScrambler::FEEDBACK_INPUT};
+    const size_t chunks[] = {1, 63, 64, 65, 200, 1000, 3607};
+
+    for (const auto poly : polys)
+    for (const auto seed : seeds)
+    for (const auto feedback : feedbacks)
+    {
+        lfsr_t ref, lfsr;
+        std::memset(&ref, 0, sizeof(ref));
+        GLFSR_init(&ref, poly, seed);
+        lfsr = ref;
+        LfsrScrambler scrambler;
+        scrambler.init(lfsr, feedback);
+
+        //process in uneven chunks to cross the 64 bit steps
+        size_t i = 0;
+        for (const auto chunk : chunks)
+        {
+            scrambler.work(lfsr, in.data()+i, out.data()+i, chunk);
+            i += chunk;
+        }
+        for (size_t j = 0; j < i; j++)
+        {
+            const auto expected = serialStep(ref, feedback, in[j]);
+            POTHOS_TEST_EQUAL(out[j], expected);
+        }
+        POTHOS_TEST_EQUAL(lfsr.data, ref.data);
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_scrambler_descrambler)
+{
+    auto registry = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    std::mt19937 gen;
+    std::uniform_int_distribution<int> bit(0, 1);
+    const size_t testLength = 10000;
+
+    for (const std::string mode : {"additive", "multiplicative"})
+    {
+        std::cout << "Testing " << mode << " scrambler and descrambler" << std::endl;
+        auto feeder = registry.callProxy("/blocks/feeder_source", "unsigned char");
+        auto scrambler = registry.callProxy("/blocks/scrambler");
+        auto descrambler = registry.callProxy("/blocks/descrambler");
+        auto scrambled = registry.callProxy("/blocks/collector_sink", "unsigned char");
+        auto collector = registry.callProxy("/blocks/collector_sink", "unsigned char");
+        for (auto block : {scrambler, descrambler})
+        {
+            block.callVoid("setMode", mode);
+            block.callVoid("setPoly", 0x18005);
+            block.callVoid("setSeed", 0x1234);
+        }
+
+        auto b0 = Pothos::BufferChunk(testLength);
+        auto p0 = b0.as<unsigned char *>();
+        for (size_t i = 0; i < testLength; i++) p0[i] = bit(gen);
+        feeder.callProxy("feedBuffer", b0);
+
+        //run the topology
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, scrambler, 0);
+            topology.connect(scrambler, 0, scrambled, 0);
+            topology.connect(scrambler, 0, descrambler, 0);
+            topology.connect(descrambler, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        //the scrambled stream matches the bit-serial scrambler
+        lfsr_t ref;
+        std::memset(&ref, 0, sizeof(ref));
+        GLFSR_init(&ref, 0x18005, 0x1234);
+        const auto feedback = (mode == "additive")?LfsrScrambler::FEEDBACK_NONE:LfsrScrambler::FEEDBACK_OUTPUT;
+        auto buff = scrambled.call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(buff.length, testLength);
+        auto ps = buff.as<const unsigned char *>();
+        for (size_t i = 0; i < testLength; i++)
+        {
+            const auto expected = serialStep(ref, feedback, p0[i]);
+            POTHOS_TEST_EQUAL(ps[i], expected);
+        }
+
+        //the descrambled stream matches the input
+        buff = collector.call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(buff.length, testLength);
+        auto pb = buff.as<const unsigned char *>();
+        for (size_t i = 0; i < testLength; i++) POTHOS_TEST_EQUAL(pb[i], p0[i]);
+    }
+}
+
+/***********************************************************************
+ * Bit-serial versus table-driven multiplicative scrambling,
+ * run with PothosUtil --bench=blocks/scrambler_throughput
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchScrambler(void)
+{
+    std::mt19937 gen;
+    std::uniform_int_distribution<int> bit(0, 1);
+    const size_t num = 1 << 16, iters = 50;
+    std::vector<unsigned char> in(num), out0(num), out1(num);
+    for (auto &b : in) b = bit(gen);
+
+    lfsr_t ref, lfsr;
+    std::memset(&ref, 0, sizeof(ref));
+    GLFSR_init(&ref, 0x18005, 0x1);
+    lfsr = ref;
+
+    //the bit-serial scrambler
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t it = 0; it < iters; it++)
+    {
+        for (size_t i = 0; i < num; i++) out0[i] = serialStep(ref, LfsrScrambler::FEEDBACK_OUTPUT, in[i]);
+    }
+
+    //the table-driven scrambler
+    LfsrScrambler scrambler;
+    scrambler.init(lfsr, LfsrScrambler::FEEDBACK_OUTPUT);
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    for (size_t it = 0; it < iters; it++) scrambler.work(lfsr, in.data(), out1.data(), num);
+    const auto t2 = std::chrono::high_resolution_clock::now();
+
+    const double serialTime = std::chrono::duration<double>(t1 - t0).count();
+    const double tableTime = std::chrono::duration<double>(t2 - t1).count();
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("serialBitsPerSec", num*iters/serialTime);
+    metrics->set("tableBitsPerSec", num*iters/tableTime);
+    metrics->set("outputsMatch", (out0 == out1)?1.0:0.0);
+    return metrics;
+}
+
+pothos_static_block(pothosBlocksRegisterBenchScrambler)
+{
+    Pothos::PluginRegistry::add("/bench/blocks/scrambler_throughput", Pothos::Callable(&benchScrambler));
+}
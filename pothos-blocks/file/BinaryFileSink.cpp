@@ -10,6 +10,7 @@
 #include <io.h>
 #else
 #include <unistd.h>
+#include <sys/uio.h> //writev
 #endif //_MSC_VER
 #include <stdio.h>
 #include <cerrno>
@@ -27,6 +28,9 @@
 
 #include <Poco/Logger.h>
 
+//limit the buffers per write, well under the system IOV_MAX
+static const int MAX_IOVECS = 64;
+
 /***********************************************************************
  * |PothosDoc Binary File Sink
  *
@@ -55,6 +59,7 @@ public:
         _fd(-1)
     {
         this->setupInput(0);
+        this->input(0)->setScatterGather(true);
         this->registerCall(this, POTHOS_FCN_TUPLE(BinaryFileSink, setFilePath));
     }
 
@@ -88,9 +93,25 @@ public:
     {
         auto in0 = this->input(0);
         if (in0->elements() == 0) return;
+
+        #ifdef _MSC_VER
         auto ptr = in0->buffer().as<const void *>();
-        auto r = write(_fd, ptr, in0->elements());
-        if (r >= 0) in0->consume(size_t(r));
+        auto r = write(_fd, ptr, in0->buffer().length);
+        #else
+        //write all queued buffers at once without copying them together
+        struct iovec iov[MAX_IOVECS];
+        int iovcnt = 0;
+        for (const auto &buff : in0->buffers())
+        {
+            if (iovcnt == MAX_IOVECS) break;
+            iov[iovcnt].iov_base = buff.as<void *>();
+            iov[iovcnt].iov_len = buff.length;
+            iovcnt++;
+        }
+        auto r = writev(_fd, iov, iovcnt);
+        #endif //_MSC_VER
+
+        if (r >= 0) in0->consume(size_t(r)/in0->dtype().size());
         else
         {
             poco_error_f3(Poco::Logger::get("BinaryFileSink"), "write() returned %d -- %s(%d)", int(r), std::string(strerror(errno)), errno);
@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <cassert>
+
+/*!
+ * Iterative radix-2 FFT with precomputed twiddles and bit-reversal.
+ * The plan is created once for a power of 2 size and reused,
+ * so that repeated transforms do not recompute the trig functions.
+ */
+template <typename Type>
+class FFTPlan
+{
+public:
+    typedef std::complex<Type> Complex;
+
+    FFTPlan(const size_t size = 1):
+        _size(size)
+    {
+        assert((size & (size-1)) == 0);
+
+        //twiddles for the largest stage, the smaller stages use strides
+        _twiddles.resize(size/2);
+        for (size_t k = 0; k < size/2; k++)
+        {
+            _twiddles[k] = std::polar(Type(1), Type(-2*M_PI*k/size));
+        }
+
+        //bit reversal permutation table
+        _reversed.resize(size);
+        size_t bits = 0;
+        while ((size_t(1) << bits) < size) bits++;
+        for (size_t i = 0; i < size; i++)
+        {
+            size_t r = 0;
+            for (size_t b = 0; b < bits; b++) if ((i >> b) & 1) r |= size_t(1) << (bits-1-b);
+            _reversed[i] = r;
+        }
+    }
+
+    size_t size(void) const
+    {
+        return _size;
+    }
+
+    //! forward transform (in-place)
+    void fft(Complex *x) const
+    {
+        this->transform(x, false);
+    }
+
+    //! inverse transform (in-place), scaled by 1/size
+    void ifft(Complex *x) const
+    {
+        this->transform(x, true);
+        const Type scale = Type(1)/_size;
+        for (size_t i = 0; i < _size; i++) x[i] *= scale;
+    }
+
+private:
+    void transform(Complex *x, const bool inverse) const
+    {
+        for (size_t i = 0; i < _size; i++)
+        {
+            if (i < _reversed[i]) std::swap(x[i], x[_reversed[i]]);
+        }
+
+        for (size_t half = 1; half < _size; half *= 2)
+        {
+            const size_t stride = _size/(half*2);
+            for (size_t start = 0; start < _size; start += half*2)
+            {
+                for (size_t k = 0; k < half; k++)
+                {
+                    auto w = _twiddles[k*stride];
+                    if (inverse) w = std::conj(w);
+                    const auto t = w*x[start+k+half];
+                    x[start+k+half] = x[start+k] - t;
+                    x[start+k] += t;
+                }
+            }
+        }
+    }
+
+    size_t _size;
+    std::vector<Complex> _twiddles;
+    std::vector<size_t> _reversed;
+};
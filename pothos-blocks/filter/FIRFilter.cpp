@@ -1,12 +1,73 @@
 // Copyright (c) 2014-2014 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "FFTHelper.hpp"
 #include <Pothos/Framework.hpp>
 #include <cstdint>
 #include <complex>
+#include <type_traits>
+#include <algorithm>
+#include <string>
 #include <cassert>
 #include <iostream>
 
+/***********************************************************************
+ * FFT implementation helpers:
+ * The FFT implementation computes in the complex type of the
+ * matching precision, and is only available for floating point.
+ **********************************************************************/
+template <typename Type> struct FIRFFTType
+{
+    typedef double type;
+    static const bool supported = std::is_floating_point<Type>::value;
+};
+
+template <> struct FIRFFTType<float>
+{
+    typedef float type;
+    static const bool supported = true;
+};
+
+template <typename Type> struct FIRFFTType<std::complex<Type>> : FIRFFTType<Type>
+{
+};
+
+template <typename WorkType, typename Type>
+std::complex<WorkType> toFFTType(const Type &x)
+{
+    return std::complex<WorkType>(WorkType(x), 0);
+}
+
+template <typename WorkType, typename Type>
+std::complex<WorkType> toFFTType(const std::complex<Type> &x)
+{
+    return std::complex<WorkType>(WorkType(x.real()), WorkType(x.imag()));
+}
+
+template <typename WorkType, typename Type>
+void fromFFTType(const std::complex<WorkType> &x, Type &y)
+{
+    y = Type(x.real());
+}
+
+template <typename WorkType, typename Type>
+void fromFFTType(const std::complex<WorkType> &x, std::complex<Type> &y)
+{
+    y = std::complex<Type>(Type(x.real()), Type(x.imag()));
+}
+
+//! Relative cost of one FFT butterfly stage per point versus a tap multiply-accumulate
+static const size_t FIR_FFT_COST_SCALE = 2;
+
+//! The filter implementations, selected by name with setMode()
+enum FIRMode
+{
+    FIR_MODE_AUTO,
+    FIR_MODE_DIRECT,
+    FIR_MODE_POLYPHASE,
+    FIR_MODE_FFT,
+};
+
 /***********************************************************************
  * |PothosDoc FIR Filter
  *
@@ -40,19 +101,43 @@
  * and use the FIR Designer taps signal to configure the filter taps at runtime.
  * |default [1.0]
  *
+ * |param mode[Mode] The implementation used to compute the filter.
+ * <ul>
+ * <li>"AUTO" - pick the implementation for each call from the number of taps,
+ * the decimation, and the number of outputs that the call produces</li>
+ * <li>"DIRECT" - direct-form convolution for every output element</li>
+ * <li>"POLYPHASE" - the input is split into one phase per decimation step,
+ * and each phase is filtered by its branch of the taps at the output rate</li>
+ * <li>"FFT" - overlap-save fast convolution, floating point types only</li>
+ * </ul>
+ * |default "AUTO"
+ * |option [Automatic] "AUTO"
+ * |option [Direct] "DIRECT"
+ * |option [Polyphase] "POLYPHASE"
+ * |option [FFT] "FFT"
+ * |preview valid
+ *
  * |factory /blocks/fir_filter(dtype, tapsType)
  * |setter setTaps(taps)
  * |setter setDecimation(decim)
  * |setter setInterpolation(interp)
+ * |setter setMode(mode)
  **********************************************************************/
 template <typename InType, typename OutType, typename TapsType>
 class FIRFilter : public Pothos::Block
 {
 public:
+    typedef typename FIRFFTType<OutType>::type FFTType;
+    typedef std::complex<FFTType> FFTComplex;
+
     FIRFilter(void):
         M(1),
         L(1),
-        K(1)
+        K(1),
+        _mode(FIR_MODE_AUTO),
+        _modeName("AUTO"),
+        _fftOutputsPerSegment(0),
+        _fftSegmentCost(0)
     {
         this->setupInput(0, typeid(InType));
         this->setupOutput(0, typeid(OutType));
@@ -62,6 +147,8 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(FIRFilter, getDecimation));
         this->registerCall(this, POTHOS_FCN_TUPLE(FIRFilter, setInterpolation));
         this->registerCall(this, POTHOS_FCN_TUPLE(FIRFilter, getInterpolation));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FIRFilter, setMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(FIRFilter, getMode));
         this->setTaps(std::vector<TapsType>(1, TapsType(1))); //initial update
     }
 
@@ -101,6 +188,26 @@ public:
         return L;
     }
 
+    void setMode(const std::string &mode)
+    {
+        if (mode == "AUTO") _mode = FIR_MODE_AUTO;
+        else if (mode == "DIRECT") _mode = FIR_MODE_DIRECT;
+        else if (mode == "POLYPHASE") _mode = FIR_MODE_POLYPHASE;
+        else if (mode == "FFT")
+        {
+            if (not FIRFFTType<OutType>::supported) throw Pothos::InvalidArgumentException("FIRFilter::setMode("+mode+")", "FFT mode requires a floating point type");
+            _mode = FIR_MODE_FFT;
+        }
+        else throw Pothos::InvalidArgumentException("FIRFilter::setMode("+mode+")", "unknown mode");
+        _modeName = mode;
+        this->updateInternals();
+    }
+
+    std::string getMode(void) const
+    {
+        return _modeName;
+    }
+
     //! always use a circular buffer to avoid discontinuity over sliding window
     Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &)
     {
@@ -124,9 +231,35 @@ public:
         const auto N = std::min((inPort->elements()-(K-1))/M, outPort->elements()/L);
 
         //grab pointers
-        auto x = inPort->buffer().template as<const InType *>() + (K-1);
+        auto x = inPort->buffer().template as<const InType *>();
         auto y = outPort->buffer().template as<OutType *>();
 
+        switch (this->selectMode(N))
+        {
+        case FIR_MODE_FFT: this->workFFT(x, y, N, inPort->elements()); break;
+        case FIR_MODE_POLYPHASE: this->workPolyphase(x + (K-1), y, N); break;
+        default: this->workDirect(x + (K-1), y, N); break;
+        }
+
+        //consume decimated, produce interpolated
+        //K-1 elements are left in the input buffer for filter history
+        inPort->consume(N*M);
+        outPort->produce(N*L);
+    }
+
+    void propagateLabels(const Pothos::InputPort *port)
+    {
+        auto outputPort = this->output(0);
+        for (const auto &label : port->labels())
+        {
+            outputPort->postLabel(label.toAdjusted(L, M));
+        }
+    }
+
+private:
+
+    void workDirect(const InType *x, OutType *y, const size_t N)
+    {
         //for each decimated input
         for (size_t n = 0; n < N; n++)
         {
@@ -142,23 +275,89 @@ public:
                 y[j+n*L] = y_n;
             }
         }
-
-        //consume decimated, produce interpolated
-        //K-1 elements are left in the input buffer for filter history
-        inPort->consume(N*M);
-        outPort->produce(N*L);
     }
 
-    void propagateLabels(const Pothos::InputPort *port)
+    /*!
+     * Polyphase decimation: the input is split into M phase streams
+     * at the output rate, x_p[n] = x[n*M-p], and the taps of each
+     * interpolation index into M branches, h_p[q] = h[p+q*M].
+     * Each output is the sum over the branches of h_p filtering x_p,
+     * accumulated one tap at a time across all N outputs,
+     * so that the inner loop runs over contiguous elements.
+     */
+    void workPolyphase(const InType *x, OutType *y, const size_t N)
     {
-        auto outputPort = this->output(0);
-        for (const auto &label : port->labels())
+        //Q is the length of the longest branch, each phase holds Q-1 history elements
+        const size_t Q = (K+M-1)/M;
+        const size_t len = N+Q-1;
+        if (M != 1)
         {
-            outputPort->postLabel(label.toAdjusted(L, M));
+            _phases.resize(M*len);
+            for (size_t p = 0; p < M; p++)
+            {
+                InType *x_p = _phases.data() + p*len;
+                for (size_t i = 0; i < len; i++)
+                {
+                    //elements before the history only meet taps past the end
+                    const auto offset = ptrdiff_t(i*M) - ptrdiff_t((Q-1)*M + p);
+                    x_p[i] = (offset + ptrdiff_t(K-1) < 0)? InType(0) : x[offset];
+                }
+            }
+        }
+
+        _accum.resize(N);
+        for (size_t j = 0; j < L; j++)
+        {
+            const auto &h = _interpTaps[j];
+            std::fill(_accum.begin(), _accum.end(), OutType(0));
+            for (size_t p = 0; p < M and p < h.size(); p++)
+            {
+                //with no decimation, the only phase is the input itself
+                const InType *x_p = (M == 1)? x : _phases.data() + p*len + (Q-1);
+                for (size_t q = 0; p+q*M < h.size(); q++)
+                {
+                    const TapsType h_pq = h[p+q*M];
+                    const InType *x_pq = x_p - q;
+                    for (size_t n = 0; n < N; n++) _accum[n] += h_pq * x_pq[n];
+                }
+            }
+            for (size_t n = 0; n < N; n++) y[j+n*L] = _accum[n];
         }
     }
 
-private:
+    /*!
+     * Overlap-save fast convolution: Each segment of the FFT size
+     * starts at a retained output and yields the outputs for
+     * the FFT size - (K-1) input elements that follow the history.
+     * Input past the available elements is zero filled,
+     * since it only contributes to outputs that are not kept.
+     */
+    void workFFT(const InType *x, OutType *y, const size_t N, const size_t available)
+    {
+        const size_t fftSize = _fftPlan.size();
+        const size_t outputsPerSegment = (fftSize-(K-1)-1)/M + 1;
+
+        for (size_t n0 = 0; n0 < N; n0 += outputsPerSegment)
+        {
+            const size_t start = n0*M;
+            const size_t numIn = std::min(fftSize, available-start);
+            for (size_t i = 0; i < numIn; i++) _fftIn[i] = toFFTType<FFTType>(x[start+i]);
+            for (size_t i = numIn; i < fftSize; i++) _fftIn[i] = 0;
+            _fftPlan.fft(_fftIn.data());
+
+            const size_t numOut = std::min(outputsPerSegment, N-n0);
+            for (size_t j = 0; j < L; j++)
+            {
+                const FFTComplex *H = _fftTaps.data() + j*fftSize;
+                for (size_t i = 0; i < fftSize; i++) _fftOut[i] = _fftIn[i]*H[i];
+                _fftPlan.ifft(_fftOut.data());
+                for (size_t n = 0; n < numOut; n++)
+                {
+                    fromFFTType(_fftOut[n*M + (K-1)], y[j+(n0+n)*L]);
+                }
+            }
+        }
+    }
 
     void updateInternals(void)
     {
@@ -185,11 +384,65 @@ private:
                 _interpTaps[j].push_back(_taps[i]);
             }
         }
+
+        //Overlap-save costs one forward transform per segment and one multiply and
+        //inverse transform per interpolation index, for the outputs of the segment.
+        //The FFT size is a power of 2 that holds several times the history.
+        size_t fftSize = 16, fftLog2 = 4;
+        while (fftSize < 4*K) {fftSize *= 2; fftLog2++;}
+        _fftOutputsPerSegment = (fftSize-(K-1)-1)/M + 1;
+        _fftSegmentCost = (1+L)*fftSize*fftLog2*FIR_FFT_COST_SCALE + L*fftSize;
+
+        //Transform the taps of each interpolation index for the FFT implementation,
+        //in automatic mode only when full segments cost less than the direct form.
+        _fftTaps.clear();
+        const bool fftCanWin = FIRFFTType<OutType>::supported and
+            _fftSegmentCost < _fftOutputsPerSegment*L*K;
+        if (_mode != FIR_MODE_FFT and not (_mode == FIR_MODE_AUTO and fftCanWin)) return;
+        _fftPlan = FFTPlan<FFTType>(fftSize);
+        _fftIn.resize(fftSize);
+        _fftOut.resize(fftSize);
+        _fftTaps.assign(L*fftSize, FFTComplex(0));
+        for (size_t j = 0; j < L; j++)
+        {
+            FFTComplex *H = _fftTaps.data() + j*fftSize;
+            for (size_t k = 0; k < _interpTaps[j].size(); k++)
+            {
+                H[k] = toFFTType<FFTType>(_interpTaps[j][k]);
+            }
+            _fftPlan.fft(H);
+        }
+    }
+
+    /*!
+     * The implementation for a call that produces N decimated outputs:
+     * The FFT computes whole segments, so with few outputs per call,
+     * or a decimation that discards most of each segment,
+     * the polyphase form costs less than the FFT.
+     */
+    FIRMode selectMode(const size_t N) const
+    {
+        if (_mode != FIR_MODE_AUTO) return _mode;
+        if (_fftTaps.empty()) return FIR_MODE_POLYPHASE;
+        const size_t numSegments = (N + _fftOutputsPerSegment - 1)/_fftOutputsPerSegment;
+        return (numSegments*_fftSegmentCost < N*L*K)? FIR_MODE_FFT : FIR_MODE_POLYPHASE;
     }
 
     std::vector<TapsType> _taps;
     std::vector<std::vector<TapsType>> _interpTaps;
     size_t M, L, K;
+    FIRMode _mode;
+    std::string _modeName;
+
+    std::vector<InType> _phases;
+    std::vector<OutType> _accum;
+
+    size_t _fftOutputsPerSegment;
+    size_t _fftSegmentCost;
+
+    FFTPlan<FFTType> _fftPlan;
+    std::vector<FFTComplex> _fftTaps;
+    std::vector<FFTComplex> _fftIn, _fftOut;
 };
 
 /***********************************************************************
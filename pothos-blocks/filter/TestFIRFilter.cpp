@@ -5,6 +5,9 @@
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
 #include <cmath> //fabs
+#include <cstdlib> //rand
+#include <cstdint>
+#include <algorithm> //max
 #include <iostream>
 
 static double filterToneGetRMS(
@@ -75,3 +78,91 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_fir_filter)
         }
     }
 }
+
+/***********************************************************************
+ * Compare the filter implementations against the direct form
+ **********************************************************************/
+template <typename Type>
+static std::vector<Type> filterModeOutput(
+    const std::string &dtype,
+    const Pothos::BufferChunk &input,
+    const std::vector<Type> &taps,
+    const size_t decim,
+    const size_t interp,
+    const std::string &mode
+)
+{
+    auto registry = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    auto feeder = registry.callProxy("/blocks/feeder_source", dtype);
+    auto filter = registry.callProxy("/blocks/fir_filter", dtype, "REAL");
+    auto collector = registry.callProxy("/blocks/collector_sink", dtype);
+    filter.callVoid("setDecimation", decim);
+    filter.callVoid("setInterpolation", interp);
+    filter.callVoid("setMode", mode);
+    filter.callVoid("setTaps", taps);
+    POTHOS_TEST_EQUAL(filter.call<std::string>("getMode"), mode);
+    feeder.callVoid("feedBuffer", input);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, filter, 0);
+        topology.connect(filter, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    auto buff = collector.call<Pothos::BufferChunk>("getBuffer");
+    return std::vector<Type>(buff.as<const Type *>(), buff.as<const Type *>() + buff.length/sizeof(Type));
+}
+
+template <typename Type>
+static void testFilterModes(
+    const std::string &dtype, const size_t numTaps, const double scale,
+    const double tolerance, const std::vector<std::string> &modes)
+{
+    //random input and taps
+    const size_t numElems = 20000;
+    Pothos::BufferChunk input(numElems*sizeof(Type));
+    for (size_t i = 0; i < numElems; i++) input.as<Type *>()[i] = Type((std::rand()/double(RAND_MAX) - 0.5)*scale);
+    std::vector<Type> taps(numTaps);
+    for (auto &tap : taps) tap = Type((std::rand()/double(RAND_MAX) - 0.5)*scale);
+
+    //decimations that do and do not divide the number of taps
+    const size_t rates[][2] = {{1, 1}, {3, 1}, {1, 2}, {2, 3}, {8, 1}, {4, 3}};
+    for (const auto &rate : rates)
+    {
+        const auto decim = rate[0], interp = rate[1];
+        const auto expected = filterModeOutput(dtype, input, taps, decim, interp, "DIRECT");
+        POTHOS_TEST_TRUE(not expected.empty());
+        for (const auto &mode : modes)
+        {
+            const auto result = filterModeOutput(dtype, input, taps, decim, interp, mode);
+            POTHOS_TEST_EQUAL(result.size(), expected.size());
+            double maxError = 0.0;
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                maxError = std::max(maxError, std::abs(double(result[i]) - double(expected[i])));
+            }
+            POTHOS_TEST_TRUE(maxError < tolerance);
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_fir_filter_modes)
+{
+    const std::vector<std::string> allModes = {"POLYPHASE", "FFT", "AUTO"};
+    testFilterModes<double>("float64", 37, 1.0, 1e-9, allModes);
+    testFilterModes<double>("float64", 512, 1.0, 1e-9, allModes);
+    testFilterModes<float>("float32", 512, 1.0, 1e-3, allModes);
+
+    //integer types are exact in the polyphase form
+    testFilterModes<int32_t>("int32", 37, 200.0, 0.5, {"POLYPHASE", "AUTO"});
+
+    //the FFT is only available for floating point types
+    auto registry = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+    auto filter = registry.callProxy("/blocks/fir_filter", "int32", "REAL");
+    POTHOS_TEST_THROWS(filter.callVoid("setMode", "FFT"), Pothos::ProxyExceptionMessage);
+    filter.callVoid("setMode", "POLYPHASE");
+}
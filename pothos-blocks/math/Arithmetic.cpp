@@ -1,6 +1,7 @@
 // Copyright (c) 2014-2014 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "ArithmeticKernels.hpp"
 #include <Pothos/Framework.hpp>
 #include <cstdint>
 #include <iostream>
@@ -13,7 +14,12 @@
  *
  * Perform arithmetic operations on elements across multiple input ports to produce a stream of outputs.
  *
- * out[n] = in0[n] $op in1[n] $op ... $op in_last[n]
+ * out[n] = in0[n] $op in1[n] $op ... $op in_last[n] $op constant
+ *
+ * The operation is fused across all inputs in a single pass over the output,
+ * using vector instructions for the host CPU where they are available.
+ * An optional constant operand is applied after the last input,
+ * so that scaling or offsetting a stream does not need a constant source block.
  *
  * |category /Math
  * |keywords math arithmetic add subtract multiply divide
@@ -32,9 +38,17 @@
  *
  * |param numInputs[Num Inputs] The number of input ports.
  * |default 2
- * |widget SpinBox(minimum=2)
+ * |widget SpinBox(minimum=1)
  * |preview disable
  *
+ * |param constant An optional constant operand applied after the last input.
+ * A single input with a constant computes out[n] = in0[n] $op constant.
+ * An empty value disables the constant operand.
+ * |default ""
+ * |widget ComboBox(editable=true)
+ * |option [Disabled] ""
+ * |preview valid
+ *
  * |param preload The number of elements to preload into each input.
  * The value is an array of integers where each element represents
  * the number of elements to preload the port with.
@@ -46,18 +60,24 @@
  * |factory /blocks/arithmetic(dtype, operation)
  * |initializer setNumInputs(numInputs)
  * |initializer setPreload(preload)
+ * |setter setConstant(constant)
  **********************************************************************/
-template <typename Type, void (*Operator)(const Type *, const Type *, Type *, const size_t)>
+template <typename Type, typename Operator>
 class Arithmetic : public Pothos::Block
 {
 public:
     Arithmetic(void):
+        _kernel(getArithmeticKernel<Operator, Type>()),
+        _useConstant(false),
+        _constant(),
         _numInlineBuffers(0)
     {
         typedef Arithmetic<Type, Operator> ClassType;
         this->registerCall(this, POTHOS_FCN_TUPLE(ClassType, setNumInputs));
         this->registerCall(this, POTHOS_FCN_TUPLE(ClassType, setPreload));
         this->registerCall(this, POTHOS_FCN_TUPLE(ClassType, preload));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ClassType, setConstant));
+        this->registerCall(this, POTHOS_FCN_TUPLE(ClassType, getConstant));
         this->registerCall(this, POTHOS_FCN_TUPLE(ClassType, getNumInlineBuffers));
         this->setupInput(0, typeid(Type));
         this->setupOutput(0, typeid(Type), this->uid()); //unique domain because of inline buffer forwarding
@@ -68,7 +88,7 @@ public:
 
     void setNumInputs(const size_t numInputs)
     {
-        if (numInputs < 2) throw Pothos::RangeException("Arithmetic::setNumInputs("+std::to_string(numInputs)+")", "require inputs >= 2");
+        if (numInputs < 1) throw Pothos::RangeException("Arithmetic::setNumInputs("+std::to_string(numInputs)+")", "require inputs >= 1");
         for (size_t i = this->inputs().size(); i < numInputs; i++)
         {
             this->setupInput(i, this->input(0)->dtype());
@@ -86,6 +106,18 @@ public:
         return _preload;
     }
 
+    void setConstant(const Pothos::Object &constant)
+    {
+        //an empty string from the block description disables the constant
+        _useConstant = constant and not (constant.type() == typeid(std::string) and constant.extract<std::string>().empty());
+        _constant = _useConstant?constant.convert<Type>():Type();
+    }
+
+    Type getConstant(void) const
+    {
+        return _constant; //zero when disabled
+    }
+
     void activate(void)
     {
         for (size_t i = 0; i < _preload.size(); i++)
@@ -111,20 +143,15 @@ public:
 
         //establish pointers to buffers
         auto out = Pothos::BufferChunk(output->buffer()).as<Type *>();
-        auto in0 = inputs[0]->buffer().as<const Type *>();
-        if (out == in0) _numInlineBuffers++; //track buffer inlining
+        _ins.resize(inputs.size());
+        for (size_t i = 0; i < inputs.size(); i++) _ins[i] = inputs[i]->buffer().as<const Type *>();
+        if (out == _ins[0]) _numInlineBuffers++; //track buffer inlining
 
-        //loop through available ports
-        for (size_t i = 1; i < inputs.size(); i++)
-        {
-            auto *inX = inputs[i]->buffer().as<const Type *>();
-            Operator(in0, inX, out, elems);
-            in0 = out; //operate on output array next loop
-            inputs[i]->consume(elems); //consume on ith input port
-        }
+        //single pass over all inputs and the constant
+        _kernel(out, _ins.data(), _ins.size(), _useConstant?&_constant:nullptr, elems);
 
-        //produce and consume on 0th ports
-        inputs[0]->consume(elems);
+        //produce and consume on all ports
+        for (auto input : inputs) input->consume(elems);
         output->produce(elems);
     }
 
@@ -134,49 +161,26 @@ public:
     }
 
 private:
+    const ArithmeticFcn<Type> _kernel;
+    std::vector<const Type *> _ins;
+    bool _useConstant;
+    Type _constant;
     size_t _numInlineBuffers;
     std::vector<size_t> _preload;
 };
 
-/***********************************************************************
- * templated arithmetic vector operators
- **********************************************************************/
-template <typename Type>
-void addArray(const Type *in0, const Type *in1, Type *out, const size_t num)
-{
-    for (size_t i = 0; i < num; i++) out[i] = in0[i] + in1[i];
-}
-
-template <typename Type>
-void subArray(const Type *in0, const Type *in1, Type *out, const size_t num)
-{
-    for (size_t i = 0; i < num; i++) out[i] = in0[i] - in1[i];
-}
-
-template <typename Type>
-void mulArray(const Type *in0, const Type *in1, Type *out, const size_t num)
-{
-    for (size_t i = 0; i < num; i++) out[i] = in0[i] * in1[i];
-}
-
-template <typename Type>
-void divArray(const Type *in0, const Type *in1, Type *out, const size_t num)
-{
-    for (size_t i = 0; i < num; i++) out[i] = in0[i] / in1[i];
-}
-
 /***********************************************************************
  * registration
  **********************************************************************/
 static Pothos::Block *arithmeticFactory(const Pothos::DType &dtype, const std::string &operation)
 {
     #define ifTypeDeclareFactory__(type, opKey, opVal) \
-        if (dtype == Pothos::DType(typeid(type)) and operation == opKey) return new Arithmetic<type, opVal<type>>();
+        if (dtype == Pothos::DType(typeid(type)) and operation == opKey) return new Arithmetic<type, opVal>();
     #define ifTypeDeclareFactory_(type) \
-        ifTypeDeclareFactory__(type, "ADD", addArray) \
-        ifTypeDeclareFactory__(type, "SUB", subArray) \
-        ifTypeDeclareFactory__(type, "MUL", mulArray) \
-        ifTypeDeclareFactory__(type, "DIV", divArray)
+        ifTypeDeclareFactory__(type, "ADD", ArithmeticAdd) \
+        ifTypeDeclareFactory__(type, "SUB", ArithmeticSub) \
+        ifTypeDeclareFactory__(type, "MUL", ArithmeticMul) \
+        ifTypeDeclareFactory__(type, "DIV", ArithmeticDiv)
     #define ifTypeDeclareFactory(type) \
         ifTypeDeclareFactory_(type) \
         ifTypeDeclareFactory_(std::complex<type>)
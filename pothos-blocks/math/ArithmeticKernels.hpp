@@ -0,0 +1,303 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstring> //memcpy
+
+/***********************************************************************
+ * Element-wise operators
+ *
+ * The complex multiply is expanded into its component products
+ * rather than calling the library multiply, which handles the
+ * infinite and not-a-number cases in a runtime helper and cannot vectorize.
+ **********************************************************************/
+struct ArithmeticAdd
+{
+    template <typename Type>
+    static Type apply(const Type &a, const Type &b) {return a + b;}
+};
+
+struct ArithmeticSub
+{
+    template <typename Type>
+    static Type apply(const Type &a, const Type &b) {return a - b;}
+};
+
+struct ArithmeticMul
+{
+    template <typename Type>
+    static Type apply(const Type &a, const Type &b) {return a * b;}
+
+    template <typename Type>
+    static std::complex<Type> apply(const std::complex<Type> &a, const std::complex<Type> &b)
+    {
+        return std::complex<Type>(
+            a.real()*b.real() - a.imag()*b.imag(),
+            a.real()*b.imag() + a.imag()*b.real());
+    }
+};
+
+struct ArithmeticDiv
+{
+    template <typename Type>
+    static Type apply(const Type &a, const Type &b) {return a / b;}
+};
+
+/***********************************************************************
+ * Fused arithmetic kernel
+ *
+ * The output is computed in chunks sized to stay in the L1 cache:
+ * every input and the optional constant are applied to one chunk
+ * before moving on to the next, so the output makes a single pass
+ * through memory no matter how many inputs there are.
+ * Each chunk is operated on in fixed size blocks that the compiler
+ * vectorizes for the target ISA, and the remainder is scalar.
+ * The complex multiply has hand written kernels for float and double.
+ * The output may be the same buffer as input 0 (read before write).
+ **********************************************************************/
+template <typename Type>
+using ArithmeticFcn = void (*)(Type *, const Type *const *, const size_t, const Type *, const size_t);
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POTHOS_ARITHMETIC_X86
+#define POTHOS_TARGET_AVX2 __attribute__((target("avx2")))
+#define POTHOS_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw")))
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define POTHOS_ARITHMETIC_INLINE inline __attribute__((always_inline))
+#define POTHOS_ARITHMETIC_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define POTHOS_ARITHMETIC_INLINE __forceinline
+#define POTHOS_ARITHMETIC_IVDEP __pragma(loop(ivdep))
+#else
+#define POTHOS_ARITHMETIC_INLINE inline
+#define POTHOS_ARITHMETIC_IVDEP
+#endif
+
+static const size_t ARITHMETIC_BLOCK_SIZE = 64;
+static const size_t ARITHMETIC_CHUNK_BYTES = 8*1024;
+
+//! Tags for the instruction set that a kernel is compiled for
+struct ArithmeticIsaDefault {};
+struct ArithmeticIsaAvx2 {};
+struct ArithmeticIsaAvx512 {};
+
+/*!
+ * The element loop: out[i] = a[i] op b[i] where out may be a.
+ * Elements only depend on the same index, so the loop ignores
+ * the possible aliasing of the output with the first operand.
+ */
+template <typename Isa, typename Op, typename Type>
+struct ArithmeticLoop
+{
+    static POTHOS_ARITHMETIC_INLINE void apply(Type *out, const Type *a, const Type *b, const size_t num)
+    {
+        size_t i = 0;
+        for (; i + ARITHMETIC_BLOCK_SIZE <= num; i += ARITHMETIC_BLOCK_SIZE)
+        {
+            POTHOS_ARITHMETIC_IVDEP
+            for (size_t j = i; j < i + ARITHMETIC_BLOCK_SIZE; j++) out[j] = Op::apply(a[j], b[j]);
+        }
+        for (; i < num; i++) out[i] = Op::apply(a[i], b[i]);
+    }
+};
+
+//! Complex add and subtract operate on the interleaved components
+template <typename Isa, typename Op, typename Type>
+struct ArithmeticComponentLoop
+{
+    static POTHOS_ARITHMETIC_INLINE void apply(std::complex<Type> *out, const std::complex<Type> *a, const std::complex<Type> *b, const size_t num)
+    {
+        ArithmeticLoop<Isa, Op, Type>::apply(reinterpret_cast<Type *>(out),
+            reinterpret_cast<const Type *>(a), reinterpret_cast<const Type *>(b), num*2);
+    }
+};
+
+template <typename Isa, typename Type>
+struct ArithmeticLoop<Isa, ArithmeticAdd, std::complex<Type>> : ArithmeticComponentLoop<Isa, ArithmeticAdd, Type> {};
+
+template <typename Isa, typename Type>
+struct ArithmeticLoop<Isa, ArithmeticSub, std::complex<Type>> : ArithmeticComponentLoop<Isa, ArithmeticSub, Type> {};
+
+/*!
+ * Complex multiply on the interleaved components.
+ * The vector kernels multiply a by the duplicated real and imaginary
+ * parts of b and combine the products with alternating signs.
+ */
+template <typename Isa, typename Type>
+struct ArithmeticLoop<Isa, ArithmeticMul, std::complex<Type>>
+{
+    static POTHOS_ARITHMETIC_INLINE void scalar(Type *out, const Type *a, const Type *b, const size_t num)
+    {
+        for (size_t j = 0; j < num*2; j += 2)
+        {
+            const Type ar = a[j], ai = a[j+1], br = b[j], bi = b[j+1];
+            out[j] = ar*br - ai*bi;
+            out[j+1] = ar*bi + ai*br;
+        }
+    }
+
+    static POTHOS_ARITHMETIC_INLINE void apply(std::complex<Type> *out, const std::complex<Type> *a, const std::complex<Type> *b, const size_t num)
+    {
+        scalar(reinterpret_cast<Type *>(out), reinterpret_cast<const Type *>(a), reinterpret_cast<const Type *>(b), num);
+    }
+};
+
+#if defined(POTHOS_ARITHMETIC_X86) && defined(__SSE2__)
+template <>
+struct ArithmeticLoop<ArithmeticIsaDefault, ArithmeticMul, std::complex<float>> : ArithmeticLoop<void, ArithmeticMul, std::complex<float>>
+{
+    static POTHOS_ARITHMETIC_INLINE void apply(std::complex<float> *out_, const std::complex<float> *a_, const std::complex<float> *b_, const size_t num)
+    {
+        auto out = reinterpret_cast<float *>(out_);
+        auto a = reinterpret_cast<const float *>(a_);
+        auto b = reinterpret_cast<const float *>(b_);
+        const __m128 sign = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+        size_t i = 0;
+        for (; i + 2 <= num; i += 2)
+        {
+            const __m128 va = _mm_loadu_ps(a + i*2);
+            const __m128 vb = _mm_loadu_ps(b + i*2);
+            const __m128 re = _mm_mul_ps(va, _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 2, 0, 0)));
+            const __m128 im = _mm_mul_ps(_mm_shuffle_ps(va, va, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 3, 1, 1)));
+            _mm_storeu_ps(out + i*2, _mm_add_ps(re, _mm_xor_ps(im, sign)));
+        }
+        scalar(out + i*2, a + i*2, b + i*2, num - i);
+    }
+};
+
+template <>
+struct ArithmeticLoop<ArithmeticIsaDefault, ArithmeticMul, std::complex<double>> : ArithmeticLoop<void, ArithmeticMul, std::complex<double>>
+{
+    static POTHOS_ARITHMETIC_INLINE void apply(std::complex<double> *out_, const std::complex<double> *a_, const std::complex<double> *b_, const size_t num)
+    {
+        auto out = reinterpret_cast<double *>(out_);
+        auto a = reinterpret_cast<const double *>(a_);
+        auto b = reinterpret_cast<const double *>(b_);
+        const __m128d sign = _mm_setr_pd(-0.0, 0.0);
+        for (size_t i = 0; i < num; i++)
+        {
+            const __m128d va = _mm_loadu_pd(a + i*2);
+            const __m128d vb = _mm_loadu_pd(b + i*2);
+            const __m128d re = _mm_mul_pd(va, _mm_unpacklo_pd(vb, vb));
+            const __m128d im = _mm_mul_pd(_mm_shuffle_pd(va, va, 1), _mm_unpackhi_pd(vb, vb));
+            _mm_storeu_pd(out + i*2, _mm_add_pd(re, _mm_xor_pd(im, sign)));
+        }
+    }
+};
+#endif //POTHOS_ARITHMETIC_X86
+
+#if defined(POTHOS_ARITHMETIC_X86)
+template <>
+struct ArithmeticLoop<ArithmeticIsaAvx2, ArithmeticMul, std::complex<float>> : ArithmeticLoop<void, ArithmeticMul, std::complex<float>>
+{
+    static POTHOS_TARGET_AVX2 void apply(std::complex<float> *out_, const std::complex<float> *a_, const std::complex<float> *b_, const size_t num)
+    {
+        auto out = reinterpret_cast<float *>(out_);
+        auto a = reinterpret_cast<const float *>(a_);
+        auto b = reinterpret_cast<const float *>(b_);
+        size_t i = 0;
+        for (; i + 4 <= num; i += 4)
+        {
+            const __m256 va = _mm256_loadu_ps(a + i*2);
+            const __m256 vb = _mm256_loadu_ps(b + i*2);
+            const __m256 re = _mm256_mul_ps(va, _mm256_moveldup_ps(vb));
+            const __m256 im = _mm256_mul_ps(_mm256_permute_ps(va, 0xb1), _mm256_movehdup_ps(vb));
+            _mm256_storeu_ps(out + i*2, _mm256_addsub_ps(re, im));
+        }
+        scalar(out + i*2, a + i*2, b + i*2, num - i);
+    }
+};
+
+template <>
+struct ArithmeticLoop<ArithmeticIsaAvx2, ArithmeticMul, std::complex<double>> : ArithmeticLoop<void, ArithmeticMul, std::complex<double>>
+{
+    static POTHOS_TARGET_AVX2 void apply(std::complex<double> *out_, const std::complex<double> *a_, const std::complex<double> *b_, const size_t num)
+    {
+        auto out = reinterpret_cast<double *>(out_);
+        auto a = reinterpret_cast<const double *>(a_);
+        auto b = reinterpret_cast<const double *>(b_);
+        size_t i = 0;
+        for (; i + 2 <= num; i += 2)
+        {
+            const __m256d va = _mm256_loadu_pd(a + i*2);
+            const __m256d vb = _mm256_loadu_pd(b + i*2);
+            const __m256d re = _mm256_mul_pd(va, _mm256_movedup_pd(vb));
+            const __m256d im = _mm256_mul_pd(_mm256_permute_pd(va, 0x5), _mm256_permute_pd(vb, 0xf));
+            _mm256_storeu_pd(out + i*2, _mm256_addsub_pd(re, im));
+        }
+        scalar(out + i*2, a + i*2, b + i*2, num - i);
+    }
+};
+
+template <typename Type>
+struct ArithmeticLoop<ArithmeticIsaAvx512, ArithmeticMul, std::complex<Type>> : ArithmeticLoop<ArithmeticIsaAvx2, ArithmeticMul, std::complex<Type>> {};
+#endif //POTHOS_ARITHMETIC_X86
+
+template <typename Isa, typename Op, typename Type>
+POTHOS_ARITHMETIC_INLINE void arithmeticFused(Type *out, const Type *const *ins, const size_t numIns, const Type *constant, const size_t num)
+{
+    typedef ArithmeticLoop<Isa, Op, Type> Loop;
+    const size_t chunkSize = std::max(ARITHMETIC_BLOCK_SIZE,
+        (ARITHMETIC_CHUNK_BYTES/sizeof(Type))/ARITHMETIC_BLOCK_SIZE*ARITHMETIC_BLOCK_SIZE);
+
+    //the constant is applied as an operand block that repeats the value
+    Type constantBlock[ARITHMETIC_BLOCK_SIZE];
+    if (constant != nullptr) std::fill(constantBlock, constantBlock+ARITHMETIC_BLOCK_SIZE, *constant);
+
+    for (size_t offset = 0; offset < num; offset += chunkSize)
+    {
+        const size_t n = std::min(chunkSize, num - offset);
+        Type *o = out + offset;
+
+        //the first operation reads input 0 unless it is already the output
+        size_t i = 1;
+        if (ins[0] != out)
+        {
+            if (numIns > 1) Loop::apply(o, ins[0]+offset, ins[1]+offset, n), i = 2;
+            else std::memcpy(o, ins[0]+offset, n*sizeof(Type));
+        }
+        for (; i < numIns; i++) Loop::apply(o, o, ins[i]+offset, n);
+        if (constant != nullptr) for (size_t j = 0; j < n; j += ARITHMETIC_BLOCK_SIZE)
+        {
+            Loop::apply(o+j, o+j, constantBlock, std::min(ARITHMETIC_BLOCK_SIZE, n-j));
+        }
+    }
+}
+
+/*!
+ * Define the fused kernel for an ISA: the always inline loops
+ * are compiled with the target options of the kernel function.
+ */
+#define POTHOS_ARITHMETIC_KERNEL(name, target, Isa) \
+    template <typename Op, typename Type> target \
+    void name(Type *out, const Type *const *ins, const size_t numIns, const Type *constant, const size_t num) \
+    { \
+        arithmeticFused<Isa, Op, Type>(out, ins, numIns, constant, num); \
+    }
+
+POTHOS_ARITHMETIC_KERNEL(arithmeticKernelDefault, , ArithmeticIsaDefault)
+#if defined(POTHOS_ARITHMETIC_X86)
+POTHOS_ARITHMETIC_KERNEL(arithmeticKernelAvx2, POTHOS_TARGET_AVX2, ArithmeticIsaAvx2)
+POTHOS_ARITHMETIC_KERNEL(arithmeticKernelAvx512, POTHOS_TARGET_AVX512, ArithmeticIsaAvx512)
+#endif
+
+/*!
+ * Get the best fused kernel for the host CPU.
+ * The default kernel is vectorized for the baseline ISA
+ * (SSE2 on x86-64 and NEON on aarch64).
+ */
+template <typename Op, typename Type>
+ArithmeticFcn<Type> getArithmeticKernel(void)
+{
+    #if defined(POTHOS_ARITHMETIC_X86)
+    if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512bw")) return &arithmeticKernelAvx512<Op, Type>;
+    if (__builtin_cpu_supports("avx2")) return &arithmeticKernelAvx2<Op, Type>;
+    #endif
+    return &arithmeticKernelDefault<Op, Type>;
+}
@@ -4,7 +4,15 @@
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Poco/JSON/Object.h>
+#include "ArithmeticKernels.hpp"
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <vector>
 
 POTHOS_TEST_BLOCK("/blocks/tests", test_arithmetic_add)
 {
@@ -131,3 +139,229 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_inline_buffer)
     std::cout << "NumInlineBuffers " << numInlines << std::endl;
     POTHOS_TEST_TRUE(numInlines > 0);
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_arithmetic_constant)
+{
+    auto registry = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    auto feeder = registry.callProxy("/blocks/feeder_source", "complex_float32");
+    auto multiplier = registry.callProxy("/blocks/arithmetic", "complex_float32", "MUL");
+    auto collector = registry.callProxy("/blocks/collector_sink", "complex_float32");
+
+    //a single input scaled by a constant
+    multiplier.callVoid("setNumInputs", 1);
+    multiplier.callVoid("setConstant", std::complex<double>(0, 2));
+    POTHOS_TEST_TRUE(multiplier.call<std::complex<float>>("getConstant") == std::complex<float>(0, 2));
+
+    //load feeder block
+    const size_t numElems = 1000;
+    auto b0 = Pothos::BufferChunk(numElems*sizeof(std::complex<float>));
+    auto p0 = b0.as<std::complex<float> *>();
+    for (size_t i = 0; i < numElems; i++) p0[i] = std::complex<float>(float(i), 1);
+    feeder.callProxy("feedBuffer", b0);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, multiplier, 0);
+        topology.connect(multiplier, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the collector
+    auto buff = collector.call<Pothos::BufferChunk>("getBuffer");
+    POTHOS_TEST_EQUAL(buff.length, numElems*sizeof(std::complex<float>));
+    auto pb = buff.as<const std::complex<float> *>();
+    for (size_t i = 0; i < numElems; i++)
+    {
+        POTHOS_TEST_EQUAL(pb[i].real(), -2.0f);
+        POTHOS_TEST_EQUAL(pb[i].imag(), 2.0f*i);
+    }
+
+    //an empty value disables the constant
+    multiplier.callVoid("setConstant", std::string());
+    POTHOS_TEST_TRUE(multiplier.call<std::complex<float>>("getConstant") == std::complex<float>());
+}
+
+/***********************************************************************
+ * Check the fused kernels against a reference for every type and
+ * operation, then compare the throughput with one pass per input.
+ **********************************************************************/
+template <typename Op, typename Type>
+static void referenceArithmetic(Type *out, const Type *const *ins, const size_t numIns, const Type *constant, const size_t num)
+{
+    if (out != ins[0]) for (size_t n = 0; n < num; n++) out[n] = ins[0][n];
+    for (size_t i = 1; i < numIns; i++)
+    {
+        for (size_t n = 0; n < num; n++) out[n] = Op::apply(out[n], ins[i][n]);
+    }
+    if (constant != nullptr) for (size_t n = 0; n < num; n++) out[n] = Op::apply(out[n], *constant);
+}
+
+template <typename Type>
+static void setArithmeticTestValue(Type &v, const int re, const int)
+{
+    v = Type(re);
+}
+
+template <typename Type>
+static void setArithmeticTestValue(std::complex<Type> &v, const int re, const int im)
+{
+    v = std::complex<Type>(Type(re), Type(im));
+}
+
+//integer results are exact, floating point results may be contracted
+template <typename Type>
+static bool arithmeticClose(const Type &a, const Type &b)
+{
+    return a == b;
+}
+
+static bool arithmeticClose(const std::complex<double> &a, const std::complex<double> &b)
+{
+    return std::abs(a - b) <= 1e-6*(1.0 + std::abs(b));
+}
+
+static bool arithmeticClose(const std::complex<float> &a, const std::complex<float> &b)
+{
+    return std::abs(a - b) <= 1e-5f*(1.0f + std::abs(b));
+}
+
+static bool arithmeticClose(const double &a, const double &b)
+{
+    return arithmeticClose(std::complex<double>(a), std::complex<double>(b));
+}
+
+static bool arithmeticClose(const float &a, const float &b)
+{
+    return arithmeticClose(std::complex<float>(a), std::complex<float>(b));
+}
+
+template <typename Type>
+static bool arithmeticClose(const std::vector<Type> &a, const std::vector<Type> &b)
+{
+    for (size_t n = 0; n < a.size(); n++)
+    {
+        if (not arithmeticClose(a[n], b[n])) return false;
+    }
+    return a.size() == b.size();
+}
+
+template <typename Op, typename Type>
+static void testArithmeticKernel(const size_t num)
+{
+    //small positive values never divide by zero
+    const size_t numIns = 3;
+    std::vector<std::vector<Type>> inputs(numIns, std::vector<Type>(num));
+    std::vector<const Type *> ins;
+    for (size_t i = 0; i < numIns; i++)
+    {
+        for (size_t n = 0; n < num; n++) setArithmeticTestValue(inputs[i][n], (n*(i+3))%5+1, (n+i)%3);
+        ins.push_back(inputs[i].data());
+    }
+    Type constant; setArithmeticTestValue(constant, 2, 1);
+    const auto kernel = getArithmeticKernel<Op, Type>();
+
+    for (size_t numInsUsed = 1; numInsUsed <= numIns; numInsUsed++)
+    {
+        std::vector<Type> expected(num), out(num);
+        referenceArithmetic<Op, Type>(expected.data(), ins.data(), numInsUsed, &constant, num);
+        kernel(out.data(), ins.data(), numInsUsed, &constant, num);
+        POTHOS_TEST_TRUE(arithmeticClose(out, expected));
+
+        //the output buffer is input 0 when the buffer is inlined
+        std::vector<Type> inlined(inputs[0]);
+        std::vector<const Type *> insInlined(ins);
+        insInlined[0] = inlined.data();
+        referenceArithmetic<Op, Type>(expected.data(), ins.data(), numInsUsed, nullptr, num);
+        kernel(inlined.data(), insInlined.data(), numInsUsed, nullptr, num);
+        POTHOS_TEST_TRUE(arithmeticClose(inlined, expected));
+    }
+}
+
+template <typename Type>
+static void testArithmeticKernels(void)
+{
+    //odd sizes exercise the chunk and block remainders
+    for (const size_t num : {1, 63, 4099})
+    {
+        testArithmeticKernel<ArithmeticAdd, Type>(num);
+        testArithmeticKernel<ArithmeticSub, Type>(num);
+        testArithmeticKernel<ArithmeticMul, Type>(num);
+        testArithmeticKernel<ArithmeticDiv, Type>(num);
+        testArithmeticKernel<ArithmeticAdd, std::complex<Type>>(num);
+        testArithmeticKernel<ArithmeticSub, std::complex<Type>>(num);
+        testArithmeticKernel<ArithmeticMul, std::complex<Type>>(num);
+        testArithmeticKernel<ArithmeticDiv, std::complex<Type>>(num);
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_arithmetic_kernels)
+{
+    testArithmeticKernels<double>();
+    testArithmeticKernels<float>();
+    testArithmeticKernels<int64_t>();
+    testArithmeticKernels<int32_t>();
+    testArithmeticKernels<int16_t>();
+    testArithmeticKernels<int8_t>();
+}
+
+//the operators as they were applied before the fused kernels
+template <typename Op, typename Type> struct StdArithmetic;
+template <typename Type> struct StdArithmetic<ArithmeticAdd, Type> : std::plus<Type> {};
+template <typename Type> struct StdArithmetic<ArithmeticMul, Type> : std::multiplies<Type> {};
+
+template <typename Op, typename Type>
+static void benchArithmeticKernel(Poco::JSON::Object::Ptr metrics, const std::string &name)
+{
+    const size_t numIns = 4, num = 1 << 16, iters = 200;
+    std::vector<std::vector<Type>> inputs(numIns, std::vector<Type>(num, Type(1)));
+    std::vector<const Type *> ins;
+    for (const auto &input : inputs) ins.push_back(input.data());
+    std::vector<Type> out(num);
+
+    //one pass over the output per input with the std operators
+    const StdArithmetic<Op, Type> op;
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t n = 0; n < iters; n++)
+    {
+        const Type *in0 = ins[0];
+        for (size_t i = 1; i < numIns; i++)
+        {
+            for (size_t k = 0; k < num; k++) out[k] = op(in0[k], ins[i][k]);
+            in0 = out.data();
+        }
+    }
+    const auto t1 = std::chrono::high_resolution_clock::now();
+
+    //the fused kernel for the host CPU
+    const auto kernel = getArithmeticKernel<Op, Type>();
+    for (size_t n = 0; n < iters; n++) kernel(out.data(), ins.data(), numIns, nullptr, num);
+    const auto t2 = std::chrono::high_resolution_clock::now();
+
+    const double perPass = std::chrono::duration<double>(t1 - t0).count();
+    const double fused = std::chrono::duration<double>(t2 - t1).count();
+    metrics->set(name + "PerPassElemsPerSec", num*iters/perPass);
+    metrics->set(name + "FusedElemsPerSec", num*iters/fused);
+}
+
+/***********************************************************************
+ * Fused arithmetic kernels versus one pass per input with 4 inputs,
+ * run with PothosUtil --bench=blocks/arithmetic_throughput
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchArithmeticThroughput(void)
+{
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    benchArithmeticKernel<ArithmeticAdd, float>(metrics, "float32Add");
+    benchArithmeticKernel<ArithmeticMul, int16_t>(metrics, "int16Mul");
+    benchArithmeticKernel<ArithmeticAdd, std::complex<float>>(metrics, "complexFloat32Add");
+    benchArithmeticKernel<ArithmeticMul, std::complex<float>>(metrics, "complexFloat32Mul");
+    benchArithmeticKernel<ArithmeticMul, std::complex<double>>(metrics, "complexFloat64Mul");
+    return metrics;
+}
+
+pothos_static_block(pothosBlocksRegisterBenchArithmetic)
+{
+    Pothos::PluginRegistry::add("/bench/blocks/arithmetic_throughput", Pothos::Callable(&benchArithmeticThroughput));
+}
@@ -0,0 +1,573 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "DatagramTransport.hpp"
+#include "SocketEndpoint.hpp"
+#include <Pothos/Exception.hpp>
+#include <Poco/Foundation.h>
+#include <Poco/Format.h>
+#include <Poco/ByteOrder.h>
+#include <Poco/Net/SocketDefs.h>
+#include <Poco/Net/NetException.h>
+#include <algorithm> //min/max
+#include <cstring> //memcpy
+
+#ifdef POCO_OS_FAMILY_UNIX
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/***********************************************************************
+ * Datagram header format:
+ * The sequence number counts data datagrams only. A parity datagram
+ * carries the sequence number of the first datagram in its group,
+ * and its payload is the XOR of the group's frame info and payloads.
+ * A frame larger than one datagram is sent as fragments in consecutive
+ * datagrams: every fragment carries the index of the frame, the more flag
+ * marks all but the last fragment, and the continue flag all but the first.
+ **********************************************************************/
+static const uint32_t PothosDatagramHeaderWord = (uint32_t('P') << 24) | (uint32_t('T') << 16) | (uint32_t('H') << 8) | uint32_t('D');
+
+#define PothosDatagramFlagParity (1 << 0)
+#define PothosDatagramFlagMore (1 << 1)
+#define PothosDatagramFlagContinue (1 << 2)
+
+struct PothosDatagramHeader
+{
+    uint32_t headerWord;
+    uint8_t flags;
+    uint8_t type;
+    uint8_t groupSize;
+    uint8_t reserved;
+    uint32_t sequence;
+    uint32_t payloadBytes;
+    uint32_t indexWord[2];
+};
+
+//! The header fields of a data datagram that parity recovers
+struct PothosDatagramParityInfo
+{
+    uint8_t type;
+    uint8_t flags;
+    uint8_t reserved[2];
+    uint32_t payloadBytes;
+    uint32_t indexWord[2];
+};
+
+static const size_t PothosDatagramDefaultBytes = 1472; //ethernet MTU less IPv4 and UDP headers
+static const size_t PothosDatagramMaxBytes = 65507;
+static const size_t PothosDatagramMaxGroupSize = 255;
+
+PothosDatagramOptions::PothosDatagramOptions(void):
+    datagramBytes(PothosDatagramDefaultBytes),
+    fecGroupSize(0),
+    sendBufferBytes(0),
+    recvBufferBytes(0),
+    multicastTTL(1),
+    multicastInterface()
+{
+    return;
+}
+
+/***********************************************************************
+ * Socket setup
+ **********************************************************************/
+static PothosDatagramOptions checkOptions(PothosDatagramOptions options)
+{
+    //the smallest datagram fits the headers and some payload
+    const size_t minBytes = sizeof(PothosDatagramHeader) + sizeof(PothosDatagramParityInfo) + 64;
+    options.datagramBytes = std::min(std::max(options.datagramBytes, minBytes), PothosDatagramMaxBytes);
+    if (options.fecGroupSize > PothosDatagramMaxGroupSize) throw Pothos::InvalidArgumentException(
+        "PothosDatagramTransport()", Poco::format("FEC group size %z exceeds %z", options.fecGroupSize, PothosDatagramMaxGroupSize));
+    return options;
+}
+
+PothosDatagramTransport::PothosDatagramTransport(const Poco::Net::SocketAddress &addr, const bool bind, const PothosDatagramOptions &options):
+    _sock(addr.family()),
+    _options(checkOptions(options)),
+    _sendScratch(_options.datagramBytes),
+    _recvScratch(_options.datagramBytes),
+    _sendParity(this->getRecvPayloadBytes()),
+    _recvParity(this->getRecvPayloadBytes())
+{
+    if (_options.sendBufferBytes > 0) _sock.setSendBufferSize(_options.sendBufferBytes);
+    if (_options.recvBufferBytes > 0) _sock.setReceiveBufferSize(_options.recvBufferBytes);
+
+    const bool multicast = addr.host().isMulticast();
+    if (multicast and addr.family() != Poco::Net::IPAddress::IPv4)
+    {
+        throw Pothos::InvalidArgumentException("PothosDatagramTransport("+addr.toString()+")", "multicast requires an IPv4 group");
+    }
+
+    in_addr iface;
+    iface.s_addr = htonl(INADDR_ANY);
+    if (not _options.multicastInterface.empty())
+    {
+        const Poco::Net::IPAddress ifaceAddr(_options.multicastInterface);
+        std::memcpy(&iface, ifaceAddr.addr(), sizeof(iface));
+    }
+
+    if (bind)
+    {
+        //multicast receivers bind the wildcard address and share the port
+        if (multicast) _sock.bind(Poco::Net::SocketAddress(Poco::Net::IPAddress(addr.family()), addr.port()), true);
+        else _sock.bind(addr, true);
+
+        if (multicast)
+        {
+            ip_mreq mreq;
+            std::memcpy(&mreq.imr_multiaddr, addr.host().addr(), sizeof(mreq.imr_multiaddr));
+            mreq.imr_interface = iface;
+            _sock.impl()->setRawOption(IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+        }
+    }
+    else
+    {
+        if (multicast)
+        {
+            //loopback delivers to receivers on this host as well
+            const unsigned char ttl = static_cast<unsigned char>(_options.multicastTTL);
+            const unsigned char loop = 1;
+            _sock.impl()->setRawOption(IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+            _sock.impl()->setRawOption(IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+            if (not _options.multicastInterface.empty())
+            {
+                _sock.impl()->setRawOption(IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface));
+            }
+        }
+        _sock.connect(addr);
+    }
+
+    this->reset();
+}
+
+std::string PothosDatagramTransport::getPort(void) const
+{
+    return std::to_string(_sock.address().port());
+}
+
+void PothosDatagramTransport::reset(void)
+{
+    _sendSequence = 0;
+    _sendGroupCount = 0;
+    _sendParityBytes = 0;
+    std::fill(_sendParity.begin(), _sendParity.end(), 0);
+
+    _synced = false;
+    _nextSequence = 0;
+    _groupStart = 0;
+    _groupSize = 0;
+    _groupCount = 0;
+    std::fill(_recvParity.begin(), _recvParity.end(), 0);
+    _holding = false;
+    _holdSequence = 0;
+    _held.clear();
+    _ready.clear();
+    _fragmenting = false;
+    _skipping = false;
+    _fragmentType = 0;
+    _fragmentIndex = 0;
+    _fragmentSequence = 0;
+    _fragmentData.clear();
+
+    _datagramsSent = 0;
+    _datagramsRecv = 0;
+    _datagramsLost = 0;
+    _datagramsRecovered = 0;
+    _framesDropped = 0;
+}
+
+size_t PothosDatagramTransport::getMaxPayloadBytes(void) const
+{
+    //with forward error correction, the parity datagram carries
+    //the parity info ahead of the largest payload in its group
+    const size_t parityBytes = (_options.fecGroupSize == 0)?0:sizeof(PothosDatagramParityInfo);
+    return this->getRecvPayloadBytes() - parityBytes;
+}
+
+size_t PothosDatagramTransport::getRecvPayloadBytes(void) const
+{
+    //the receiver does not know the sender's options, accept any datagram up to the size
+    return _options.datagramBytes - sizeof(PothosDatagramHeader);
+}
+
+unsigned long long PothosDatagramTransport::getDatagramsSent(void) const
+{
+    return _datagramsSent.load();
+}
+
+unsigned long long PothosDatagramTransport::getDatagramsReceived(void) const
+{
+    return _datagramsRecv.load();
+}
+
+unsigned long long PothosDatagramTransport::getDatagramsLost(void) const
+{
+    return _datagramsLost.load();
+}
+
+unsigned long long PothosDatagramTransport::getDatagramsRecovered(void) const
+{
+    return _datagramsRecovered.load();
+}
+
+unsigned long long PothosDatagramTransport::getFramesDropped(void) const
+{
+    return _framesDropped.load();
+}
+
+/***********************************************************************
+ * Parity accumulation
+ **********************************************************************/
+static void xorBytes(char *accum, const char *in, const size_t numBytes)
+{
+    for (size_t i = 0; i < numBytes; i++) accum[i] ^= in[i];
+}
+
+void PothosDatagramTransport::accumulate(std::vector<char> &accum, const void *header, const void *payload, const size_t payloadBytes)
+{
+    const auto &h = *reinterpret_cast<const PothosDatagramHeader *>(header);
+    PothosDatagramParityInfo info;
+    std::memset(&info, 0, sizeof(info));
+    info.type = h.type;
+    info.flags = h.flags;
+    info.payloadBytes = h.payloadBytes;
+    info.indexWord[0] = h.indexWord[0];
+    info.indexWord[1] = h.indexWord[1];
+    xorBytes(accum.data(), reinterpret_cast<const char *>(&info), sizeof(info));
+    xorBytes(accum.data() + sizeof(info), reinterpret_cast<const char *>(payload), payloadBytes);
+}
+
+/***********************************************************************
+ * Send a frame as one or more datagrams
+ **********************************************************************/
+void PothosDatagramTransport::send(const uint16_t type, const uint64_t index, const void *buff, const size_t numBytes)
+{
+    const size_t maxDataBytes = this->getMaxPayloadBytes();
+    const bool stream = type == PothosPacketTypeBuffer;
+    const size_t groupSize = _options.fecGroupSize;
+    size_t offset = 0;
+    do
+    {
+        const size_t frameBytes = std::min(numBytes-offset, maxDataBytes);
+        const uint64_t frameIndex = stream?(index + offset):index;
+        const char *payload = reinterpret_cast<const char *>(buff) + offset;
+
+        //stream buffers split anywhere, other frames are reassembled from fragments
+        uint8_t flags = 0;
+        if (not stream and offset != 0) flags |= PothosDatagramFlagContinue;
+        if (not stream and offset + frameBytes != numBytes) flags |= PothosDatagramFlagMore;
+
+        PothosDatagramHeader header;
+        header.headerWord = Poco::ByteOrder::toNetwork(PothosDatagramHeaderWord);
+        header.flags = flags;
+        header.type = uint8_t(type);
+        header.groupSize = uint8_t(groupSize);
+        header.reserved = 0;
+        header.sequence = Poco::ByteOrder::toNetwork(_sendSequence++);
+        header.payloadBytes = Poco::ByteOrder::toNetwork(uint32_t(frameBytes));
+        header.indexWord[0] = Poco::ByteOrder::toNetwork(uint32_t(frameIndex >> 32));
+        header.indexWord[1] = Poco::ByteOrder::toNetwork(uint32_t(frameIndex >> 0));
+        this->sendDatagram(&header, payload, frameBytes);
+        offset += frameBytes;
+
+        if (groupSize == 0) continue;
+        this->accumulate(_sendParity, &header, payload, frameBytes);
+        _sendParityBytes = std::max(_sendParityBytes, sizeof(PothosDatagramParityInfo) + frameBytes);
+        if (++_sendGroupCount != groupSize) continue;
+
+        //the group is complete, follow it with the parity datagram
+        PothosDatagramHeader parity;
+        parity.headerWord = header.headerWord;
+        parity.flags = PothosDatagramFlagParity;
+        parity.type = 0;
+        parity.groupSize = uint8_t(groupSize);
+        parity.reserved = 0;
+        parity.sequence = Poco::ByteOrder::toNetwork(uint32_t(_sendSequence - groupSize));
+        parity.payloadBytes = Poco::ByteOrder::toNetwork(uint32_t(_sendParityBytes));
+        parity.indexWord[0] = 0;
+        parity.indexWord[1] = 0;
+        this->sendDatagram(&parity, _sendParity.data(), _sendParityBytes);
+        std::fill(_sendParity.begin(), _sendParity.begin() + _sendParityBytes, 0);
+        _sendParityBytes = 0;
+        _sendGroupCount = 0;
+    } while (offset < numBytes);
+}
+
+void PothosDatagramTransport::sendDatagram(const void *header, const void *payload, const size_t payloadBytes)
+{
+    #ifdef POCO_OS_FAMILY_UNIX
+    iovec iov[2];
+    iov[0].iov_base = const_cast<void *>(header);
+    iov[0].iov_len = sizeof(PothosDatagramHeader);
+    iov[1].iov_base = const_cast<void *>(payload);
+    iov[1].iov_len = payloadBytes;
+
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = (payloadBytes == 0)?1:2;
+
+    ssize_t ret = 0;
+    do ret = ::sendmsg(_sock.impl()->sockfd(), &msg, MSG_NOSIGNAL);
+    while (ret < 0 and errno == EINTR);
+
+    //a unicast receiver that is not listening yet is a dropped datagram
+    if (ret < 0 and errno == ECONNREFUSED) return;
+    if (ret < 0) throw Pothos::RuntimeException("PothosDatagramTransport::send()", std::strerror(errno));
+    #else
+    std::memcpy(_sendScratch.data(), header, sizeof(PothosDatagramHeader));
+    std::memcpy(_sendScratch.data() + sizeof(PothosDatagramHeader), payload, payloadBytes);
+    try
+    {
+        _sock.sendBytes(_sendScratch.data(), int(sizeof(PothosDatagramHeader) + payloadBytes));
+    }
+    catch (const Poco::Net::ConnectionRefusedException &)
+    {
+        return;
+    }
+    #endif
+    _datagramsSent++;
+}
+
+/***********************************************************************
+ * Receive a datagram and deliver frames in sequence order
+ **********************************************************************/
+void PothosDatagramTransport::recv(uint16_t &type, uint64_t &index, Pothos::BufferChunk &buffer,
+    const std::chrono::high_resolution_clock::duration &timeout, const Allocator &allocator)
+{
+    type = 0;
+    index = 0;
+
+    //receive until a frame is ready, datagrams may be held back for recovery
+    const auto exitTime = std::chrono::high_resolution_clock::now() + timeout;
+    while (true)
+    {
+        while (_ready.empty())
+        {
+            const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(exitTime - std::chrono::high_resolution_clock::now()).count();
+            if (micros < 0) return;
+            if (not _sock.poll(Poco::Timespan(Poco::Timespan::TimeDiff(micros)), Poco::Net::Socket::SELECT_READ)) return;
+            this->recvDatagram(buffer, allocator);
+        }
+
+        auto frame = _ready.front();
+        _ready.pop_front();
+        if (not this->reassemble(frame, allocator)) continue;
+        type = frame.type;
+        index = frame.index;
+        buffer = frame.payload;
+        return;
+    }
+}
+
+bool PothosDatagramTransport::reassemble(Frame &frame, const Allocator &allocator)
+{
+    const bool first = (frame.flags & PothosDatagramFlagContinue) == 0;
+    const bool last = (frame.flags & PothosDatagramFlagMore) == 0;
+    const bool sameFrame = frame.type == _fragmentType and frame.index == _fragmentIndex;
+
+    //a fragment continues the partial frame only when nothing was lost in between
+    const bool follows = _fragmenting and not first and sameFrame and frame.sequence == _fragmentSequence + 1;
+    if (_fragmenting and not follows)
+    {
+        _fragmenting = false;
+        _skipping = true;
+        _framesDropped++;
+    }
+
+    //the rest of a frame that lost a fragment is skipped, each frame is counted once
+    if (not first and not follows)
+    {
+        if (not (_skipping and sameFrame)) _framesDropped++;
+        _skipping = not last;
+        _fragmentType = frame.type;
+        _fragmentIndex = frame.index;
+        return false;
+    }
+    _skipping = false;
+
+    //the common case is a whole frame in one datagram
+    if (first and last) return true;
+
+    //the fragments are copied out, the payload may be the caller's buffer
+    if (first)
+    {
+        _fragmenting = true;
+        _fragmentType = frame.type;
+        _fragmentIndex = frame.index;
+        _fragmentData.clear();
+    }
+    _fragmentSequence = frame.sequence;
+    const char *payload = frame.payload.as<const char *>();
+    _fragmentData.insert(_fragmentData.end(), payload, payload + frame.payload.length);
+    if (not last) return false;
+
+    _fragmenting = false;
+    frame.payload = allocator(_fragmentData.size());
+    frame.payload.length = _fragmentData.size();
+    std::memcpy(frame.payload.as<void *>(), _fragmentData.data(), _fragmentData.size());
+    return true;
+}
+
+void PothosDatagramTransport::recvDatagram(const Pothos::BufferChunk &buffer, const Allocator &allocator)
+{
+    //receive directly into the caller's buffer when the largest payload fits
+    const size_t maxPayloadBytes = this->getRecvPayloadBytes();
+    Pothos::BufferChunk payload = (buffer.length >= maxPayloadBytes)?buffer:allocator(maxPayloadBytes);
+
+    PothosDatagramHeader header;
+    bool truncated = false;
+    size_t recvBytes = 0;
+
+    #ifdef POCO_OS_FAMILY_UNIX
+    iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = payload.as<void *>();
+    iov[1].iov_len = maxPayloadBytes;
+
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    ssize_t ret = 0;
+    do ret = ::recvmsg(_sock.impl()->sockfd(), &msg, 0);
+    while (ret < 0 and errno == EINTR);
+    if (ret < 0) throw Pothos::RuntimeException("PothosDatagramTransport::recv()", std::strerror(errno));
+    truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+    recvBytes = size_t(ret);
+    #else
+    const int ret = _sock.receiveBytes(_recvScratch.data(), int(_recvScratch.size()));
+    recvBytes = size_t(ret);
+    if (recvBytes >= sizeof(header))
+    {
+        std::memcpy(&header, _recvScratch.data(), sizeof(header));
+        std::memcpy(payload.as<void *>(), _recvScratch.data() + sizeof(header), recvBytes - sizeof(header));
+    }
+    #endif
+
+    //ignore datagrams from other protocols or larger than configured
+    if (truncated or recvBytes < sizeof(header)) return;
+    if (Poco::ByteOrder::fromNetwork(header.headerWord) != PothosDatagramHeaderWord) return;
+    const size_t payloadBytes = Poco::ByteOrder::fromNetwork(header.payloadBytes);
+    if (payloadBytes + sizeof(header) != recvBytes) return;
+    _datagramsRecv++;
+
+    const uint32_t sequence = Poco::ByteOrder::fromNetwork(header.sequence);
+    const size_t groupSize = header.groupSize;
+    if ((header.flags & PothosDatagramFlagParity) != 0)
+    {
+        return this->handleParity(sequence, groupSize, payload.as<const char *>(), payloadBytes);
+    }
+
+    //late and duplicate datagrams are dropped
+    if (not _synced) _nextSequence = sequence;
+    _synced = true;
+    const int32_t distance = int32_t(sequence - _nextSequence);
+    if (distance < 0) return;
+
+    //a new group: the loss held for recovery in the last group is final
+    const uint32_t groupStart = (groupSize == 0)?sequence:(sequence - sequence % groupSize);
+    if (groupSize != _groupSize or groupStart != _groupStart)
+    {
+        this->flushHeld();
+        _groupStart = groupStart;
+        _groupSize = groupSize;
+        _groupCount = 0;
+        if (groupSize != 0) std::fill(_recvParity.begin(), _recvParity.end(), 0);
+    }
+
+    //a single gap within the group may be recovered from the parity
+    if (distance > 0)
+    {
+        const bool sameGroup = groupSize != 0 and uint32_t(_nextSequence - groupStart) < groupSize;
+        if (distance == 1 and sameGroup and not _holding)
+        {
+            _holding = true;
+            _holdSequence = _nextSequence;
+        }
+        else
+        {
+            this->flushHeld();
+            _datagramsLost += distance;
+        }
+    }
+    _nextSequence = sequence + 1;
+
+    if (groupSize != 0)
+    {
+        this->accumulate(_recvParity, &header, payload.as<const void *>(), payloadBytes);
+        _groupCount++;
+    }
+
+    Frame frame;
+    frame.type = header.type;
+    frame.flags = header.flags;
+    frame.sequence = sequence;
+    frame.index = (uint64_t(Poco::ByteOrder::fromNetwork(header.indexWord[0])) << 32) |
+        (uint64_t(Poco::ByteOrder::fromNetwork(header.indexWord[1])) << 0);
+    frame.payload = payload;
+    frame.payload.length = payloadBytes;
+
+    //the common case is delivered in place, queued frames must own their memory
+    if (not _holding and _ready.empty()) return _ready.push_back(frame);
+    frame.payload = Pothos::BufferChunk(payloadBytes);
+    std::memcpy(frame.payload.as<void *>(), payload.as<const void *>(), payloadBytes);
+    if (_holding) _held.push_back(frame);
+    else _ready.push_back(frame);
+}
+
+void PothosDatagramTransport::handleParity(const uint32_t sequence, const size_t groupSize, const char *parity, const size_t parityBytes)
+{
+    //recovery is possible when exactly one datagram of this group is missing
+    if (groupSize == 0 or groupSize != _groupSize or sequence != _groupStart) return;
+    if (_groupCount == 0 or _groupCount + 1 != groupSize) return;
+    if (parityBytes < sizeof(PothosDatagramParityInfo) or parityBytes > _recvParity.size()) return;
+
+    //the missing datagram is either held for or it is the tail of the group
+    const bool tail = not _holding and _nextSequence == _groupStart + uint32_t(groupSize) - 1;
+    if (not _holding and not tail) return;
+
+    xorBytes(_recvParity.data(), parity, parityBytes);
+    PothosDatagramParityInfo info;
+    std::memcpy(&info, _recvParity.data(), sizeof(info));
+    const size_t payloadBytes = Poco::ByteOrder::fromNetwork(info.payloadBytes);
+    if (payloadBytes + sizeof(info) > parityBytes) return;
+
+    Frame frame;
+    frame.type = info.type;
+    frame.flags = info.flags;
+    frame.sequence = tail?_nextSequence:_holdSequence;
+    frame.index = (uint64_t(Poco::ByteOrder::fromNetwork(info.indexWord[0])) << 32) |
+        (uint64_t(Poco::ByteOrder::fromNetwork(info.indexWord[1])) << 0);
+    frame.payload = Pothos::BufferChunk(payloadBytes);
+    std::memcpy(frame.payload.as<void *>(), _recvParity.data() + sizeof(info), payloadBytes);
+    _ready.push_back(frame);
+    _datagramsRecovered++;
+    _groupCount++;
+
+    if (tail) _nextSequence++;
+    else
+    {
+        _ready.insert(_ready.end(), _held.begin(), _held.end());
+        _held.clear();
+        _holding = false;
+    }
+}
+
+void PothosDatagramTransport::flushHeld(void)
+{
+    if (not _holding) return;
+    _datagramsLost++;
+    _ready.insert(_ready.end(), _held.begin(), _held.end());
+    _held.clear();
+    _holding = false;
+}
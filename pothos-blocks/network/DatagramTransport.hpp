@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+//
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <Poco/Net/DatagramSocket.h>
+#include <Poco/Net/SocketAddress.h>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <cstdint>
+
+/*!
+ * Configuration for the datagram transport from the URI query.
+ */
+struct PothosDatagramOptions
+{
+    PothosDatagramOptions(void);
+
+    //! the size of each datagram including the datagram header
+    size_t datagramBytes;
+
+    //! send one parity datagram every fecGroupSize data datagrams, 0 disables
+    size_t fecGroupSize;
+
+    //! socket send and receive buffer sizes in bytes, 0 keeps the system default
+    int sendBufferBytes;
+    int recvBufferBytes;
+
+    //! multicast time to live and outgoing/joining interface address
+    int multicastTTL;
+    std::string multicastInterface;
+};
+
+/*!
+ * The datagram transport carries the network blocks' frames over UDP.
+ * There is no handshake and no flow control: a sending endpoint
+ * connects to a unicast or multicast address, and any number of
+ * receiving endpoints bind the port (and join the multicast group).
+ *
+ * Every datagram carries a sequence number. The receiver counts
+ * the missing sequence numbers as lost datagrams, and it repairs
+ * a single loss per group when forward error correction is enabled:
+ * the sender follows each group with the XOR of the group's datagrams.
+ * Frames larger than a datagram are sent as fragments, and the receiver
+ * drops a frame when one of its fragments is lost and not recovered.
+ */
+class PothosDatagramTransport
+{
+public:
+
+    //! Allocate a receive buffer of at least the given size
+    typedef std::function<Pothos::BufferChunk(const size_t)> Allocator;
+
+    /*!
+     * Create the datagram socket.
+     * \param addr the unicast or multicast address
+     * \param bind true to bind the port and receive, false to connect and send
+     * \param options the transport options from the URI query
+     */
+    PothosDatagramTransport(const Poco::Net::SocketAddress &addr, const bool bind, const PothosDatagramOptions &options);
+
+    //! Get the bound or connected port number
+    std::string getPort(void) const;
+
+    //! Restart the sequence numbers and clear the receive state
+    void reset(void);
+
+    /*!
+     * The largest payload that fits in one datagram.
+     * Data datagrams use the full datagram size without forward error correction,
+     * otherwise the parity info of the group's parity datagram is reserved.
+     */
+    size_t getMaxPayloadBytes(void) const;
+
+    /*!
+     * Send a frame. Stream buffers are split across datagrams,
+     * the index of each datagram advances by the bytes before it.
+     * Other frames are split into fragments that keep the frame index.
+     */
+    void send(const uint16_t type, const uint64_t index, const void *buff, const size_t numBytes);
+
+    /*!
+     * Receive a frame. The payload is received into the buffer
+     * when it fits, otherwise into a buffer from the allocator.
+     * The type is zero when there was nothing to receive.
+     */
+    void recv(uint16_t &type, uint64_t &index, Pothos::BufferChunk &buffer,
+        const std::chrono::high_resolution_clock::duration &timeout, const Allocator &allocator);
+
+    //! Datagram counters for the flow statistics
+    unsigned long long getDatagramsSent(void) const;
+    unsigned long long getDatagramsReceived(void) const;
+    unsigned long long getDatagramsLost(void) const;
+    unsigned long long getDatagramsRecovered(void) const;
+    unsigned long long getFramesDropped(void) const;
+
+private:
+    struct Frame
+    {
+        uint16_t type;
+        uint8_t flags;
+        uint32_t sequence;
+        uint64_t index;
+        Pothos::BufferChunk payload;
+    };
+
+    size_t getRecvPayloadBytes(void) const;
+    bool reassemble(Frame &frame, const Allocator &allocator);
+    void sendDatagram(const void *header, const void *payload, const size_t payloadBytes);
+    void accumulate(std::vector<char> &accum, const void *header, const void *payload, const size_t payloadBytes);
+    void recvDatagram(const Pothos::BufferChunk &buffer, const Allocator &allocator);
+    void handleParity(const uint32_t sequence, const size_t groupSize, const char *parity, const size_t parityBytes);
+    void flushHeld(void);
+
+    Poco::Net::DatagramSocket _sock;
+    const PothosDatagramOptions _options;
+    std::vector<char> _sendScratch;
+    std::vector<char> _recvScratch;
+
+    //sender state
+    uint32_t _sendSequence;
+    size_t _sendGroupCount;
+    std::vector<char> _sendParity;
+    size_t _sendParityBytes;
+
+    //receiver state
+    bool _synced;
+    uint32_t _nextSequence;
+    uint32_t _groupStart;
+    size_t _groupSize;
+    size_t _groupCount;
+    std::vector<char> _recvParity;
+    bool _holding;
+    uint32_t _holdSequence;
+    std::deque<Frame> _held;
+    std::deque<Frame> _ready;
+
+    //reassembly of the fragmented frame
+    bool _fragmenting;
+    bool _skipping;
+    uint16_t _fragmentType;
+    uint64_t _fragmentIndex;
+    uint32_t _fragmentSequence;
+    std::vector<char> _fragmentData;
+
+    std::atomic<unsigned long long> _datagramsSent;
+    std::atomic<unsigned long long> _datagramsRecv;
+    std::atomic<unsigned long long> _datagramsLost;
+    std::atomic<unsigned long long> _datagramsRecovered;
+    std::atomic<unsigned long long> _framesDropped;
+};
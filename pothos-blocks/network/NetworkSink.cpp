@@ -2,11 +2,13 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "SocketEndpoint.hpp"
+#include "PacketBatch.hpp"
 #include <Pothos/Framework.hpp>
 #include <thread>
 #include <sstream>
 #include <string>
 #include <chrono>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -16,9 +18,40 @@
  * The network sink accepts data on its input port and serializes it over a socket.
  * All input port data is serialized, which includes stream buffers, inline labels, and async messages.
  *
- * The underlying supports two transport options:
- * TCP - tcp://host:port
- * or UDT - udt://host:port
+ * The underlying supports three transport options:
+ * TCP - tcp://host:port,
+ * UDT - udt://host:port,
+ * or UDP - udp://host:port
+ *
+ * Transport options can be appended to the URI as query parameters:
+ * "version=1" uses the legacy header that limits frames to 64 KiB,
+ * "frame=bytes" sets the largest frame size offered to the remote,
+ * and "window=bytes" sets the upper bound of the flow control window.
+ * Example: tcp://host:port?frame=1048576&window=8388608
+ *
+ * The flow control window adapts to the measured round trip time
+ * and the rate that the receiving end consumes the stream.
+ * The getFlowStats() call and probe report the live window,
+ * acknowledgment interval and rate, round trip time, and stall time.
+ *
+ * The UDP transport sends datagrams without a handshake or flow control,
+ * so that one network sink can feed many network sources at once:
+ * the sink connects to a multicast group, each source binds the group's port.
+ * Example: udp://239.255.0.1:1234?iface=192.168.10.1&fec=8&rcvbuf=4194304
+ * The UDP options are "mtu=bytes" for the datagram size (default 1472),
+ * "fec=N" to follow every N datagrams with a parity datagram
+ * that repairs a single loss in the group without retransmission,
+ * "sndbuf=bytes" and "rcvbuf=bytes" for the socket buffer sizes,
+ * "iface=address" for the multicast interface, and "ttl=hops".
+ * Packet payloads and messages larger than a datagram are sent as fragments;
+ * a message or packet loses all of its fragments when one of them is lost.
+ *
+ * Labels are coalesced into one frame in a compact binary encoding,
+ * sent immediately ahead of the buffer frame that they annotate.
+ * Messages are coalesced into batch frames: the messages available
+ * to one call of work() share a frame, and the message latency
+ * holds a batch open for later messages up to the given time.
+ * A message larger than one frame is split across several batch frames.
  *
  * |category /Network
  * |category /Sinks
@@ -34,7 +67,14 @@
  * |option [Bind] "BIND"
  * |default "DISCONNECT"
  *
+ * |param messageLatency[Message Latency] The longest time that a message waits to be batched.
+ * Zero sends the messages from each call to work without waiting for more.
+ * |units seconds
+ * |default 0.0
+ * |preview valid
+ *
  * |factory /blocks/network_sink(uri, opt)
+ * |setter setMessageLatency(messageLatency)
  **********************************************************************/
 class NetworkSink : public Pothos::Block
 {
@@ -46,11 +86,18 @@ public:
 
     NetworkSink(const std::string &uri, const std::string &opt):
         _ep(PothosPacketSocketEndpoint(uri, opt)),
-        running(false)
+        running(false),
+        _messageLatency(0.0)
     {
         //std::cout << "NetworkSink " << opt << " " << uri << std::endl;
         this->setupInput(0);
+        this->input(0)->setScatterGather(true);
+        this->setActivateWaitsOnPeer(true); //open and close handshake with the source
         this->registerCall(this, POTHOS_FCN_TUPLE(NetworkSink, getActualPort));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NetworkSink, getFlowStats));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NetworkSink, setMessageLatency));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NetworkSink, getMessageLatency));
+        this->registerProbe("getFlowStats");
     }
 
     ~NetworkSink(void)
@@ -68,6 +115,21 @@ public:
         return _ep.getActualPort();
     }
 
+    Poco::JSON::Object::Ptr getFlowStats(void)
+    {
+        return _ep.getFlowStats();
+    }
+
+    void setMessageLatency(const double seconds)
+    {
+        _messageLatency = seconds;
+    }
+
+    double getMessageLatency(void) const
+    {
+        return _messageLatency;
+    }
+
     void activate(void)
     {
         _ep.openComms();
@@ -80,6 +142,8 @@ public:
 
     void deactivate(void)
     {
+        this->flushMessages();
+
         //stop the endpoint handler thread
         assert(handlerThread.joinable());
         running = false;
@@ -103,6 +167,25 @@ public:
 
     void work(void);
 
+    void flushMessages(void)
+    {
+        if (_messageBatch.empty()) return;
+        _ep.send(PothosPacketTypeMessages, 0, _messageBatch.data(), _messageBatch.size());
+        _messageBatch.clear();
+    }
+
+    //a record larger than one frame is split across batch frames,
+    //the index of each frame is the number of record bytes that follow it
+    void sendMessageParts(const std::string &record, const size_t maxFrameBytes)
+    {
+        for (size_t offset = 0; offset < record.size();)
+        {
+            const size_t numBytes = std::min(record.size()-offset, maxFrameBytes);
+            _ep.send(PothosPacketTypeMessages, record.size()-offset-numBytes, record.data()+offset, numBytes);
+            offset += numBytes;
+        }
+    }
+
     void updateDType(const Pothos::DType &dtype)
     {
         if (_lastDtype == dtype) return;
@@ -117,6 +200,9 @@ private:
     std::thread handlerThread;
     bool running;
     Pothos::DType _lastDtype;
+    double _messageLatency;
+    std::string _messageBatch;
+    std::chrono::high_resolution_clock::time_point _messageBatchTime;
 };
 
 void NetworkSink::work(void)
@@ -128,6 +214,8 @@ void NetworkSink::work(void)
     }
 
     auto inputPort = this->input(0);
+    const bool batching = _ep.getVersion() >= 3;
+    const size_t maxFrameBytes = _ep.getMaxFrameBytes();
 
     //serialize messages
     while (inputPort->hasMessage())
@@ -137,6 +225,9 @@ void NetworkSink::work(void)
         //special efficient packing for buffers in the packet
         if (msg.type() == typeid(Pothos::Packet))
         {
+            //batched messages go first to keep the order
+            this->flushMessages();
+
             //extract packet and clear its payload (just send header)
             auto packet = msg.extract<Pothos::Packet>();
             const auto buffer = packet.payload;
@@ -153,6 +244,20 @@ void NetworkSink::work(void)
             _ep.send(PothosPacketTypePayload, 0, buffer.as<const void *>(), buffer.length);
         }
 
+        //coalesce into the message batch, a full batch is sent first
+        else if (batching)
+        {
+            std::string record;
+            PothosPacketAppendMessage(record, msg);
+            if (_messageBatch.size() + record.size() > maxFrameBytes) this->flushMessages();
+            if (record.size() > maxFrameBytes) this->sendMessageParts(record, maxFrameBytes);
+            else
+            {
+                if (_messageBatch.empty()) _messageBatchTime = std::chrono::high_resolution_clock::now();
+                _messageBatch += record;
+            }
+        }
+
         //arbitrary serialization
         else
         {
@@ -162,29 +267,74 @@ void NetworkSink::work(void)
         }
     }
 
+    //coalesce labels into frames ahead of the buffer frame that they annotate,
+    //the label index is relative to the index of the frame (all labels go before buffers)
+    if (batching)
+    {
+        const bool buffersFollow = inputPort->elements() != 0;
+        std::string labelBatch;
+        for (const auto &label : inputPort->labels())
+        {
+            std::string record;
+            PothosPacketAppendLabel(record, label);
+            if (labelBatch.size() + record.size() > maxFrameBytes)
+            {
+                _ep.send(PothosPacketTypeLabels, inputPort->totalElements(), labelBatch.data(), labelBatch.size(), true);
+                labelBatch.clear();
+            }
+            labelBatch += record;
+        }
+        if (not labelBatch.empty())
+        {
+            _ep.send(PothosPacketTypeLabels, inputPort->totalElements(), labelBatch.data(), labelBatch.size(), buffersFollow);
+        }
+    }
+
     //serialize labels (all labels are sent before buffers to ensure ordering at the destination)
     while (inputPort->labels().begin() != inputPort->labels().end())
     {
         const auto &label = *inputPort->labels().begin();
-        std::ostringstream oss;
-        Pothos::Object(label).serialize(oss);
-        auto index = label.index + inputPort->totalElements();
-        _ep.send(PothosPacketTypeLabel, index, oss.str().data(), oss.str().length());
+        if (not batching)
+        {
+            std::ostringstream oss;
+            Pothos::Object(label).serialize(oss);
+            auto index = label.index + inputPort->totalElements();
+            _ep.send(PothosPacketTypeLabel, index, oss.str().data(), oss.str().length());
+        }
         inputPort->removeLabel(label);
     }
 
-    //available buffer?
-    const auto &buffer = inputPort->buffer();
-    if (buffer.length == 0) return;
+    //send the available buffers in order without copying them together
+    size_t elemsSent = 0;
+    for (const auto &buffer : inputPort->buffers())
+    {
+        //send the dtype when changed
+        this->updateDType(buffer.dtype);
 
-    //send the dtype when changed
-    this->updateDType(buffer.dtype);
+        //send a buffer of whole port elements
+        const size_t elemSize = inputPort->dtype().size();
+        const size_t numElems = buffer.length/elemSize;
+        const size_t numBytes = numElems*elemSize;
+        if (numBytes != 0) _ep.send(PothosPacketTypeBuffer, inputPort->totalElements()+elemsSent, buffer.as<const void *>(), numBytes);
+        elemsSent += numElems;
 
-    //send a buffer
-    {
-        _ep.send(PothosPacketTypeBuffer, inputPort->totalElements(), buffer.as<const void *>(), buffer.length);
-        inputPort->consume(inputPort->elements());
+        //an element spans the next buffer, the port will recover it at the front
+        if (numBytes != buffer.length) break;
     }
+    if (elemsSent != 0) inputPort->consume(elemsSent);
+
+    //send the message batch once it is as old as the latency allows
+    if (_messageBatch.empty()) return;
+    const auto age = std::chrono::high_resolution_clock::now() - _messageBatchTime;
+    const auto latency = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(_messageLatency));
+    if (age >= latency) return this->flushMessages();
+
+    //wait out the latency in steps no longer than the work timeout,
+    //rather than spinning through the scheduler until the batch is due
+    const auto step = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+        std::chrono::nanoseconds(this->workInfo().maxTimeoutNs));
+    std::this_thread::sleep_for(std::min(latency - age, step));
+    return this->yield();
 }
 
 static Pothos::BlockRegistry registerNetworkSink(
@@ -2,8 +2,11 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "SocketEndpoint.hpp"
+#include "PacketBatch.hpp"
 #include <Pothos/Framework.hpp>
+#include <Pothos/Util/MPSCQueue.hpp>
 #include <cstring> //std::memset
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <cassert>
@@ -15,9 +18,38 @@
  * The network source deserializes data from the socket and produces on its output port.
  * Socket data encompasses stream buffers, inline labels, and async messages.
  *
- * The underlying supports two transport options:
- * TCP - tcp://host:port
- * or UDT - udt://host:port
+ * The underlying supports three transport options:
+ * TCP - tcp://host:port,
+ * UDT - udt://host:port,
+ * or UDP - udp://host:port
+ *
+ * Transport options can be appended to the URI as query parameters:
+ * "version=1" uses the legacy header that limits frames to 64 KiB,
+ * "frame=bytes" sets the largest frame size offered to the remote,
+ * and "window=bytes" sets the upper bound of the flow control window.
+ * Example: tcp://host:port?frame=1048576&window=8388608
+ *
+ * The flow control window adapts to the measured round trip time
+ * and the rate that the receiving end consumes the stream.
+ * The getFlowStats() call and probe report the live window,
+ * acknowledgment interval and rate, round trip time, and stall time.
+ *
+ * The UDP transport sends datagrams without a handshake or flow control,
+ * so that one network sink can feed many network sources at once:
+ * the sink connects to a multicast group, each source binds the group's port.
+ * Example: udp://239.255.0.1:1234?iface=192.168.10.1&fec=8&rcvbuf=4194304
+ * The UDP options are "mtu=bytes" for the datagram size (default 1472),
+ * "fec=N" to follow every N datagrams with a parity datagram
+ * that repairs a single loss in the group without retransmission,
+ * "sndbuf=bytes" and "rcvbuf=bytes" for the socket buffer sizes,
+ * "iface=address" for the multicast interface, and "ttl=hops".
+ * Lost datagrams that could not be repaired are reported downstream
+ * with a "gap" label, its data is the number of datagrams lost.
+ *
+ * Stream buffers are received directly into the output port's buffers.
+ * Packet payloads and other messages are received directly into buffers
+ * from a circular pool owned by the block, a payload that does not fit
+ * in one buffer of the pool is received into a newly allocated buffer.
  *
  * |category /Network
  * |category /Sources
@@ -33,7 +65,15 @@
  * |option [Bind] "BIND"
  * |default "DISCONNECT"
  *
+ * |param poolSize[Pool Size] The total size of the pool for received payloads and messages.
+ * The pool is split into 4 buffers, no larger than the negotiated frame.
+ * Zero disables the pool, and every payload is received into a new buffer.
+ * |units bytes
+ * |default 1048576
+ * |preview valid
+ *
  * |factory /blocks/network_source(uri, opt)
+ * |setter setPoolSize(poolSize)
  **********************************************************************/
 class NetworkSource : public Pothos::Block
 {
@@ -45,11 +85,24 @@ public:
 
     NetworkSource(const std::string &uri, const std::string &opt):
         _ep(PothosPacketSocketEndpoint(uri, opt)),
-        _nextExpectedIndex(0)
+        _nextExpectedIndex(0),
+        _datagramsLost(0),
+        _poolSize(1024*1024),
+        _messagePartsLeft(0)
     {
         //std::cout << "NetworkSource " << opt << " " << uri << std::endl;
         this->setupOutput(0);
+        this->setActivateWaitsOnPeer(true); //open and close handshake with the sink
         this->registerCall(this, POTHOS_FCN_TUPLE(NetworkSource, getActualPort));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NetworkSource, getFlowStats));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NetworkSource, setPoolSize));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NetworkSource, getPoolSize));
+        this->registerProbe("getFlowStats");
+    }
+
+    ~NetworkSource(void)
+    {
+        this->releasePool();
     }
 
     std::string getActualPort(void) const
@@ -57,14 +110,49 @@ public:
         return _ep.getActualPort();
     }
 
+    Poco::JSON::Object::Ptr getFlowStats(void)
+    {
+        return _ep.getFlowStats();
+    }
+
+    void setPoolSize(const size_t bytes)
+    {
+        _poolSize = bytes;
+    }
+
+    size_t getPoolSize(void) const
+    {
+        return _poolSize;
+    }
+
     void activate(void)
     {
         _ep.openComms();
+        _datagramsLost = 0;
+
+        //a pool for received payloads, buffers may return from any thread
+        Pothos::BufferManagerArgs args;
+        args.numBuffers = 4;
+        args.bufferSize = std::min(_ep.getMaxFrameBytes(), _poolSize/args.numBuffers);
+        if (args.bufferSize == 0) return;
+        _pool = Pothos::BufferManager::make("circular", args);
+        _pool->setCallback([this](const Pothos::ManagedBuffer &buff){_poolReturns.push(buff);});
+        _ep.setRecvBufferManager(_pool);
     }
 
     void deactivate(void)
     {
         _ep.closeComms();
+        this->releasePool();
+        _messageParts.clear();
+    }
+
+    //release the manager first, so that returned buffers are freed rather than pushed back
+    void releasePool(void)
+    {
+        _ep.setRecvBufferManager(nullptr);
+        _pool.reset();
+        _poolReturns.clear();
     }
 
     void work(void);
@@ -72,8 +160,14 @@ public:
 private:
     PothosPacketSocketEndpoint _ep;
     unsigned long long _nextExpectedIndex;
+    unsigned long long _datagramsLost;
+    size_t _poolSize;
     Pothos::DType _lastDtype;
     Pothos::Packet _packetHeader;
+    std::string _messageParts;
+    unsigned long long _messagePartsLeft;
+    Pothos::BufferManager::Sptr _pool;
+    Pothos::Util::MPSCQueue<Pothos::ManagedBuffer> _poolReturns;
 };
 
 void NetworkSource::work(void)
@@ -83,6 +177,10 @@ void NetworkSource::work(void)
 
     auto outputPort = this->output(0);
 
+    //restore released payload buffers to the pool
+    Pothos::ManagedBuffer returned;
+    if (_pool) while (_poolReturns.pop(returned)) _pool->push(returned);
+
     //recv the header, use output buffer when possible for zero-copy
     uint16_t type;
     uint64_t index;
@@ -92,9 +190,18 @@ void NetworkSource::work(void)
     //handle the output
     if (type == PothosPacketTypeBuffer)
     {
+        //mark the stream where datagrams were lost before this buffer
+        const auto datagramsLost = _ep.getDatagramsLost();
+        if (datagramsLost != _datagramsLost)
+        {
+            outputPort->postLabel(Pothos::Label("gap", datagramsLost - _datagramsLost, 0));
+            _datagramsLost = datagramsLost;
+        }
+
+        //datagrams that were held back for recovery arrive in other buffers
         _nextExpectedIndex = index + buffer.length;
         buffer.dtype = _lastDtype;
-        outputPort->popBuffer(buffer.length);
+        if (buffer.address == outputPort->buffer().address) outputPort->popBuffer(buffer.length);
         outputPort->postBuffer(buffer);
     }
     else if (type == PothosPacketTypeMessage)
@@ -130,6 +237,38 @@ void NetworkSource::work(void)
         label.index = index - _nextExpectedIndex;
         outputPort->postLabel(label);
     }
+    else if (type == PothosPacketTypeLabels)
+    {
+        for (auto &label : PothosPacketUnpackLabels(buffer.as<const void *>(), buffer.length))
+        {
+            label.index += index - _nextExpectedIndex;
+            outputPort->postLabel(label);
+        }
+    }
+    else if (type == PothosPacketTypeMessages)
+    {
+        //a record larger than one frame arrives in parts, the index counts the record bytes that follow,
+        //a part that does not continue the record in progress follows lost datagrams and is dropped
+        if (not _messageParts.empty() and _messagePartsLeft != buffer.length + index) _messageParts.clear();
+        if (index != 0 or not _messageParts.empty())
+        {
+            _messageParts.append(buffer.as<const char *>(), buffer.length);
+            _messagePartsLeft = index;
+            if (index != 0) return this->yield();
+            std::string record; record.swap(_messageParts);
+            for (const auto &msg : PothosPacketUnpackMessages(record.data(), record.size()))
+            {
+                outputPort->postMessage(msg);
+            }
+        }
+        else
+        {
+            for (const auto &msg : PothosPacketUnpackMessages(buffer.as<const void *>(), buffer.length))
+            {
+                outputPort->postMessage(msg);
+            }
+        }
+    }
     else if (type == PothosPacketTypeDType)
     {
         std::istringstream iss(std::string(buffer.as<char *>(), buffer.length));
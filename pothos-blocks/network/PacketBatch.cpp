@@ -0,0 +1,255 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PacketBatch.hpp"
+#include <Pothos/Object.hpp>
+#include <Pothos/Exception.hpp>
+#include <Poco/ByteOrder.h>
+#include <sstream>
+#include <cstring> //memcpy
+#include <cstdint>
+
+/***********************************************************************
+ * Variable length integers: 7 bits per byte, low bits first
+ **********************************************************************/
+static void appendVarint(std::string &out, unsigned long long value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+static unsigned long long readVarint(const char *&p, const char *end)
+{
+    unsigned long long value = 0;
+    for (size_t shift = 0; shift < 64; shift += 7)
+    {
+        if (p == end) throw Pothos::DataFormatException("PothosPacketUnpack()", "truncated integer");
+        const auto byte = static_cast<unsigned char>(*p++);
+        value |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return value;
+    }
+    throw Pothos::DataFormatException("PothosPacketUnpack()", "integer overflow");
+}
+
+static const char *readBytes(const char *&p, const char *end, const size_t numBytes)
+{
+    if (size_t(end - p) < numBytes) throw Pothos::DataFormatException("PothosPacketUnpack()", "truncated data");
+    const char *bytes = p;
+    p += numBytes;
+    return bytes;
+}
+
+/***********************************************************************
+ * Label data encoding by type
+ **********************************************************************/
+enum LabelDataTag
+{
+    TAG_NULL,
+    TAG_BOOL,
+    TAG_CHAR,
+    TAG_SCHAR,
+    TAG_UCHAR,
+    TAG_SHORT,
+    TAG_USHORT,
+    TAG_INT,
+    TAG_UINT,
+    TAG_LONG,
+    TAG_ULONG,
+    TAG_LLONG,
+    TAG_ULLONG,
+    TAG_FLOAT,
+    TAG_DOUBLE,
+    TAG_STRING,
+    TAG_OBJECT,
+};
+
+template <typename Type>
+static bool appendSigned(std::string &out, const Pothos::Object &data, const LabelDataTag tag)
+{
+    if (data.type() != typeid(Type)) return false;
+    out.push_back(char(tag));
+    const long long value = data.extract<Type>();
+    appendVarint(out, (static_cast<unsigned long long>(value) << 1) ^ static_cast<unsigned long long>(value >> 63));
+    return true;
+}
+
+template <typename Type>
+static bool appendUnsigned(std::string &out, const Pothos::Object &data, const LabelDataTag tag)
+{
+    if (data.type() != typeid(Type)) return false;
+    out.push_back(char(tag));
+    appendVarint(out, static_cast<unsigned long long>(data.extract<Type>()));
+    return true;
+}
+
+static long long readSigned(const char *&p, const char *end)
+{
+    const auto value = readVarint(p, end);
+    return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
+
+static void appendData(std::string &out, const Pothos::Object &data)
+{
+    if (not data) return out.push_back(char(TAG_NULL));
+    if (data.type() == typeid(bool))
+    {
+        out.push_back(char(TAG_BOOL));
+        return out.push_back(char(data.extract<bool>()?1:0));
+    }
+    if (appendSigned<char>(out, data, TAG_CHAR)) return;
+    if (appendSigned<signed char>(out, data, TAG_SCHAR)) return;
+    if (appendUnsigned<unsigned char>(out, data, TAG_UCHAR)) return;
+    if (appendSigned<short>(out, data, TAG_SHORT)) return;
+    if (appendUnsigned<unsigned short>(out, data, TAG_USHORT)) return;
+    if (appendSigned<int>(out, data, TAG_INT)) return;
+    if (appendUnsigned<unsigned int>(out, data, TAG_UINT)) return;
+    if (appendSigned<long>(out, data, TAG_LONG)) return;
+    if (appendUnsigned<unsigned long>(out, data, TAG_ULONG)) return;
+    if (appendSigned<long long>(out, data, TAG_LLONG)) return;
+    if (appendUnsigned<unsigned long long>(out, data, TAG_ULLONG)) return;
+    if (data.type() == typeid(float))
+    {
+        uint32_t bits; const float value = data.extract<float>();
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = Poco::ByteOrder::toNetwork(bits);
+        out.push_back(char(TAG_FLOAT));
+        out.append(reinterpret_cast<const char *>(&bits), sizeof(bits));
+        return;
+    }
+    if (data.type() == typeid(double))
+    {
+        uint64_t bits; const double value = data.extract<double>();
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = Poco::ByteOrder::toNetwork(Poco::UInt64(bits));
+        out.push_back(char(TAG_DOUBLE));
+        out.append(reinterpret_cast<const char *>(&bits), sizeof(bits));
+        return;
+    }
+    if (data.type() == typeid(std::string))
+    {
+        const auto &value = data.extract<std::string>();
+        out.push_back(char(TAG_STRING));
+        appendVarint(out, value.size());
+        out.append(value);
+        return;
+    }
+
+    //everything else uses the object serialization
+    std::ostringstream oss;
+    data.serialize(oss);
+    out.push_back(char(TAG_OBJECT));
+    appendVarint(out, oss.str().size());
+    out.append(oss.str());
+}
+
+static Pothos::Object readData(const char *&p, const char *end)
+{
+    const auto tag = static_cast<unsigned char>(*readBytes(p, end, 1));
+    switch (tag)
+    {
+    case TAG_NULL: return Pothos::Object();
+    case TAG_BOOL: return Pothos::Object(*readBytes(p, end, 1) != 0);
+    case TAG_CHAR: return Pothos::Object(char(readSigned(p, end)));
+    case TAG_SCHAR: return Pothos::Object((signed char)(readSigned(p, end)));
+    case TAG_UCHAR: return Pothos::Object((unsigned char)(readVarint(p, end)));
+    case TAG_SHORT: return Pothos::Object(short(readSigned(p, end)));
+    case TAG_USHORT: return Pothos::Object((unsigned short)(readVarint(p, end)));
+    case TAG_INT: return Pothos::Object(int(readSigned(p, end)));
+    case TAG_UINT: return Pothos::Object((unsigned int)(readVarint(p, end)));
+    case TAG_LONG: return Pothos::Object(long(readSigned(p, end)));
+    case TAG_ULONG: return Pothos::Object((unsigned long)(readVarint(p, end)));
+    case TAG_LLONG: return Pothos::Object((long long)(readSigned(p, end)));
+    case TAG_ULLONG: return Pothos::Object((unsigned long long)(readVarint(p, end)));
+    case TAG_FLOAT:
+    {
+        uint32_t bits; float value;
+        std::memcpy(&bits, readBytes(p, end, sizeof(bits)), sizeof(bits));
+        bits = Poco::ByteOrder::fromNetwork(bits);
+        std::memcpy(&value, &bits, sizeof(value));
+        return Pothos::Object(value);
+    }
+    case TAG_DOUBLE:
+    {
+        uint64_t bits; double value;
+        std::memcpy(&bits, readBytes(p, end, sizeof(bits)), sizeof(bits));
+        bits = Poco::ByteOrder::fromNetwork(Poco::UInt64(bits));
+        std::memcpy(&value, &bits, sizeof(value));
+        return Pothos::Object(value);
+    }
+    case TAG_STRING:
+    {
+        const size_t length = size_t(readVarint(p, end));
+        return Pothos::Object(std::string(readBytes(p, end, length), length));
+    }
+    case TAG_OBJECT:
+    {
+        const size_t length = size_t(readVarint(p, end));
+        std::istringstream iss(std::string(readBytes(p, end, length), length));
+        Pothos::Object data;
+        data.deserialize(iss);
+        return data;
+    }
+    }
+    throw Pothos::DataFormatException("PothosPacketUnpackLabels()", "unknown data tag " + std::to_string(tag));
+}
+
+/***********************************************************************
+ * Label batches
+ **********************************************************************/
+void PothosPacketAppendLabel(std::string &batch, const Pothos::Label &label)
+{
+    appendVarint(batch, label.index);
+    appendVarint(batch, label.width);
+    appendVarint(batch, label.id.size());
+    batch.append(label.id);
+    appendData(batch, label.data);
+}
+
+std::vector<Pothos::Label> PothosPacketUnpackLabels(const void *batch, const size_t numBytes)
+{
+    std::vector<Pothos::Label> labels;
+    const char *p = reinterpret_cast<const char *>(batch);
+    const char *end = p + numBytes;
+    while (p != end)
+    {
+        Pothos::Label label;
+        label.index = readVarint(p, end);
+        label.width = size_t(readVarint(p, end));
+        const size_t idLength = size_t(readVarint(p, end));
+        label.id.assign(readBytes(p, end, idLength), idLength);
+        label.data = readData(p, end);
+        labels.push_back(label);
+    }
+    return labels;
+}
+
+/***********************************************************************
+ * Message batches
+ **********************************************************************/
+void PothosPacketAppendMessage(std::string &batch, const Pothos::Object &msg)
+{
+    std::ostringstream oss;
+    msg.serialize(oss);
+    appendVarint(batch, oss.str().size());
+    batch.append(oss.str());
+}
+
+std::vector<Pothos::Object> PothosPacketUnpackMessages(const void *batch, const size_t numBytes)
+{
+    std::vector<Pothos::Object> messages;
+    const char *p = reinterpret_cast<const char *>(batch);
+    const char *end = p + numBytes;
+    while (p != end)
+    {
+        const size_t length = size_t(readVarint(p, end));
+        std::istringstream iss(std::string(readBytes(p, end, length), length));
+        Pothos::Object msg;
+        msg.deserialize(iss);
+        messages.push_back(msg);
+    }
+    return messages;
+}
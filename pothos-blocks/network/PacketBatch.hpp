@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+//
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Framework/Label.hpp>
+#include <Pothos/Object/Object.hpp>
+#include <string>
+#include <vector>
+
+/*!
+ * Append a label to a label batch.
+ * The label index is relative to the index of the batch frame.
+ * Labels use a compact binary encoding: the index, width and id
+ * followed by the data, where booleans, integers, floats and strings
+ * are encoded by type and other data is serialized as an Object.
+ */
+void PothosPacketAppendLabel(std::string &batch, const Pothos::Label &label);
+
+/*!
+ * Decode the labels from a label batch frame.
+ * \throws DataFormatException for a malformed batch
+ */
+std::vector<Pothos::Label> PothosPacketUnpackLabels(const void *batch, const size_t numBytes);
+
+/*!
+ * Append a message to a message batch.
+ * Each message is serialized as an Object behind its length.
+ */
+void PothosPacketAppendMessage(std::string &batch, const Pothos::Object &msg);
+
+/*!
+ * Decode the messages from a message batch frame in order.
+ * \throws DataFormatException for a malformed batch
+ */
+std::vector<Pothos::Object> PothosPacketUnpackMessages(const void *batch, const size_t numBytes);
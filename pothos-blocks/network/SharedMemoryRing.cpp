@@ -0,0 +1,516 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SharedMemoryRing.hpp"
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework/SharedBuffer.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm> //max
+#include <cstring> //memcpy
+#include <climits> //INT_MAX
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+/***********************************************************************
+ * Shared memory layout:
+ * The header occupies the first page of the segment, followed by
+ * the stream region and the copy region, each half of the capacity.
+ * The writer claims a free descriptor for each packet, and either
+ * references the stream region or copies into the descriptor's area
+ * of the copy region, then pushes the packet onto the packet queue.
+ * The reader marks the descriptor free once the packet is released,
+ * which may happen out of order, so a long-held buffer
+ * only reduces the capacity rather than stalling the stream.
+ * The last bytes of each copy area are not used, because the input port
+ * downstream of the reader merges address adjacent buffers,
+ * and would release the descriptor of the second buffer too early.
+ * The writer and reader fields are on separate cache lines.
+ **********************************************************************/
+static const uint64_t SHM_RING_MAGIC = 0x504f54484f535332ull; //POTHOSS2
+static const size_t SHM_RING_HEADER_SIZE = 4096;
+static const size_t SHM_RING_NUM_SLOTS = 64;
+static const size_t SHM_RING_ALIGNMENT = 64;
+static const size_t SHM_RING_MIN_CAPACITY = 64*1024;
+
+struct SharedMemoryPacket
+{
+    uint16_t type;
+    uint8_t slot;
+    uint8_t more;
+    uint32_t length;
+    uint64_t index;
+    uint64_t offset; //from the start of the stream region
+};
+
+struct SharedMemoryRingHeader
+{
+    uint64_t magic;
+    uint64_t capacity;
+    uint64_t streamSize;
+    uint64_t slotSize;
+
+    //written by the writer: total packets pushed
+    alignas(64) std::atomic<uint64_t> head;
+    std::atomic<uint32_t> headSeq;
+    std::atomic<uint32_t> readerWaiters;
+
+    //written by the reader: bit mask of free descriptors
+    alignas(64) std::atomic<uint64_t> freeSlots;
+    std::atomic<uint32_t> freeSeq;
+    std::atomic<uint32_t> writerWaiters;
+
+    //packet queue, one entry per descriptor is sufficient
+    alignas(64) SharedMemoryPacket packets[SHM_RING_NUM_SLOTS];
+};
+
+static_assert(sizeof(SharedMemoryRingHeader) <= SHM_RING_HEADER_SIZE, "shared memory ring header exceeds the first page");
+
+#ifdef __linux__
+
+static size_t numFreeSlots(uint64_t mask)
+{
+    size_t count = 0;
+    for (; mask != 0; mask &= mask-1) count++;
+    return count;
+}
+
+/***********************************************************************
+ * futex helpers for process shared wait and notify
+ **********************************************************************/
+static void futexWait(std::atomic<uint32_t> &word, const uint32_t expected, const std::chrono::high_resolution_clock::duration &timeout)
+{
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+    if (nanos <= 0) return;
+    struct timespec ts;
+    ts.tv_sec = nanos/1000000000;
+    ts.tv_nsec = nanos%1000000000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+static void futexWake(std::atomic<uint32_t> &word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+/*!
+ * Wait until the condition is true, or the timeout expires.
+ * The sequence word is incremented by the other side upon each change.
+ */
+template <typename Condition>
+static bool waitOnSequence(std::atomic<uint32_t> &seq, std::atomic<uint32_t> &waiters,
+    const std::chrono::high_resolution_clock::duration &timeout, Condition cond)
+{
+    if (cond()) return true;
+    const auto exitTime = std::chrono::high_resolution_clock::now() + timeout;
+    while (true)
+    {
+        const auto expected = seq.load();
+        waiters++;
+        const bool ready = cond();
+        if (not ready) futexWait(seq, expected, exitTime - std::chrono::high_resolution_clock::now());
+        waiters--;
+        if (ready or cond()) return true;
+        if (std::chrono::high_resolution_clock::now() >= exitTime) return false;
+    }
+}
+
+/***********************************************************************
+ * Ring implementation
+ **********************************************************************/
+struct SharedMemoryMapping
+{
+    SharedMemoryMapping(const int fd, const size_t size):
+        size(size)
+    {
+        addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) throw Pothos::SystemException("PothosPacketSharedMemoryRing::map()", std::strerror(errno));
+    }
+
+    ~SharedMemoryMapping(void)
+    {
+        munmap(addr, size);
+    }
+
+    void *addr;
+    const size_t size;
+};
+
+struct PothosPacketSharedMemoryRing::Impl
+{
+    Impl(void):
+        owner(false),
+        header(nullptr),
+        ring(nullptr),
+        streamSize(0),
+        slotSize(0),
+        inFlightMask(0),
+        readPos(0)
+    {
+        return;
+    }
+
+    ~Impl(void)
+    {
+        if (owner) shm_unlink(name.c_str());
+    }
+
+    void map(const int fd, const size_t size)
+    {
+        mapping.reset(new SharedMemoryMapping(fd, size));
+        header = reinterpret_cast<SharedMemoryRingHeader *>(mapping->addr);
+        ring = reinterpret_cast<char *>(mapping->addr) + SHM_RING_HEADER_SIZE;
+    }
+
+    /*!
+     * Claim the lowest free descriptor, waiting up to the timeout.
+     * The buffer that referenced the descriptor before is replaced,
+     * the reader has released it when the descriptor is free.
+     */
+    bool claim(size_t &slot, const Pothos::BufferChunk &buff, const std::chrono::high_resolution_clock::duration &timeout)
+    {
+        auto &hdr = *header;
+        const bool ready = waitOnSequence(hdr.freeSeq, hdr.writerWaiters, timeout, [&](void)
+        {
+            return hdr.freeSlots.load(std::memory_order_acquire) != 0;
+        });
+        if (not ready) return false;
+
+        Pothos::BufferChunk old;
+        std::lock_guard<std::mutex> lock(writerMutex);
+        const auto mask = hdr.freeSlots.load(std::memory_order_acquire);
+        slot = 0;
+        while (((mask >> slot) & 1) == 0) slot++;
+        hdr.freeSlots.fetch_and(~(uint64_t(1) << slot));
+        old = std::move(inFlight[slot]);
+        inFlight[slot] = buff;
+        if (buff) inFlightMask |= (uint64_t(1) << slot);
+        else inFlightMask &= ~(uint64_t(1) << slot);
+        return true;
+    }
+
+    //! Publish the packet and notify a waiting reader
+    void publish(const uint16_t type, const uint64_t index, const size_t slot,
+        const uint64_t offset, const size_t numBytes, const bool more)
+    {
+        auto &hdr = *header;
+        const uint64_t head = hdr.head.load(std::memory_order_relaxed);
+        auto &packet = hdr.packets[head % SHM_RING_NUM_SLOTS];
+        packet.type = type;
+        packet.slot = uint8_t(slot);
+        packet.more = more?1:0;
+        packet.length = uint32_t(numBytes);
+        packet.index = index;
+        packet.offset = offset;
+        hdr.head.store(head + 1, std::memory_order_release);
+        hdr.headSeq++;
+        if (hdr.readerWaiters.load() != 0) futexWake(hdr.headSeq);
+    }
+
+    std::string name;
+    bool owner;
+    std::shared_ptr<SharedMemoryMapping> mapping;
+    SharedMemoryRingHeader *header;
+    char *ring;
+    uint64_t streamSize;
+    uint64_t slotSize;
+
+    //writer state: stream buffers referenced by the descriptors
+    std::mutex writerMutex;
+    Pothos::BufferChunk inFlight[SHM_RING_NUM_SLOTS];
+    std::atomic<uint64_t> inFlightMask;
+
+    //reader state: packets popped from the queue
+    uint64_t readPos;
+};
+
+PothosPacketSharedMemoryRing::PothosPacketSharedMemoryRing(void):
+    _impl(new Impl())
+{
+    return;
+}
+
+PothosPacketSharedMemoryRing::~PothosPacketSharedMemoryRing(void)
+{
+    return;
+}
+
+PothosPacketSharedMemoryRing::Sptr PothosPacketSharedMemoryRing::create(const size_t capacity_)
+{
+    static std::atomic<unsigned> counter(0);
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const size_t capacity = ((std::max(capacity_, SHM_RING_MIN_CAPACITY) + pageSize - 1)/pageSize)*pageSize;
+
+    Sptr ring(new PothosPacketSharedMemoryRing());
+    auto &impl = *ring->_impl;
+    impl.name = "/pothos-ring-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+    const int fd = shm_open(impl.name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0) throw Pothos::SystemException("PothosPacketSharedMemoryRing::create("+impl.name+")", std::strerror(errno));
+    impl.owner = true;
+    if (ftruncate(fd, SHM_RING_HEADER_SIZE + capacity) != 0)
+    {
+        ::close(fd);
+        throw Pothos::SystemException("PothosPacketSharedMemoryRing::create("+impl.name+")", std::strerror(errno));
+    }
+    impl.map(fd, SHM_RING_HEADER_SIZE + capacity);
+
+    //initialize the header, the new segment is already zero filled
+    impl.streamSize = ((capacity/2)/pageSize)*pageSize;
+    impl.slotSize = (((capacity - impl.streamSize)/SHM_RING_NUM_SLOTS)/SHM_RING_ALIGNMENT)*SHM_RING_ALIGNMENT;
+    impl.header->capacity = capacity;
+    impl.header->streamSize = impl.streamSize;
+    impl.header->slotSize = impl.slotSize;
+    impl.header->freeSlots = ~uint64_t(0);
+    impl.header->magic = SHM_RING_MAGIC;
+    return ring;
+}
+
+PothosPacketSharedMemoryRing::Sptr PothosPacketSharedMemoryRing::open(const std::string &name)
+{
+    Sptr ring(new PothosPacketSharedMemoryRing());
+    auto &impl = *ring->_impl;
+    impl.name = name;
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) throw Pothos::SystemException("PothosPacketSharedMemoryRing::open("+name+")", std::strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 or size_t(st.st_size) <= SHM_RING_HEADER_SIZE)
+    {
+        ::close(fd);
+        throw Pothos::DataFormatException("PothosPacketSharedMemoryRing::open("+name+")", "bad segment size");
+    }
+    impl.map(fd, st.st_size);
+
+    const auto &hdr = *impl.header;
+    if (hdr.magic != SHM_RING_MAGIC or hdr.capacity != st.st_size - SHM_RING_HEADER_SIZE or
+        hdr.slotSize <= SHM_RING_ALIGNMENT or hdr.streamSize + hdr.slotSize*SHM_RING_NUM_SLOTS > hdr.capacity)
+    {
+        throw Pothos::DataFormatException("PothosPacketSharedMemoryRing::open("+name+")", "bad segment header");
+    }
+    impl.streamSize = hdr.streamSize;
+    impl.slotSize = hdr.slotSize;
+
+    //the segment name is no longer needed once both sides are mapped
+    shm_unlink(name.c_str());
+    return ring;
+}
+
+const std::string &PothosPacketSharedMemoryRing::getName(void) const
+{
+    return _impl->name;
+}
+
+size_t PothosPacketSharedMemoryRing::getMaxPayload(void) const
+{
+    return _impl->slotSize - SHM_RING_ALIGNMENT;
+}
+
+Pothos::SharedBuffer PothosPacketSharedMemoryRing::getStreamRegion(void) const
+{
+    return Pothos::SharedBuffer(size_t(_impl->ring), _impl->streamSize, _impl->mapping);
+}
+
+bool PothosPacketSharedMemoryRing::isStreamBuffer(const Pothos::BufferChunk &buff) const
+{
+    const size_t begin = size_t(_impl->ring);
+    return buff.address >= begin and buff.getEnd() <= begin + _impl->streamSize;
+}
+
+bool PothosPacketSharedMemoryRing::send(const uint16_t type, const uint64_t index, const void *buff, const size_t numBytes,
+    const std::chrono::high_resolution_clock::duration &timeout, const bool more)
+{
+    auto &impl = *_impl;
+    if (numBytes > this->getMaxPayload())
+    {
+        throw Pothos::RangeException("PothosPacketSharedMemoryRing::send()", "payload exceeds the copy area size");
+    }
+
+    //claim a descriptor and copy into its area
+    size_t slot = 0;
+    if (not impl.claim(slot, Pothos::BufferChunk::null(), timeout)) return false;
+    const uint64_t offset = impl.streamSize + slot*impl.slotSize;
+    std::memcpy(impl.ring + offset, buff, numBytes);
+    impl.publish(type, index, slot, offset, numBytes, more);
+    return true;
+}
+
+bool PothosPacketSharedMemoryRing::sendBuffer(const uint16_t type, const uint64_t index, const Pothos::BufferChunk &buff,
+    const std::chrono::high_resolution_clock::duration &timeout)
+{
+    auto &impl = *_impl;
+    if (not this->isStreamBuffer(buff))
+    {
+        throw Pothos::RangeException("PothosPacketSharedMemoryRing::sendBuffer()", "buffer is not in the stream region");
+    }
+
+    //claim a descriptor that holds the buffer until the reader releases it
+    size_t slot = 0;
+    if (not impl.claim(slot, buff, timeout)) return false;
+    impl.publish(type, index, slot, buff.address - size_t(impl.ring), buff.length, false);
+    return true;
+}
+
+void PothosPacketSharedMemoryRing::reap(const std::chrono::high_resolution_clock::duration &timeout)
+{
+    auto &impl = *_impl;
+    auto &hdr = *impl.header;
+    waitOnSequence(hdr.freeSeq, hdr.writerWaiters, timeout, [&](void)
+    {
+        return (hdr.freeSlots.load(std::memory_order_acquire) & impl.inFlightMask.load()) != 0;
+    });
+
+    //the buffers are released outside of the lock,
+    //which may notify the upstream block's buffer manager
+    std::vector<Pothos::BufferChunk> released;
+    {
+        std::lock_guard<std::mutex> lock(impl.writerMutex);
+        const uint64_t mask = hdr.freeSlots.load(std::memory_order_acquire) & impl.inFlightMask.load();
+        for (size_t slot = 0; slot < SHM_RING_NUM_SLOTS; slot++)
+        {
+            if (((mask >> slot) & 1) == 0) continue;
+            released.push_back(std::move(impl.inFlight[slot]));
+            impl.inFlight[slot] = Pothos::BufferChunk();
+        }
+        impl.inFlightMask &= ~mask;
+    }
+}
+
+bool PothosPacketSharedMemoryRing::recv(uint16_t &type, uint64_t &index, Pothos::BufferChunk &buffer, bool &more,
+    const std::chrono::high_resolution_clock::duration &timeout)
+{
+    auto &impl = *_impl;
+    auto &hdr = *impl.header;
+
+    const bool ready = waitOnSequence(hdr.headSeq, hdr.readerWaiters, timeout, [&](void)
+    {
+        return hdr.head.load(std::memory_order_acquire) != impl.readPos;
+    });
+    if (not ready) return false;
+
+    const auto packet = hdr.packets[impl.readPos % SHM_RING_NUM_SLOTS];
+    impl.readPos++;
+    type = packet.type;
+    index = packet.index;
+    more = packet.more != 0;
+    if (packet.slot >= SHM_RING_NUM_SLOTS or packet.offset + packet.length > hdr.capacity)
+    {
+        throw Pothos::DataFormatException("PothosPacketSharedMemoryRing::recv("+impl.name+")", "bad packet descriptor");
+    }
+    const auto payload = impl.ring + packet.offset;
+
+    //zero-copy stream buffers while most descriptors are free, the container releases the descriptor
+    const bool zeroCopy = (type == uint16_t('B') or type == uint16_t('P')) and
+        numFreeSlots(hdr.freeSlots.load()) >= SHM_RING_NUM_SLOTS/4;
+    if (zeroCopy)
+    {
+        auto self = this->shared_from_this();
+        const uint64_t slot = packet.slot;
+        std::shared_ptr<void> container(nullptr, [self, slot](void *){self->release(slot);});
+        buffer = Pothos::BufferChunk(Pothos::SharedBuffer(size_t(payload), packet.length, container));
+    }
+
+    //otherwise copy out the packet and release the descriptor now
+    else
+    {
+        buffer = Pothos::BufferChunk(packet.length);
+        std::memcpy(buffer.as<void *>(), payload, packet.length);
+        this->release(packet.slot);
+    }
+    return true;
+}
+
+void PothosPacketSharedMemoryRing::release(const uint64_t slot)
+{
+    auto &hdr = *_impl->header;
+    hdr.freeSlots.fetch_or(uint64_t(1) << slot, std::memory_order_release);
+    hdr.freeSeq++;
+    if (hdr.writerWaiters.load() != 0) futexWake(hdr.freeSeq);
+}
+
+#else //__linux__
+
+struct PothosPacketSharedMemoryRing::Impl
+{
+    std::string name;
+};
+
+PothosPacketSharedMemoryRing::PothosPacketSharedMemoryRing(void):
+    _impl(new Impl())
+{
+    return;
+}
+
+PothosPacketSharedMemoryRing::~PothosPacketSharedMemoryRing(void)
+{
+    return;
+}
+
+PothosPacketSharedMemoryRing::Sptr PothosPacketSharedMemoryRing::create(const size_t)
+{
+    throw Pothos::NotImplementedException("PothosPacketSharedMemoryRing::create()", "shared memory transport requires Linux");
+}
+
+PothosPacketSharedMemoryRing::Sptr PothosPacketSharedMemoryRing::open(const std::string &)
+{
+    throw Pothos::NotImplementedException("PothosPacketSharedMemoryRing::open()", "shared memory transport requires Linux");
+}
+
+const std::string &PothosPacketSharedMemoryRing::getName(void) const
+{
+    return _impl->name;
+}
+
+size_t PothosPacketSharedMemoryRing::getMaxPayload(void) const
+{
+    return 0;
+}
+
+Pothos::SharedBuffer PothosPacketSharedMemoryRing::getStreamRegion(void) const
+{
+    return Pothos::SharedBuffer();
+}
+
+bool PothosPacketSharedMemoryRing::isStreamBuffer(const Pothos::BufferChunk &) const
+{
+    return false;
+}
+
+bool PothosPacketSharedMemoryRing::send(const uint16_t, const uint64_t, const void *, const size_t,
+    const std::chrono::high_resolution_clock::duration &, const bool)
+{
+    return false;
+}
+
+bool PothosPacketSharedMemoryRing::sendBuffer(const uint16_t, const uint64_t, const Pothos::BufferChunk &,
+    const std::chrono::high_resolution_clock::duration &)
+{
+    return false;
+}
+
+void PothosPacketSharedMemoryRing::reap(const std::chrono::high_resolution_clock::duration &)
+{
+    return;
+}
+
+bool PothosPacketSharedMemoryRing::recv(uint16_t &, uint64_t &, Pothos::BufferChunk &, bool &,
+    const std::chrono::high_resolution_clock::duration &)
+{
+    return false;
+}
+
+void PothosPacketSharedMemoryRing::release(const uint64_t)
+{
+    return;
+}
+
+#endif //__linux__
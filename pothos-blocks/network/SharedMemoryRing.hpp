@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+//
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <Pothos/Framework/SharedBuffer.hpp>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+/*!
+ * A single producer, single consumer ring of packets in shared memory.
+ * The ring is a POSIX shared memory segment that is created by the
+ * writer and opened by name from the reader in another process.
+ * The packet types and indexes follow the socket endpoint packets.
+ *
+ * The segment is divided into a stream region and a copy region.
+ * The writer hands out the stream region as buffers for the upstream
+ * block to produce into, and a packet that references the stream region
+ * is sent without a copy. Other packets are copied into the copy area
+ * of their descriptor; a packet larger than a copy area is sent as
+ * fragments, each marked with more until the last fragment.
+ *
+ * Packets are received zero-copy: the received buffer points into the
+ * shared memory, and the descriptor is returned to the writer once every
+ * reference to the received buffer has been released.
+ * When few descriptors remain free, the reader copies out the payload instead.
+ */
+class PothosPacketSharedMemoryRing :
+    public std::enable_shared_from_this<PothosPacketSharedMemoryRing>
+{
+public:
+    typedef std::shared_ptr<PothosPacketSharedMemoryRing> Sptr;
+
+    /*!
+     * Create a new shared memory ring for the writer.
+     * \param capacity the size of the ring in bytes
+     */
+    static Sptr create(const size_t capacity);
+
+    /*!
+     * Open an existing shared memory ring for the reader.
+     * \param name the segment name from the writer's getName()
+     */
+    static Sptr open(const std::string &name);
+
+    ~PothosPacketSharedMemoryRing(void);
+
+    //! Get the name of the shared memory segment
+    const std::string &getName(void) const;
+
+    //! The largest payload that can be copied in a single packet (the copy area size)
+    size_t getMaxPayload(void) const;
+
+    /*!
+     * Get the stream region for the writer's buffers.
+     * The shared buffer keeps the mapping alive while it is referenced.
+     */
+    Pothos::SharedBuffer getStreamRegion(void) const;
+
+    //! Is the buffer entirely inside the stream region?
+    bool isStreamBuffer(const Pothos::BufferChunk &buff) const;
+
+    /*!
+     * Copy a packet into the ring for the reader.
+     * \throws RangeException when numBytes exceeds getMaxPayload()
+     * \param more true when the next packet continues this packet
+     * \return false when the ring did not have space within the timeout
+     */
+    bool send(const uint16_t type, const uint64_t index, const void *buff, const size_t numBytes,
+        const std::chrono::high_resolution_clock::duration &timeout, const bool more = false);
+
+    /*!
+     * Send a packet that references the stream region without a copy.
+     * The ring holds a reference to the buffer until the reader releases it.
+     * \throws RangeException when the buffer is not in the stream region
+     * \return false when the ring did not have space within the timeout
+     */
+    bool sendBuffer(const uint16_t type, const uint64_t index, const Pothos::BufferChunk &buff,
+        const std::chrono::high_resolution_clock::duration &timeout);
+
+    /*!
+     * Drop the references to the buffers that the reader has released,
+     * which returns the stream buffers to the upstream block.
+     * Waits up to the timeout when there is nothing to drop.
+     */
+    void reap(const std::chrono::high_resolution_clock::duration &timeout);
+
+    /*!
+     * Receive a packet from the writer.
+     * Packets reference the shared memory directly.
+     * \param [out] more true when the next packet continues this packet
+     * \return false when no packet arrived within the timeout
+     */
+    bool recv(uint16_t &type, uint64_t &index, Pothos::BufferChunk &buffer, bool &more,
+        const std::chrono::high_resolution_clock::duration &timeout);
+
+private:
+    PothosPacketSharedMemoryRing(void);
+    void release(const uint64_t slot);
+    struct Impl; std::unique_ptr<Impl> _impl;
+};
@@ -0,0 +1,337 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SharedMemoryRing.hpp"
+#include "SocketEndpoint.hpp"
+#include <Pothos/Framework.hpp>
+#include <Pothos/Util/RingDeque.hpp>
+#include <algorithm> //min
+#include <cstring> //memcpy
+#include <sstream>
+#include <string>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cassert>
+
+/***********************************************************************
+ * Buffer manager for the upstream block:
+ * The buffers are divided from the stream region of the ring,
+ * so that a produced buffer can be sent to the reader without a copy.
+ * The buffer size follows from the ring capacity, not the manager arguments.
+ * Neighbouring buffers are separated by a gap, otherwise the input port
+ * could merge the address adjacent chunks of two different buffers,
+ * and the ring would only hold a reference to the first buffer.
+ **********************************************************************/
+class SharedMemoryBufferManager :
+    public Pothos::BufferManager,
+    public std::enable_shared_from_this<SharedMemoryBufferManager>
+{
+public:
+    SharedMemoryBufferManager(const Pothos::SharedBuffer &region):
+        _region(region)
+    {
+        return;
+    }
+
+    void init(const Pothos::BufferManagerArgs &args)
+    {
+        Pothos::BufferManager::init(args);
+        const size_t numBuffers = std::max<size_t>(1, std::min(args.numBuffers, _region.getLength()/(2*GAP_SIZE)));
+        const size_t stride = ((_region.getLength()/numBuffers)/GAP_SIZE)*GAP_SIZE;
+        _readyBuffs.set_capacity(numBuffers);
+
+        for (size_t i = 0; i < numBuffers; i++)
+        {
+            Pothos::SharedBuffer sharedBuff(_region.getAddress() + i*stride, stride - GAP_SIZE, _region);
+            Pothos::ManagedBuffer buffer;
+            buffer.reset(this->shared_from_this(), sharedBuff);
+        }
+    }
+
+    bool empty(void) const
+    {
+        return _readyBuffs.empty();
+    }
+
+    void pop(const size_t numBytes)
+    {
+        assert(not _readyBuffs.empty());
+
+        //re-use the buffer for small consumes
+        //length 0 buffers are always popped
+        if (this->front().length != 0 and this->front().length >= numBytes*2)
+        {
+            auto buff = this->front();
+            buff.address += numBytes;
+            buff.length -= numBytes;
+            this->setFrontBuffer(buff);
+            return;
+        }
+
+        _readyBuffs.pop_front();
+        if (_readyBuffs.empty()) this->setFrontBuffer(Pothos::BufferChunk::null());
+        else this->setFrontBuffer(_readyBuffs.front());
+    }
+
+    void push(const Pothos::ManagedBuffer &buff)
+    {
+        if (_readyBuffs.empty()) this->setFrontBuffer(buff);
+        assert(not _readyBuffs.full());
+        _readyBuffs.push_back(buff);
+    }
+
+private:
+    static const size_t GAP_SIZE = 64;
+    const Pothos::SharedBuffer _region;
+    Pothos::Util::RingDeque<Pothos::ManagedBuffer> _readyBuffs;
+};
+
+/***********************************************************************
+ * |PothosDoc Shared Memory Sink
+ *
+ * The shared memory sink accepts data on its input port and writes it
+ * into a shared memory ring that is read by a shared memory source
+ * in another process on the same host.
+ * All input port data is transported, which includes stream buffers, inline labels, and async messages.
+ *
+ * The sink provides the buffer manager for the upstream block,
+ * so that the upstream block produces directly into the shared memory
+ * and the stream buffers are transported without a copy.
+ * Other data is copied into the ring; data larger than a copy area
+ * of the ring is sent in fragments and reassembled by the source.
+ * The getFlowStats() call reports the bytes sent with and without a copy.
+ *
+ * The topology uses the shared memory sink and source automatically
+ * for flows between process environments on the same host.
+ *
+ * |category /Network
+ * |category /Sinks
+ * |keywords sink shared memory ipc
+ *
+ * |param capacity[Capacity] The size of the shared memory ring in bytes.
+ * |units bytes
+ * |default 4194304
+ *
+ * |factory /blocks/shared_memory_sink(capacity)
+ **********************************************************************/
+class SharedMemorySink : public Pothos::Block
+{
+public:
+    static Block *make(const size_t capacity)
+    {
+        return new SharedMemorySink(capacity);
+    }
+
+    SharedMemorySink(const size_t capacity):
+        _ring(PothosPacketSharedMemoryRing::create(capacity)),
+        _running(false),
+        _zeroCopyBytes(0),
+        _copiedBytes(0)
+    {
+        this->setupInput(0);
+        this->registerCall(this, POTHOS_FCN_TUPLE(SharedMemorySink, getRingName));
+        this->registerCall(this, POTHOS_FCN_TUPLE(SharedMemorySink, getFlowStats));
+    }
+
+    ~SharedMemorySink(void)
+    {
+        //the thread cannot be left running
+        if (_reaperThread.joinable())
+        {
+            _running = false;
+            _reaperThread.join();
+        }
+    }
+
+    std::string getRingName(void) const
+    {
+        return _ring->getName();
+    }
+
+    Poco::JSON::Object::Ptr getFlowStats(void) const
+    {
+        Poco::JSON::Object::Ptr stats(new Poco::JSON::Object());
+        stats->set("zeroCopyBytes", Poco::UInt64(_zeroCopyBytes));
+        stats->set("copiedBytes", Poco::UInt64(_copiedBytes));
+        return stats;
+    }
+
+    /*!
+     * The first upstream port produces into the stream region of the ring.
+     * The manager is only handed out once, other upstream ports
+     * and other memory domains use their own buffers and are copied.
+     */
+    Pothos::BufferManager::Sptr getInputBufferManager(const std::string &, const std::string &domain)
+    {
+        if (not domain.empty()) return Pothos::BufferManager::Sptr();
+        if (not _manager) _manager.reset(new SharedMemoryBufferManager(_ring->getStreamRegion()));
+        if (_manager->isInitialized()) return Pothos::BufferManager::Sptr();
+        return _manager;
+    }
+
+    void activate(void)
+    {
+        //start the thread that returns the released buffers to the upstream block
+        _running = true;
+        assert(not _reaperThread.joinable());
+        _reaperThread = std::thread(&SharedMemorySink::reapLoop, this);
+    }
+
+    void deactivate(void)
+    {
+        assert(_reaperThread.joinable());
+        _running = false;
+        _reaperThread.join();
+    }
+
+    void work(void);
+
+private:
+    void reapLoop(void)
+    {
+        while (_running) _ring->reap(std::chrono::milliseconds(100));
+    }
+
+    /*!
+     * Packets are queued until the ring has space,
+     * so that a message or label is never lost after it is popped.
+     */
+    void queuePacket(const uint16_t type, const uint64_t index, const Pothos::BufferChunk &data)
+    {
+        _pending.push_back(PendingPacket());
+        _pending.back().type = type;
+        _pending.back().index = index;
+        _pending.back().data = data;
+        _pending.back().offset = 0;
+    }
+
+    void queueObject(const uint16_t type, const uint64_t index, const Pothos::Object &obj)
+    {
+        std::ostringstream oss;
+        obj.serialize(oss);
+        const auto str = oss.str();
+        Pothos::BufferChunk data(str.size());
+        std::memcpy(data.as<void *>(), str.data(), str.size());
+        this->queuePacket(type, index, data);
+    }
+
+    void updateDType(const Pothos::DType &dtype)
+    {
+        if (_lastDtype == dtype) return;
+        this->queueObject(PothosPacketTypeDType, 0, Pothos::Object(dtype));
+        _lastDtype = dtype;
+    }
+
+    bool flushPending(const std::chrono::high_resolution_clock::duration &timeout);
+
+    struct PendingPacket
+    {
+        uint16_t type;
+        uint64_t index;
+        Pothos::BufferChunk data;
+        size_t offset; //bytes already sent as fragments
+    };
+
+    PothosPacketSharedMemoryRing::Sptr _ring;
+    std::shared_ptr<SharedMemoryBufferManager> _manager;
+    Pothos::DType _lastDtype;
+    std::deque<PendingPacket> _pending;
+    std::atomic<bool> _running;
+    std::thread _reaperThread;
+    std::atomic<unsigned long long> _zeroCopyBytes;
+    std::atomic<unsigned long long> _copiedBytes;
+};
+
+bool SharedMemorySink::flushPending(const std::chrono::high_resolution_clock::duration &timeout)
+{
+    while (not _pending.empty())
+    {
+        auto &packet = _pending.front();
+
+        //a payload in the stream region is sent without a copy
+        if (packet.offset == 0 and packet.data.length != 0 and _ring->isStreamBuffer(packet.data))
+        {
+            if (not _ring->sendBuffer(packet.type, packet.index, packet.data, timeout)) return false;
+            _zeroCopyBytes += packet.data.length;
+            _pending.pop_front();
+            continue;
+        }
+
+        //otherwise copy the packet, in fragments when larger than a copy area
+        const size_t numBytes = std::min(_ring->getMaxPayload(), packet.data.length - packet.offset);
+        const bool more = packet.offset + numBytes < packet.data.length;
+        if (not _ring->send(packet.type, packet.index, packet.data.as<const char *>() + packet.offset, numBytes, timeout, more)) return false;
+        if (packet.type == PothosPacketTypePayload) _copiedBytes += numBytes;
+        if (more) packet.offset += numBytes;
+        else _pending.pop_front();
+    }
+    return true;
+}
+
+void SharedMemorySink::work(void)
+{
+    const auto timeoutNanos = std::chrono::nanoseconds(this->workInfo().maxTimeoutNs);
+    const auto timeout = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(timeoutNanos);
+
+    auto inputPort = this->input(0);
+
+    //send the packets that did not fit in the ring last time
+    if (not this->flushPending(timeout)) return this->yield();
+
+    //serialize messages
+    while (inputPort->hasMessage())
+    {
+        const auto msg = inputPort->popMessage();
+
+        //special efficient packing for buffers in the packet
+        if (msg.type() == typeid(Pothos::Packet))
+        {
+            //extract packet and clear its payload (just send header)
+            auto packet = msg.extract<Pothos::Packet>();
+            const auto buffer = packet.payload;
+            packet.payload = Pothos::BufferChunk();
+            this->queueObject(PothosPacketTypeHeader, inputPort->totalMessages(), Pothos::Object(packet));
+            this->updateDType(buffer.dtype);
+            this->queuePacket(PothosPacketTypePayload, 0, buffer);
+        }
+
+        //arbitrary serialization
+        else this->queueObject(PothosPacketTypeMessage, inputPort->totalMessages(), msg);
+    }
+
+    //serialize labels (all labels are sent before buffers to ensure ordering at the destination)
+    while (inputPort->labels().begin() != inputPort->labels().end())
+    {
+        const auto &label = *inputPort->labels().begin();
+        this->queueObject(PothosPacketTypeLabel, label.index + inputPort->totalElements(), Pothos::Object(label));
+        inputPort->removeLabel(label);
+    }
+
+    //available buffer?
+    const auto &buffer = inputPort->buffer();
+    if (buffer.length != 0) this->updateDType(buffer.dtype);
+    if (not this->flushPending(timeout)) return this->yield();
+    if (buffer.length == 0) return;
+
+    //a buffer produced into the stream region is sent without a copy
+    if (_ring->isStreamBuffer(buffer))
+    {
+        if (not _ring->sendBuffer(PothosPacketTypeBuffer, inputPort->totalElements(), buffer, timeout)) return this->yield();
+        _zeroCopyBytes += buffer.length;
+        inputPort->consume(buffer.length);
+        return;
+    }
+
+    //otherwise copy up to one copy area of whole elements
+    const size_t elemSize = std::max<size_t>(1, buffer.dtype.size());
+    const size_t maxBytes = std::max(elemSize, (_ring->getMaxPayload()/elemSize)*elemSize);
+    const size_t numBytes = std::min(buffer.length, maxBytes);
+    if (not _ring->send(PothosPacketTypeBuffer, inputPort->totalElements(), buffer.as<const void *>(), numBytes, timeout)) return this->yield();
+    _copiedBytes += numBytes;
+    inputPort->consume(numBytes);
+}
+
+static Pothos::BlockRegistry registerSharedMemorySink(
+    "/blocks/shared_memory_sink", &SharedMemorySink::make);
@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "SharedMemoryRing.hpp"
+#include "SocketEndpoint.hpp"
+#include <Pothos/Framework.hpp>
+#include <cstring> //memcpy
+#include <sstream>
+#include <string>
+#include <chrono>
+
+/***********************************************************************
+ * |PothosDoc Shared Memory Source
+ *
+ * The shared memory source reads data from a shared memory ring
+ * written by a shared memory sink in another process on the same host,
+ * and produces the data on its output port.
+ * Stream buffers are produced zero-copy and reference the shared memory.
+ * Packets that the sink sent in fragments are reassembled before they are produced.
+ * Ring data encompasses stream buffers, inline labels, and async messages.
+ *
+ * |category /Network
+ * |category /Sources
+ * |keywords source shared memory ipc
+ *
+ * |param name[Name] The name of the ring from the shared memory sink.
+ * |default ""
+ *
+ * |factory /blocks/shared_memory_source(name)
+ **********************************************************************/
+class SharedMemorySource : public Pothos::Block
+{
+public:
+    static Block *make(const std::string &name)
+    {
+        return new SharedMemorySource(name);
+    }
+
+    SharedMemorySource(const std::string &name):
+        _ring(PothosPacketSharedMemoryRing::open(name)),
+        _nextExpectedIndex(0)
+    {
+        this->setupOutput(0);
+    }
+
+    void work(void);
+
+private:
+    PothosPacketSharedMemoryRing::Sptr _ring;
+    unsigned long long _nextExpectedIndex;
+    Pothos::DType _lastDtype;
+    Pothos::Packet _packetHeader;
+    std::string _fragments;
+};
+
+void SharedMemorySource::work(void)
+{
+    const auto timeoutNanos = std::chrono::nanoseconds(this->workInfo().maxTimeoutNs);
+    const auto timeout = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(timeoutNanos);
+
+    auto outputPort = this->output(0);
+
+    //recv the next packet, buffers reference the ring for zero-copy
+    uint16_t type;
+    uint64_t index;
+    Pothos::BufferChunk buffer;
+    bool more = false;
+    if (not _ring->recv(type, index, buffer, more, timeout)) return this->yield();
+
+    //accumulate fragments until the last fragment of the packet
+    if (more or not _fragments.empty())
+    {
+        _fragments.append(buffer.as<const char *>(), buffer.length);
+        if (more) return this->yield();
+        buffer = Pothos::BufferChunk(_fragments.size());
+        std::memcpy(buffer.as<void *>(), _fragments.data(), _fragments.size());
+        _fragments.clear();
+    }
+
+    //handle the output
+    if (type == PothosPacketTypeBuffer)
+    {
+        _nextExpectedIndex = index + buffer.length;
+        buffer.dtype = _lastDtype;
+        outputPort->postBuffer(buffer);
+    }
+    else if (type == PothosPacketTypeMessage)
+    {
+        std::istringstream iss(std::string(buffer.as<char *>(), buffer.length));
+        Pothos::Object msg;
+        msg.deserialize(iss);
+        outputPort->postMessage(msg);
+    }
+    else if (type == PothosPacketTypeHeader)
+    {
+        std::istringstream iss(std::string(buffer.as<char *>(), buffer.length));
+        Pothos::ObjectM msg; msg.deserialize(iss);
+        _packetHeader = msg.extract<Pothos::Packet>(); //store it, payload comes next
+    }
+    else if (type == PothosPacketTypePayload)
+    {
+        buffer.dtype = _lastDtype;
+        _packetHeader.payload = buffer;
+        outputPort->postMessage(_packetHeader);
+        _packetHeader = Pothos::Packet(); //clear local reference
+    }
+    else if (type == PothosPacketTypeLabel)
+    {
+        std::istringstream iss(std::string(buffer.as<char *>(), buffer.length));
+        Pothos::Object data;
+        data.deserialize(iss);
+        auto label = data.extract<Pothos::Label>();
+        label.index = index - _nextExpectedIndex;
+        outputPort->postLabel(label);
+    }
+    else if (type == PothosPacketTypeDType)
+    {
+        std::istringstream iss(std::string(buffer.as<char *>(), buffer.length));
+        Pothos::Object data;
+        data.deserialize(iss);
+        _lastDtype = data.extract<Pothos::DType>();
+    }
+
+    return this->yield(); //always yield to service recv() again
+}
+
+static Pothos::BlockRegistry registerSharedMemorySource(
+    "/blocks/shared_memory_source", &SharedMemorySource::make);
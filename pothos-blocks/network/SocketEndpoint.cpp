@@ -1,7 +1,8 @@
-// Copyright (c) 2014-2014 Josh Blum
+// Copyright (c) 2014-2015 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "SocketEndpoint.hpp"
+#include "DatagramTransport.hpp"
 #include <Pothos/Exception.hpp>
 #include <Poco/Foundation.h>
 #include <Poco/URI.h>
@@ -11,9 +12,20 @@
 #include <Poco/ByteOrder.h>
 #include <Poco/SingletonHolder.h>
 #include <mutex>
+#include <atomic>
 #include <udt.h>
 #include <cassert>
+#include <cstring> //memcpy
+#include <algorithm> //min
 #include <iostream>
+#include <stdexcept> //logic_error
+
+#ifdef POCO_OS_FAMILY_UNIX
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#endif
 
 /***********************************************************************
  * Ensure that the MSG_MORE flag exists:
@@ -27,6 +39,10 @@
 #define MSG_MORE 0
 #endif
 
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
 /***********************************************************************
  * Socket interface abstraction
  **********************************************************************/
@@ -40,6 +56,18 @@ struct PothosPacketSocketEndpointInterface
 
     virtual int send(const void *buff, const size_t length, const int flags = 0) = 0;
 
+    /*!
+     * Send from two buffers in order as if they were one.
+     * The default implementation sends one buffer at a time,
+     * implementations with a gather call send both in one call.
+     * \return the number of bytes sent from the concatenation
+     */
+    virtual int sendv(const void *buff0, const size_t length0, const void *buff1, const size_t length1, const int flags = 0)
+    {
+        if (length0 == 0) return this->send(buff1, length1, flags);
+        return this->send(buff0, length0, (length1 == 0)?flags:(flags | MSG_MORE));
+    }
+
     virtual int recv(void *buff, const size_t length, const int flags = 0) = 0;
 };
 
@@ -97,6 +125,28 @@ struct PothosPacketSocketEndpointInterfaceTcp : PothosPacketSocketEndpointInterf
         return clientSock.sendBytes(buff, int(length), flags);
     }
 
+    #ifdef POCO_OS_FAMILY_UNIX
+    int sendv(const void *buff0, const size_t length0, const void *buff1, const size_t length1, const int flags)
+    {
+        iovec iov[2];
+        iov[0].iov_base = const_cast<void *>(buff0);
+        iov[0].iov_len = length0;
+        iov[1].iov_base = const_cast<void *>(buff1);
+        iov[1].iov_len = length1;
+
+        msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = (length0 == 0)?(iov+1):iov;
+        msg.msg_iovlen = (length0 == 0 or length1 == 0)?1:2;
+
+        ssize_t ret = 0;
+        do ret = ::sendmsg(clientSock.impl()->sockfd(), &msg, flags | MSG_NOSIGNAL);
+        while (ret < 0 and errno == EINTR);
+        if (ret < 0) throw Pothos::RuntimeException("PothosPacketSocketEndpointInterfaceTcp::sendv()", std::strerror(errno));
+        return int(ret);
+    }
+    #endif
+
     int recv(void *buff, const size_t length, const int flags)
     {
         return clientSock.receiveBytes(buff, int(length), flags);
@@ -259,6 +309,7 @@ struct PothosPacketSocketEndpointInterfaceUdt : PothosPacketSocketEndpointInterf
     (uint32_t(str[3]) << 0)
 
 static const uint32_t PothosPacketHeaderWord = POTHOS_PACKET_WORD32("PTHS");
+static const uint32_t PothosPacketHeaderWordV2 = POTHOS_PACKET_WORD32("PTH2");
 
 #define PothosPacketFlagFin (1 << 0)
 #define PothosPacketFlagSyn (1 << 1)
@@ -266,7 +317,9 @@ static const uint32_t PothosPacketHeaderWord = POTHOS_PACKET_WORD32("PTHS");
 #define PothosPacketFlagPsh (1 << 3)
 #define PothosPacketFlagAck (1 << 4)
 #define PothosPacketFlagFlo (1 << 5)
+#define PothosPacketFlagWin (1 << 6)
 
+//! Version 1 header: the payload length is limited to 16 bits
 struct PothosPacketHeader
 {
     uint32_t headerWord;
@@ -277,6 +330,53 @@ struct PothosPacketHeader
     uint32_t indexWord[2];
 };
 
+/*!
+ * Version 2 header: the same size as version 1 with a 32-bit payload length.
+ * The header word identifies the version of every header on the wire,
+ * the flags and the type field always fit into 8 bits in practice.
+ */
+struct PothosPacketHeaderV2
+{
+    uint32_t headerWord;
+    uint8_t flags;
+    uint8_t type;
+    uint16_t packetCount;
+    uint32_t payloadBytes;
+    uint32_t indexWord[2];
+};
+
+static_assert(sizeof(PothosPacketHeader) == sizeof(PothosPacketHeaderV2), "header versions differ in size");
+
+/*!
+ * Capabilities are the payload of the SYN packets (version 2 and up).
+ * Version 1 endpoints ignore this payload and reply without one,
+ * so that both endpoints continue to use the version 1 header.
+ */
+struct PothosPacketCapabilities
+{
+    uint32_t version;
+    uint32_t maxFrameBytes;
+    uint32_t maxWindowBytes;
+};
+
+//! Version 3 adds the label batch and message batch frame types
+static const uint32_t PothosPacketVersion = 3;
+static const size_t PothosPacketMaxFrameBytesV1 = 0xffff;
+static const size_t PothosPacketDefaultMaxFrameBytes = 4*1024*1024;
+
+/***********************************************************************
+ * Flow control window parameters:
+ * The sender adapts its window to twice the bandwidth-delay product,
+ * measured as the rate that the receiver acknowledged bytes during
+ * one round trip, multiplied by the minimum observed round trip time.
+ * The sender announces the window with the Win flag (version 2 and up),
+ * and the receiver acknowledges every quarter of the announced window.
+ **********************************************************************/
+static const uint64_t PothosPacketMinWindowBytes = 256*1024;
+static const uint64_t PothosPacketDefaultMaxWindowBytes = 16*1024*1024;
+static const uint64_t PothosPacketLegacyAckIntervalBytes = PothosPacketMinWindowBytes/8;
+static const auto PothosPacketMinRttLifetime = std::chrono::seconds(10);
+
 /***********************************************************************
  * States for connection establishment and termination
  **********************************************************************/
@@ -305,9 +405,16 @@ struct PothosPacketSocketEndpoint::Impl
         lastSentPacketCount(0),
         nextRecvPacketCount(0),
         bytesLeftInStream(0),
-        iface(nullptr)
+        localVersion(PothosPacketVersion),
+        localMaxFrameBytes(PothosPacketDefaultMaxFrameBytes),
+        sendVersion(1),
+        sendMaxFrameBytes(PothosPacketMaxFrameBytesV1),
+        localMaxWindowBytes(PothosPacketDefaultMaxWindowBytes),
+        recvManagerBytes(0),
+        iface(nullptr),
+        datagram(nullptr)
     {
-        return;
+        this->resetFlowControl();
     }
 
     //state
@@ -323,21 +430,66 @@ struct PothosPacketSocketEndpoint::Impl
     uint64_t lastFlowMsgRecv;
     uint64_t lastFlowMsgSent;
 
+    //negotiated header version and frame size
+    uint32_t localVersion;
+    size_t localMaxFrameBytes;
+    uint32_t sendVersion;
+    size_t sendMaxFrameBytes;
+
+    //adaptive flow control, protected by the flow mutex
+    uint64_t localMaxWindowBytes;
+    uint64_t maxWindowBytes;
+    uint64_t windowBytes;
+    uint64_t announcedWindowBytes;
+    uint64_t ackIntervalBytes;
+    uint64_t acksSent;
+    uint64_t acksRecv;
+    bool probing;
+    uint64_t probeOffset;
+    uint64_t probeAcked;
+    std::chrono::high_resolution_clock::time_point probeTime;
+    double rttSeconds;
+    double rttMinSeconds;
+    std::chrono::high_resolution_clock::time_point rttMinExpiry;
+    double drainBytesPerSec;
+    bool stalled;
+    std::chrono::high_resolution_clock::time_point stallTime;
+    double stallSeconds;
+    std::chrono::high_resolution_clock::time_point openTime;
+    std::mutex flowMutex;
+
+    //optional pool for received payloads
+    std::shared_ptr<Pothos::BufferManager> recvManager;
+    size_t recvManagerBytes; //the size of one buffer from the manager
+    std::atomic<unsigned long long> recvPoolBuffers;
+    std::atomic<unsigned long long> recvAllocations;
+    Pothos::BufferChunk allocRecvBuffer(const size_t numBytes);
+
     PothosPacketSocketEndpointInterface *iface;
 
+    //the udp scheme replaces the stream protocol with datagrams
+    PothosDatagramTransport *datagram;
+
     void unpackHeader(const PothosPacketHeader &header, const size_t recvBytes, uint16_t &flags, uint16_t &type, uint64_t &index, size_t &payloadBytes);
+    void handleCapabilities(const Pothos::BufferChunk &buffer);
+    bool handleFlowAck(const uint64_t ackedBytes);
+    void resetFlowControl(void);
     void handleState(const uint16_t &flags);
     void send(const uint16_t flags)
     {
         return this->send(flags, 0, 0, nullptr, 0);
     }
-    void send(const uint16_t flags, const uint16_t type, const uint64_t &index, const void *buff, const size_t numBytes, const bool more = false);
-    void recv(uint16_t &flags, uint16_t &type, uint64_t &index, Pothos::BufferChunk &buffer, const std::chrono::high_resolution_clock::duration &timeout);
-
-    uint64_t flowControlWindowBytes(void) const
+    void sendSyn(const uint16_t flags)
     {
-        return 256*1024;
+        if (this->localVersion < 2) return this->send(flags);
+        PothosPacketCapabilities caps;
+        caps.version = Poco::ByteOrder::toNetwork(this->localVersion);
+        caps.maxFrameBytes = Poco::ByteOrder::toNetwork(uint32_t(this->localMaxFrameBytes));
+        caps.maxWindowBytes = Poco::ByteOrder::toNetwork(uint32_t(std::min<uint64_t>(this->localMaxWindowBytes, 0xffffffff)));
+        return this->send(flags, 0, 0, &caps, sizeof(caps));
     }
+    void send(const uint16_t flags, const uint16_t type, const uint64_t &index, const void *buff, const size_t numBytes, const bool more = false);
+    void recv(uint16_t &flags, uint16_t &type, uint64_t &index, Pothos::BufferChunk &buffer, const std::chrono::high_resolution_clock::duration &timeout);
 
     std::mutex sendMutex;
 };
@@ -355,6 +507,29 @@ PothosPacketSocketEndpoint::PothosPacketSocketEndpoint(const std::string &uri, c
     {
         Poco::URI uriObj(uri);
         const Poco::Net::SocketAddress addr(uriObj.getHost(), uriObj.getPort());
+
+        //optional transport settings from the query string
+        PothosDatagramOptions datagramOptions;
+        std::string query = uriObj.getQuery();
+        while (not query.empty())
+        {
+            const auto ampPos = query.find('&');
+            const auto param = query.substr(0, ampPos);
+            query = (ampPos == std::string::npos)?"":query.substr(ampPos+1);
+            const auto eqPos = param.find('=');
+            const auto key = param.substr(0, eqPos);
+            const auto value = (eqPos == std::string::npos)?"":param.substr(eqPos+1);
+            if (key == "version") _impl->localVersion = std::min<uint32_t>(std::stoul(value), PothosPacketVersion);
+            else if (key == "frame") _impl->localMaxFrameBytes = std::max<size_t>(std::stoul(value), PothosPacketMaxFrameBytesV1);
+            else if (key == "window") _impl->localMaxWindowBytes = std::max<uint64_t>(std::stoull(value), PothosPacketLegacyAckIntervalBytes);
+            else if (key == "mtu") datagramOptions.datagramBytes = std::stoul(value);
+            else if (key == "fec") datagramOptions.fecGroupSize = std::stoul(value);
+            else if (key == "sndbuf") datagramOptions.sendBufferBytes = std::stoi(value);
+            else if (key == "rcvbuf") datagramOptions.recvBufferBytes = std::stoi(value);
+            else if (key == "ttl") datagramOptions.multicastTTL = std::stoi(value);
+            else if (key == "iface") datagramOptions.multicastInterface = value;
+            else throw Pothos::InvalidArgumentException("PothosPacketSocketEndpoint("+uri+")", "unknown query parameter " + key);
+        }
         if (uriObj.getScheme() == "tcp" and opt == "BIND")
         {
             _impl->iface = new PothosPacketSocketEndpointInterfaceTcp(addr, true);
@@ -371,16 +546,24 @@ PothosPacketSocketEndpoint::PothosPacketSocketEndpoint(const std::string &uri, c
         {
             _impl->iface = new PothosPacketSocketEndpointInterfaceUdt(addr, false);
         }
+        else if (uriObj.getScheme() == "udp" and (opt == "BIND" or opt == "CONNECT"))
+        {
+            _impl->datagram = new PothosDatagramTransport(addr, opt == "BIND", datagramOptions);
+        }
         else
         {
             throw Pothos::InvalidArgumentException("PothosPacketSocketEndpoint("+uri+" -> "+opt+")",
-                "unknown URI scheme + opt combo, expects tcp/udp, CONNECT/BIND");
+                "unknown URI scheme + opt combo, expects tcp/udt/udp, CONNECT/BIND");
         }
     }
     catch (const Poco::Exception &ex)
     {
         throw Pothos::RuntimeException("PothosPacketSocketEndpoint("+uri+" -> "+opt+")", ex.displayText());
     }
+    catch (const std::logic_error &ex) //from parsing a query value
+    {
+        throw Pothos::InvalidArgumentException("PothosPacketSocketEndpoint("+uri+" -> "+opt+")", "bad query value: " + std::string(ex.what()));
+    }
 }
 
 PothosPacketSocketEndpoint::~PothosPacketSocketEndpoint(void)
@@ -394,18 +577,70 @@ PothosPacketSocketEndpoint::~PothosPacketSocketEndpoint(void)
         //failure OK, other endpoint may be destructed
     }
     delete _impl->iface;
+    delete _impl->datagram;
     delete _impl;
 }
 
 std::string PothosPacketSocketEndpoint::getActualPort(void) const
 {
+    if (_impl->datagram != nullptr) return _impl->datagram->getPort();
     return _impl->iface->getPort();
 }
 
 bool PothosPacketSocketEndpoint::isReady(void)
 {
-    return (_impl->state == EP_STATE_ESTABLISHED) and
-        (_impl->lastFlowMsgRecv + _impl->flowControlWindowBytes() > _impl->totalBytesSent);
+    if (_impl->state != EP_STATE_ESTABLISHED) return false;
+    if (_impl->datagram != nullptr) return true;
+
+    std::lock_guard<std::mutex> lock(_impl->flowMutex);
+    const bool ready = _impl->lastFlowMsgRecv + _impl->windowBytes > _impl->totalBytesSent;
+
+    //accumulate the time spent waiting on the remote to acknowledge
+    const auto now = std::chrono::high_resolution_clock::now();
+    if (not ready and not _impl->stalled) _impl->stallTime = now;
+    if (ready and _impl->stalled) _impl->stallSeconds += std::chrono::duration<double>(now - _impl->stallTime).count();
+    _impl->stalled = not ready;
+    return ready;
+}
+
+Poco::JSON::Object::Ptr PothosPacketSocketEndpoint::getFlowStats(void)
+{
+    std::lock_guard<std::mutex> lock(_impl->flowMutex);
+    const auto now = std::chrono::high_resolution_clock::now();
+    const double upTime = std::chrono::duration<double>(now - _impl->openTime).count();
+    double stallSeconds = _impl->stallSeconds;
+    if (_impl->stalled) stallSeconds += std::chrono::duration<double>(now - _impl->stallTime).count();
+
+    Poco::JSON::Object::Ptr stats(new Poco::JSON::Object());
+    stats->set("version", Poco::UInt32(_impl->sendVersion));
+    stats->set("maxFrameBytes", Poco::UInt64(_impl->sendMaxFrameBytes));
+    stats->set("windowBytes", Poco::UInt64(_impl->windowBytes));
+    stats->set("maxWindowBytes", Poco::UInt64(_impl->maxWindowBytes));
+    stats->set("ackIntervalBytes", Poco::UInt64(_impl->ackIntervalBytes));
+    stats->set("acksSent", Poco::UInt64(_impl->acksSent));
+    stats->set("acksReceived", Poco::UInt64(_impl->acksRecv));
+    stats->set("ackRate", (upTime > 0.0)?((_impl->acksSent + _impl->acksRecv)/upTime):0.0);
+    stats->set("rttSeconds", _impl->rttSeconds);
+    stats->set("rttMinSeconds", _impl->rttMinSeconds);
+    stats->set("drainBytesPerSec", _impl->drainBytesPerSec);
+    stats->set("stallSeconds", stallSeconds);
+    stats->set("recvPoolBuffers", Poco::UInt64(_impl->recvPoolBuffers.load()));
+    stats->set("recvAllocations", Poco::UInt64(_impl->recvAllocations.load()));
+    if (_impl->datagram != nullptr)
+    {
+        stats->set("datagramsSent", Poco::UInt64(_impl->datagram->getDatagramsSent()));
+        stats->set("datagramsReceived", Poco::UInt64(_impl->datagram->getDatagramsReceived()));
+        stats->set("datagramsLost", Poco::UInt64(_impl->datagram->getDatagramsLost()));
+        stats->set("datagramsRecovered", Poco::UInt64(_impl->datagram->getDatagramsRecovered()));
+        stats->set("framesDropped", Poco::UInt64(_impl->datagram->getFramesDropped()));
+    }
+    return stats;
+}
+
+unsigned long long PothosPacketSocketEndpoint::getDatagramsLost(void) const
+{
+    if (_impl->datagram == nullptr) return 0;
+    return _impl->datagram->getDatagramsLost();
 }
 
 /***********************************************************************
@@ -421,13 +656,25 @@ void PothosPacketSocketEndpoint::openComms(void)
     _impl->lastSentPacketCount = uint16_t(std::rand());
     _impl->totalBytesRecv = 0;
     _impl->totalBytesSent = 0;
-    _impl->lastFlowMsgRecv = 0;
     _impl->lastFlowMsgSent = 0;
+    _impl->resetFlowControl();
+
+    //datagrams have no handshake, the sender transmits whether or not anyone listens
+    if (_impl->datagram != nullptr)
+    {
+        _impl->datagram->reset();
+        _impl->state = EP_STATE_ESTABLISHED;
+        return;
+    }
+
+    //the version 1 header is used until the capabilities are exchanged
+    _impl->sendVersion = 1;
+    _impl->sendMaxFrameBytes = PothosPacketMaxFrameBytesV1;
 
     //initiate connect operation
     if (_impl->state == EP_STATE_CLOSED)
     {
-        _impl->send(PothosPacketFlagSyn);
+        _impl->sendSyn(PothosPacketFlagSyn);
         _impl->state = EP_STATE_SYN_SENT;
     }
 
@@ -454,6 +701,11 @@ void PothosPacketSocketEndpoint::openComms(void)
 void PothosPacketSocketEndpoint::closeComms(void)
 {
     if (_impl->state == EP_STATE_CLOSED) return;
+    if (_impl->datagram != nullptr)
+    {
+        _impl->state = EP_STATE_CLOSED;
+        return;
+    }
 
     Pothos::BufferChunk buffer(1024);
     uint16_t type;
@@ -503,7 +755,9 @@ void PothosPacketSocketEndpoint::Impl::handleState(const uint16_t &flags)
     case EP_STATE_LISTEN:
         if ((flags & PothosPacketFlagSyn) != 0)
         {
-            this->send(PothosPacketFlagSyn | PothosPacketFlagAck);
+            //reply with capabilities only when the remote offered them
+            if (this->sendVersion >= 2) this->sendSyn(PothosPacketFlagSyn | PothosPacketFlagAck);
+            else this->send(PothosPacketFlagSyn | PothosPacketFlagAck);
             this->state = EP_STATE_SYN_RECEIVED;
         }
         break;
@@ -516,7 +770,8 @@ void PothosPacketSocketEndpoint::Impl::handleState(const uint16_t &flags)
         }
         else if ((flags & PothosPacketFlagSyn) != 0)
         {
-            this->send(PothosPacketFlagSyn | PothosPacketFlagAck);
+            if (this->sendVersion >= 2) this->sendSyn(PothosPacketFlagSyn | PothosPacketFlagAck);
+            else this->send(PothosPacketFlagSyn | PothosPacketFlagAck);
             this->state = EP_STATE_SYN_RECEIVED;
         }
         break;
@@ -594,19 +849,34 @@ void PothosPacketSocketEndpoint::Impl::unpackHeader(const PothosPacketHeader &he
         throw Pothos::Exception("PothosPacketSocketEndpoint::unpackHeader()", "incomplete header");
     }
 
-    if (Poco::ByteOrder::fromNetwork(header.headerWord) != PothosPacketHeaderWord)
+    //extract header fields -- the header word selects the version
+    uint16_t recvPacketCount = 0;
+    const uint32_t headerWord = Poco::ByteOrder::fromNetwork(header.headerWord);
+    if (headerWord == PothosPacketHeaderWord)
+    {
+        flags = Poco::ByteOrder::fromNetwork(header.flags);
+        recvPacketCount = Poco::ByteOrder::fromNetwork(header.packetCount);
+        payloadBytes = Poco::ByteOrder::fromNetwork(header.payloadBytes);
+        type = Poco::ByteOrder::fromNetwork(header.type);
+        index = uint64_t(Poco::ByteOrder::fromNetwork(header.indexWord[1]));
+        index |= (uint64_t(Poco::ByteOrder::fromNetwork(header.indexWord[0])) << 32);
+    }
+    else if (headerWord == PothosPacketHeaderWordV2)
+    {
+        PothosPacketHeaderV2 headerV2;
+        std::memcpy(&headerV2, &header, sizeof(headerV2));
+        flags = headerV2.flags;
+        recvPacketCount = Poco::ByteOrder::fromNetwork(headerV2.packetCount);
+        payloadBytes = Poco::ByteOrder::fromNetwork(headerV2.payloadBytes);
+        type = headerV2.type;
+        index = uint64_t(Poco::ByteOrder::fromNetwork(headerV2.indexWord[1]));
+        index |= (uint64_t(Poco::ByteOrder::fromNetwork(headerV2.indexWord[0])) << 32);
+    }
+    else
     {
         throw Pothos::Exception("PothosPacketSocketEndpoint::unpackHeader()", "headerWord fail");
     }
 
-    //extract header fields
-    flags = Poco::ByteOrder::fromNetwork(header.flags);
-    const uint16_t recvPacketCount = Poco::ByteOrder::fromNetwork(header.packetCount);
-    payloadBytes = Poco::ByteOrder::fromNetwork(header.payloadBytes);
-    type = Poco::ByteOrder::fromNetwork(header.type);
-    index = uint64_t(Poco::ByteOrder::fromNetwork(header.indexWord[1]));
-    index |= (uint64_t(Poco::ByteOrder::fromNetwork(header.indexWord[0])) << 32);
-
     //when the sender is telling us to use a new sequence number
     if ((flags & PothosPacketFlagSyn) != 0) this->nextRecvPacketCount = recvPacketCount;
 
@@ -622,9 +892,137 @@ void PothosPacketSocketEndpoint::Impl::unpackHeader(const PothosPacketHeader &he
     //save header fields for partial recvs
     lastType = type;
     lastIndex = index;
+}
+
+/***********************************************************************
+ * negotiate the header version from the remote capabilities
+ **********************************************************************/
+void PothosPacketSocketEndpoint::Impl::handleCapabilities(const Pothos::BufferChunk &buffer)
+{
+    //a SYN without capabilities comes from a version 1 endpoint
+    this->sendVersion = 1;
+    this->sendMaxFrameBytes = PothosPacketMaxFrameBytesV1;
+    {
+        std::lock_guard<std::mutex> lock(this->flowMutex);
+        this->maxWindowBytes = this->localMaxWindowBytes;
+    }
+    if (buffer.length < sizeof(PothosPacketCapabilities)) return;
+
+    PothosPacketCapabilities caps;
+    std::memcpy(&caps, buffer.as<const void *>(), sizeof(caps));
+    const uint32_t remoteVersion = Poco::ByteOrder::fromNetwork(caps.version);
+    const size_t remoteMaxFrameBytes = Poco::ByteOrder::fromNetwork(caps.maxFrameBytes);
+    const uint64_t remoteMaxWindowBytes = Poco::ByteOrder::fromNetwork(caps.maxWindowBytes);
+
+    this->sendVersion = std::min(this->localVersion, remoteVersion);
+    if (this->sendVersion < 2) return;
+    this->sendMaxFrameBytes = std::max(PothosPacketMaxFrameBytesV1,
+        std::min(this->localMaxFrameBytes, remoteMaxFrameBytes));
+
+    std::lock_guard<std::mutex> lock(this->flowMutex);
+    this->maxWindowBytes = std::max(PothosPacketLegacyAckIntervalBytes,
+        std::min(this->localMaxWindowBytes, remoteMaxWindowBytes));
+    this->windowBytes = std::min(this->windowBytes, this->maxWindowBytes);
+}
 
-    //run the handler for the state machine
-    this->handleState(flags);
+/***********************************************************************
+ * adaptive flow control
+ **********************************************************************/
+void PothosPacketSocketEndpoint::Impl::resetFlowControl(void)
+{
+    std::lock_guard<std::mutex> lock(this->flowMutex);
+    this->lastFlowMsgRecv = 0;
+    this->maxWindowBytes = this->localMaxWindowBytes;
+    this->windowBytes = std::min(PothosPacketMinWindowBytes, this->maxWindowBytes);
+    this->announcedWindowBytes = 0;
+    this->ackIntervalBytes = PothosPacketLegacyAckIntervalBytes;
+    this->acksSent = 0;
+    this->acksRecv = 0;
+    this->probing = false;
+    this->rttSeconds = 0.0;
+    this->rttMinSeconds = 0.0;
+    this->drainBytesPerSec = 0.0;
+    this->stalled = false;
+    this->stallSeconds = 0.0;
+    this->openTime = std::chrono::high_resolution_clock::now();
+    this->recvPoolBuffers = 0;
+    this->recvAllocations = 0;
+}
+
+bool PothosPacketSocketEndpoint::Impl::handleFlowAck(const uint64_t ackedBytes)
+{
+    const auto now = std::chrono::high_resolution_clock::now();
+    std::lock_guard<std::mutex> lock(this->flowMutex);
+    this->acksRecv++;
+    this->lastFlowMsgRecv = ackedBytes;
+
+    //the probe completes when the remote acknowledges the probe offset
+    if (not this->probing or ackedBytes < this->probeOffset) return false;
+    this->probing = false;
+    const double rtt = std::chrono::duration<double>(now - this->probeTime).count();
+    if (rtt <= 0.0) return false;
+
+    //the smoothed rtt is for reporting, the window follows the minimum rtt
+    this->rttSeconds = (this->rttSeconds == 0.0)?rtt:((7*this->rttSeconds + rtt)/8);
+    if (this->rttMinSeconds == 0.0 or rtt < this->rttMinSeconds or now > this->rttMinExpiry)
+    {
+        this->rttMinSeconds = rtt;
+        this->rttMinExpiry = now + PothosPacketMinRttLifetime;
+    }
+
+    //the rate that the remote consumed bytes over the last round trip
+    this->drainBytesPerSec = (ackedBytes - this->probeAcked)/rtt;
+    const auto target = uint64_t(2*this->drainBytesPerSec*this->rttMinSeconds);
+    const auto minWindow = std::min(PothosPacketMinWindowBytes, this->maxWindowBytes);
+    this->windowBytes = std::max(minWindow, std::min(target, this->maxWindowBytes));
+
+    //announce when the window moves an eighth from the last announcement
+    const auto delta = std::max(this->windowBytes, this->announcedWindowBytes) - std::min(this->windowBytes, this->announcedWindowBytes);
+    if (delta <= this->announcedWindowBytes/8) return false;
+    this->announcedWindowBytes = this->windowBytes;
+    return true;
+}
+
+/***********************************************************************
+ * buffers for received payloads
+ **********************************************************************/
+void PothosPacketSocketEndpoint::setRecvBufferManager(const std::shared_ptr<Pothos::BufferManager> &manager)
+{
+    _impl->recvManager = manager;
+    _impl->recvManagerBytes = (manager and not manager->empty())?manager->front().length:0;
+}
+
+size_t PothosPacketSocketEndpoint::getMaxFrameBytes(void) const
+{
+    if (_impl->datagram != nullptr) return _impl->datagram->getMaxPayloadBytes();
+    return _impl->sendMaxFrameBytes;
+}
+
+uint32_t PothosPacketSocketEndpoint::getVersion(void) const
+{
+    if (_impl->datagram != nullptr) return PothosPacketVersion;
+    return _impl->sendVersion;
+}
+
+Pothos::BufferChunk PothosPacketSocketEndpoint::Impl::allocRecvBuffer(const size_t numBytes)
+{
+    //a payload larger than one buffer of the pool never fits, leave the pool for smaller payloads
+    auto &manager = this->recvManager;
+    if (manager and numBytes <= this->recvManagerBytes)
+    {
+        //skip the tail of the front buffer when the payload does not fit
+        if (not manager->empty() and manager->front().length < numBytes) manager->pop(manager->front().length);
+        if (not manager->empty() and manager->front().length >= numBytes)
+        {
+            auto buffer = manager->front();
+            buffer.length = numBytes;
+            manager->pop(numBytes);
+            this->recvPoolBuffers++;
+            return buffer;
+        }
+    }
+    this->recvAllocations++;
+    return Pothos::BufferChunk(numBytes);
 }
 
 /***********************************************************************
@@ -632,6 +1030,12 @@ void PothosPacketSocketEndpoint::Impl::unpackHeader(const PothosPacketHeader &he
  **********************************************************************/
 void PothosPacketSocketEndpoint::recv(uint16_t &type, uint64_t &index, Pothos::BufferChunk &buffer, const std::chrono::high_resolution_clock::duration &timeout)
 {
+    if (_impl->datagram != nullptr)
+    {
+        Impl *impl = _impl;
+        return _impl->datagram->recv(type, index, buffer, timeout,
+            [impl](const size_t numBytes){return impl->allocRecvBuffer(numBytes);});
+    }
     uint16_t flags = 0;
     return _impl->recv(flags, type, index, buffer, timeout);
 }
@@ -646,9 +1050,10 @@ void PothosPacketSocketEndpoint::Impl::recv(uint16_t &flags, uint16_t &type, uin
 
     int ret;
     PothosPacketHeader header;
+    const bool newHeader = this->bytesLeftInStream == 0;
 
     //no bytes left in stream, receive a new header
-    if (this->bytesLeftInStream == 0)
+    if (newHeader)
     {
         //receive the header
         ret = this->iface->recv(&header, sizeof(header), MSG_WAITALL);
@@ -663,9 +1068,13 @@ void PothosPacketSocketEndpoint::Impl::recv(uint16_t &flags, uint16_t &type, uin
 
         //create a new buffer of the required length if need be
         //partial receives are always ok with packet buffer type
+        if (type != PothosPacketTypeBuffer and this->bytesLeftInStream > this->localMaxFrameBytes)
+        {
+            throw Pothos::Exception("PothosPacketSocketEndpoint::recv(header)", "frame exceeds maximum");
+        }
         if (type != PothosPacketTypeBuffer and buffer.length < this->bytesLeftInStream)
         {
-            buffer = Pothos::BufferChunk(this->bytesLeftInStream);
+            buffer = this->allocRecvBuffer(this->bytesLeftInStream);
         }
     }
 
@@ -693,17 +1102,40 @@ void PothosPacketSocketEndpoint::Impl::recv(uint16_t &flags, uint16_t &type, uin
 
     this->bytesLeftInStream -= buffer.length;
 
+    //the remainder of a partially received stream buffer continues its index
+    if (type == PothosPacketTypeBuffer) this->lastIndex = index + buffer.length;
+
+    //run the handler for the state machine once the payload is in
+    if (newHeader)
+    {
+        if ((flags & PothosPacketFlagSyn) != 0) this->handleCapabilities(buffer);
+        this->handleState(flags);
+    }
+
     //deal with flow control (incoming)
     if ((flags & PothosPacketFlagFlo) != 0)
     {
-        this->lastFlowMsgRecv = index;
+        //announce the new window outside of the flow lock
+        if (this->handleFlowAck(index) and this->sendVersion >= 2)
+        {
+            this->send(PothosPacketFlagWin, 0, this->announcedWindowBytes, nullptr, 0);
+        }
+    }
+
+    //the remote announced its window, acknowledge every quarter of it
+    if ((flags & PothosPacketFlagWin) != 0)
+    {
+        std::lock_guard<std::mutex> lock(this->flowMutex);
+        this->ackIntervalBytes = std::max(PothosPacketLegacyAckIntervalBytes, index/4);
     }
 
     //deal with flow control (outgoing)
-    if (this->totalBytesRecv > this->lastFlowMsgSent + this->flowControlWindowBytes()/8)
+    if (this->totalBytesRecv > this->lastFlowMsgSent + this->ackIntervalBytes)
     {
         this->send(PothosPacketFlagFlo, 0, this->totalBytesRecv, nullptr, 0);
         this->lastFlowMsgSent = this->totalBytesRecv;
+        std::lock_guard<std::mutex> lock(this->flowMutex);
+        this->acksSent++;
     }
 }
 
@@ -712,6 +1144,7 @@ void PothosPacketSocketEndpoint::Impl::recv(uint16_t &flags, uint16_t &type, uin
  **********************************************************************/
 void PothosPacketSocketEndpoint::send(const uint16_t type, const uint64_t &index, const void *buff, const size_t numBytes, const bool more)
 {
+    if (_impl->datagram != nullptr) return _impl->datagram->send(type, index, buff, numBytes);
     _impl->send(PothosPacketFlagPsh, type, index, buff, numBytes, more);
 }
 
@@ -719,34 +1152,72 @@ void PothosPacketSocketEndpoint::Impl::send(const uint16_t flags, const uint16_t
 {
     std::unique_lock<std::mutex> lock(this->sendMutex);
 
-    int ret;
-    PothosPacketHeader header;
-    header.headerWord = Poco::ByteOrder::toNetwork(PothosPacketHeaderWord);
-    header.flags = Poco::ByteOrder::toNetwork(flags);
-    header.payloadBytes = Poco::ByteOrder::toNetwork(uint16_t(numBytes));
-    header.packetCount = Poco::ByteOrder::toNetwork(uint16_t(this->lastSentPacketCount++));
-    header.type = Poco::ByteOrder::toNetwork(type);
-    header.indexWord[0] = Poco::ByteOrder::toNetwork(uint32_t(index >> 32));
-    header.indexWord[1] = Poco::ByteOrder::toNetwork(uint32_t(index >> 0));
-
-    //send the header
-    ret = this->iface->send(&header, sizeof(header), more?MSG_MORE:((numBytes==0)?0:MSG_MORE));
-    if (ret != int(sizeof(header)))
+    //only stream buffers can be split across frames, each frame indexes its first byte
+    if (type != PothosPacketTypeBuffer and numBytes > this->sendMaxFrameBytes)
     {
-        throw Pothos::Exception("PothosPacketSocketEndpoint::send(header)", std::to_string(ret));
+        throw Pothos::RangeException("PothosPacketSocketEndpoint::send()", Poco::format(
+            "%z bytes exceeds the maximum frame of %z bytes", numBytes, this->sendMaxFrameBytes));
     }
-    this->totalBytesSent += ret;
 
-    //send all of the available buffer
-    size_t bytesLeft = numBytes;
-    while (bytesLeft != 0)
+    size_t offset = 0;
+    do
     {
-        ret = this->iface->send((const void *)(size_t(buff)+numBytes-bytesLeft), bytesLeft, more?MSG_MORE:0);
-        if (ret <= 0)
+        const size_t frameBytes = std::min(numBytes-offset, this->sendMaxFrameBytes);
+        const bool moreFrames = offset + frameBytes < numBytes;
+        const uint64_t frameIndex = (type == PothosPacketTypeBuffer)?(index + offset):index;
+
+        //both header versions have the same size
+        PothosPacketHeader header;
+        if (this->sendVersion >= 2)
         {
-            throw Pothos::Exception("PothosPacketSocketEndpoint::send(payload)", std::to_string(ret));
+            PothosPacketHeaderV2 headerV2;
+            headerV2.headerWord = Poco::ByteOrder::toNetwork(PothosPacketHeaderWordV2);
+            headerV2.flags = uint8_t(flags);
+            headerV2.type = uint8_t(type);
+            headerV2.packetCount = Poco::ByteOrder::toNetwork(uint16_t(this->lastSentPacketCount++));
+            headerV2.payloadBytes = Poco::ByteOrder::toNetwork(uint32_t(frameBytes));
+            headerV2.indexWord[0] = Poco::ByteOrder::toNetwork(uint32_t(frameIndex >> 32));
+            headerV2.indexWord[1] = Poco::ByteOrder::toNetwork(uint32_t(frameIndex >> 0));
+            std::memcpy(&header, &headerV2, sizeof(header));
         }
-        this->totalBytesSent += ret;
-        bytesLeft -= size_t(ret);
-    }
+        else
+        {
+            header.headerWord = Poco::ByteOrder::toNetwork(PothosPacketHeaderWord);
+            header.flags = Poco::ByteOrder::toNetwork(flags);
+            header.payloadBytes = Poco::ByteOrder::toNetwork(uint16_t(frameBytes));
+            header.packetCount = Poco::ByteOrder::toNetwork(uint16_t(this->lastSentPacketCount++));
+            header.type = Poco::ByteOrder::toNetwork(type);
+            header.indexWord[0] = Poco::ByteOrder::toNetwork(uint32_t(frameIndex >> 32));
+            header.indexWord[1] = Poco::ByteOrder::toNetwork(uint32_t(frameIndex >> 0));
+        }
+
+        //send the header and the payload together
+        const char *payload = reinterpret_cast<const char *>(buff) + offset;
+        size_t headerLeft = sizeof(header);
+        size_t payloadLeft = frameBytes;
+        while (headerLeft + payloadLeft != 0)
+        {
+            const int ret = this->iface->sendv(
+                reinterpret_cast<const char *>(&header) + sizeof(header) - headerLeft, headerLeft,
+                payload + frameBytes - payloadLeft, payloadLeft, (more or moreFrames)?MSG_MORE:0);
+            if (ret <= 0)
+            {
+                throw Pothos::Exception("PothosPacketSocketEndpoint::send()", std::to_string(ret));
+            }
+            this->totalBytesSent += ret;
+            const size_t headerSent = std::min(size_t(ret), headerLeft);
+            headerLeft -= headerSent;
+            payloadLeft -= size_t(ret) - headerSent;
+        }
+        offset += frameBytes;
+    } while (offset < numBytes);
+
+    //time the round trip of the data just sent when no probe is outstanding
+    if ((flags & PothosPacketFlagPsh) == 0) return;
+    std::lock_guard<std::mutex> flowLock(this->flowMutex);
+    if (this->probing) return;
+    this->probing = true;
+    this->probeOffset = this->totalBytesSent;
+    this->probeAcked = this->lastFlowMsgRecv;
+    this->probeTime = std::chrono::high_resolution_clock::now();
 }
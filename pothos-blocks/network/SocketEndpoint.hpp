@@ -6,6 +6,8 @@
 #pragma once
 #include <Pothos/Config.hpp>
 #include <Pothos/Framework/BufferChunk.hpp>
+#include <Pothos/Framework/BufferManager.hpp>
+#include <Poco/JSON/Object.h>
 #include <chrono>
 #include <cstdint>
 
@@ -15,6 +17,8 @@ static const uint16_t PothosPacketTypeBuffer = uint16_t('B');
 static const uint16_t PothosPacketTypeDType = uint16_t('D');
 static const uint16_t PothosPacketTypeHeader = uint16_t('H');
 static const uint16_t PothosPacketTypePayload = uint16_t('P');
+static const uint16_t PothosPacketTypeLabels = uint16_t('l');
+static const uint16_t PothosPacketTypeMessages = uint16_t('m');
 
 class PothosPacketSocketEndpoint
 {
@@ -24,7 +28,15 @@ public:
      * Create a new socket endpoint.
      * For the URI scheme, the protocol can be udp or tcp.
      * Do not specify the port for automatic port selection on BIND.
-     * \param uri the socket parameters proto://host:port
+     * Query parameters configure the transport:
+     * version=1 to use the legacy 16-bit length header,
+     * frame=bytes for the largest frame that will be sent or received,
+     * window=bytes for the upper bound of the flow control window.
+     * The udp scheme sends datagrams without a handshake or flow control:
+     * mtu=bytes for the datagram size, fec=N for one parity datagram
+     * every N datagrams, sndbuf=bytes and rcvbuf=bytes for the socket
+     * buffers, iface=address and ttl=hops for multicast groups.
+     * \param uri the socket parameters proto://host:port[?query]
      * \param opt the socket mode BIND or CONNECT
      */
     PothosPacketSocketEndpoint(const std::string &uri, const std::string &opt);
@@ -56,6 +68,42 @@ public:
      */
     bool isReady(void);
 
+    /*!
+     * Get the flow control statistics of this endpoint:
+     * the negotiated header version and maximum frame size, the live window, acknowledgment interval and rate,
+     * round trip times, drain rate, and time spent stalled,
+     * and the counts of pooled and allocated receive buffers.
+     */
+    Poco::JSON::Object::Ptr getFlowStats(void);
+
+    /*!
+     * Get the number of datagrams lost since openComms().
+     * Always zero for the stream oriented schemes.
+     */
+    unsigned long long getDatagramsLost(void) const;
+
+    /*!
+     * Get the negotiated maximum frame size in bytes.
+     * Valid once openComms() has completed the handshake.
+     */
+    size_t getMaxFrameBytes(void) const;
+
+    /*!
+     * Get the negotiated protocol version.
+     * Version 3 and up understand label and message batches.
+     * Valid once openComms() has completed the handshake.
+     */
+    uint32_t getVersion(void) const;
+
+    /*!
+     * Set a buffer manager for received payloads.
+     * Payloads that do not fit the buffer passed to recv()
+     * are received directly into buffers from this manager;
+     * without a manager or when it is empty, buffers are allocated.
+     * The caller is responsible for the buffer returns to the manager.
+     */
+    void setRecvBufferManager(const std::shared_ptr<Pothos::BufferManager> &manager);
+
     /*!
      * Receive data from the remote endpoint.
      */
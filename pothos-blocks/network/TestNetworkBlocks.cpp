@@ -4,25 +4,42 @@
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
+#include <Pothos/Plugin.hpp>
 #include <Poco/Format.h>
 #include <Poco/JSON/Object.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/StreamSocket.h>
+#include <Poco/Net/DatagramSocket.h>
+#include <Pothos/Util/MPSCQueue.hpp>
+#include "SocketEndpoint.hpp"
+#include "PacketBatch.hpp"
 #include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <sstream>
+#include <cstring> //memcmp
 
-static void network_test_harness(const std::string &scheme, const bool serverIsSource)
+static void network_test_harness(const std::string &scheme, const bool serverIsSource, const std::string &query = "")
 {
     std::cout << Poco::format("network_test_harness: %s:// (serverIsSource? %s)",
         scheme, std::string(serverIsSource?"true":"false")) << std::endl;
     auto env = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
 
     //create server
-    auto server_uri = Poco::format("%s://0.0.0.0", scheme);
+    auto server_uri = Poco::format("%s://0.0.0.0%s", scheme, query);
     std::cout << "make server " << server_uri << std::endl;
     auto server = env.callProxy(
         (serverIsSource)?"/blocks/network_source":"/blocks/network_sink",
         server_uri, "BIND");
 
     //create client
-    auto client_uri = Poco::format("%s://localhost:%s", scheme, server.call<std::string>("getActualPort"));
+    auto client_uri = Poco::format("%s://localhost:%s%s", scheme, server.call<std::string>("getActualPort"), query);
     std::cout << "make client " << client_uri << std::endl;
     auto client = env.callProxy(
         (serverIsSource)?"/blocks/network_sink":"/blocks/network_source",
@@ -78,18 +95,22 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_network_blocks)
 {
     network_test_harness("tcp", true);
     network_test_harness("tcp", false);
+    //a version 2 remote receives labels and messages one frame each
+    network_test_harness("tcp", true, "?version=2");
+    //udp receives on the bound port, a large socket buffer avoids drops
+    network_test_harness("udp", true, "?rcvbuf=4194304");
     //network_test_harness("udt", true);
     //network_test_harness("udt", false);
 }
 
-POTHOS_TEST_BLOCK("/blocks/tests", test_network_packet_message)
+static void network_packet_harness(const std::string &scheme, const std::string &query = "")
 {
     auto env = Pothos::ProxyEnvironment::make("managed");
     auto registry = env->findProxy("Pothos/BlockRegistry");
 
     //network blocks
-    auto source = registry.callProxy("/blocks/network_source", "tcp://0.0.0.0", "BIND");
-    auto client_uri = Poco::format("tcp://localhost:%s", source.call<std::string>("getActualPort"));
+    auto source = registry.callProxy("/blocks/network_source", Poco::format("%s://0.0.0.0%s", scheme, query), "BIND");
+    auto client_uri = Poco::format("%s://localhost:%s%s", scheme, source.call<std::string>("getActualPort"), query);
     auto sink = registry.callProxy("/blocks/network_sink", client_uri, "CONNECT");
 
     //tester blocks
@@ -98,15 +119,17 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_network_packet_message)
     auto s2p = registry.callProxy("/blocks/stream_to_packet");
     auto p2s = registry.callProxy("/blocks/packet_to_stream");
 
-    //create a test plan
+    //create a test plan, the payloads span several datagrams
     Poco::JSON::Object::Ptr testPlan(new Poco::JSON::Object());
     testPlan->set("enableBuffers", true);
     testPlan->set("enableLabels", true);
     testPlan->set("enableMessages", true);
+    testPlan->set("minSize", 1000);
+    testPlan->set("maxSize", 4000);
     auto expected = feeder.callProxy("feedTestPlan", testPlan);
 
     //create tester topology
-    std::cout << "Basic message test" << std::endl;
+    std::cout << "Basic message test " << scheme << std::endl;
     {
         Pothos::Topology topology;
         topology.connect(feeder, 0, s2p, 0);
@@ -120,3 +143,751 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_network_packet_message)
     std::cout << "verifyTestPlan" << std::endl;
     collector.callVoid("verifyTestPlan", expected);
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_packet_message)
+{
+    network_packet_harness("tcp");
+    //packet headers and payloads larger than a datagram are fragmented
+    network_packet_harness("udp", "?rcvbuf=4194304");
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_message_batch)
+{
+    auto env = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+    auto source = env.callProxy("/blocks/network_source", "tcp://0.0.0.0", "BIND");
+    auto sink = env.callProxy("/blocks/network_sink", Poco::format("tcp://localhost:%s", source.call<std::string>("getActualPort")), "CONNECT");
+    sink.callVoid("setMessageLatency", 0.005);
+
+    auto feeder = env.callProxy("/blocks/feeder_source", "int");
+    auto collector = env.callProxy("/blocks/collector_sink", "int");
+
+    //messages held open for later messages arrive in order
+    Poco::JSON::Object::Ptr testPlan(new Poco::JSON::Object());
+    testPlan->set("enableMessages", true);
+    testPlan->set("minTrials", 100);
+    testPlan->set("maxTrials", 200);
+    auto expected = feeder.callProxy("feedTestPlan", testPlan);
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, sink, 0);
+        topology.connect(source, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    collector.callVoid("verifyTestPlan", expected);
+
+    //a message larger than the frame is split across batch frames
+    auto partsSource = env.callProxy("/blocks/network_source", "tcp://0.0.0.0", "BIND");
+    auto partsSink = env.callProxy("/blocks/network_sink", Poco::format("tcp://localhost:%s?frame=65535", partsSource.call<std::string>("getActualPort")), "CONNECT");
+    auto partsFeeder = env.callProxy("/blocks/feeder_source", "int");
+    auto partsCollector = env.callProxy("/blocks/collector_sink", "int");
+    const std::string message(200000, 'm');
+    partsFeeder.callProxy("feedMessage", Pothos::Object(std::string("before")));
+    partsFeeder.callProxy("feedMessage", Pothos::Object(message));
+    partsFeeder.callProxy("feedMessage", Pothos::Object(std::string("after")));
+
+    {
+        Pothos::Topology topology;
+        topology.connect(partsFeeder, 0, partsSink, 0);
+        topology.connect(partsSource, 0, partsCollector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    auto msgs = partsCollector.call<std::vector<Pothos::Object>>("getMessages");
+    POTHOS_TEST_EQUAL(msgs.size(), 3);
+    POTHOS_TEST_EQUAL(msgs[0].extract<std::string>(), "before");
+    POTHOS_TEST_EQUAL(msgs[1].extract<std::string>(), message);
+    POTHOS_TEST_EQUAL(msgs[2].extract<std::string>(), "after");
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_label_batch)
+{
+    std::vector<Pothos::Label> labels;
+    labels.push_back(Pothos::Label("null", Pothos::Object(), 0));
+    labels.push_back(Pothos::Label("bool", true, 1));
+    labels.push_back(Pothos::Label("char", char(-3), 2));
+    labels.push_back(Pothos::Label("int", int(-123456), 3, 4));
+    labels.push_back(Pothos::Label("uint", (unsigned int)(4000000000u), 100));
+    labels.push_back(Pothos::Label("rxTime", (long long)(-1234567890123456789ll), 1000));
+    labels.push_back(Pothos::Label("ull", (unsigned long long)(18000000000000000000ull), 1ull << 40));
+    labels.push_back(Pothos::Label("float", 1.5f, 5));
+    labels.push_back(Pothos::Label("double", -0.125, 6));
+    labels.push_back(Pothos::Label("string", std::string("hello"), 7));
+    labels.push_back(Pothos::Label("dtype", Pothos::DType("complex_float32"), 8));
+
+    std::string batch;
+    for (const auto &label : labels) PothosPacketAppendLabel(batch, label);
+
+    //the encoding of the common scalar types is compact
+    std::ostringstream oss;
+    Pothos::Object(labels.at(5)).serialize(oss);
+    std::string record;
+    PothosPacketAppendLabel(record, labels.at(5));
+    std::cout << "  rxTime label: " << record.size() << " bytes, " << oss.str().size() << " bytes serialized" << std::endl;
+    POTHOS_TEST_TRUE(record.size() < 32);
+
+    //the labels decode with the same ids, indexes, widths, and data types
+    const auto decoded = PothosPacketUnpackLabels(batch.data(), batch.size());
+    POTHOS_TEST_EQUAL(decoded.size(), labels.size());
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+        POTHOS_TEST_EQUAL(decoded[i].id, labels[i].id);
+        POTHOS_TEST_EQUAL(decoded[i].index, labels[i].index);
+        POTHOS_TEST_EQUAL(decoded[i].width, labels[i].width);
+        POTHOS_TEST_TRUE(decoded[i].data.type() == labels[i].data.type());
+        POTHOS_TEST_EQUAL(decoded[i].data.toString(), labels[i].data.toString());
+    }
+
+    //a truncated batch is rejected
+    POTHOS_TEST_THROWS(PothosPacketUnpackLabels(batch.data(), batch.size()-1), Pothos::DataFormatException);
+
+    //messages decode in order
+    std::string messages;
+    PothosPacketAppendMessage(messages, Pothos::Object(std::string("first")));
+    PothosPacketAppendMessage(messages, Pothos::Object(int(2)));
+    const auto msgs = PothosPacketUnpackMessages(messages.data(), messages.size());
+    POTHOS_TEST_EQUAL(msgs.size(), 2);
+    POTHOS_TEST_EQUAL(msgs[0].extract<std::string>(), "first");
+    POTHOS_TEST_EQUAL(msgs[1].extract<int>(), 2);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_shared_memory_blocks)
+{
+    auto env = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+    auto feeder = env.callProxy("/blocks/feeder_source", "int");
+    auto collector = env.callProxy("/blocks/collector_sink", "int");
+
+    //a small ring so that the stream wraps and applies back-pressure
+    auto sink = env.callProxy("/blocks/shared_memory_sink", 1024*1024);
+    auto source = env.callProxy("/blocks/shared_memory_source", sink.call<std::string>("getRingName"));
+
+    //create a test plan
+    Poco::JSON::Object::Ptr testPlan(new Poco::JSON::Object());
+    testPlan->set("enableBuffers", true);
+    testPlan->set("enableLabels", true);
+    testPlan->set("enableMessages", true);
+    testPlan->set("minTrials", 100);
+    testPlan->set("maxTrials", 200);
+    testPlan->set("minSize", 1000);
+    testPlan->set("maxSize", 20000);
+    auto expected = feeder.callProxy("feedTestPlan", testPlan);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, sink, 0);
+        topology.connect(source, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    collector.callVoid("verifyTestPlan", expected);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_shared_memory_zero_copy)
+{
+    auto env = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+    auto feeder = env.callProxy("/blocks/feeder_source", "int");
+    auto copier = env.callProxy("/blocks/copier");
+    auto collector = env.callProxy("/blocks/collector_sink", "int");
+    auto sink = env.callProxy("/blocks/shared_memory_sink", 1024*1024);
+    auto source = env.callProxy("/blocks/shared_memory_source", sink.call<std::string>("getRingName"));
+
+    //create a test plan
+    Poco::JSON::Object::Ptr testPlan(new Poco::JSON::Object());
+    testPlan->set("enableBuffers", true);
+    testPlan->set("enableLabels", true);
+    testPlan->set("minTrials", 100);
+    testPlan->set("maxTrials", 200);
+    testPlan->set("minSize", 1000);
+    testPlan->set("maxSize", 20000);
+    auto expected = feeder.callProxy("feedTestPlan", testPlan);
+
+    //the copier produces into the ring, so the stream is sent without a copy
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, copier, 0);
+        topology.connect(copier, 0, sink, 0);
+        topology.connect(source, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    collector.callVoid("verifyTestPlan", expected);
+    auto stats = sink.call<Poco::JSON::Object::Ptr>("getFlowStats");
+    std::cout << "zeroCopyBytes " << stats->getValue<Poco::UInt64>("zeroCopyBytes") << std::endl;
+    std::cout << "copiedBytes " << stats->getValue<Poco::UInt64>("copiedBytes") << std::endl;
+    POTHOS_TEST_TRUE(stats->getValue<Poco::UInt64>("zeroCopyBytes") > 0);
+    POTHOS_TEST_EQUAL(stats->getValue<Poco::UInt64>("copiedBytes"), 0);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_shared_memory_fragments)
+{
+    auto env = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+    auto feeder = env.callProxy("/blocks/feeder_source", "uint8");
+    auto collector = env.callProxy("/blocks/collector_sink", "uint8");
+
+    //a 1 MiB ring has 8 KiB copy areas, the data below is several times larger
+    auto sink = env.callProxy("/blocks/shared_memory_sink", 1024*1024);
+    auto source = env.callProxy("/blocks/shared_memory_source", sink.call<std::string>("getRingName"));
+
+    Pothos::Packet packet;
+    packet.payload = Pothos::BufferChunk("uint8", 100000);
+    for (size_t i = 0; i < packet.payload.length; i++) packet.payload.as<char *>()[i] = char(i % 251);
+    const std::string message(50000, 'm');
+    feeder.callProxy("feedMessage", Pothos::Object(packet));
+    feeder.callProxy("feedMessage", Pothos::Object(message));
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, sink, 0);
+        topology.connect(source, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    auto msgs = collector.call<std::vector<Pothos::Object>>("getMessages");
+    POTHOS_TEST_EQUAL(msgs.size(), 2);
+    const auto &outPacket = msgs[0].extract<Pothos::Packet>();
+    POTHOS_TEST_EQUAL(outPacket.payload.length, packet.payload.length);
+    POTHOS_TEST_EQUAL(std::memcmp(outPacket.payload.as<const void *>(), packet.payload.as<const void *>(), packet.payload.length), 0);
+    POTHOS_TEST_EQUAL(msgs[1].extract<std::string>(), message);
+}
+
+/***********************************************************************
+ * A TCP delay line to emulate a long link without tc/netem:
+ * The proxy accepts one connection and forwards both directions
+ * to the target port, delivering each chunk after a one-way delay.
+ **********************************************************************/
+class DelayProxy
+{
+public:
+    DelayProxy(const std::string &targetPort, const std::chrono::microseconds &delay):
+        _delay(delay),
+        _running(true),
+        _listener(Poco::Net::SocketAddress("127.0.0.1", 0))
+    {
+        _acceptThread = std::thread(&DelayProxy::acceptLoop, this, targetPort);
+    }
+
+    ~DelayProxy(void)
+    {
+        _running = false;
+        _cond.notify_all();
+        _acceptThread.join();
+        for (auto &t : _threads) t.join();
+        _inner.close();
+        _outer.close();
+    }
+
+    std::string getPort(void) const
+    {
+        return std::to_string(_listener.address().port());
+    }
+
+private:
+    struct Chunk
+    {
+        std::chrono::high_resolution_clock::time_point deadline;
+        std::vector<char> data;
+    };
+
+    void acceptLoop(const std::string &targetPort)
+    {
+        while (_running and not _listener.poll(Poco::Timespan(0, 10000), Poco::Net::Socket::SELECT_READ));
+        if (not _running) return;
+        _inner = _listener.acceptConnection();
+        _outer.connect(Poco::Net::SocketAddress("127.0.0.1", targetPort));
+        _inner.setNoDelay(true);
+        _outer.setNoDelay(true);
+
+        _threads.emplace_back(&DelayProxy::readLoop, this, _inner, std::ref(_forward));
+        _threads.emplace_back(&DelayProxy::writeLoop, this, _outer, std::ref(_forward));
+        _threads.emplace_back(&DelayProxy::readLoop, this, _outer, std::ref(_reverse));
+        _threads.emplace_back(&DelayProxy::writeLoop, this, _inner, std::ref(_reverse));
+    }
+
+    void readLoop(Poco::Net::StreamSocket sock, std::deque<Chunk> &queue)
+    {
+        std::vector<char> buff(64*1024);
+        while (_running)
+        {
+            if (not sock.poll(Poco::Timespan(0, 10000), Poco::Net::Socket::SELECT_READ)) continue;
+            int ret = 0;
+            try {ret = sock.receiveBytes(buff.data(), int(buff.size()));}
+            catch (const Poco::Exception &){}
+            if (ret <= 0) return;
+            Chunk chunk;
+            chunk.deadline = std::chrono::high_resolution_clock::now() + _delay;
+            chunk.data.assign(buff.begin(), buff.begin()+ret);
+            std::lock_guard<std::mutex> lock(_mutex);
+            queue.push_back(std::move(chunk));
+            _cond.notify_all();
+        }
+    }
+
+    void writeLoop(Poco::Net::StreamSocket sock, std::deque<Chunk> &queue)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (_running)
+        {
+            if (queue.empty() or queue.front().deadline > std::chrono::high_resolution_clock::now())
+            {
+                if (queue.empty()) _cond.wait_for(lock, std::chrono::milliseconds(10));
+                else _cond.wait_until(lock, queue.front().deadline);
+                continue;
+            }
+            const auto chunk = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            try {sock.sendBytes(chunk.data.data(), int(chunk.data.size()));}
+            catch (const Poco::Exception &){return;}
+            lock.lock();
+        }
+    }
+
+    const std::chrono::microseconds _delay;
+    std::atomic<bool> _running;
+    Poco::Net::ServerSocket _listener;
+    Poco::Net::StreamSocket _inner, _outer;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::deque<Chunk> _forward, _reverse;
+    std::thread _acceptThread;
+    std::vector<std::thread> _threads;
+};
+
+/***********************************************************************
+ * Loopback transfer of large buffers between socket endpoints.
+ * The query strings select the transport options on either end.
+ * The payload is a byte ramp that is verified at the receiver.
+ * A non-zero delay routes the transfer through a delay line.
+ * \return the transfer rate in bytes per second
+ **********************************************************************/
+static double endpoint_loopback_rate(
+    const std::string &serverQuery, const std::string &clientQuery,
+    const size_t bufferSize = 1024*1024, const size_t totalBytes = 128*1024*1024,
+    const std::chrono::microseconds &delay = std::chrono::microseconds(0),
+    Poco::JSON::Object::Ptr *clientStats = nullptr)
+{
+    PothosPacketSocketEndpoint server("tcp://0.0.0.0"+serverQuery, "BIND");
+    std::unique_ptr<DelayProxy> proxy;
+    if (delay.count() != 0) proxy.reset(new DelayProxy(server.getActualPort(), delay));
+    const auto clientPort = proxy?proxy->getPort():server.getActualPort();
+    PothosPacketSocketEndpoint client("tcp://localhost:"+clientPort+clientQuery, "CONNECT");
+
+    //handshake from both ends at once
+    std::thread serverOpen([&server]{server.openComms();});
+    client.openComms();
+    serverOpen.join();
+
+    //the sending endpoint must service recv() for the flow control messages
+    std::atomic<bool> running(true);
+    std::thread handler([&client, &running]
+    {
+        while (running)
+        {
+            uint16_t type; uint64_t index;
+            Pothos::BufferChunk buffer;
+            client.recv(type, index, buffer);
+        }
+    });
+
+    //a ramp with a period of 256 bytes, the extra period is for verification
+    Pothos::BufferChunk ramp(bufferSize+256);
+    for (size_t i = 0; i < ramp.length; i++) ramp.as<unsigned char *>()[i] = (i & 0xff);
+
+    //the server receives and verifies the ramp
+    size_t bytesRecvd = 0;
+    bool ok = true;
+    std::thread receiver([&server, &bytesRecvd, &ok, &ramp, totalBytes, bufferSize]
+    {
+        Pothos::BufferChunk storage(bufferSize);
+        while (bytesRecvd < totalBytes)
+        {
+            uint16_t type; uint64_t index;
+            auto buffer = storage;
+            server.recv(type, index, buffer);
+            if (type != PothosPacketTypeBuffer) continue;
+            ok = ok and std::memcmp(buffer.as<const void *>(), ramp.as<const char *>() + (bytesRecvd & 0xff), buffer.length) == 0;
+            bytesRecvd += buffer.length;
+        }
+    });
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t sent = 0; sent < totalBytes; sent += bufferSize)
+    {
+        while (not client.isReady()) std::this_thread::sleep_for(std::chrono::microseconds(100));
+        client.send(PothosPacketTypeBuffer, sent, ramp.as<const void *>(), bufferSize);
+    }
+    receiver.join();
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    if (clientStats != nullptr) *clientStats = client.getFlowStats();
+
+    running = false;
+    handler.join();
+
+    //close from both ends at once
+    std::thread serverClose([&server]{server.closeComms();});
+    client.closeComms();
+    serverClose.join();
+
+    POTHOS_TEST_EQUAL(bytesRecvd, totalBytes);
+    POTHOS_TEST_TRUE(ok);
+    return totalBytes/std::chrono::duration<double>(t1-t0).count();
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_endpoint_negotiation)
+{
+    //a legacy endpoint on either end falls back to the legacy header
+    Poco::JSON::Object::Ptr legacyServerStats, legacyClientStats, negotiatedStats;
+    endpoint_loopback_rate("?version=1", "", 1024*1024, 8*1024*1024, std::chrono::microseconds(0), &legacyServerStats);
+    endpoint_loopback_rate("", "?version=1", 1024*1024, 8*1024*1024, std::chrono::microseconds(0), &legacyClientStats);
+    endpoint_loopback_rate("", "", 1024*1024, 8*1024*1024, std::chrono::microseconds(0), &negotiatedStats);
+    POTHOS_TEST_EQUAL(legacyServerStats->getValue<int>("version"), 1);
+    POTHOS_TEST_EQUAL(legacyServerStats->getValue<int>("maxFrameBytes"), 0xffff);
+    POTHOS_TEST_EQUAL(legacyClientStats->getValue<int>("version"), 1);
+    POTHOS_TEST_EQUAL(legacyClientStats->getValue<int>("maxFrameBytes"), 0xffff);
+    POTHOS_TEST_EQUAL(negotiatedStats->getValue<int>("version"), 3);
+    POTHOS_TEST_EQUAL(negotiatedStats->getValue<int>("maxFrameBytes"), 4*1024*1024);
+}
+
+/***********************************************************************
+ * Loopback throughput of 1 MiB buffers with either header,
+ * run with PothosUtil --bench=blocks/network_endpoint_throughput
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchNetworkEndpointThroughput(void)
+{
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("legacyServerBytesPerSec", endpoint_loopback_rate("?version=1", ""));
+    metrics->set("legacyClientBytesPerSec", endpoint_loopback_rate("", "?version=1"));
+    metrics->set("negotiatedBytesPerSec", endpoint_loopback_rate("", ""));
+    return metrics;
+}
+
+pothos_static_block(pothosBlocksRegisterBenchNetworkEndpoint)
+{
+    Pothos::PluginRegistry::add("/bench/blocks/network_endpoint_throughput", Pothos::Callable(&benchNetworkEndpointThroughput));
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_flow_control)
+{
+    //a 20 ms round trip: the adaptive window grows past the legacy 256 KiB window
+    const auto delay = std::chrono::milliseconds(10);
+    const size_t bufferSize = 64*1024;
+    Poco::JSON::Object::Ptr fixedStats, adaptiveStats;
+    endpoint_loopback_rate("", "?window=262144", bufferSize, 8*1024*1024, delay, &fixedStats);
+    endpoint_loopback_rate("", "", bufferSize, 64*1024*1024, delay, &adaptiveStats);
+
+    POTHOS_TEST_EQUAL(fixedStats->getValue<Poco::UInt64>("windowBytes"), 262144);
+    POTHOS_TEST_TRUE(adaptiveStats->getValue<Poco::UInt64>("windowBytes") > 262144);
+    POTHOS_TEST_TRUE(adaptiveStats->getValue<double>("rttMinSeconds") >= 0.02);
+}
+
+/***********************************************************************
+ * Fixed versus adaptive window over a 20 ms round trip,
+ * run with PothosUtil --bench=blocks/network_flow_control
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchNetworkFlowControl(void)
+{
+    const auto delay = std::chrono::milliseconds(10);
+    const size_t bufferSize = 64*1024;
+    Poco::JSON::Object::Ptr fixedStats, adaptiveStats;
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("fixedBytesPerSec", endpoint_loopback_rate("", "?window=262144", bufferSize, 8*1024*1024, delay, &fixedStats));
+    metrics->set("adaptiveBytesPerSec", endpoint_loopback_rate("", "", bufferSize, 64*1024*1024, delay, &adaptiveStats));
+    metrics->set("adaptiveWindowBytes", adaptiveStats->getValue<double>("windowBytes"));
+    metrics->set("adaptiveStallSeconds", adaptiveStats->getValue<double>("stallSeconds"));
+    return metrics;
+}
+
+pothos_static_block(pothosBlocksRegisterBenchNetworkFlowControl)
+{
+    Pothos::PluginRegistry::add("/bench/blocks/network_flow_control", Pothos::Callable(&benchNetworkFlowControl));
+}
+
+/***********************************************************************
+ * Receive a sustained stream of packet payloads at the endpoint level,
+ * with or without a pool of receive buffers like the network source.
+ * \return the flow stats of the receiver with the allocation counts
+ **********************************************************************/
+static Poco::JSON::Object::Ptr endpoint_recv_payloads(const bool usePool, const size_t numPackets, const size_t packetSize, double &rate)
+{
+    PothosPacketSocketEndpoint server("tcp://0.0.0.0", "BIND");
+    PothosPacketSocketEndpoint client("tcp://localhost:"+server.getActualPort(), "CONNECT");
+
+    std::thread serverOpen([&server]{server.openComms();});
+    client.openComms();
+    serverOpen.join();
+
+    Pothos::BufferManager::Sptr pool;
+    Pothos::Util::MPSCQueue<Pothos::ManagedBuffer> returns;
+    if (usePool)
+    {
+        //the same pool as the network source with the default pool size
+        Pothos::BufferManagerArgs args;
+        args.bufferSize = 256*1024;
+        args.numBuffers = 4;
+        pool = Pothos::BufferManager::make("circular", args);
+        pool->setCallback([&returns](const Pothos::ManagedBuffer &buff){returns.push(buff);});
+        server.setRecvBufferManager(pool);
+    }
+
+    std::atomic<bool> running(true);
+    std::thread handler([&client, &running]
+    {
+        while (running)
+        {
+            uint16_t type; uint64_t index;
+            Pothos::BufferChunk buffer;
+            client.recv(type, index, buffer);
+        }
+    });
+
+    size_t numRecvd = 0;
+    std::thread receiver([&]
+    {
+        while (numRecvd < numPackets)
+        {
+            Pothos::ManagedBuffer returned;
+            while (returns.pop(returned)) pool->push(returned);
+            uint16_t type; uint64_t index;
+            Pothos::BufferChunk buffer;
+            server.recv(type, index, buffer);
+            if (type == PothosPacketTypePayload) numRecvd++;
+        }
+    });
+
+    Pothos::BufferChunk payload(packetSize);
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < numPackets; i++)
+    {
+        while (not client.isReady()) std::this_thread::sleep_for(std::chrono::microseconds(100));
+        client.send(PothosPacketTypePayload, 0, payload.as<const void *>(), payload.length);
+    }
+    receiver.join();
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    rate = numPackets/std::chrono::duration<double>(t1-t0).count();
+    const auto stats = server.getFlowStats();
+
+    running = false;
+    handler.join();
+    std::thread serverClose([&server]{server.closeComms();});
+    client.closeComms();
+    serverClose.join();
+
+    server.setRecvBufferManager(nullptr);
+    pool.reset();
+    returns.clear();
+    return stats;
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_recv_pool)
+{
+    const size_t numPackets = 2000;
+    double rate = 0.0;
+    const auto allocStats = endpoint_recv_payloads(false, numPackets, 8*1024, rate);
+    const auto poolStats = endpoint_recv_payloads(true, numPackets, 8*1024, rate);
+
+    //every payload and message allocates without the pool
+    const auto allocCount = allocStats->getValue<Poco::UInt64>("recvAllocations");
+    const auto poolCount = poolStats->getValue<Poco::UInt64>("recvAllocations");
+    POTHOS_TEST_TRUE(allocCount >= numPackets);
+    POTHOS_TEST_TRUE(poolCount < numPackets/100);
+    POTHOS_TEST_TRUE(poolStats->getValue<Poco::UInt64>("recvPoolBuffers") >= numPackets);
+
+    //payloads larger than a pool buffer are allocated without draining the pool
+    const auto largeStats = endpoint_recv_payloads(true, 20, 512*1024, rate);
+    POTHOS_TEST_TRUE(largeStats->getValue<Poco::UInt64>("recvAllocations") >= 20);
+    POTHOS_TEST_TRUE(largeStats->getValue<Poco::UInt64>("recvPoolBuffers") < 20);
+}
+
+/***********************************************************************
+ * Payload rate with and without the receive pool,
+ * run with PothosUtil --bench=blocks/network_recv_pool
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchNetworkRecvPool(void)
+{
+    const size_t numPackets = 20000;
+    double allocRate = 0.0, poolRate = 0.0;
+    endpoint_recv_payloads(false, numPackets, 8*1024, allocRate);
+    endpoint_recv_payloads(true, numPackets, 8*1024, poolRate);
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("allocPacketsPerSec", allocRate);
+    metrics->set("poolPacketsPerSec", poolRate);
+    return metrics;
+}
+
+pothos_static_block(pothosBlocksRegisterBenchNetworkRecvPool)
+{
+    Pothos::PluginRegistry::add("/bench/blocks/network_recv_pool", Pothos::Callable(&benchNetworkRecvPool));
+}
+
+/***********************************************************************
+ * One sink feeds two sources through a multicast group on the loopback
+ **********************************************************************/
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_multicast)
+{
+    auto env = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    //both receivers share the port of the group
+    const std::string group = "udp://239.255.73.1";
+    const std::string query = "?iface=127.0.0.1&fec=4&rcvbuf=4194304";
+    auto source0 = env.callProxy("/blocks/network_source", group + query, "BIND");
+    const auto port = source0.call<std::string>("getActualPort");
+    auto source1 = env.callProxy("/blocks/network_source", group + ":" + port + query, "BIND");
+    auto sink = env.callProxy("/blocks/network_sink", group + ":" + port + query, "CONNECT");
+
+    auto feeder = env.callProxy("/blocks/feeder_source", "int");
+    auto collector0 = env.callProxy("/blocks/collector_sink", "int");
+    auto collector1 = env.callProxy("/blocks/collector_sink", "int");
+
+    Poco::JSON::Object::Ptr testPlan(new Poco::JSON::Object());
+    testPlan->set("enableBuffers", true);
+    testPlan->set("enableLabels", true);
+    testPlan->set("enableMessages", true);
+    auto expected = feeder.callProxy("feedTestPlan", testPlan);
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, sink, 0);
+        topology.connect(source0, 0, collector0, 0);
+        topology.connect(source1, 0, collector1, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    collector0.callVoid("verifyTestPlan", expected);
+    collector1.callVoid("verifyTestPlan", expected);
+}
+
+/***********************************************************************
+ * Datagram loss and recovery through a relay that drops datagrams:
+ * every 7th datagram is dropped, so that with a parity datagram
+ * every 4 data datagrams each group loses at most one datagram.
+ **********************************************************************/
+static void endpoint_datagram_loss(const uint16_t frameType, const size_t frameBytes,
+    const size_t fecGroupSize, const size_t numFrames,
+    std::vector<uint64_t> &indexes, Poco::JSON::Object::Ptr &stats)
+{
+    const size_t dropInterval = 7;
+    const bool stream = frameType == PothosPacketTypeBuffer;
+
+    PothosPacketSocketEndpoint receiver("udp://127.0.0.1?rcvbuf=4194304", "BIND");
+
+    //the relay forwards to the receiver and drops every 7th datagram
+    Poco::Net::DatagramSocket relay(Poco::Net::SocketAddress("127.0.0.1", 0));
+    relay.setReceiveBufferSize(4*1024*1024);
+    const Poco::Net::SocketAddress target("127.0.0.1", receiver.getActualPort());
+    std::atomic<bool> running(true);
+    std::thread relayThread([&relay, &running, &target, dropInterval]()
+    {
+        std::vector<char> buff(64*1024);
+        Poco::Net::SocketAddress from;
+        size_t count = 0;
+        while (running)
+        {
+            if (not relay.poll(Poco::Timespan(0, 10000), Poco::Net::Socket::SELECT_READ)) continue;
+            const int ret = relay.receiveFrom(buff.data(), int(buff.size()), from);
+            if (count++ % dropInterval == 3) continue;
+            relay.sendTo(buff.data(), ret, target);
+        }
+    });
+
+    PothosPacketSocketEndpoint sender(Poco::format("udp://127.0.0.1:%hu?fec=%z", relay.address().port(), fecGroupSize), "CONNECT");
+    sender.openComms();
+    receiver.openComms();
+
+    std::vector<char> frame(frameBytes);
+    for (size_t i = 0; i < numFrames; i++)
+    {
+        for (size_t j = 0; j < frameBytes; j++) frame[j] = char(i+j);
+        sender.send(frameType, stream?(i*frameBytes):i, frame.data(), frame.size());
+    }
+
+    //receive until the relay has been quiet for a while
+    for (size_t timeouts = 0; timeouts < 3;)
+    {
+        uint16_t type;
+        uint64_t index;
+        Pothos::BufferChunk buffer(2048);
+        receiver.recv(type, index, buffer);
+        if (type == 0) {timeouts++; continue;}
+        POTHOS_TEST_EQUAL(type, frameType);
+        POTHOS_TEST_EQUAL(buffer.length, frameBytes);
+        const size_t i = size_t(stream?(index/frameBytes):index);
+        for (size_t j = 0; j < frameBytes; j++) POTHOS_TEST_EQUAL(buffer.as<const char *>()[j], char(i+j));
+        indexes.push_back(index);
+    }
+
+    running = false;
+    relayThread.join();
+    stats = receiver.getFlowStats();
+    sender.closeComms();
+    receiver.closeComms();
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_datagram_fec)
+{
+    const size_t numFrames = 400;
+
+    //without parity the dropped datagrams are counted as lost
+    {
+        std::vector<uint64_t> indexes;
+        Poco::JSON::Object::Ptr stats;
+        endpoint_datagram_loss(PothosPacketTypeBuffer, 1000, 0, numFrames, indexes, stats);
+        std::cout << "  no FEC: " << indexes.size() << " of " << numFrames << " frames, "
+            << stats->getValue<Poco::UInt64>("datagramsLost") << " lost" << std::endl;
+        //the relay drops datagram i when i % 7 == 3
+        POTHOS_TEST_EQUAL(indexes.size(), numFrames - (numFrames+3)/7);
+        POTHOS_TEST_EQUAL(stats->getValue<Poco::UInt64>("datagramsLost"), numFrames - indexes.size());
+        POTHOS_TEST_EQUAL(stats->getValue<Poco::UInt64>("datagramsRecovered"), 0);
+    }
+
+    //with parity every dropped data datagram is recovered in order
+    {
+        std::vector<uint64_t> indexes;
+        Poco::JSON::Object::Ptr stats;
+        endpoint_datagram_loss(PothosPacketTypeBuffer, 1000, 4, numFrames, indexes, stats);
+        std::cout << "  FEC 4: " << indexes.size() << " of " << numFrames << " frames, "
+            << stats->getValue<Poco::UInt64>("datagramsRecovered") << " recovered" << std::endl;
+        POTHOS_TEST_EQUAL(indexes.size(), numFrames);
+        for (size_t i = 0; i < indexes.size(); i++) POTHOS_TEST_EQUAL(indexes[i], i*1000);
+        POTHOS_TEST_EQUAL(stats->getValue<Poco::UInt64>("datagramsLost"), 0);
+        POTHOS_TEST_TRUE(stats->getValue<Poco::UInt64>("datagramsRecovered") > 0);
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_datagram_fragments)
+{
+    //each message spans three datagrams of the default size
+    const size_t numFrames = 400;
+    const size_t frameBytes = 4000;
+
+    //without parity, a message that loses one fragment is dropped whole
+    {
+        std::vector<uint64_t> indexes;
+        Poco::JSON::Object::Ptr stats;
+        endpoint_datagram_loss(PothosPacketTypeMessage, frameBytes, 0, numFrames, indexes, stats);
+
+        //the relay drops datagram i when i % 7 == 3, which is never twice in one message
+        const size_t numDropped = (3*numFrames+3)/7;
+        POTHOS_TEST_EQUAL(indexes.size(), numFrames - numDropped);
+        POTHOS_TEST_EQUAL(stats->getValue<Poco::UInt64>("datagramsLost"), numDropped);
+        POTHOS_TEST_EQUAL(stats->getValue<Poco::UInt64>("framesDropped"), numDropped);
+        for (size_t i = 1; i < indexes.size(); i++) POTHOS_TEST_TRUE(indexes[i-1] < indexes[i]);
+    }
+
+    //with parity every lost fragment is recovered and every message is reassembled
+    {
+        std::vector<uint64_t> indexes;
+        Poco::JSON::Object::Ptr stats;
+        endpoint_datagram_loss(PothosPacketTypeMessage, frameBytes, 4, numFrames, indexes, stats);
+        POTHOS_TEST_EQUAL(indexes.size(), numFrames);
+        for (size_t i = 0; i < indexes.size(); i++) POTHOS_TEST_EQUAL(indexes[i], i);
+        POTHOS_TEST_EQUAL(stats->getValue<Poco::UInt64>("framesDropped"), 0);
+    }
+}
@@ -43,3 +43,75 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_network_topology)
 
     collector.callVoid("verifyTestPlan", expected);
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_shared_memory_topology)
+{
+    //spawn two servers on this host and connect to both
+    Pothos::RemoteServer server0("tcp://0.0.0.0");
+    Pothos::RemoteClient client0("tcp://localhost:"+server0.getActualPort());
+    Pothos::RemoteServer server1("tcp://0.0.0.0");
+    Pothos::RemoteClient client1("tcp://localhost:"+server1.getActualPort());
+    auto reg0 = client0.makeEnvironment("managed")->findProxy("Pothos/BlockRegistry");
+    auto reg1 = client1.makeEnvironment("managed")->findProxy("Pothos/BlockRegistry");
+
+    //the feeder and collector are in different processes
+    auto feeder = reg0.callProxy("/blocks/feeder_source", "int");
+    auto collector = reg1.callProxy("/blocks/collector_sink", "int");
+
+    //create a test plan
+    Poco::JSON::Object::Ptr testPlan(new Poco::JSON::Object());
+    testPlan->set("enableBuffers", true);
+    testPlan->set("enableLabels", true);
+    testPlan->set("enableMessages", true);
+    auto expected = feeder.callProxy("feedTestPlan", testPlan);
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+
+        //the flow crosses processes on the same host with shared memory
+        const auto markup = topology.toDotMarkup();
+        POTHOS_TEST_TRUE(markup.find("ShmFrom") != std::string::npos);
+        POTHOS_TEST_TRUE(markup.find("NetFrom") == std::string::npos);
+    }
+
+    collector.callVoid("verifyTestPlan", expected);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_network_topology_many_flows)
+{
+    //More network flows than the bounded commit threads:
+    //every endpoint waits in activate() for the handshake with its peer,
+    //so the commit only succeeds when the endpoints get dedicated threads.
+    const size_t numFlows = 24;
+    auto env = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    std::vector<Pothos::Proxy> feeders, collectors;
+    Pothos::Topology topology;
+    for (size_t i = 0; i < numFlows; i++)
+    {
+        auto source = env.callProxy("/blocks/network_source", "tcp://0.0.0.0", "BIND");
+        auto sink = env.callProxy("/blocks/network_sink", "tcp://localhost:"+source.call<std::string>("getActualPort"), "CONNECT");
+        feeders.push_back(env.callProxy("/blocks/feeder_source", "int"));
+        collectors.push_back(env.callProxy("/blocks/collector_sink", "int"));
+
+        auto b = Pothos::BufferChunk(sizeof(int));
+        b.as<int *>()[0] = int(i);
+        feeders.back().callProxy("feedBuffer", b);
+
+        topology.connect(feeders.back(), 0, sink, 0);
+        topology.connect(source, 0, collectors.back(), 0);
+    }
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive());
+
+    for (size_t i = 0; i < numFlows; i++)
+    {
+        auto buff = collectors[i].call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(buff.length, sizeof(int));
+        POTHOS_TEST_EQUAL(buff.as<const int *>()[0], int(i));
+    }
+}
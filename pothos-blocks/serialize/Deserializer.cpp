@@ -1,4 +1,4 @@
-// Copyright (c) 2014-2014 Josh Blum
+// Copyright (c) 2014-2015 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "SerializeCommon.hpp"
@@ -36,6 +36,7 @@ public:
         _nextExpectedIndex(0)
     {
         this->setupInput(0);
+        this->input(0)->setScatterGather(true);
         this->setupOutput(0);
     }
 
@@ -45,10 +46,11 @@ public:
     }
 
     void work(void);
+    void handleBuffer(const Pothos::BufferChunk &);
     void handlePacket(const Pothos::BufferChunk &);
 
 private:
-    Pothos::BufferChunk _accumulator;
+    Pothos::BufferRope _accumulator;
     unsigned long long _nextExpectedIndex;
 };
 
@@ -67,7 +69,7 @@ static bool inspectPacket(const Pothos::BufferChunk &packet, bool &isFragment, s
         assert(Poco::ByteOrder::fromNetwork(vrlp_pkt[0]) == mVRL);
         pkt_bytes = Poco::ByteOrder::fromNetwork(vrlp_pkt[1]) & 0xfffff;
         const size_t pkt_words32 = padUp32(pkt_bytes)/4;
-        isFragment = pkt_bytes > packet.length;
+        isFragment = padUp32(pkt_bytes) > packet.length;
         if (pkt_bytes > MAX_PKT_BYTES) return false; //call this BS
         return isFragment or Poco::ByteOrder::fromNetwork(vrlp_pkt[pkt_words32-1]) == VEND;
     }
@@ -126,39 +128,41 @@ static void unpackBuffer(const Pothos::BufferChunk &packet, size_t &seq, size_t
 
 void Deserializer::work(void)
 {
+    //handle each queued buffer in order,
+    //only packets split across buffers are copied
     auto inputPort = this->input(0);
-    auto buff = inputPort->buffer();
-    inputPort->consume(buff.length);
-
-    //TODO use an iovec approach to avoid accumulating
+    for (const auto &buff : inputPort->buffers())
+    {
+        inputPort->consume(buff.length);
+        this->handleBuffer(buff);
+    }
+}
 
+void Deserializer::handleBuffer(const Pothos::BufferChunk &buff)
+{
+    //the accumulator holds buffers by reference
     _accumulator.append(buff);
 
     //character by character recovery search for packet header
-    while (_accumulator.length >= MIN_PKT_BYTES)
+    while (_accumulator.length() >= MIN_PKT_BYTES)
     {
         bool isFragment = true; size_t pkt_bytes = 0;
-        if (inspectPacket(_accumulator, isFragment, pkt_bytes))
+        bool isPacket = inspectPacket(_accumulator.front(MIN_PKT_BYTES), isFragment, pkt_bytes);
+
+        //the packet spans several buffers, only this packet is copied together
+        if (isPacket and isFragment)
         {
-            if (isFragment) return; //wait for more incoming buffers to accumulate
-            this->handlePacket(_accumulator); //handle the packet, its good probably
-
-            //increment for the next iteration
-            assert(pkt_bytes <= _accumulator.length);
-            _accumulator.address += pkt_bytes;
-            _accumulator.length -= pkt_bytes;
-            assert(_accumulator.length <= _accumulator.getBuffer().getLength());
+            if (padUp32(pkt_bytes) > _accumulator.length()) return; //wait for more incoming buffers to accumulate
+            isPacket = inspectPacket(_accumulator.front(padUp32(pkt_bytes)), isFragment, pkt_bytes);
         }
-        else
+
+        if (isPacket)
         {
-            //the search continues
-            _accumulator.address++;
-            _accumulator.length--;
+            this->handlePacket(_accumulator.front(padUp32(pkt_bytes))); //handle the packet, its good probably
+            _accumulator.pop(pkt_bytes); //increment for the next iteration
         }
+        else _accumulator.pop(1); //the search continues
     }
-
-    //dont keep a reference if the buffer is empty
-    if (_accumulator.length == 0) _accumulator = Pothos::BufferChunk();
 }
 
 /*!
@@ -6,6 +6,7 @@
 #include <Pothos/Proxy.hpp>
 #include <Pothos/Remote.hpp>
 #include <Poco/JSON/Object.h>
+#include <Poco/JSON/Parser.h>
 #include <iostream>
 
 /*!
@@ -59,3 +60,74 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_json_topology)
 
     std::cout << "done!\n";
 }
+
+/*!
+ * A topology description with buffer manager configuration:
+ * The feeder's output port uses a custom circular buffer manager,
+ * and the gateway's output port uses the topology defaults.
+ */
+static const char *BUFFER_MANAGER_JSON =
+"{"
+"   \"bufferManager\" : {\"bufferSize\" : 16384},"
+"   \"blocks\" : ["
+"       {"
+"           \"id\" : \"feeder\","
+"           \"path\" : \"\\/blocks\\/feeder_source\","
+"           \"args\" : [\"int\"],"
+"           \"bufferManagers\" : {"
+"               \"0\" : {\"type\" : \"circular\", \"numBuffers\" : 8, \"bufferSize\" : 65536}"
+"           }"
+"       },"
+"       {"
+"           \"id\" : \"fwd\","
+"           \"path\" : \"\\/blocks\\/gateway\","
+"           \"calls\" : [[\"setMode\", \"FORWARD\"]]"
+"       },"
+"       {"
+"           \"id\" : \"collector\","
+"           \"path\" : \"\\/blocks\\/collector_sink\","
+"           \"args\" : [\"int\"]"
+"       }"
+"   ],"
+"   \"connections\" : ["
+"       [\"feeder\", 0, \"fwd\", 0],"
+"       [\"fwd\", 0, \"collector\", 0]"
+"   ]"
+"}"
+;
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_json_topology_buffer_manager)
+{
+    auto topology = Pothos::Topology::make(BUFFER_MANAGER_JSON);
+    POTHOS_TEST_EQUAL(topology->getBufferManagerType(), "generic");
+    POTHOS_TEST_EQUAL(topology->getBufferManagerArgs().bufferSize, 16384);
+    topology->commit();
+
+    //check the buffer managers reported in the stats
+    Poco::JSON::Parser p; p.parse(topology->queryJSONStats());
+    const auto stats = p.getHandler()->asVar().extract<Poco::JSON::Object::Ptr>();
+    std::vector<std::string> uids;
+    stats->getNames(uids);
+    size_t numCircular = 0, numGeneric = 0;
+    for (const auto &uid : uids)
+    {
+        const auto outputStats = stats->getObject(uid)->getArray("outputStats");
+        if (not outputStats) continue;
+        const auto portStats = outputStats->getObject(0);
+        const auto type = portStats->getValue<std::string>("bufferManagerType");
+        if (type == "circular")
+        {
+            numCircular++;
+            POTHOS_TEST_EQUAL(portStats->getValue<size_t>("numBuffers"), 8);
+            POTHOS_TEST_EQUAL(portStats->getValue<size_t>("bufferSize"), 65536);
+        }
+        if (type == "generic")
+        {
+            numGeneric++;
+            POTHOS_TEST_EQUAL(portStats->getValue<size_t>("numBuffers"), 4);
+            POTHOS_TEST_EQUAL(portStats->getValue<size_t>("bufferSize"), 16384);
+        }
+    }
+    POTHOS_TEST_EQUAL(numCircular, 1);
+    POTHOS_TEST_EQUAL(numGeneric, 1);
+}
@@ -6,6 +6,7 @@
 #include <Pothos/Proxy.hpp>
 #include <Poco/JSON/Object.h>
 #include <iostream>
+#include <cstring> //memset
 
 POTHOS_TEST_BLOCK("/blocks/tests", test_unit_test_blocks)
 {
@@ -102,3 +103,50 @@ POTHOS_TEST_BLOCK("/blocks/tests", test_random_unit_test)
 
     collector.callVoid("verifyTestPlan", expected);
 }
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_fan_in_labels)
+{
+    auto env = Pothos::ProxyEnvironment::make("managed");
+    auto registry = env->findProxy("Pothos/BlockRegistry");
+    auto collector = registry.callProxy("/blocks/collector_sink", "uint8");
+
+    //two producers into one input: each labels its own bytes
+    const size_t numBuffers = 100, buffSize = 64;
+    const std::string ids("AB");
+    std::vector<Pothos::Proxy> feeders;
+    for (const char id : ids)
+    {
+        auto feeder = registry.callProxy("/blocks/feeder_source", "uint8");
+        for (size_t i = 0; i < numBuffers; i++)
+        {
+            auto b = Pothos::BufferChunk(buffSize);
+            std::memset(b.as<void *>(), id, buffSize);
+            feeder.callProxy("feedBuffer", b);
+            for (size_t off : {size_t(0), buffSize/2, buffSize-1})
+            {
+                feeder.callProxy("feedLabel", Pothos::Label(std::string(1, id), i, i*buffSize+off));
+            }
+        }
+        feeders.push_back(feeder);
+    }
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        for (const auto &feeder : feeders) topology.connect(feeder, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //every label must point at a byte of its own producer
+    auto lbls = collector.call<std::vector<Pothos::Label>>("getLabels");
+    auto buff = collector.call<Pothos::BufferChunk>("getBuffer");
+    POTHOS_TEST_EQUAL(buff.length, ids.size()*numBuffers*buffSize);
+    POTHOS_TEST_EQUAL(lbls.size(), ids.size()*numBuffers*3);
+    const auto pb = buff.as<const char *>();
+    for (const auto &lbl : lbls)
+    {
+        POTHOS_TEST_TRUE(lbl.index < buff.length);
+        POTHOS_TEST_EQUAL(std::string(1, pb[lbl.index]), lbl.id);
+    }
+}
@@ -0,0 +1,291 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring> //memcpy
+#include <limits>
+
+/*!
+ * A streaming pseudorandom noise generator.
+ *
+ * The random words come from independent xoshiro256++ generators,
+ * one per lane, with the state stored per word across the lanes,
+ * so the state update of every lane is computed in one vectorizable loop.
+ * The words are generated into a pool of BLOCK_SIZE words at a time.
+ *
+ * Normal and exponential variates use the ziggurat method:
+ * nearly every sample costs one word, a table lookup and a compare,
+ * and the exact distribution is kept by the rare rejection steps.
+ * The low bits of a word select the layer and the top 52 bits
+ * are the uniform, so one word serves both.
+ *
+ * The generator also satisfies the standard uniform random bit generator
+ * requirements, so it can drive the standard library distributions.
+ */
+class NoiseGenerator
+{
+public:
+    static const size_t LANES = 8;
+    static const size_t BLOCK_SIZE = 256;
+
+    typedef uint64_t result_type;
+    static constexpr result_type min(void) {return 0;}
+    static constexpr result_type max(void) {return std::numeric_limits<result_type>::max();}
+
+    NoiseGenerator(const uint64_t seed = 0):
+        _ziggurat(ziggurat())
+    {
+        this->seed(seed);
+    }
+
+    //! Seed every lane from one value with the splitmix64 sequence
+    void seed(uint64_t seed)
+    {
+        for (size_t l = 0; l < LANES; l++)
+        {
+            _s0[l] = splitmix64(seed);
+            _s1[l] = splitmix64(seed);
+            _s2[l] = splitmix64(seed);
+            _s3[l] = splitmix64(seed);
+        }
+        _poolIndex = BLOCK_SIZE;
+    }
+
+    //! Get the next random word
+    result_type operator()(void)
+    {
+        if (_poolIndex == BLOCK_SIZE) this->fill();
+        return _pool[_poolIndex++];
+    }
+
+    //! Uniform variates in [0, 1)
+    void uniform(double *out, const size_t num)
+    {
+        for (size_t i = 0; i < num; i += BLOCK_SIZE)
+        {
+            const size_t n = std::min(num - i, size_t(BLOCK_SIZE));
+            this->fill();
+            for (size_t k = 0; k < n; k++) out[i+k] = toUnit(_pool[k]);
+            _poolIndex = n;
+        }
+    }
+
+    /*!
+     * Standard normal variates (mean 0, deviation 1).
+     * A block of words is mapped through the ziggurat first,
+     * and the few samples outside of the accepted layer areas are redone.
+     */
+    void normal(double *out, const size_t num)
+    {
+        const auto &z = _ziggurat;
+        size_t rejectIndex[BLOCK_SIZE];
+        uint64_t rejectWord[BLOCK_SIZE];
+        for (size_t i = 0; i < num; i += BLOCK_SIZE)
+        {
+            const size_t n = std::min(num - i, size_t(BLOCK_SIZE));
+            this->fill();
+            size_t numRejects = 0;
+            for (size_t k = 0; k < n; k++)
+            {
+                const uint64_t w = _pool[k];
+                const size_t layer = w & 0x7f;
+                const double u = 2*toUnit(w) - 1;
+                out[i+k] = u*z.normalX[layer];
+                if (std::abs(u) < z.normalR[layer]) continue;
+                rejectIndex[numRejects] = k;
+                rejectWord[numRejects++] = w;
+            }
+            _poolIndex = n;
+            for (size_t r = 0; r < numRejects; r++) out[i+rejectIndex[r]] = this->normal(rejectWord[r]);
+        }
+    }
+
+    //! Standard exponential variates (mean 1)
+    void exponential(double *out, const size_t num)
+    {
+        const auto &z = _ziggurat;
+        size_t rejectIndex[BLOCK_SIZE];
+        uint64_t rejectWord[BLOCK_SIZE];
+        for (size_t i = 0; i < num; i += BLOCK_SIZE)
+        {
+            const size_t n = std::min(num - i, size_t(BLOCK_SIZE));
+            this->fill();
+            size_t numRejects = 0;
+            for (size_t k = 0; k < n; k++)
+            {
+                const uint64_t w = _pool[k];
+                const size_t layer = w & 0xff;
+                const double u = toUnit(w);
+                out[i+k] = u*z.expX[layer];
+                if (u < z.expR[layer]) continue;
+                rejectIndex[numRejects] = k;
+                rejectWord[numRejects++] = w;
+            }
+            _poolIndex = n;
+            for (size_t r = 0; r < numRejects; r++) out[i+rejectIndex[r]] = this->exponential(rejectWord[r]);
+        }
+    }
+
+    double normal(void)
+    {
+        return this->normal((*this)());
+    }
+
+    double exponential(void)
+    {
+        return this->exponential((*this)());
+    }
+
+    //! A uniform in (0, 1) for the logarithms
+    double unitOpen(void)
+    {
+        return (((*this)() >> 11) + 0.5)/9007199254740992.0; //2^53
+    }
+
+    //! Convert the top 52 bits of a word to a uniform in [0, 1)
+    static double toUnit(const uint64_t w)
+    {
+        //the bits are the mantissa of a double in [1, 2)
+        const uint64_t bits = (w >> 12) | 0x3ff0000000000000ull;
+        double d; std::memcpy(&d, &bits, sizeof(d));
+        return d - 1.0;
+    }
+
+private:
+    static inline uint64_t rotl(const uint64_t x, const int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitmix64(uint64_t &x)
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27))*0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    //! Refill the pool: each step advances every lane once
+    void fill(void)
+    {
+        for (size_t j = 0; j < BLOCK_SIZE; j += LANES)
+        {
+            for (size_t l = 0; l < LANES; l++)
+            {
+                _pool[j+l] = rotl(_s0[l] + _s3[l], 23) + _s0[l];
+                const uint64_t t = _s1[l] << 17;
+                _s2[l] ^= _s0[l];
+                _s3[l] ^= _s1[l];
+                _s1[l] ^= _s2[l];
+                _s0[l] ^= _s3[l];
+                _s2[l] ^= t;
+                _s3[l] = rotl(_s3[l], 45);
+            }
+        }
+        _poolIndex = 0;
+    }
+
+    //! A normal variate starting from the given word
+    double normal(uint64_t w)
+    {
+        const auto &z = _ziggurat;
+        while (true)
+        {
+            //the top bits are a signed uniform and the low 7 bits the layer
+            const size_t i = w & 0x7f;
+            const double u = 2*toUnit(w) - 1;
+            if (std::abs(u) < z.normalR[i]) return u*z.normalX[i];
+            if (i == 0) return normalTail(u < 0);
+            const double x = u*z.normalX[i];
+            const double f0 = std::exp(-0.5*(z.normalX[i]*z.normalX[i] - x*x));
+            const double f1 = std::exp(-0.5*(z.normalX[i+1]*z.normalX[i+1] - x*x));
+            if (f1 + this->unitOpen()*(f0 - f1) < 1.0) return x;
+            w = (*this)();
+        }
+    }
+
+    //! An exponential variate starting from the given word
+    double exponential(uint64_t w)
+    {
+        const auto &z = _ziggurat;
+        while (true)
+        {
+            const size_t i = w & 0xff;
+            const double u = toUnit(w);
+            if (u < z.expR[i]) return u*z.expX[i];
+            if (i == 0) return EXP_R - std::log(this->unitOpen());
+            const double x = u*z.expX[i];
+            const double f0 = std::exp(-(z.expX[i] - x));
+            const double f1 = std::exp(-(z.expX[i+1] - x));
+            if (f1 + this->unitOpen()*(f0 - f1) < 1.0) return x;
+            w = (*this)();
+        }
+    }
+
+    double normalTail(const bool negative)
+    {
+        double x, y;
+        do
+        {
+            x = std::log(this->unitOpen())/NORMAL_R;
+            y = std::log(this->unitOpen());
+        } while (-2*y < x*x);
+        return negative?(x - NORMAL_R):(NORMAL_R - x);
+    }
+
+    /*!
+     * The ziggurat layers: X holds the layer edges from the base
+     * (which includes the tail area) to the peak, and R holds the ratio
+     * of each edge to the one below, under which a sample is accepted.
+     */
+    static constexpr double NORMAL_R = 3.442619855899;
+    static constexpr double NORMAL_V = 9.91256303526217e-3;
+    static constexpr double EXP_R = 7.69711747013104972;
+    static constexpr double EXP_V = 3.949659822581572e-3;
+
+    struct Ziggurat
+    {
+        double normalX[129], normalR[128];
+        double expX[257], expR[256];
+
+        Ziggurat(void)
+        {
+            double f = std::exp(-0.5*NORMAL_R*NORMAL_R);
+            normalX[0] = NORMAL_V/f;
+            normalX[1] = NORMAL_R;
+            normalX[128] = 0;
+            for (size_t i = 2; i < 128; i++)
+            {
+                normalX[i] = std::sqrt(-2*std::log(NORMAL_V/normalX[i-1] + f));
+                f = std::exp(-0.5*normalX[i]*normalX[i]);
+            }
+            for (size_t i = 0; i < 128; i++) normalR[i] = normalX[i+1]/normalX[i];
+
+            f = std::exp(-EXP_R);
+            expX[0] = EXP_V/f;
+            expX[1] = EXP_R;
+            expX[256] = 0;
+            for (size_t i = 2; i < 256; i++)
+            {
+                expX[i] = -std::log(EXP_V/expX[i-1] + f);
+                f = std::exp(-expX[i]);
+            }
+            for (size_t i = 0; i < 256; i++) expR[i] = expX[i+1]/expX[i];
+        }
+    };
+
+    static const Ziggurat &ziggurat(void)
+    {
+        static const Ziggurat z;
+        return z;
+    }
+
+    const Ziggurat &_ziggurat;
+    uint64_t _s0[LANES], _s1[LANES], _s2[LANES], _s3[LANES];
+    uint64_t _pool[BLOCK_SIZE];
+    size_t _poolIndex;
+};
@@ -1,8 +1,10 @@
 // Copyright (c) 2014-2014 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "NoiseGenerator.hpp"
 #include <Pothos/Framework.hpp>
 #include <Pothos/Util/MathCompat.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <complex>
@@ -17,6 +19,11 @@ static const size_t waveTableSize = 4096;
  * When a complex data type is chosen, the real and imaginary
  * components are simply treated as two independent channels.
  *
+ * By default, the noise is generated sample by sample as a stream
+ * from a vectorized pseudorandom generator, so the output never repeats.
+ * The table mode outputs a precomputed table of 4096 samples
+ * from a random offset on each work call.
+ *
  * |category /Sources
  * |category /Waveforms
  * |keywords noise random source pseudorandom gaussian
@@ -53,7 +60,17 @@ static const size_t waveTableSize = 4096;
  * </ul>
  * |default 1.0
  *
+ * |param mode The method used to generate the noise.
+ * The stream mode produces a Laplace distribution with the given mean and diversity b.
+ * The table mode keeps its previous Laplace output, which only matches
+ * the stream mode when the mean is 0 and b is 1.
+ * |default "STREAM"
+ * |option [Stream] "STREAM"
+ * |option [Table] "TABLE"
+ * |preview valid
+ *
  * |factory /blocks/noise_source(dtype)
+ * |setter setMode(mode)
  * |setter setWaveform(wave)
  * |setter setOffset(offset)
  * |setter setAmplitude(ampl)
@@ -73,7 +90,9 @@ public:
         _mean(0.0),
         _b(1.0),
         _gen(_rd()),
-        _waveIndex(0, waveTableSize-1)
+        _waveIndex(0, waveTableSize-1),
+        _mode("STREAM"),
+        _noise((uint64_t(_rd()) << 32) | _rd())
     {
         this->setupOutput(0, typeid(Type));
         this->registerCall(this, POTHOS_FCN_TUPLE(NoiseSource, setWaveform));
@@ -86,6 +105,8 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(NoiseSource, getMean));
         this->registerCall(this, POTHOS_FCN_TUPLE(NoiseSource, setB));
         this->registerCall(this, POTHOS_FCN_TUPLE(NoiseSource, getB));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NoiseSource, setMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(NoiseSource, getMode));
     }
 
     void activate(void)
@@ -95,9 +116,16 @@ public:
 
     void work(void)
     {
-        _index += _waveIndex(_gen); //lookup into table is random each work()
         auto outPort = this->output(0);
         auto out = outPort->buffer().template as<Type *>();
+        if (_mode == "STREAM")
+        {
+            this->workStream(out, outPort->elements());
+            outPort->produce(outPort->elements());
+            return;
+        }
+
+        _index += _waveIndex(_gen); //lookup into table is random each work()
         for (size_t i = 0; i < outPort->elements(); i++)
         {
             out[i] = _table[_index % waveTableSize];
@@ -161,6 +189,17 @@ public:
         return _b;
     }
 
+    void setMode(const std::string &mode)
+    {
+        if (mode != "STREAM" and mode != "TABLE") throw Pothos::InvalidArgumentException("NoiseSource::setMode("+mode+")", "unknown mode setting");
+        _mode = mode;
+    }
+
+    std::string getMode(void) const
+    {
+        return _mode;
+    }
+
 private:
     void updateTable(void)
     {
@@ -195,10 +234,105 @@ private:
             {
                 this->setElem(_table[i], std::complex<double>(_poisson(_gen), _poisson(_gen)));
             }
+            this->updatePoissonCdf();
         }
         else throw Pothos::InvalidArgumentException("NoiseSource::setWaveform("+_wave+")", "unknown waveform setting");
     }
 
+    /*!
+     * The cumulative distribution of the poisson distribution for inversion,
+     * computed in the log domain and cut off where the tail is negligible.
+     * Very large means use the standard distribution instead.
+     */
+    void updatePoissonCdf(void)
+    {
+        _poissonCdf.clear();
+        if (_mean > 1e4) return;
+        const double mean = std::max(_mean, 0.0);
+        const size_t last = size_t(mean + 20*std::sqrt(mean) + 20);
+        double sum = 0.0;
+        for (size_t k = 0; k <= last; k++)
+        {
+            if (mean > 0.0) sum += std::exp(k*std::log(mean) - mean - std::lgamma(k+1.0));
+            else sum = 1.0;
+            _poissonCdf.push_back(sum);
+        }
+        _poissonCdf.back() = 2.0; //catch any rounding in the last step
+    }
+
+    /*!
+     * Generate a block of samples for the stream mode.
+     * Two channels are drawn per sample for the complex types
+     * or when the amplitude rotates the second channel into the real part.
+     */
+    void workStream(Type *out, const size_t num)
+    {
+        double vals[2*NoiseGenerator::BLOCK_SIZE];
+        const size_t channels = this->numChannels(out);
+        for (size_t i = 0; i < num; i += NoiseGenerator::BLOCK_SIZE)
+        {
+            const size_t n = std::min(num - i, size_t(NoiseGenerator::BLOCK_SIZE));
+            this->generate(vals, n*channels);
+            if (channels == 2) for (size_t k = 0; k < n; k++)
+            {
+                this->setElem(out[i+k], std::complex<double>(vals[2*k], vals[2*k+1]));
+            }
+            else for (size_t k = 0; k < n; k++)
+            {
+                this->setElem(out[i+k], vals[k]);
+            }
+        }
+    }
+
+    template <typename T>
+    size_t numChannels(const T *) const
+    {
+        return (_scalar.imag() == 0.0)?1:2;
+    }
+
+    template <typename T>
+    size_t numChannels(const std::complex<T> *) const
+    {
+        return 2;
+    }
+
+    void generate(double *vals, const size_t num)
+    {
+        if (_wave == "UNIFORM")
+        {
+            _noise.uniform(vals, num);
+            for (size_t i = 0; i < num; i++) vals[i] = (_mean - _b) + 2*_b*vals[i];
+        }
+        else if (_wave == "NORMAL")
+        {
+            _noise.normal(vals, num);
+            for (size_t i = 0; i < num; i++) vals[i] = _mean + _b*vals[i];
+        }
+        else if (_wave == "LAPLACE")
+        {
+            //an exponential with a random sign, one sign bit per sample
+            _noise.exponential(vals, num);
+            uint64_t signs = 0;
+            for (size_t i = 0; i < num; i++)
+            {
+                if (i % 64 == 0) signs = _noise();
+                vals[i] = _mean + (((signs >> (i % 64)) & 0x1)?_b:-_b)*vals[i];
+            }
+        }
+        else if (_wave == "POISSON" and _poissonCdf.empty())
+        {
+            for (size_t i = 0; i < num; i++) vals[i] = _poisson(_noise);
+        }
+        else if (_wave == "POISSON")
+        {
+            _noise.uniform(vals, num);
+            for (size_t i = 0; i < num; i++)
+            {
+                vals[i] = double(std::upper_bound(_poissonCdf.begin(), _poissonCdf.end(), vals[i]) - _poissonCdf.begin());
+            }
+        }
+    }
+
     template <typename T>
     void setElem(T &out, const std::complex<double> &val)
     {
@@ -237,6 +371,10 @@ private:
     std::uniform_real_distribution<> _uniform;
     std::normal_distribution<> _normal;
     std::poisson_distribution<> _poisson;
+
+    std::string _mode;
+    NoiseGenerator _noise;
+    std::vector<double> _poissonCdf;
 };
 
 /***********************************************************************
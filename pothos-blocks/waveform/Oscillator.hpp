@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Util/MathCompat.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+
+#if defined(__GNUC__)
+#define POTHOS_OSCILLATOR_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define POTHOS_OSCILLATOR_RESTRICT __restrict
+#else
+#define POTHOS_OSCILLATOR_RESTRICT
+#endif
+
+/*!
+ * A numerically controlled oscillator with a 64-bit phase accumulator.
+ * The phase is an unsigned fraction of a cycle that wraps without error,
+ * so the frequency resolution is 2^-64 cycles per sample.
+ *
+ * The complex exponential is generated in blocks:
+ * the exponential at the start of each block is computed from the accumulator
+ * and multiplied by a table of exponentials for the offsets within the block.
+ * Every block starts at the exact accumulated phase, so rounding errors
+ * do not build up. The table is stored as interleaved components and as
+ * the components rotated by 90 degrees, so the complex multiply becomes
+ * two scaled table reads per output component, which vectorizes.
+ *
+ * Changing the frequency keeps the accumulated phase,
+ * so the output stays phase continuous across frequency changes.
+ */
+template <typename Type>
+class Oscillator
+{
+public:
+    static const size_t BLOCK_SIZE = 256;
+
+    Oscillator(void):
+        _phase(0), _step(0), _offset(0)
+    {
+        this->updateRotation();
+    }
+
+    //! Set the frequency in cycles per sample
+    void setFrequency(const double freq)
+    {
+        _step = toPhase(freq);
+        this->updateRotation();
+    }
+
+    //! The frequency that the accumulator represents (+/- 0.5)
+    double getFrequency(void) const
+    {
+        return toCycles(_step);
+    }
+
+    //! Set the phase offset in radians
+    void setPhase(const double phase)
+    {
+        _offset = toPhase(phase/(2*M_PI));
+    }
+
+    double getPhase(void) const
+    {
+        return toCycles(_offset)*2*M_PI;
+    }
+
+    /*!
+     * Fill the output with the phase of each sample as a fraction of a cycle.
+     * The accumulator advances by num samples.
+     */
+    void phases(uint64_t *out, const size_t num)
+    {
+        const uint64_t phase = _phase + _offset;
+        for (size_t i = 0; i < num; i++) out[i] = phase + i*_step;
+        _phase += num*_step;
+    }
+
+    /*!
+     * Generate the complex exponential times a scalar.
+     * The accumulator advances by num samples.
+     */
+    void exponential(std::complex<Type> *out, const size_t num, const std::complex<double> &scalar)
+    {
+        for (size_t i = 0; i < num; i += BLOCK_SIZE)
+        {
+            const size_t n = std::min(BLOCK_SIZE, num - i);
+            const auto base = scalar*std::polar(1.0, toCycles(_phase + _offset)*2*M_PI);
+            auto o = reinterpret_cast<Type *>(out + i);
+            if (n == BLOCK_SIZE) this->rotate(o, base, BLOCK_SIZE); //constant count vectorizes
+            else this->rotate(o, base, n);
+            _phase += n*_step;
+        }
+    }
+
+    //! Convert cycles to an accumulator phase, wrapping to one cycle
+    static uint64_t toPhase(const double cycles)
+    {
+        double frac = cycles - std::floor(cycles);
+        if (not (frac < 1.0)) frac = 0.0; //rounded up to a full cycle or not finite
+        return uint64_t(std::ldexp(frac, 64));
+    }
+
+    //! Convert an accumulator phase to signed cycles (+/- 0.5)
+    static double toCycles(const uint64_t phase)
+    {
+        return std::ldexp(double(int64_t(phase)), -64);
+    }
+
+private:
+    void rotate(Type *POTHOS_OSCILLATOR_RESTRICT out, const std::complex<double> &base, const size_t num) const
+    {
+        const Type br = Type(base.real()), bi = Type(base.imag());
+        for (size_t j = 0; j < num*2; j++) out[j] = br*_rot[j] + bi*_rot90[j];
+    }
+
+    void updateRotation(void)
+    {
+        for (size_t k = 0; k < BLOCK_SIZE; k++)
+        {
+            const double angle = toCycles(k*_step)*2*M_PI;
+            _rot[2*k+0] = Type(std::cos(angle));
+            _rot[2*k+1] = Type(std::sin(angle));
+            _rot90[2*k+0] = -_rot[2*k+1];
+            _rot90[2*k+1] = _rot[2*k+0];
+        }
+    }
+
+    uint64_t _phase;
+    uint64_t _step;
+    uint64_t _offset;
+    Type _rot[BLOCK_SIZE*2];
+    Type _rot90[BLOCK_SIZE*2];
+};
+
+template <typename Type>
+const size_t Oscillator<Type>::BLOCK_SIZE;
@@ -0,0 +1,302 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Poco/JSON/Object.h>
+#include "Oscillator.hpp"
+#include "NoiseGenerator.hpp"
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <vector>
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_waveform_oscillator)
+{
+    Oscillator<double> osc;
+
+    //sub-Hz resolution at any practical sample rate
+    osc.setFrequency(1e-12);
+    POTHOS_TEST_TRUE(std::abs(osc.getFrequency() - 1e-12) < 1e-19);
+    osc.setFrequency(-0.25);
+    POTHOS_TEST_EQUAL(osc.getFrequency(), -0.25);
+
+    //generate in uneven chunks and change the frequency half way
+    const double freq0 = 0.0123456789, freq1 = -0.31415926, phase = 0.5;
+    osc.setFrequency(freq0);
+    osc.setPhase(phase);
+    const size_t num = 10000, change = 4321;
+    std::vector<std::complex<double>> out(num);
+    for (size_t i = 0; i < num;)
+    {
+        if (i == change) osc.setFrequency(freq1);
+        const size_t n = std::min<size_t>((i < change)?(change - i):(num - i), 777);
+        osc.exponential(out.data()+i, n, 2.0);
+        i += n;
+    }
+
+    //the phase is continuous across the frequency change
+    for (size_t i = 0; i < num; i++)
+    {
+        const double cycles = (i < change)?(i*freq0):(change*freq0 + (i-change)*freq1);
+        const auto expected = std::polar(2.0, 2*M_PI*cycles + phase);
+        POTHOS_TEST_TRUE(std::abs(out[i] - expected) < 1e-9);
+    }
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_waveform_source_nco)
+{
+    auto registry = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    const size_t numElems = 10000;
+    const double freq = 0.0123456789, phase = 1.0;
+    const std::complex<double> ampl(0.0, 2.0), offset(0.25, -0.5);
+
+    auto waveSource = registry.callProxy("/blocks/waveform_source", "complex128");
+    waveSource.callVoid("setMode", "NCO");
+    waveSource.callVoid("setWaveform", "SINE");
+    waveSource.callVoid("setFrequency", freq);
+    waveSource.callVoid("setPhase", phase);
+    waveSource.callVoid("setAmplitude", ampl);
+    waveSource.callVoid("setOffset", offset);
+    POTHOS_TEST_TRUE(std::abs(waveSource.call<double>("getFrequency") - freq) < 1e-15);
+
+    auto finiteRelease = registry.callProxy("/blocks/finite_release");
+    finiteRelease.callVoid("setTotalElements", numElems);
+    auto collector = registry.callProxy("/blocks/collector_sink", "complex128");
+
+    //run the topology
+    {
+        Pothos::Topology topology;
+        topology.connect(waveSource, 0, finiteRelease, 0);
+        topology.connect(finiteRelease, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive());
+    }
+
+    //check the collector
+    auto buff = collector.call<Pothos::BufferChunk>("getBuffer");
+    POTHOS_TEST_TRUE(buff.length >= numElems*sizeof(std::complex<double>));
+    auto pb = buff.as<const std::complex<double> *>();
+    for (size_t i = 0; i < numElems; i++)
+    {
+        const auto expected = ampl*std::polar(1.0, 2*M_PI*freq*i + phase) + offset;
+        POTHOS_TEST_TRUE(std::abs(pb[i] - expected) < 1e-9);
+    }
+}
+
+/***********************************************************************
+ * Wave table lookup versus the oscillator for complex_float32,
+ * run with PothosUtil --bench=blocks/waveform_oscillator_throughput
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchWaveformOscillator(void)
+{
+    const size_t num = 1 << 12, iters = 2000;
+    std::vector<std::complex<float>> out(num);
+
+    //the wave table lookup of the table mode
+    std::vector<std::complex<float>> table(4096);
+    for (size_t i = 0; i < table.size(); i++) table[i] = std::polar(1.0f, float(2*M_PI*i/table.size()));
+    size_t index = 0;
+    const size_t step = 123;
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t n = 0; n < iters; n++)
+    {
+        for (size_t i = 0; i < num; i++)
+        {
+            out[i] = table[index % table.size()];
+            index += step;
+        }
+    }
+
+    //the oscillator of the oscillator mode
+    Oscillator<float> osc;
+    osc.setFrequency(0.0123456789);
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    for (size_t n = 0; n < iters; n++) osc.exponential(out.data(), num, 1.0);
+    const auto t2 = std::chrono::high_resolution_clock::now();
+
+    const double tableTime = std::chrono::duration<double>(t1 - t0).count();
+    const double oscTime = std::chrono::duration<double>(t2 - t1).count();
+    volatile float sink = out[0].real(); (void)sink; //use the output
+
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("tableSamplesPerSec", num*iters/tableTime);
+    metrics->set("oscillatorSamplesPerSec", num*iters/oscTime);
+    return metrics;
+}
+
+pothos_static_block(pothosBlocksRegisterBenchWaveformOscillator)
+{
+    Pothos::PluginRegistry::add("/bench/blocks/waveform_oscillator_throughput", Pothos::Callable(&benchWaveformOscillator));
+}
+
+/***********************************************************************
+ * Noise generation
+ **********************************************************************/
+struct Moments
+{
+    Moments(const double *x, const size_t num):
+        mean(0.0), var(0.0), skew(0.0), kurt(0.0)
+    {
+        for (size_t i = 0; i < num; i++) mean += x[i];
+        mean /= num;
+        double m3 = 0.0, m4 = 0.0;
+        for (size_t i = 0; i < num; i++)
+        {
+            const double d = x[i] - mean;
+            var += d*d; m3 += d*d*d; m4 += d*d*d*d;
+        }
+        var /= num; m3 /= num; m4 /= num;
+        skew = m3/std::pow(var, 1.5);
+        kurt = m4/(var*var);
+    }
+    double mean, var, skew, kurt;
+};
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_noise_generator_statistics)
+{
+    NoiseGenerator gen(12345);
+    const size_t num = 1 << 20;
+    std::vector<double> x(num);
+
+    //uniform: moments and a chi-square over 64 equal bins
+    gen.uniform(x.data(), num);
+    Moments u(x.data(), num);
+    POTHOS_TEST_TRUE(std::abs(u.mean - 0.5) < 0.005);
+    POTHOS_TEST_TRUE(std::abs(u.var - 1.0/12) < 0.002);
+    std::vector<size_t> bins(64, 0);
+    for (size_t i = 0; i < num; i++)
+    {
+        POTHOS_TEST_TRUE(x[i] >= 0.0 and x[i] < 1.0);
+        bins[size_t(x[i]*bins.size())]++;
+    }
+    double chi2 = 0.0;
+    const double expected = double(num)/bins.size();
+    for (const auto b : bins) chi2 += (b - expected)*(b - expected)/expected;
+    POTHOS_TEST_TRUE(chi2 < 120); //63 degrees of freedom, p < 1e-4
+
+    //normal: moments and the probability of the tails past the ziggurat base
+    gen.normal(x.data(), num);
+    Moments n(x.data(), num);
+    POTHOS_TEST_TRUE(std::abs(n.mean) < 0.01);
+    POTHOS_TEST_TRUE(std::abs(n.var - 1.0) < 0.01);
+    POTHOS_TEST_TRUE(std::abs(n.skew) < 0.02);
+    POTHOS_TEST_TRUE(std::abs(n.kurt - 3.0) < 0.05);
+    size_t tail3 = 0, tail4 = 0;
+    for (size_t i = 0; i < num; i++)
+    {
+        if (std::abs(x[i]) > 3.0) tail3++;
+        if (std::abs(x[i]) > 4.0) tail4++;
+    }
+    POTHOS_TEST_TRUE(std::abs(double(tail3)/num - 2.6998e-3) < 3e-4);
+    POTHOS_TEST_TRUE(std::abs(double(tail4)/num - 6.334e-5) < 3e-5);
+
+    //exponential: moments of the unit exponential
+    gen.exponential(x.data(), num);
+    Moments e(x.data(), num);
+    POTHOS_TEST_TRUE(std::abs(e.mean - 1.0) < 0.01);
+    POTHOS_TEST_TRUE(std::abs(e.var - 1.0) < 0.02);
+    POTHOS_TEST_TRUE(std::abs(e.skew - 2.0) < 0.1);
+    POTHOS_TEST_TRUE(std::abs(e.kurt - 9.0) < 1.0);
+
+    //consecutive blocks are uncorrelated
+    gen.normal(x.data(), num);
+    double corr = 0.0;
+    for (size_t i = 1; i < num; i++) corr += x[i]*x[i-1];
+    POTHOS_TEST_TRUE(std::abs(corr/num) < 0.01);
+}
+
+POTHOS_TEST_BLOCK("/blocks/tests", test_noise_source_stream)
+{
+    auto registry = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    const size_t numElems = 100000;
+    const double mean = 0.5, b = 2.0;
+    struct {const char *wave; double mean; double var;} expected[] = {
+        {"UNIFORM", mean, b*b/3},
+        {"NORMAL", mean, b*b},
+        {"LAPLACE", mean, 2*b*b},
+        {"POISSON", 3.5, 3.5},
+    };
+
+    for (const auto &exp : expected)
+    {
+        std::cout << "Testing noise source " << exp.wave << std::endl;
+        auto noiseSource = registry.callProxy("/blocks/noise_source", "float64");
+        POTHOS_TEST_EQUAL(noiseSource.call<std::string>("getMode"), "STREAM");
+        noiseSource.callVoid("setWaveform", exp.wave);
+        noiseSource.callVoid("setMean", (std::string(exp.wave) == "POISSON")?exp.mean:mean);
+        noiseSource.callVoid("setB", b);
+
+        auto finiteRelease = registry.callProxy("/blocks/finite_release");
+        finiteRelease.callVoid("setTotalElements", numElems);
+        auto collector = registry.callProxy("/blocks/collector_sink", "float64");
+
+        //run the topology
+        {
+            Pothos::Topology topology;
+            topology.connect(noiseSource, 0, finiteRelease, 0);
+            topology.connect(finiteRelease, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive());
+        }
+
+        auto buff = collector.call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_TRUE(buff.length >= numElems*sizeof(double));
+        auto pb = buff.as<const double *>();
+        Moments m(pb, numElems);
+        std::cout << "  mean " << m.mean << ", variance " << m.var << std::endl;
+        POTHOS_TEST_TRUE(std::abs(m.mean - exp.mean) < 0.05);
+        POTHOS_TEST_TRUE(std::abs(m.var/exp.var - 1.0) < 0.05);
+
+        //the stream does not repeat with the period of the table
+        if (std::string(exp.wave) == "POISSON") continue;
+        size_t repeats = 0;
+        for (size_t i = 4096; i < numElems; i++) if (pb[i] == pb[i-4096]) repeats++;
+        POTHOS_TEST_EQUAL(repeats, 0);
+    }
+}
+
+/***********************************************************************
+ * The standard normal distribution versus the noise generator,
+ * run with PothosUtil --bench=blocks/noise_generator_throughput
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchNoiseGenerator(void)
+{
+    const size_t num = 1 << 12, iters = 500;
+    std::vector<double> out(num);
+
+    //the standard library normal distribution of the table mode
+    std::mt19937 gen;
+    std::normal_distribution<> normal;
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t n = 0; n < iters; n++)
+    {
+        for (size_t i = 0; i < num; i++) out[i] = normal(gen);
+    }
+
+    //the vectorized generator of the stream mode
+    NoiseGenerator noise;
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    for (size_t n = 0; n < iters; n++) noise.normal(out.data(), num);
+    const auto t2 = std::chrono::high_resolution_clock::now();
+
+    const double stdTime = std::chrono::duration<double>(t1 - t0).count();
+    const double noiseTime = std::chrono::duration<double>(t2 - t1).count();
+    volatile double sink = out[0]; (void)sink; //use the output
+
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("stdNormalSamplesPerSec", num*iters/stdTime);
+    metrics->set("noiseGeneratorSamplesPerSec", num*iters/noiseTime);
+    return metrics;
+}
+
+pothos_static_block(pothosBlocksRegisterBenchNoiseGenerator)
+{
+    Pothos::PluginRegistry::add("/bench/blocks/noise_generator_throughput", Pothos::Callable(&benchNoiseGenerator));
+}
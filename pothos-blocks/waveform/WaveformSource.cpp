@@ -1,11 +1,13 @@
 // Copyright (c) 2014-2014 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "Oscillator.hpp"
 #include <Pothos/Framework.hpp>
 #include <Pothos/Util/MathCompat.hpp>
 #include <cstdint>
 #include <iostream>
 #include <complex>
+#include <type_traits>
 
 static const size_t waveTableSize = 4096;
 
@@ -16,6 +18,12 @@ static const size_t waveTableSize = 4096;
  * When a complex data type is chosen, the real and imaginary
  * components of the outputs will be 90 degrees out of phase.
  *
+ * The waveform is generated from a wave table by default.
+ * The oscillator mode uses a 64-bit phase accumulator instead:
+ * the frequency resolution is well below 1 Hz at any sample rate,
+ * the sinusoid is computed in vectorized blocks without a table,
+ * and changes to the frequency and phase keep the output continuous.
+ *
  * |category /Sources
  * |category /Waveforms
  * |keywords cosine sine ramp square waveform source signal
@@ -36,6 +44,11 @@ static const size_t waveTableSize = 4096;
  * |units cycles/sample
  * |default 0.1
  *
+ * |param phase The phase offset of the waveform.
+ * |units radians
+ * |default 0.0
+ * |preview valid
+ *
  * |param ampl[Amplitude] A constant scalar representing the amplitude.
  * |default 1.0
  *
@@ -43,21 +56,38 @@ static const size_t waveTableSize = 4096;
  * |default 0.0
  * |preview valid
  *
+ * |param mode The method used to generate the waveform.
+ * The wave table has 4096 entries, which quantizes the frequency
+ * to multiples of 1/4096 cycles/sample.
+ * |default "TABLE"
+ * |option [Wave Table] "TABLE"
+ * |option [Oscillator] "NCO"
+ * |preview valid
+ *
  * |factory /blocks/waveform_source(dtype)
+ * |setter setMode(mode)
  * |setter setWaveform(wave)
  * |setter setOffset(offset)
  * |setter setAmplitude(ampl)
  * |setter setFrequency(freq)
+ * |setter setPhase(phase)
  **********************************************************************/
 template <typename Type>
 class WaveformSource : public Pothos::Block
 {
+    //the oscillator computes in single precision for single precision outputs
+    typedef typename std::conditional<
+        std::is_same<Type, float>::value or std::is_same<Type, std::complex<float>>::value,
+        float, double>::type OscillatorSample;
+    typedef Oscillator<OscillatorSample> OscillatorType;
+
 public:
     WaveformSource(void):
-        _index(0), _step(0),
+        _index(0), _step(0), _tableOffset(0),
         _table(waveTableSize),
         _offset(0.0), _scalar(1.0),
-        _wave("CONST")
+        _wave("CONST"),
+        _mode("TABLE")
     {
         this->setupOutput(0, typeid(Type));
         this->registerCall(this, POTHOS_FCN_TUPLE(WaveformSource<Type>, setWaveform));
@@ -68,6 +98,10 @@ public:
         this->registerCall(this, POTHOS_FCN_TUPLE(WaveformSource<Type>, getAmplitude));
         this->registerCall(this, POTHOS_FCN_TUPLE(WaveformSource<Type>, setFrequency));
         this->registerCall(this, POTHOS_FCN_TUPLE(WaveformSource<Type>, getFrequency));
+        this->registerCall(this, POTHOS_FCN_TUPLE(WaveformSource<Type>, setPhase));
+        this->registerCall(this, POTHOS_FCN_TUPLE(WaveformSource<Type>, getPhase));
+        this->registerCall(this, POTHOS_FCN_TUPLE(WaveformSource<Type>, setMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(WaveformSource<Type>, getMode));
     }
 
     void activate(void)
@@ -79,9 +113,10 @@ public:
     {
         auto outPort = this->output(0);
         auto out = outPort->buffer().template as<Type *>();
-        for (size_t i = 0; i < outPort->elements(); i++)
+        if (_mode == "NCO") this->workOscillator(out, outPort->elements());
+        else for (size_t i = 0; i < outPort->elements(); i++)
         {
-            out[i] = _table[_index % waveTableSize];
+            out[i] = _table[(_index + _tableOffset) % waveTableSize];
             _index += _step;
         }
         outPort->produce(outPort->elements());
@@ -123,13 +158,38 @@ public:
     void setFrequency(const double &freq)
     {
         _step = size_t(std::llround(freq*_table.size()));
+        _oscillator.setFrequency(freq);
     }
 
     double getFrequency(void)
     {
+        if (_mode == "NCO") return _oscillator.getFrequency();
         return double(_step)/_table.size();
     }
 
+    void setPhase(const double &phase)
+    {
+        _tableOffset = size_t(std::llround(phase/(2*M_PI)*_table.size()));
+        _oscillator.setPhase(phase);
+    }
+
+    double getPhase(void)
+    {
+        if (_mode == "NCO") return _oscillator.getPhase();
+        return (2*M_PI*(_tableOffset % _table.size()))/_table.size();
+    }
+
+    void setMode(const std::string &mode)
+    {
+        if (mode != "TABLE" and mode != "NCO") throw Pothos::InvalidArgumentException("WaveformSource::setMode("+mode+")", "unknown mode setting");
+        _mode = mode;
+    }
+
+    std::string getMode(void)
+    {
+        return _mode;
+    }
+
 private:
     void updateTable(void)
     {
@@ -171,6 +231,71 @@ private:
         else throw Pothos::InvalidArgumentException("WaveformSource::setWaveform("+_wave+")", "unknown waveform setting");
     }
 
+    /*!
+     * Generate the waveform from the oscillator phase in blocks:
+     * the sinusoid is the scaled complex exponential,
+     * and the other waveforms are computed from the phase of each sample.
+     */
+    void workOscillator(Type *out, const size_t num)
+    {
+        if (_wave == "SINE") return this->sineOscillator(out, num);
+
+        uint64_t phases[OscillatorType::BLOCK_SIZE];
+        static const uint64_t quarter = uint64_t(1) << 62;
+        const bool ramp = _wave == "RAMP", square = _wave == "SQUARE";
+        for (size_t i = 0; i < num; i += OscillatorType::BLOCK_SIZE)
+        {
+            const size_t n = std::min(OscillatorType::BLOCK_SIZE, num - i);
+            _oscillator.phases(phases, n);
+            for (size_t k = 0; k < n; k++)
+            {
+                const uint64_t p = phases[k], q = p + 3*quarter;
+                std::complex<double> val(1.0);
+                if (ramp) val = std::complex<double>(
+                    2*std::ldexp(double(p), -64) - 1.0,
+                    2*std::ldexp(double(q), -64) - 1.0);
+                else if (square) val = std::complex<double>(
+                    (p < 2*quarter)? 0.0 : 1.0,
+                    (q < 2*quarter)? 0.0 : 1.0);
+                this->setElem(out[i+k], val);
+            }
+        }
+    }
+
+    //! The exponential is generated directly into complex floating point outputs
+    void sineOscillator(std::complex<OscillatorSample> *out, const size_t num)
+    {
+        _oscillator.exponential(out, num, _scalar);
+        if (_offset == std::complex<double>()) return;
+        const std::complex<OscillatorSample> offset(_offset);
+        for (size_t i = 0; i < num; i++) out[i] += offset;
+    }
+
+    //! Other outputs are converted from a block of the exponential
+    template <typename T>
+    void sineOscillator(T *out, const size_t num)
+    {
+        std::complex<OscillatorSample> wave[OscillatorType::BLOCK_SIZE];
+        for (size_t i = 0; i < num; i += OscillatorType::BLOCK_SIZE)
+        {
+            const size_t n = std::min(OscillatorType::BLOCK_SIZE, num - i);
+            _oscillator.exponential(wave, n, _scalar);
+            for (size_t k = 0; k < n; k++) this->setElem(out[i+k], wave[k].real(), wave[k].imag());
+        }
+    }
+
+    template <typename T>
+    void setElem(T &out, const double re, const double)
+    {
+        out = Type(re + _offset.real());
+    }
+
+    template <typename T>
+    void setElem(std::complex<T> &out, const double re, const double im)
+    {
+        out = Type(T(re + _offset.real()), T(im + _offset.imag()));
+    }
+
     template <typename T>
     void setElem(T &out, const std::complex<double> &val)
     {
@@ -185,9 +310,12 @@ private:
 
     size_t _index;
     size_t _step;
+    size_t _tableOffset;
     std::vector<Type> _table;
     std::complex<double> _offset, _scalar;
     std::string _wave;
+    std::string _mode;
+    OscillatorType _oscillator;
 };
 
 /***********************************************************************
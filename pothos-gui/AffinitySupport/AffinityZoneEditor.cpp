@@ -29,7 +29,8 @@ AffinityZoneEditor::AffinityZoneEditor(QWidget *parent):
     _prioritySpin(new QSpinBox(this)),
     _cpuSelection(nullptr),
     _cpuSelectionContainer(new QVBoxLayout()),
-    _yieldModeBox(new QComboBox(this))
+    _yieldModeBox(new QComboBox(this)),
+    _schedulerModeBox(new QComboBox(this))
 {
     assert(_hostExplorerDock != nullptr);
 
@@ -115,6 +116,16 @@ AffinityZoneEditor::AffinityZoneEditor(QWidget *parent):
         _yieldModeBox->setToolTip(tr("Yield mode specifies the internal threading mechanisms"));
         connect(_yieldModeBox, SIGNAL(activated(int)), this, SLOT(handleComboChanged(int)));
     }
+
+    //scheduler mode
+    {
+        formLayout->addRow(tr("Scheduler mode"), _schedulerModeBox);
+        _schedulerModeBox->addItem(tr("Default"), "");
+        _schedulerModeBox->addItem(tr("Round robin"), "ROUND_ROBIN");
+        _schedulerModeBox->addItem(tr("Work stealing"), "WORK_STEALING");
+        _schedulerModeBox->setToolTip(tr("Scheduler mode specifies how pool threads select blocks to process"));
+        connect(_schedulerModeBox, SIGNAL(activated(int)), this, SLOT(handleComboChanged(int)));
+    }
 }
 
 QColor AffinityZoneEditor::color(void) const
@@ -191,6 +202,14 @@ void AffinityZoneEditor::loadFromConfig(const Poco::JSON::Object::Ptr &config)
             if (_yieldModeBox->itemData(i).toString() == mode) _yieldModeBox->setCurrentIndex(i);
         }
     }
+    if (config->has("schedulerMode"))
+    {
+        auto mode = QString::fromStdString(config->getValue<std::string>("schedulerMode"));
+        for (int i = 0; i < _schedulerModeBox->count(); i++)
+        {
+            if (_schedulerModeBox->itemData(i).toString() == mode) _schedulerModeBox->setCurrentIndex(i);
+        }
+    }
 }
 
 Poco::JSON::Object::Ptr AffinityZoneEditor::getCurrentConfig(void) const
@@ -207,6 +226,7 @@ Poco::JSON::Object::Ptr AffinityZoneEditor::getCurrentConfig(void) const
     for (auto num : _cpuSelection->selection()) affinity->add(num);
     config->set("affinity", affinity);
     config->set("yieldMode", _yieldModeBox->itemData(_yieldModeBox->currentIndex()).toString().toStdString());
+    config->set("schedulerMode", _schedulerModeBox->itemData(_schedulerModeBox->currentIndex()).toString().toStdString());
     return config;
 }
 
@@ -85,6 +85,7 @@ private:
     CpuSelectionWidget *_cpuSelection;
     QVBoxLayout *_cpuSelectionContainer;
     QComboBox *_yieldModeBox;
+    QComboBox *_schedulerModeBox;
 
     std::map<QString, std::vector<Pothos::System::NumaInfo>> _uriToNumaInfo;
 };
@@ -18,7 +18,8 @@ public:
         _helpRequested(argc <= 1),
         _docParseRequested(false),
         _deviceInfoRequested(false),
-        _runTopologyRequested(false)
+        _runTopologyRequested(false),
+        _benchRequested(false)
     {
         this->setUnixOptions(true); //always unix style --option
 
@@ -76,12 +77,24 @@ protected:
             .argument("inputFile")
             .binding("inputFile"));
 
-        options.addOption(Poco::Util::Option("run-duration", "", "run the topology for the duration in seconds")
+        options.addOption(Poco::Util::Option("run-duration", "", "run the topology or each benchmark for the duration in seconds")
             .required(false)
             .repeatable(false)
             .argument("runDuration")
             .binding("runDuration"));
 
+        options.addOption(Poco::Util::Option("bench", "", "run the framework benchmarks, optionally a comma separated list of names")
+            .required(false)
+            .repeatable(false)
+            .argument("benchNames", false/*optional*/)
+            .binding("benchNames"));
+
+        options.addOption(Poco::Util::Option("baseline", "", "compare the benchmark results against a baseline results file")
+            .required(false)
+            .repeatable(false)
+            .argument("baselineFile")
+            .binding("baselineFile"));
+
         options.addOption(Poco::Util::Option("self-tests", "", "run all plugin self tests")
             .required(false)
             .repeatable(false)
@@ -124,6 +137,7 @@ protected:
         if (name == "doc-parse") _docParseRequested = true;
         if (name == "device-info") _deviceInfoRequested = true;
         if (name == "run-topology") _runTopologyRequested = true;
+        if (name == "bench") _benchRequested = true;
         if (name == "help") this->stopOptionsProcessing();
     }
 
@@ -163,6 +177,7 @@ protected:
             else if (_docParseRequested) this->docParse(args);
             else if (_deviceInfoRequested) this->printDeviceInfo();
             else if (_runTopologyRequested) this->runTopology();
+            else if (_benchRequested) this->runBenchmarks();
         }
         catch(const Pothos::Exception &ex)
         {
@@ -178,6 +193,7 @@ private:
     bool _docParseRequested;
     bool _deviceInfoRequested;
     bool _runTopologyRequested;
+    bool _benchRequested;
 };
 
 int main(int argc, char *argv[])
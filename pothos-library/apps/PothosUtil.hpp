@@ -19,6 +19,7 @@ public:
     void proxyServer(const std::string &, const std::string &);
     void loadModule(const std::string &, const std::string &);
     void runTopology(void);
+    void runBenchmarks(void);
     void docParse(const std::vector<std::string> &);
 };
 
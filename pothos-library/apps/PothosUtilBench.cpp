@@ -0,0 +1,547 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PothosUtil.hpp"
+#include <Pothos/Framework.hpp>
+#include <Pothos/Proxy.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Pothos/Remote.hpp>
+#include <Pothos/System.hpp>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Parser.h>
+#include <Poco/StringTokenizer.h>
+#include <Poco/Path.h>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <ctime>
+#include <vector>
+#include <map>
+
+static long long nowNs(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+/***********************************************************************
+ * Ping pong block circulates timestamped messages through a loop
+ * and records the round trip time of each message it receives.
+ * The first message is pushed into the input port once committed.
+ **********************************************************************/
+class BenchPingPong : public Pothos::Block
+{
+public:
+    BenchPingPong(void)
+    {
+        this->setupInput(0);
+        this->setupOutput(0);
+    }
+
+    void work(void)
+    {
+        auto inputPort = this->input(0);
+        while (inputPort->hasMessage())
+        {
+            const auto sent = inputPort->popMessage().convert<long long>();
+            const auto now = nowNs();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _roundTrips.push_back(now - sent);
+            }
+            this->output(0)->postMessage(now);
+        }
+    }
+
+    std::vector<long long> takeRoundTrips(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<long long> roundTrips;
+        roundTrips.swap(_roundTrips);
+        return roundTrips;
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<long long> _roundTrips;
+};
+
+/***********************************************************************
+ * Benchmark context holds the topology under test
+ **********************************************************************/
+struct BenchContext
+{
+    BenchContext(const std::string &poolArgs):
+        poolArgs(poolArgs),
+        registry(Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry")),
+        numHops(1)
+    {
+        return;
+    }
+
+    //! Get the thread pool under test for the given environment
+    Pothos::Proxy getThreadPool(const Pothos::ProxyEnvironment::Sptr &env)
+    {
+        if (threadPools.count(env) != 0) return threadPools.at(env);
+        auto args = env->findProxy("Pothos/ThreadPoolArgs").callProxy("new", poolArgs);
+        return threadPools[env] = env->findProxy("Pothos/ThreadPool").callProxy("new", args);
+    }
+
+    //! Make a block from the registry and assign it the thread pool under test
+    Pothos::Proxy makeBlock(const Pothos::Proxy &reg, const std::string &path)
+    {
+        auto block = reg.callProxy(path);
+        block.callVoid("setThreadPool", this->getThreadPool(reg.getEnvironment()));
+        return block;
+    }
+
+    Pothos::Proxy makeBlock(const std::string &path)
+    {
+        return this->makeBlock(registry, path);
+    }
+
+    Pothos::Proxy makeInfiniteSource(const Pothos::Proxy &reg)
+    {
+        auto source = this->makeBlock(reg, "/blocks/infinite_source");
+        source.callVoid("enableBuffers", true);
+        return source;
+    }
+
+    const std::string poolArgs;
+    Pothos::Proxy registry;
+    std::map<Pothos::ProxyEnvironment::Sptr, Pothos::Proxy> threadPools;
+
+    //remote environments outlive the topology
+    Pothos::RemoteServer server;
+    Pothos::RemoteClient client;
+
+    Pothos::Topology topology;
+    std::vector<Pothos::Proxy> sinks;
+    std::shared_ptr<BenchPingPong> pingPong;
+    size_t numHops;
+};
+
+static const size_t BENCH_CHAIN_LENGTH = 4;
+
+static void benchCopierChain(BenchContext &ctx)
+{
+    auto last = ctx.makeInfiniteSource(ctx.registry);
+    for (size_t i = 0; i < BENCH_CHAIN_LENGTH; i++)
+    {
+        auto copier = ctx.makeBlock("/blocks/copier");
+        ctx.topology.connect(last, 0, copier, 0);
+        last = copier;
+    }
+    auto sink = ctx.makeBlock("/blocks/black_hole");
+    ctx.topology.connect(last, 0, sink, 0);
+    ctx.sinks.push_back(sink);
+    ctx.numHops = BENCH_CHAIN_LENGTH + 1;
+}
+
+static void benchFanOut(BenchContext &ctx)
+{
+    auto source = ctx.makeInfiniteSource(ctx.registry);
+    for (size_t i = 0; i < BENCH_CHAIN_LENGTH; i++)
+    {
+        auto copier = ctx.makeBlock("/blocks/copier");
+        auto sink = ctx.makeBlock("/blocks/black_hole");
+        ctx.topology.connect(source, 0, copier, 0);
+        ctx.topology.connect(copier, 0, sink, 0);
+        ctx.sinks.push_back(sink);
+    }
+    ctx.numHops = 2;
+}
+
+static void benchFanIn(BenchContext &ctx)
+{
+    auto sink = ctx.makeBlock("/blocks/black_hole");
+    for (size_t i = 0; i < BENCH_CHAIN_LENGTH; i++)
+    {
+        auto source = ctx.makeBlock("/blocks/infinite_source");
+        source.callVoid("enableMessages", true);
+        ctx.topology.connect(source, 0, sink, 0);
+    }
+    ctx.sinks.push_back(sink);
+}
+
+static void benchMessagePingPong(BenchContext &ctx)
+{
+    ctx.pingPong.reset(new BenchPingPong());
+    ctx.pingPong->setThreadPool(ctx.getThreadPool(ctx.registry.getEnvironment()).convert<Pothos::ThreadPool>());
+    auto pingPong = ctx.registry.getEnvironment()->makeProxy(std::static_pointer_cast<Pothos::Block>(ctx.pingPong));
+    auto last = pingPong;
+    for (size_t i = 0; i < BENCH_CHAIN_LENGTH; i++)
+    {
+        auto copier = ctx.makeBlock("/blocks/copier");
+        ctx.topology.connect(last, 0, copier, 0);
+        last = copier;
+    }
+    ctx.topology.connect(last, 0, pingPong, 0);
+    ctx.numHops = BENCH_CHAIN_LENGTH + 1;
+}
+
+static void benchLabelStorm(BenchContext &ctx)
+{
+    auto source = ctx.makeInfiniteSource(ctx.registry);
+    source.callVoid("enableLabels", true);
+    source.callVoid("setBufferMTU", size_t(64));
+    auto copier = ctx.makeBlock("/blocks/copier");
+    auto sink = ctx.makeBlock("/blocks/black_hole");
+    ctx.topology.connect(source, 0, copier, 0);
+    ctx.topology.connect(copier, 0, sink, 0);
+    ctx.sinks.push_back(sink);
+    ctx.numHops = 2;
+}
+
+static void benchCrossProcess(BenchContext &ctx)
+{
+    ctx.server = Pothos::RemoteServer("tcp://0.0.0.0");
+    ctx.client = Pothos::RemoteClient("tcp://localhost:"+ctx.server.getActualPort());
+    auto remoteReg = ctx.client.makeEnvironment("managed")->findProxy("Pothos/BlockRegistry");
+    auto source = ctx.makeInfiniteSource(remoteReg);
+    auto sink = ctx.makeBlock("/blocks/black_hole");
+    ctx.topology.connect(source, 0, sink, 0);
+    ctx.sinks.push_back(sink);
+}
+
+struct BenchDescriptor
+{
+    const char *name;
+    const char *description;
+    void (*setup)(BenchContext &);
+};
+
+static const BenchDescriptor benchDescriptors[] = {
+    {"copier_chain", "source, chain of copiers, sink", &benchCopierChain},
+    {"fan_out", "one source feeding parallel copiers and sinks", &benchFanOut},
+    {"fan_in", "many message sources into one sink", &benchFanIn},
+    {"message_ping_pong", "one message circulating a loop of copiers", &benchMessagePingPong},
+    {"label_storm", "small buffers with one label each", &benchLabelStorm},
+    {"cross_process", "source in another process, sink in this process", &benchCrossProcess},
+};
+
+//thread pool configurations under test, named by ThreadPoolArgs JSON markup
+static const std::vector<std::pair<std::string, std::string>> benchThreadPools = {
+    {"default", "{}"},
+    {"single", "{\"numThreads\" : 1}"},
+    {"hybrid", "{\"yieldMode\" : \"HYBRID\"}"},
+};
+
+/***********************************************************************
+ * Measurement helpers
+ **********************************************************************/
+struct BenchCounts
+{
+    BenchCounts(void): bytes(0), labels(0), messages(0){}
+    unsigned long long bytes;
+    unsigned long long labels;
+    unsigned long long messages;
+};
+
+static BenchCounts queryCounts(const std::vector<Pothos::Proxy> &sinks)
+{
+    BenchCounts counts;
+    for (const auto &sink : sinks)
+    {
+        const auto stats = sink.callProxy("get:_actor").call<Poco::JSON::Object::Ptr>("queryWorkStats");
+        const auto inputStats = stats->getArray("inputStats");
+        if (not inputStats) continue;
+        for (size_t i = 0; i < inputStats->size(); i++)
+        {
+            const auto portStats = inputStats->getObject(i);
+            counts.bytes += portStats->getValue<Poco::UInt64>("totalElements")*portStats->getValue<Poco::UInt64>("dtypeSize");
+            counts.labels += portStats->getValue<Poco::UInt64>("totalLabels");
+            counts.messages += portStats->getValue<Poco::UInt64>("totalMessages");
+        }
+    }
+    return counts;
+}
+
+static double percentile(const std::vector<long long> &sorted, const double p)
+{
+    if (sorted.empty()) return 0.0;
+    return double(sorted[size_t(p*(sorted.size()-1))]);
+}
+
+static Poco::JSON::Object::Ptr runBenchmark(const BenchDescriptor &desc, const std::string &poolArgs, const double duration)
+{
+    BenchContext ctx(poolArgs);
+    desc.setup(ctx);
+    ctx.topology.commit();
+    if (ctx.pingPong) ctx.pingPong->input(0)->pushMessage(Pothos::Object(nowNs()));
+
+    //let the flows reach a steady state before measuring
+    std::this_thread::sleep_for(std::chrono::milliseconds(long(std::min(duration/4, 0.5)*1000)));
+
+    const auto counts0 = queryCounts(ctx.sinks);
+    if (ctx.pingPong) ctx.pingPong->takeRoundTrips();
+    const auto cpu0 = std::clock();
+    const auto t0 = std::chrono::high_resolution_clock::now();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(long(duration*1000)));
+
+    const auto counts1 = queryCounts(ctx.sinks);
+    const auto cpu1 = std::clock();
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    std::vector<long long> roundTrips;
+    if (ctx.pingPong) roundTrips = ctx.pingPong->takeRoundTrips();
+
+    const double elapsed = std::chrono::duration<double>(t1 - t0).count();
+    const double cpuTime = double(cpu1 - cpu0)/CLOCKS_PER_SEC;
+    unsigned long long messages = counts1.messages - counts0.messages;
+    if (ctx.pingPong) messages = roundTrips.size()*ctx.numHops;
+
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("bytesPerSec", (counts1.bytes - counts0.bytes)/elapsed);
+    metrics->set("messagesPerSec", messages/elapsed);
+    metrics->set("labelsPerSec", (counts1.labels - counts0.labels)/elapsed);
+    metrics->set("cpuTime", cpuTime);
+    metrics->set("cpuLoad", cpuTime/elapsed);
+
+    //per hop latency from the round trip times
+    if (not roundTrips.empty())
+    {
+        std::sort(roundTrips.begin(), roundTrips.end());
+        const double usPerHop = 1e-3/ctx.numHops;
+        metrics->set("latencyP50Us", percentile(roundTrips, 0.50)*usPerHop);
+        metrics->set("latencyP90Us", percentile(roundTrips, 0.90)*usPerHop);
+        metrics->set("latencyP99Us", percentile(roundTrips, 0.99)*usPerHop);
+    }
+
+    Poco::JSON::Object::Ptr result(new Poco::JSON::Object());
+    result->set("elapsed", elapsed);
+    result->set("metrics", metrics);
+    return result;
+}
+
+/***********************************************************************
+ * Topology commit benchmarks time the commit of a chain of idle blocks:
+ * the initial commit, a commit without changes, a commit after
+ * one connection is re-routed through a new block, and the teardown.
+ **********************************************************************/
+static const std::vector<size_t> benchCommitSizes = {10, 100, 1000};
+
+static double timeCommitMs(Pothos::Topology &topology)
+{
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    topology.commit();
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+static Poco::JSON::Object::Ptr runCommitBenchmark(const size_t numBlocks)
+{
+    auto registry = Pothos::ProxyEnvironment::make("managed")->findProxy("Pothos/BlockRegistry");
+
+    //an idle source, a chain of copiers, and a sink
+    std::vector<Pothos::Proxy> blocks;
+    blocks.push_back(registry.callProxy("/blocks/infinite_source"));
+    while (blocks.size() < numBlocks-1) blocks.push_back(registry.callProxy("/blocks/copier"));
+    blocks.push_back(registry.callProxy("/blocks/black_hole"));
+
+    Pothos::Topology topology;
+    for (size_t i = 1; i < blocks.size(); i++) topology.connect(blocks[i-1], 0, blocks[i], 0);
+
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    metrics->set("commitMs", timeCommitMs(topology));
+    metrics->set("recommitMs", timeCommitMs(topology));
+
+    //re-route the middle connection through a new copier
+    const size_t middle = blocks.size()/2;
+    auto copier = registry.callProxy("/blocks/copier");
+    topology.disconnect(blocks[middle-1], 0, blocks[middle], 0);
+    topology.connect(blocks[middle-1], 0, copier, 0);
+    topology.connect(copier, 0, blocks[middle], 0);
+    metrics->set("changeCommitMs", timeCommitMs(topology));
+
+    topology.disconnectAll();
+    metrics->set("teardownMs", timeCommitMs(topology));
+
+    Poco::JSON::Object::Ptr result(new Poco::JSON::Object());
+    result->set("numBlocks", Poco::UInt64(numBlocks));
+    result->set("metrics", metrics);
+    return result;
+}
+
+/***********************************************************************
+ * Microbenchmarks from the plugin registry: the library and modules
+ * register a Pothos::Callable under /bench that takes no arguments
+ * and returns a Poco::JSON::Object::Ptr of metric names to values.
+ * The benchmark name is the plugin path under /bench.
+ **********************************************************************/
+static void findPluginBenchmarks(const Pothos::PluginPath &path, std::vector<Pothos::Plugin> &plugins)
+{
+    if (not Pothos::PluginRegistry::empty(path))
+    {
+        auto plugin = Pothos::PluginRegistry::get(path);
+        if (plugin.getObject().type() == typeid(Pothos::Callable)) plugins.push_back(plugin);
+    }
+    for (const auto &name : Pothos::PluginRegistry::list(path))
+    {
+        findPluginBenchmarks(path.join(name), plugins);
+    }
+}
+
+static Poco::JSON::Object::Ptr runPluginBenchmark(const Pothos::Plugin &plugin)
+{
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    const auto metrics = plugin.getObject().extract<Pothos::Callable>().call<Poco::JSON::Object::Ptr>();
+    const auto t1 = std::chrono::high_resolution_clock::now();
+
+    Poco::JSON::Object::Ptr result(new Poco::JSON::Object());
+    result->set("elapsed", std::chrono::duration<double>(t1 - t0).count());
+    result->set("metrics", metrics);
+    return result;
+}
+
+/***********************************************************************
+ * Baseline comparison
+ **********************************************************************/
+static Poco::JSON::Object::Ptr loadBaseline(const std::string &path)
+{
+    std::ifstream ifs(Poco::Path::expand(path));
+    if (not ifs) throw Pothos::FileNotFoundException("PothosUtilBase::runBenchmarks()", path);
+    Poco::JSON::Parser p; p.parse(ifs);
+    return p.getHandler()->asVar().extract<Poco::JSON::Object::Ptr>();
+}
+
+static Poco::JSON::Object::Ptr findResult(const Poco::JSON::Object::Ptr &report, const std::string &name, const std::string &pool)
+{
+    const auto results = report->getArray("results");
+    if (results) for (size_t i = 0; i < results->size(); i++)
+    {
+        const auto result = results->getObject(i);
+        if (result->getValue<std::string>("name") != name) continue;
+        if (result->getValue<std::string>("threadPool") != pool) continue;
+        return result;
+    }
+    return Poco::JSON::Object::Ptr();
+}
+
+static void compareResult(Poco::JSON::Object::Ptr result, const Poco::JSON::Object::Ptr &baseline)
+{
+    const auto metrics = result->getObject("metrics");
+    const auto baseMetrics = baseline->getObject("metrics");
+    if (not metrics or not baseMetrics) return;
+
+    Poco::JSON::Object::Ptr changes(new Poco::JSON::Object());
+    std::vector<std::string> names; metrics->getNames(names);
+    for (const auto &name : names)
+    {
+        if (not baseMetrics->has(name)) continue;
+        const auto current = metrics->getValue<double>(name);
+        const auto base = baseMetrics->getValue<double>(name);
+        if (base == 0.0) continue;
+        const auto change = (current - base)*100/base;
+        changes->set(name, change);
+        std::ostringstream oss; oss << std::showpos << std::fixed << std::setprecision(1) << change << "%";
+        std::cout << "    " << std::left << std::setw(16) << name << std::right
+            << std::setw(14) << base << " -> " << std::setw(14) << current
+            << " (" << oss.str() << ")" << std::endl;
+    }
+    result->set("baselineChange", changes);
+}
+
+static void printResult(Poco::JSON::Object::Ptr result, const Poco::JSON::Object::Ptr &baseline)
+{
+    const auto metrics = result->getObject("metrics");
+    std::vector<std::string> names; metrics->getNames(names);
+    for (const auto &name : names)
+    {
+        std::cout << "    " << std::left << std::setw(16) << name << std::right
+            << std::setw(14) << metrics->getValue<double>(name) << std::endl;
+    }
+
+    const auto baseResult = baseline?findResult(baseline,
+        result->getValue<std::string>("name"), result->getValue<std::string>("threadPool")):Poco::JSON::Object::Ptr();
+    if (baseResult)
+    {
+        std::cout << "  compared to baseline:" << std::endl;
+        compareResult(result, baseResult);
+    }
+}
+
+/***********************************************************************
+ * Run the benchmark suite
+ **********************************************************************/
+void PothosUtilBase::runBenchmarks(void)
+{
+    Pothos::init();
+
+    const double duration = this->config().getDouble("runDuration", 1.0);
+
+    //an optional comma separated list selects benchmarks by name
+    std::vector<std::string> selected;
+    const auto benchNames = this->config().getString("benchNames", "");
+    for (const auto &name : Poco::StringTokenizer(benchNames, ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY))
+    {
+        selected.push_back(name);
+    }
+
+    Poco::JSON::Object::Ptr baseline;
+    if (this->config().has("baselineFile")) baseline = loadBaseline(this->config().getString("baselineFile"));
+
+    Poco::JSON::Array::Ptr results(new Poco::JSON::Array());
+    for (const auto &desc : benchDescriptors)
+    {
+        if (not selected.empty() and std::find(selected.begin(), selected.end(), desc.name) == selected.end()) continue;
+        for (const auto &pool : benchThreadPools)
+        {
+            std::cout << ">>> Benchmark " << desc.name << " (" << desc.description << ") on " << pool.first << " thread pool" << std::endl;
+            auto result = runBenchmark(desc, pool.second, duration);
+            result->set("name", std::string(desc.name));
+            result->set("threadPool", pool.first);
+            results->add(result);
+            printResult(result, baseline);
+        }
+    }
+
+    for (const auto numBlocks : benchCommitSizes)
+    {
+        const auto name = "commit_"+std::to_string(numBlocks);
+        if (not selected.empty() and std::find(selected.begin(), selected.end(), name) == selected.end()) continue;
+        std::cout << ">>> Benchmark " << name << " (commit a chain of " << numBlocks << " blocks)" << std::endl;
+        auto result = runCommitBenchmark(numBlocks);
+        result->set("name", name);
+        result->set("threadPool", std::string("default"));
+        results->add(result);
+        printResult(result, baseline);
+    }
+
+    std::vector<Pothos::Plugin> plugins;
+    findPluginBenchmarks(Pothos::PluginPath("/bench"), plugins);
+    for (const auto &plugin : plugins)
+    {
+        const auto name = plugin.getPath().toString().substr(std::string("/bench/").size());
+        if (not selected.empty() and std::find(selected.begin(), selected.end(), name) == selected.end()) continue;
+        std::cout << ">>> Benchmark " << name << std::endl;
+        auto result = runPluginBenchmark(plugin);
+        result->set("name", name);
+        result->set("threadPool", std::string("default"));
+        results->add(result);
+        printResult(result, baseline);
+    }
+
+    Poco::JSON::Object::Ptr report(new Poco::JSON::Object());
+    report->set("apiVersion", Pothos::System::getApiVersion());
+    report->set("numCpus", Poco::UInt64(std::thread::hardware_concurrency()));
+    report->set("duration", duration);
+    report->set("results", results);
+
+    //dump the results to file if specified
+    if (this->config().has("outputFile"))
+    {
+        const auto resultsFile = this->config().getString("outputFile");
+        std::cout << ">>> Dumping results: " << resultsFile << std::endl;
+        std::ofstream ofs(Poco::Path::expand(resultsFile));
+        report->stringify(ofs, 4);
+        ofs << std::endl;
+    }
+}
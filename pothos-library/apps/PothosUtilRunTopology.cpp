@@ -6,6 +6,7 @@
 #include <Poco/Path.h>
 #include <fstream>
 #include <thread>
+#include <chrono>
 #include <iostream>
 
 void PothosUtilBase::runTopology(void)
@@ -19,7 +20,10 @@ void PothosUtilBase::runTopology(void)
 
     //create the topology from the JSON string
     std::cout << ">>> Create Topology: " << path << std::endl;
+    const auto startTime = std::chrono::high_resolution_clock::now();
     auto topology = Pothos::Topology::make(json);
+    const std::chrono::duration<double> makeTime = std::chrono::high_resolution_clock::now() - startTime;
+    std::cout << ">>> Created topology in " << makeTime.count() << " seconds" << std::endl;
 
     //commit the topology and wait for specified time for CTRL+C
     if (this->config().has("runDuration"))
@@ -28,6 +28,7 @@
 #include <Pothos/Framework/BlockRegistry.hpp>
 #include <Pothos/Framework/BufferManager.hpp>
 #include <Pothos/Framework/BufferAccumulator.hpp>
+#include <Pothos/Framework/BufferRope.hpp>
 #include <Pothos/Framework/BufferChunk.hpp>
 #include <Pothos/Framework/SharedBuffer.hpp>
 #include <Pothos/Framework/ManagedBuffer.hpp>
@@ -314,6 +314,16 @@ public:
      */
     void yield(void);
 
+    /*!
+     * Mark that activate() and deactivate() wait on an external peer,
+     * such as a network endpoint that performs a handshake with its remote.
+     * The topology activates most blocks on a bounded number of threads,
+     * but these blocks each get a thread so that peers activated together overlap.
+     * Call this method from the block's constructor.
+     * \param waits true when the activation waits on a peer
+     */
+    void setActivateWaitsOnPeer(const bool waits);
+
     /*!
      * Call a method on a derived instance with opaque input and return types.
      * \param name the name of the method as a string
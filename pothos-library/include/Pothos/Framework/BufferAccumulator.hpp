@@ -4,7 +4,7 @@
 /// BufferAccumulator provides an input pool of buffers.
 ///
 /// \copyright
-/// Copyright (c) 2013-2014 Josh Blum
+/// Copyright (c) 2013-2015 Josh Blum
 /// SPDX-License-Identifier: BSL-1.0
 ///
 
@@ -57,10 +57,23 @@ public:
 
     /*!
      * Pop numBytes from the front of this accumulator.
+     * When numBytes exceeds the front buffer,
+     * the bytes are removed across several buffers.
      * \param numBytes the number of bytes to remove
      */
     void pop(const size_t numBytes);
 
+    //! Get the number of buffer chunks held in this accumulator
+    size_t getNumChunks(void) const;
+
+    /*!
+     * Get a buffer chunk in order from the front.
+     * This reference is invalidated after mutator calls.
+     * \param index the chunk index less than getNumChunks()
+     * \return a const reference to the buffer chunk
+     */
+    const BufferChunk &at(const size_t index) const;
+
     //! Get the total number of bytes held in this accumulator
     size_t getTotalBytesAvailable(void) const;
 
@@ -100,6 +113,18 @@ inline const Pothos::BufferChunk &Pothos::BufferAccumulator::front(void) const
     return _queue.front();
 }
 
+inline size_t Pothos::BufferAccumulator::getNumChunks(void) const
+{
+    //the queue holds a dummy empty buffer when there are no bytes
+    return (_bytesAvailable == 0)? 0 : _queue.size();
+}
+
+inline const Pothos::BufferChunk &Pothos::BufferAccumulator::at(const size_t index) const
+{
+    assert(index < _queue.size());
+    return _queue[index];
+}
+
 inline size_t Pothos::BufferAccumulator::getTotalBytesAvailable(void) const
 {
     return _bytesAvailable;
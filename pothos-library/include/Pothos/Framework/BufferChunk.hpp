@@ -5,7 +5,7 @@
 /// a managed or shared buffer and address/length offsets.
 ///
 /// \copyright
-/// Copyright (c) 2013-2014 Josh Blum
+/// Copyright (c) 2013-2015 Josh Blum
 /// SPDX-License-Identifier: BSL-1.0
 ///
 
@@ -143,10 +143,15 @@ public:
 
     /*!
      * Append another buffer onto the back of this buffer.
-     * This call allocates a new memory slab the size of both buffers
-     * and copies the contents from each one into the new memory slab.
+     * When the other buffer continues this buffer in the same memory,
+     * append simply extends the length without copying.
+     * Otherwise the contents of the other buffer are copied,
+     * either into the unused end of a buffer made by a prior append,
+     * or into a new memory slab with room for future appends,
+     * so that repeated appends copy each byte a bounded number of times.
      * The length and address members will be updated accordingly.
      * When empty, append simply copies a reference to the other buffer.
+     * Use BufferRope to accumulate buffers by reference instead.
      * \param other the other buffer to append to the end
      */
     void append(const BufferChunk &other);
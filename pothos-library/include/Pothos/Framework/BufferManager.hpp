@@ -140,6 +140,15 @@ public:
     //! Has this buffer manager been initialized?
     bool isInitialized(void) const;
 
+    /*!
+     * Get the factory name that was used to make this manager.
+     * \return the factory name or empty when not made by the factory
+     */
+    const std::string &getName(void) const;
+
+    //! Get the arguments that this manager was initialized with.
+    const BufferManagerArgs &getArgs(void) const;
+
 protected:
     //! Default constructor
     BufferManager(void);
@@ -149,6 +158,8 @@ protected:
 
 private:
     bool _initialized;
+    std::string _name;
+    BufferManagerArgs _args;
     BufferChunk _frontBuffer;
     std::function<void(const ManagedBuffer &)> _callback;
 };
@@ -175,3 +186,13 @@ inline bool Pothos::BufferManager::isInitialized(void) const
 {
     return _initialized;
 }
+
+inline const std::string &Pothos::BufferManager::getName(void) const
+{
+    return _name;
+}
+
+inline const Pothos::BufferManagerArgs &Pothos::BufferManager::getArgs(void) const
+{
+    return _args;
+}
@@ -0,0 +1,133 @@
+///
+/// \file Framework/BufferRope.hpp
+///
+/// BufferRope is a list of buffer chunks for zero-copy accumulation.
+///
+/// \copyright
+/// Copyright (c) 2026 Josh Blum
+/// SPDX-License-Identifier: BSL-1.0
+///
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <Pothos/Util/RingDeque.hpp>
+#include <cassert>
+
+namespace Pothos {
+
+/*!
+ * A BufferRope accumulates buffer chunks by reference.
+ * Appending a buffer holds a reference to it rather than copying it,
+ * and buffers that continue the previous buffer in memory are merged.
+ * Bytes are only copied together when the caller demands contiguous
+ * access with front(), and then only the bytes that were demanded.
+ *
+ * Note: References to managed buffers hold back the upstream buffer manager.
+ * Only accumulate what will be consumed soon, or copy out for storage.
+ */
+class POTHOS_API BufferRope
+{
+public:
+
+    //! Create an empty buffer rope
+    BufferRope(void);
+
+    //! Is the rope empty? -- true when zero bytes
+    bool empty(void) const;
+
+    //! Get the total number of bytes held in this rope
+    size_t length(void) const;
+
+    //! Get the number of buffer chunks held in this rope
+    size_t getNumChunks(void) const;
+
+    /*!
+     * Get a buffer chunk in order from the front.
+     * This reference is invalidated after mutator calls.
+     * \param index the chunk index less than getNumChunks()
+     * \return a const reference to the buffer chunk
+     */
+    const BufferChunk &at(const size_t index) const;
+
+    /*!
+     * Append a buffer chunk onto the back of the rope.
+     * The rope holds a reference to the buffer, nothing is copied.
+     * \param buffer a buffer chunk
+     */
+    void append(const BufferChunk &buffer);
+
+    /*!
+     * Copy bytes out of the rope without removing them.
+     * \throws RangeException when the bytes are not available
+     * \param [out] dst the destination memory of numBytes
+     * \param offset the byte offset from the front of the rope
+     * \param numBytes the number of bytes to copy
+     */
+    void peek(void *dst, const size_t offset, const size_t numBytes) const;
+
+    /*!
+     * Get the front of the rope with at least numBytes contiguous.
+     * When the front chunk is shorter, just enough chunks are
+     * copied together so that the front chunk holds numBytes.
+     * This reference is invalidated after mutator calls.
+     * \throws RangeException when the bytes are not available
+     * \param numBytes the number of contiguous bytes needed
+     * \return a const reference to the front buffer
+     */
+    const BufferChunk &front(const size_t numBytes);
+
+    /*!
+     * Remove numBytes from the front of the rope and return them.
+     * The result references the original memory when the bytes
+     * are within one chunk, otherwise the bytes are copied together.
+     * \throws RangeException when the bytes are not available
+     * \param numBytes the number of bytes to remove
+     * \return a buffer chunk holding the removed bytes
+     */
+    BufferChunk split(const size_t numBytes);
+
+    /*!
+     * Remove numBytes from the front of the rope.
+     * \throws RangeException when the bytes are not available
+     * \param numBytes the number of bytes to remove
+     */
+    void pop(const size_t numBytes);
+
+    /*!
+     * Get the entire contents of the rope as one buffer chunk.
+     * The rope keeps the contiguous result as its only chunk.
+     * \return the contents or a null buffer when empty
+     */
+    BufferChunk flatten(void);
+
+    //! Remove all chunks from the rope
+    void clear(void);
+
+private:
+    Util::RingDeque<BufferChunk> _chunks;
+    size_t _length;
+};
+
+} //namespace Pothos
+
+inline bool Pothos::BufferRope::empty(void) const
+{
+    return _length == 0;
+}
+
+inline size_t Pothos::BufferRope::length(void) const
+{
+    return _length;
+}
+
+inline size_t Pothos::BufferRope::getNumChunks(void) const
+{
+    return _chunks.size();
+}
+
+inline const Pothos::BufferChunk &Pothos::BufferRope::at(const size_t index) const
+{
+    assert(index < _chunks.size());
+    return _chunks[index];
+}
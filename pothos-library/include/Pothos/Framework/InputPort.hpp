@@ -16,8 +16,9 @@
 #include <Pothos/Framework/BufferChunk.hpp>
 #include <Pothos/Framework/BufferAccumulator.hpp>
 #include <Pothos/Util/RingDeque.hpp>
-#include <Pothos/Util/SpinLock.hpp>
+#include <Pothos/Util/MPSCQueue.hpp>
 #include <string>
+#include <vector>
 
 namespace Pothos {
 
@@ -62,6 +63,26 @@ public:
      */
     size_t elements(void) const;
 
+    /*!
+     * Enable scatter-gather access to the input stream.
+     * When enabled, the port no longer copies fragmented buffers
+     * together to satisfy the reserve; the reserve is instead met
+     * by the total number of elements across all queued buffers.
+     * The queued buffers are accessed with buffers(), and consume()
+     * may remove elements across several of these buffers.
+     * buffer() and elements() still refer to the front buffer.
+     * \param enable true to enable scatter-gather access
+     */
+    void setScatterGather(const bool enable);
+
+    /*!
+     * Get access to all queued stream buffers in order.
+     * Each buffer holds length/dtype().size() port elements.
+     * The list is only filled when scatter-gather is enabled,
+     * and otherwise this returns an empty list.
+     */
+    const std::vector<BufferChunk> &buffers(void) const;
+
     /*!
      * Get the total number of elements consumed on this port.
      * The value returned by this method will not change
@@ -114,6 +135,7 @@ public:
      * Consume elements on this port.
      * The number of elements specified must be less than
      * or equal to the number of elements available.
+     * In scatter-gather mode, the elements may span several buffers.
      * \param numElements the number of elements to consume
      */
     void consume(const size_t numElements);
@@ -178,10 +200,12 @@ private:
     std::string _name;
     DType _dtype;
     std::string _domain;
+    bool _scatterGather;
 
     //state set in pre-work
     BufferChunk _buffer;
     size_t _elements;
+    std::vector<BufferChunk> _buffers;
     LabelIteratorRange _labelIter;
 
     //port stats
@@ -197,18 +221,35 @@ private:
     //counts work actions which we will use to establish activity
     size_t _workEvents;
 
-    Util::SpinLock _asyncMessagesLock;
-    Util::RingDeque<std::pair<Object, BufferChunk>> _asyncMessages;
-
-    Util::SpinLock _slotCallsLock;
-    Util::RingDeque<std::pair<Object, BufferChunk>> _slotCalls;
+    Util::MPSCQueue<std::pair<Object, BufferChunk>> _asyncMessages;
+    Util::MPSCQueue<std::pair<Object, BufferChunk>> _slotCalls;
 
     std::vector<Label> _inlineMessages; //user api structure
-    Util::RingDeque<Label> _inputInlineMessages; //shared structure
-
-    Util::SpinLock _bufferAccumulatorLock;
+    Util::RingDeque<Label> _inputInlineMessages; //actor-owned structure
     BufferAccumulator _bufferAccumulator;
 
+    //buffers and labels handed off from producers, drained by the actor
+    //a posted item carries the labels and buffers of one post together,
+    //so that the label offsets apply to its own buffers under fan-in
+    //the common post fits in the inline arrays so that it does not allocate,
+    //the vectors only hold the labels and buffers beyond the inline arrays
+    struct BufferLabelItem
+    {
+        enum Kind {POSTED, PUSHED_BUFFER, LABEL};
+        enum {INLINE_SIZE = 4};
+        BufferLabelItem(void):
+            kind(POSTED), numLabels(0), numBuffers(0){}
+        Kind kind;
+        size_t numLabels;
+        Label labels[INLINE_SIZE];
+        std::vector<Label> moreLabels;
+        size_t numBuffers;
+        BufferChunk buffers[INLINE_SIZE];
+        std::vector<BufferChunk> moreBuffers;
+    };
+    Util::MPSCQueue<BufferLabelItem> _bufferLabelItems;
+    void bufferLabelDrain(void);
+
     std::vector<OutputPort *> _subscribers;
 
     /////// async message interface /////////
@@ -230,10 +271,11 @@ private:
     /////// input buffer interface /////////
     void bufferAccumulatorFront(BufferChunk &);
     void bufferAccumulatorPush(const BufferChunk &buffer);
-    void bufferAccumulatorPushNoLock(const BufferChunk &buffer);
+    void bufferAccumulatorPushNoLock(const BufferChunk &buffer); //actor only
     void bufferAccumulatorPop(const size_t numBytes);
     void bufferAccumulatorRequire(const size_t numBytes);
     void bufferAccumulatorClear(void);
+    void bufferAccumulatorGather(void);
 
     /////// combined label association push /////////
     void bufferLabelPush(
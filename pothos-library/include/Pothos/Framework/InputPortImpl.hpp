@@ -10,7 +10,6 @@
 
 #pragma once
 #include <Pothos/Framework/InputPort.hpp>
-#include <mutex> //lock_guard
 
 inline int Pothos::InputPort::index(void) const
 {
@@ -42,6 +41,16 @@ inline size_t Pothos::InputPort::elements(void) const
     return _elements;
 }
 
+inline void Pothos::InputPort::setScatterGather(const bool enable)
+{
+    _scatterGather = enable;
+}
+
+inline const std::vector<Pothos::BufferChunk> &Pothos::InputPort::buffers(void) const
+{
+    return _buffers;
+}
+
 inline unsigned long long Pothos::InputPort::totalElements(void) const
 {
     return _totalElements;
@@ -113,36 +122,35 @@ inline void Pothos::InputPort::setReserve(const size_t numElements)
 
 inline bool Pothos::InputPort::asyncMessagesEmpty(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_asyncMessagesLock);
     return _asyncMessages.empty();
 }
 
 inline Pothos::Object Pothos::InputPort::asyncMessagesPop(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_asyncMessagesLock);
-    if (_asyncMessages.empty()) return Pothos::Object();
-    auto msg = _asyncMessages.front().first;
-    _asyncMessages.pop_front();
-    return msg;
+    std::pair<Object, BufferChunk> msg;
+    if (not _asyncMessages.pop(msg)) return Pothos::Object();
+    return msg.first;
 }
 
 inline void Pothos::InputPort::inlineMessagesPush(const Pothos::Label &label)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-    if (_inputInlineMessages.full()) _inputInlineMessages.set_capacity(_inputInlineMessages.capacity()*2);
-    _inputInlineMessages.push_back(label);
+    BufferLabelItem item;
+    item.kind = BufferLabelItem::LABEL;
+    item.numLabels = 1;
+    item.labels[0] = label;
+    _bufferLabelItems.push(item);
 }
 
 inline void Pothos::InputPort::inlineMessagesClear(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
+    this->bufferLabelDrain();
     _inputInlineMessages.clear();
     _inlineMessages.clear();
 }
 
 inline void Pothos::InputPort::bufferAccumulatorFront(Pothos::BufferChunk &buff)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
+    this->bufferLabelDrain();
     while (not _inputInlineMessages.empty())
     {
         const auto &front = _inputInlineMessages.front();
@@ -154,19 +162,31 @@ inline void Pothos::InputPort::bufferAccumulatorFront(Pothos::BufferChunk &buff)
 
 inline void Pothos::InputPort::bufferAccumulatorPush(const BufferChunk &buffer)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
-    this->bufferAccumulatorPushNoLock(buffer);
-    _totalBuffers++;
+    BufferLabelItem item;
+    item.kind = BufferLabelItem::PUSHED_BUFFER;
+    item.numBuffers = 1;
+    item.buffers[0] = buffer;
+    _bufferLabelItems.push(item);
 }
 
 inline void Pothos::InputPort::bufferAccumulatorRequire(const size_t numBytes)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
+    this->bufferLabelDrain();
     _bufferAccumulator.require(numBytes);
 }
 
+inline void Pothos::InputPort::bufferAccumulatorGather(void)
+{
+    _buffers.clear();
+    for (size_t i = 0; i < _bufferAccumulator.getNumChunks(); i++)
+    {
+        const auto &chunk = _bufferAccumulator.at(i);
+        if (chunk.length != 0) _buffers.push_back(chunk);
+    }
+}
+
 inline void Pothos::InputPort::bufferAccumulatorClear(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
+    this->bufferLabelDrain();
     _bufferAccumulator = BufferAccumulator();
 }
@@ -16,7 +16,7 @@
 #include <Pothos/Framework/BufferChunk.hpp>
 #include <Pothos/Framework/BufferManager.hpp>
 #include <Pothos/Util/RingDeque.hpp>
-#include <Pothos/Util/SpinLock.hpp>
+#include <Pothos/Util/MPSCQueue.hpp>
 #include <string>
 
 namespace Pothos {
@@ -158,6 +158,24 @@ public:
      */
     void setReadBeforeWrite(InputPort *port);
 
+    /*!
+     * Set the buffer manager arguments for this output port.
+     * These arguments initialize the buffer manager that the topology
+     * installs on this port, unless the manager was initialized by a block.
+     * Ports without arguments use the topology's buffer manager arguments.
+     * \param args the buffer manager init arguments
+     */
+    void setBufferManagerArgs(const BufferManagerArgs &args);
+
+    /*!
+     * Set the buffer manager type for this output port.
+     * The type is the factory name of a buffer manager plugin,
+     * and it is used when neither block provides a custom manager.
+     * Ports without a type use the topology's buffer manager type.
+     * \param type the factory name, example "generic" or "circular"
+     */
+    void setBufferManagerType(const std::string &type);
+
 private:
     WorkerActor *_actor;
 
@@ -186,10 +204,15 @@ private:
     //counts work actions which we will use to establish activity
     size_t _workEvents;
 
-    Util::SpinLock _bufferManagerLock;
+    //buffer manager configuration, empty when unspecified
+    std::shared_ptr<BufferManagerArgs> _bufferManagerArgs;
+    std::string _bufferManagerType;
+
+    //returned buffers are handed off to the actor through the return queues
+    Util::MPSCQueue<ManagedBuffer> _bufferManagerReturns;
     BufferManager::Sptr _bufferManager;
 
-    Util::SpinLock _tokenManagerLock;
+    Util::MPSCQueue<ManagedBuffer> _tokenManagerReturns;
     BufferManager::Sptr _tokenManager; //used for message backpressure
 
     /////// buffer manager /////////
@@ -197,7 +220,8 @@ private:
     bool bufferManagerEmpty(void);
     void bufferManagerFront(BufferChunk &);
     void bufferManagerPop(const size_t numBytes);
-    void bufferManagerPush(Pothos::Util::SpinLock *mutex, const ManagedBuffer &buff);
+    void bufferManagerPush(Util::MPSCQueue<ManagedBuffer> *returns, const ManagedBuffer &buff);
+    void bufferManagerDrain(Util::MPSCQueue<ManagedBuffer> &returns);
 
     /////// token manager /////////
     void tokenManagerInit(void);
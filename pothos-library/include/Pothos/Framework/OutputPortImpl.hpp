@@ -10,7 +10,6 @@
 
 #pragma once
 #include <Pothos/Framework/OutputPort.hpp>
-#include <mutex> //lock_guard
 
 inline int Pothos::OutputPort::index(void) const
 {
@@ -111,31 +110,30 @@ inline void Pothos::OutputPort::postLabel(const Label &label)
 
 inline bool Pothos::OutputPort::bufferManagerEmpty(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferManagerLock);
+    this->bufferManagerDrain(_bufferManagerReturns);
     return not _bufferManager or _bufferManager->empty();
 }
 
 inline void Pothos::OutputPort::bufferManagerFront(Pothos::BufferChunk &buff)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferManagerLock);
+    this->bufferManagerDrain(_bufferManagerReturns);
     buff = _bufferManager->front();
 }
 
 inline void Pothos::OutputPort::bufferManagerPop(const size_t numBytes)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferManagerLock);
     return _bufferManager->pop(numBytes);
 }
 
 inline bool Pothos::OutputPort::tokenManagerEmpty(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_tokenManagerLock);
+    this->bufferManagerDrain(_tokenManagerReturns);
     return _tokenManager->empty();
 }
 
 inline Pothos::BufferChunk Pothos::OutputPort::tokenManagerPop(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_tokenManagerLock);
+    this->bufferManagerDrain(_tokenManagerReturns);
     if (_tokenManager->empty()) return Pothos::BufferChunk();
     auto tok = _tokenManager->front();
     _tokenManager->pop(0);
@@ -144,6 +142,15 @@ inline Pothos::BufferChunk Pothos::OutputPort::tokenManagerPop(void)
 
 inline void Pothos::OutputPort::tokenManagerPop(const size_t numBytes)
 {
-    std::lock_guard<Util::SpinLock> lock(_tokenManagerLock);
     return _tokenManager->pop(numBytes);
 }
+
+inline void Pothos::OutputPort::bufferManagerDrain(Util::MPSCQueue<ManagedBuffer> &returns)
+{
+    ManagedBuffer buff;
+    while (returns.pop(buff))
+    {
+        auto mgr = buff.getBufferManager();
+        if (mgr) mgr->push(buff);
+    }
+}
@@ -11,6 +11,7 @@
 #pragma once
 #include <Pothos/Config.hpp>
 #include <memory> //shared_ptr
+#include <string>
 
 namespace Pothos {
 
@@ -52,6 +53,45 @@ public:
      */
     static SharedBuffer makeCirc(const size_t numBytes, const long nodeAffinity = -1);
 
+    /*!
+     * Create a SharedBuffer backed by huge pages given a length in bytes.
+     * The allocation tries explicit huge pages (MAP_HUGETLB) first,
+     * then memory that is advised for transparent huge pages,
+     * and finally falls back to the regular make() allocation.
+     * The underlying allocation is a multiple of the huge page size.
+     *
+     * \param numBytes the number of bytes to allocate in this buffer
+     * \param nodeAffinity which NUMA node to allocate on (-1 for dont care)
+     * \return a new shared buffer object
+     */
+    static SharedBuffer makeHuge(const size_t numBytes, const long nodeAffinity = -1);
+
+    /*!
+     * Create a circular SharedBuffer backed by huge pages given a length in bytes.
+     * The allocation tries a hugetlb memfd first, then a memfd mapping
+     * that is advised for transparent huge pages,
+     * and finally falls back to the regular makeCirc() allocation.
+     * The length is rounded up to a multiple of the huge page size (2 MiB typically),
+     * so the circular buffer may be larger than the requested number of bytes.
+     * The node affinity is applied to the huge page mapping when libnuma is available;
+     * the makeCirc() fallback does not bind the memory to a node.
+     *
+     * \param numBytes the number of bytes to allocate in this buffer
+     * \param nodeAffinity which NUMA node to allocate on (-1 for dont care)
+     * \return a new circular shared buffer object
+     */
+    static SharedBuffer makeHugeCirc(const size_t numBytes, const long nodeAffinity = -1);
+
+    /*!
+     * Get the statistics for huge page allocations in this process.
+     * The result is a JSON object keyed by the memory backing:
+     * "hugetlb" for explicit huge pages, "thp" for memory advised for transparent huge pages,
+     * and "fallback" for regular memory when huge pages were unavailable.
+     * Each entry contains the number of "allocations" and total "bytes".
+     * \return the allocation stats as a JSON string
+     */
+    static std::string getHugeAllocationStats(void);
+
     /*!
      * Create a SharedBuffer from address, length, and the container.
      * The container is any object that can be put into a shared_ptr.
@@ -112,6 +152,8 @@ public:
 
 private:
     static SharedBuffer makeCircUnprotected(const size_t numBytes, const long nodeAffinity);
+    static SharedBuffer makeHugeUnprotected(const size_t numBytes, const long nodeAffinity, std::string &backing);
+    static SharedBuffer makeHugeCircUnprotected(const size_t numBytes, const long nodeAffinity, std::string &backing);
     size_t _address;
     size_t _length;
     size_t _alias;
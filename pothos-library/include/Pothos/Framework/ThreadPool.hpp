@@ -41,7 +41,11 @@ public:
      *     "priority" : 0.5,
      *     "affinityMode" : "CPU",
      *     "affinity" : [0, 2, 4, 6],
-     *     "yieldMode" : "SPIN"
+     *     "yieldMode" : "HYBRID",
+     *     "spinDuration" : 50e-6,
+     *     "spinIterations" : 1000,
+     *     "spinYield" : true,
+     *     "schedulerMode" : "WORK_STEALING"
      * }
      * \endcode
      * \param json a JSON object markup string
@@ -85,12 +89,49 @@ public:
      * The yieldMode specifies the internal threading mechanisms:
      * 
      *  - "CONDITION" - Threads wait on condition variables when no work is available.
-     *  - "HYBRID" - Threads spin for a while, then yield to other threads, when no work is available.
+     *  - "HYBRID" - Threads spin for a while, then wait on condition variables, when no work is available.
      *  - "SPIN" - Threads busy-wait, without yielding, when no work is available.
      *
      * The default is "CONDITION".
      */
     std::string yieldMode;
+
+    /*!
+     * The maximum number of seconds that a thread spins in "HYBRID" yield mode
+     * before waiting on a condition variable. A value of 0.0 specifies no time limit.
+     * When both spinDuration and spinIterations are zero, threads do not spin.
+     *
+     * The default is 100 microseconds.
+     */
+    double spinDuration;
+
+    /*!
+     * The maximum number of spin iterations in "HYBRID" yield mode
+     * before waiting on a condition variable. A value of 0 specifies no iteration limit.
+     *
+     * The default is 0 (spin until the spinDuration elapses).
+     */
+    int spinIterations;
+
+    /*!
+     * Yield the processor to other threads (sched_yield on unix)
+     * on every spin iteration while spinning in "HYBRID" yield mode.
+     *
+     * The default is false.
+     */
+    bool spinYield;
+
+    /*!
+     * The schedulerMode specifies how pool threads select blocks to process:
+     *
+     *  - "ROUND_ROBIN" - Each thread polls every block in turn, looking for work.
+     *  - "WORK_STEALING" - Blocks are queued onto per-thread run queues only when
+     *    they are given work; idle threads steal from the run queues of other threads.
+     *
+     * The schedulerMode only applies to the thread-pool mechanic (numThreads > 0).
+     * The default is "ROUND_ROBIN".
+     */
+    std::string schedulerMode;
 };
 
 /*!
@@ -107,7 +148,8 @@ public:
  *    dedicated thread spawned explicitly for its execution alone.
  *
  *  - Positive values for numThreads indicate pool-mode where a
- *    fixed number of threads operate on the blocks in a round-robin fashion.
+ *    fixed number of threads operate on the blocks in a round-robin fashion,
+ *    or only on the blocks with work when the work-stealing scheduler is selected.
  *    The thread pool will never spawn more threads than there are blocks.
  */
 class POTHOS_API ThreadPool
@@ -12,6 +12,7 @@
 #include <Pothos/Config.hpp>
 #include <Pothos/Framework/Connectable.hpp>
 #include <Pothos/Framework/ThreadPool.hpp>
+#include <Pothos/Framework/BufferManager.hpp>
 #include <Pothos/Object/Object.hpp>
 #include <string>
 #include <memory>
@@ -48,6 +49,13 @@ public:
      * The special thread pool named "default" will apply
      * to all blocks that do not specify the "threadPool" key.
      *
+     * The "bufferManager" field is an optional JSON object
+     * with the default buffer manager "type" and the BufferManagerArgs
+     * fields "numBuffers", "bufferSize", and "nodeAffinity".
+     * A block can configure the buffer manager for its output ports
+     * using the optional "bufferManagers" key, which is a JSON object
+     * of output port names to objects with the same fields.
+     *
      * Example JSON markup for a topology description:
      * \code {.json}
      * {
@@ -55,6 +63,7 @@ public:
      *         "default" : {"priority" : 0.5},
      *         "myPool0" : {"yieldMode" : "SPIN"}
      *     },
+     *     "bufferManager" : {"numBuffers" : 4, "bufferSize" : 16384},
      *     "blocks" : [
      *         {
      *             "id" : "id0",
@@ -69,6 +78,9 @@ public:
      *             "id" : "id1",
      *             "path" : "/blocks/bar",
      *             "threadPool" : "myPool0",
+     *             "bufferManagers" : {
+     *                 "out0" : {"type" : "circular", "numBuffers" : 8, "bufferSize" : 65536}
+     *             },
      *             "args" : [],
      *             "calls" : [
      *                 ["setBar", "OK"],
@@ -101,6 +113,27 @@ public:
     //! Get the thread pool used by all blocks in this topology.
     const ThreadPool &getThreadPool(void) const;
 
+    /*!
+     * Set the default buffer manager arguments for this topology.
+     * The arguments apply to every output port in the committed flows
+     * that did not specify its own arguments with OutputPort::setBufferManagerArgs().
+     */
+    void setBufferManagerArgs(const BufferManagerArgs &args);
+
+    //! Get the default buffer manager arguments for this topology.
+    const BufferManagerArgs &getBufferManagerArgs(void) const;
+
+    /*!
+     * Set the default buffer manager type for this topology.
+     * The type applies to every output port in the committed flows
+     * that did not specify its own type with OutputPort::setBufferManagerType().
+     * The default type when unspecified is "generic".
+     */
+    void setBufferManagerType(const std::string &type);
+
+    //! Get the default buffer manager type for this topology.
+    const std::string &getBufferManagerType(void) const;
+
     /*!
      * Get a vector of info about all of the input ports available.
      */
@@ -58,6 +58,9 @@ public:
     /*!
      * Create a proxy environment that is interfaced over an iostream.
      * This allows for remote proxies that talk over pipes and sockets.
+     * The client and server negotiate a binary datagram format when both
+     * peers support it; set the "datagramFormat" arg to "TEXT" to force
+     * the Base64 encoded text format used by older peers.
      */
     static ProxyEnvironment::Sptr makeEnvironment(std::istream &is, std::ostream &os,
         const std::string &name, const ProxyEnvironmentArgs &args = ProxyEnvironmentArgs());
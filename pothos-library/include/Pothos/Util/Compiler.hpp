@@ -73,6 +73,14 @@ public:
      * \return the output binary generated module as a string
      */
     virtual std::string compileCppModule(const CompilerArgs &args) = 0;
+
+    /*!
+     * Get a string that identifies this compiler and its version.
+     * Caches of compiled modules use the identity as part of the key.
+     * The default implementation returns an empty string,
+     * which means that the compiler output should not be cached.
+     */
+    virtual std::string identity(void);
 };
 
 } //namespace Util
@@ -0,0 +1,175 @@
+///
+/// \file Util/MPSCQueue.hpp
+///
+/// A bounded lock-free multi-producer single-consumer queue.
+///
+/// \copyright
+/// Copyright (c) 2026 Josh Blum
+/// SPDX-License-Identifier: BSL-1.0
+///
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Util/SpinLock.hpp>
+#include <cstdlib> //size_t
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <deque>
+#include <mutex>
+
+namespace Pothos {
+namespace Util {
+
+/*!
+ * MPSCQueue is a bounded lock-free queue for many producers and one consumer.
+ * Each cell of the ring has a sequence number that tells producers
+ * when the cell is free and tells the consumer when the cell is written.
+ * A producer claims a cell with one compare and swap on the head index;
+ * with a single producer, the compare and swap never retries.
+ * The consumer owns the tail index and only loads and stores the cells.
+ *
+ * When the ring is full, producers fall back to a spin-locked overflow queue
+ * that the consumer drains after the ring, so the queue has no capacity limit
+ * and the order of elements from any one producer is always preserved.
+ *
+ * A producer that is preempted between claiming and writing a cell
+ * hides the newer elements from the consumer until the write completes;
+ * producers should notify the consumer after each push.
+ */
+template <typename T>
+class MPSCQueue
+{
+public:
+    //! Construct a new queue -- the ring capacity is rounded up to a power of two
+    MPSCQueue(const size_t capacity = 64);
+
+    //! Push an element onto the back of the queue (any thread)
+    void push(const T &elem);
+
+    /*!
+     * Pop an element from the front of the queue (consumer only)
+     * \param [out] elem the element popped from the front
+     * \return true when an element was popped, false when empty
+     */
+    bool pop(T &elem);
+
+    //! Is the queue empty? (exact only from the consumer)
+    bool empty(void) const;
+
+    //! Remove all elements from the queue (consumer only)
+    void clear(void);
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    bool tryPushRing(const T &elem);
+
+    size_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+
+    //producer and consumer indexes on separate cache lines
+    char _pad0[64];
+    std::atomic<size_t> _head;
+    char _pad1[64];
+    size_t _tail;
+    char _pad2[64];
+
+    //overflow when the ring is full
+    std::atomic<size_t> _overflowSize;
+    SpinLock _overflowLock;
+    std::deque<T> _overflow;
+};
+
+template <typename T>
+MPSCQueue<T>::MPSCQueue(const size_t capacity):
+    _mask(0),
+    _head(0),
+    _tail(0),
+    _overflowSize(0)
+{
+    size_t size = 1;
+    while (size < capacity) size *= 2;
+    _mask = size - 1;
+    _cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; i++) _cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool MPSCQueue<T>::tryPushRing(const T &elem)
+{
+    size_t pos = _head.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    while (true)
+    {
+        cell = &_cells[pos & _mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = intptr_t(seq) - intptr_t(pos);
+        if (diff == 0)
+        {
+            if (_head.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)) break;
+        }
+        else if (diff < 0) return false; //full
+        else pos = _head.load(std::memory_order_relaxed);
+    }
+    cell->data = elem;
+    cell->sequence.store(pos+1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+void MPSCQueue<T>::push(const T &elem)
+{
+    //elements go to the overflow until it drains to keep the order
+    if (_overflowSize.load(std::memory_order_acquire) == 0 and this->tryPushRing(elem)) return;
+    std::lock_guard<SpinLock> lock(_overflowLock);
+    _overflow.push_back(elem);
+    _overflowSize.fetch_add(1, std::memory_order_release);
+}
+
+template <typename T>
+bool MPSCQueue<T>::pop(T &elem)
+{
+    Cell &cell = _cells[_tail & _mask];
+    if (cell.sequence.load(std::memory_order_acquire) == _tail+1)
+    {
+        elem = cell.data;
+        cell.data = T(); //release references held by the ring
+        cell.sequence.store(_tail+_mask+1, std::memory_order_release);
+        _tail++;
+        return true;
+    }
+
+    //the overflow is only taken once the ring is drained,
+    //a claimed but unwritten cell may hold an older element
+    if (_head.load(std::memory_order_acquire) != _tail) return false;
+    if (_overflowSize.load(std::memory_order_acquire) == 0) return false;
+    std::lock_guard<SpinLock> lock(_overflowLock);
+    elem = _overflow.front();
+    _overflow.pop_front();
+    _overflowSize.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool MPSCQueue<T>::empty(void) const
+{
+    const Cell &cell = _cells[_tail & _mask];
+    if (cell.sequence.load(std::memory_order_acquire) == _tail+1) return false;
+    if (_head.load(std::memory_order_acquire) != _tail) return true;
+    return _overflowSize.load(std::memory_order_acquire) == 0;
+}
+
+template <typename T>
+void MPSCQueue<T>::clear(void)
+{
+    T elem;
+    while (this->pop(elem)){}
+}
+
+} //namespace Util
+} //namespace Pothos
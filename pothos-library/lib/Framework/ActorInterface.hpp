@@ -6,6 +6,9 @@
 #include <atomic>
 #include <mutex>
 #include <thread>
+#include <memory>
+#include <functional>
+#include <chrono>
 #include <condition_variable>
 
 /*!
@@ -17,7 +20,13 @@ public:
 
     ActorInterface(void):
         _waitModeEnabled(true),
-        _externalAcquired(0)
+        _spinModeEnabled(false),
+        _spinIterations(0),
+        _spinDuration(0),
+        _spinYield(false),
+        _readyNotifyEnabled(false),
+        _externalAcquired(0),
+        _wakeSequence(0)
     {
         _changeFlagged.test_and_set();
     }
@@ -72,10 +81,49 @@ public:
         _waitModeEnabled = enb;
     }
 
+    /*!
+     * Enable spinning before waiting on the condition variable.
+     * Spinning stops when either of the limits has been reached.
+     * \param iterations the maximum spin iterations (0 for no limit)
+     * \param duration the maximum spin time (0 for no limit)
+     * \param yield true to yield the thread on each spin iteration
+     */
+    void enableSpinMode(const size_t iterations, const std::chrono::nanoseconds &duration, const bool yield)
+    {
+        _spinModeEnabled = iterations != 0 or duration.count() != 0;
+        _spinIterations = iterations;
+        _spinDuration = duration;
+        _spinYield = yield;
+    }
+
+    //! Disable spinning before waiting on the condition variable
+    void disableSpinMode(void)
+    {
+        _spinModeEnabled = false;
+    }
+
+    /*!
+     * Set a callback to notify a scheduler that the actor may have work.
+     * The callback is invoked on every external change to the actor.
+     * Pass an empty function to disable the notifications.
+     */
+    void setReadyNotifier(const std::function<void(void)> &notifier);
+
 private:
+
+    //! Spin on the change flag within the spin limits
+    bool spinAcquire(void);
+
     bool _waitModeEnabled;
+    bool _spinModeEnabled;
+    size_t _spinIterations;
+    std::chrono::nanoseconds _spinDuration;
+    bool _spinYield;
+    std::atomic<bool> _readyNotifyEnabled;
+    std::shared_ptr<std::function<void(void)>> _readyNotifier;
     std::atomic_flag _changeFlagged;
     std::atomic<size_t> _externalAcquired;
+    std::atomic<size_t> _wakeSequence;
     std::mutex _contextMutex;
     std::mutex _acquireMutex;
     std::condition_variable _cond;
@@ -131,6 +179,15 @@ inline bool ActorInterface::workerThreadAcquire(const bool waitEnabled)
         return true;
     }
 
+    //a wake-up that arrives while spinning must not be lost in the wait
+    const size_t wakeSequence = _wakeSequence.load(std::memory_order_acquire);
+
+    //spin mode enabled -- spin on the flag before the wait
+    if (waitEnabled and _spinModeEnabled)
+    {
+        if (this->spinAcquire()) return true;
+    }
+
     //wait mode enabled -- lock and wait on condition variable
     if (waitEnabled)
     {
@@ -140,6 +197,7 @@ inline bool ActorInterface::workerThreadAcquire(const bool waitEnabled)
            _contextMutex.lock();
             return true;
         }
+        if (_wakeSequence.load(std::memory_order_acquire) != wakeSequence) return false;
         _cond.wait(lock);
         if (not _changeFlagged.test_and_set(std::memory_order_acquire))
         {
@@ -152,6 +210,29 @@ inline bool ActorInterface::workerThreadAcquire(const bool waitEnabled)
     return false;
 }
 
+inline bool ActorInterface::spinAcquire(void)
+{
+    const auto exitTime = std::chrono::high_resolution_clock::now() + _spinDuration;
+    for (size_t i = 0; _spinIterations == 0 or i < _spinIterations; i++)
+    {
+        //external context requested, bail out to block on the mutex
+        if (_externalAcquired.load(std::memory_order_acquire) != 0) return false;
+
+        if (not _changeFlagged.test_and_set(std::memory_order_acquire))
+        {
+            _contextMutex.lock();
+            return true;
+        }
+
+        if (_spinYield) std::this_thread::yield();
+
+        //check the time limit periodically to limit clock calls
+        if ((i % 16) == 15 and _spinDuration.count() != 0 and
+            std::chrono::high_resolution_clock::now() > exitTime) break;
+    }
+    return false;
+}
+
 inline void ActorInterface::workerThreadRelease(void)
 {
     _contextMutex.unlock();
@@ -164,6 +245,21 @@ inline void ActorInterface::flagExternalChange(void)
 
     //wake a blocked thread to process the change
     if (_waitModeEnabled) this->wakeNoChange();
+
+    //notify the scheduler that the actor has a change
+    if (_readyNotifyEnabled.load(std::memory_order_acquire))
+    {
+        auto notifier = std::atomic_load(&_readyNotifier);
+        if (notifier) (*notifier)();
+    }
+}
+
+inline void ActorInterface::setReadyNotifier(const std::function<void(void)> &notifier)
+{
+    std::shared_ptr<std::function<void(void)>> newNotifier;
+    if (notifier) newNotifier.reset(new std::function<void(void)>(notifier));
+    std::atomic_store(&_readyNotifier, newNotifier);
+    _readyNotifyEnabled.store(bool(newNotifier), std::memory_order_release);
 }
 
 inline void ActorInterface::wakeNoChange(void)
@@ -174,6 +270,7 @@ inline void ActorInterface::wakeNoChange(void)
 
     //otherwise we need to notify the waiting cv
     std::lock_guard<std::mutex> lock(_acquireMutex);
+    _wakeSequence++;
     _cond.notify_one();
 }
 
@@ -18,6 +18,7 @@ void Pothos::Block::setThreadPool(const ThreadPool &newThreadPool)
     if (_threadPool)
     {
         auto threads = std::static_pointer_cast<ThreadEnvironment>(_threadPool.getContainer());
+        _actor->setReadyNotifier(TaskData::Notify());
         threads->unregisterTask(this);
     }
 
@@ -25,13 +26,23 @@ void Pothos::Block::setThreadPool(const ThreadPool &newThreadPool)
     if (newThreadPool)
     {
         auto threads = std::static_pointer_cast<ThreadEnvironment>(newThreadPool.getContainer());
-        threads->registerTask(this,
+        //configure the actor interface based on thread pool args
+        //wait mode is the default, spin mode disables waiting,
+        //and hybrid mode spins for a limited time before waiting
+        const auto &args = threads->getArgs();
+        _actor->enableWaitMode(threads->isWaitingEnabled());
+        if (args.yieldMode == "HYBRID") _actor->enableSpinMode(args.spinIterations,
+            std::chrono::nanoseconds((long long)(args.spinDuration*1e9)), args.spinYield);
+        else _actor->disableSpinMode();
+
+        const auto notifier = threads->registerTask(this,
             std::bind(&Pothos::WorkerActor::processTask, _actor.get(), std::placeholders::_1),
             std::bind(&Pothos::WorkerActor::wakeNoChange, _actor.get()));
 
-        //configure the actor interface based on thread pool args
-        //all we support for now is the default (wait) or spin mode
-        _actor->enableWaitMode(threads->isWaitingEnabled());
+        //the notifier queues the actor when it has work (work-stealing mode)
+        //call it once to process any changes flagged before registration
+        _actor->setReadyNotifier(notifier);
+        if (notifier) notifier();
     }
 
     //and save the reference to the new pool
@@ -229,6 +240,11 @@ void Pothos::Block::yield(void)
     _actor->flagInternalChange();
 }
 
+void Pothos::Block::setActivateWaitsOnPeer(const bool waits)
+{
+    _actor->activateWaitsOnPeer = waits;
+}
+
 std::shared_ptr<Pothos::BufferManager> Pothos::Block::getInputBufferManager(const std::string &, const std::string &)
 {
     return Pothos::BufferManager::Sptr(); //abdicate
@@ -129,14 +129,24 @@ void Pothos::BufferAccumulator::push(const BufferChunk &buffer)
 /***********************************************************************
  * BufferAccumulator Pop implementation
  **********************************************************************/
-void Pothos::BufferAccumulator::pop(const size_t numBytes)
+void Pothos::BufferAccumulator::pop(const size_t numBytes_)
 {
     //remove num bytes from the total count
-    assert(_bytesAvailable >= numBytes);
-    _bytesAvailable -= numBytes;
+    assert(_bytesAvailable >= numBytes_);
+    _bytesAvailable -= numBytes_;
+    size_t numBytes = numBytes_;
 
-    //remove num bytes from the front of the queue
+    //remove entire buffers when the pop spans several buffers
     auto &queue = _queue;
+    while (numBytes > queue.front().length)
+    {
+        numBytes -= queue.front().length;
+        queue.pop_front();
+        _impl->inPoolBuffer = false;
+        assert(not queue.empty());
+    }
+
+    //remove num bytes from the front of the queue
     assert(not queue.empty());
     assert(queue.front().length >= numBytes);
     queue.front().address += numBytes;
@@ -1,4 +1,4 @@
-// Copyright (c) 2013-2014 Josh Blum
+// Copyright (c) 2013-2015 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework/BufferChunk.hpp>
@@ -54,15 +54,32 @@ void Pothos::BufferChunk::append(const BufferChunk &other)
         *this = other;
         return;
     }
-    //otherwise allocate and copy two buffers together
-    else
+
+    //other continues this buffer in the same memory, just extend the length
+    //(a managed buffer only holds its own slice of a pool's memory,
+    //so both must come from the same managed buffer or from none)
+    if (this->getEnd() == other.address and _buffer and _buffer == other.getBuffer() and
+        _managedBuffer == other.getManagedBuffer())
     {
-        Pothos::BufferChunk accumulator(this->length + other.length);
-        accumulator.dtype = this->dtype;
-        std::memcpy((void *)accumulator.address, (const void *)this->address, this->length);
-        std::memcpy((char *)accumulator.address+this->length, (const void *)other.address, other.length);
-        *this = accumulator;
+        this->length += other.length;
+        return;
     }
+
+    //this is the only reference to the memory and it has room at the end
+    if (not _managedBuffer and this->unique() and _buffer.getEnd() - this->getEnd() >= other.length)
+    {
+        std::memcpy((void *)this->getEnd(), (const void *)other.address, other.length);
+        this->length += other.length;
+        return;
+    }
+
+    //otherwise allocate with room to grow and copy two buffers together
+    Pothos::BufferChunk accumulator(2*(this->length + other.length));
+    accumulator.length = this->length + other.length;
+    accumulator.dtype = this->dtype;
+    std::memcpy((void *)accumulator.address, (const void *)this->address, this->length);
+    std::memcpy((char *)accumulator.address+this->length, (const void *)other.address, other.length);
+    *this = accumulator;
 }
 
 #include <Pothos/Managed.hpp>
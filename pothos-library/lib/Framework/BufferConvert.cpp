@@ -7,8 +7,33 @@
 #include <functional>
 #include <complex>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
 #include <map>
 
+/***********************************************************************
+ * element conversion:
+ * Floating point to integer truncates toward zero and saturates
+ * to the range of the output type, NaN converts to zero.
+ * This matches the SIMD kernels, so the result does not depend on the CPU.
+ **********************************************************************/
+template <typename OutType, typename InType>
+typename std::enable_if<std::is_floating_point<InType>::value and std::is_integral<OutType>::value, OutType>::type
+convertElem(const InType in)
+{
+    if (in != in) return OutType(0);
+    if (in <= InType(std::numeric_limits<OutType>::min())) return std::numeric_limits<OutType>::min();
+    if (in >= InType(std::numeric_limits<OutType>::max())) return std::numeric_limits<OutType>::max();
+    return OutType(in);
+}
+
+template <typename OutType, typename InType>
+typename std::enable_if<not (std::is_floating_point<InType>::value and std::is_integral<OutType>::value), OutType>::type
+convertElem(const InType in)
+{
+    return OutType(in);
+}
+
 /***********************************************************************
  * templated conversions
  **********************************************************************/
@@ -17,7 +42,7 @@ void rawConvert(const void *in, void *out, const size_t num)
 {
     auto inElems = reinterpret_cast<const InType *>(in);
     auto outElems = reinterpret_cast<OutType *>(out);
-    for (size_t i = 0; i < num; i++) outElems[i] = OutType(inElems[i]);
+    for (size_t i = 0; i < num; i++) outElems[i] = convertElem<OutType>(inElems[i]);
 }
 
 template <typename InType, typename OutType>
@@ -25,7 +50,7 @@ void rawConvertRealToComplex(const void *in, void *out, const size_t num)
 {
     auto inElems = reinterpret_cast<const InType *>(in);
     auto outElems = reinterpret_cast<std::complex<OutType> *>(out);
-    for (size_t i = 0; i < num; i++) outElems[i] = std::complex<OutType>(OutType(inElems[i]));
+    for (size_t i = 0; i < num; i++) outElems[i] = std::complex<OutType>(convertElem<OutType>(inElems[i]));
 }
 
 template <typename InType, typename OutType>
@@ -33,7 +58,7 @@ void rawConvertComplex(const void *in, void *out, const size_t num)
 {
     auto inElems = reinterpret_cast<const std::complex<InType> *>(in);
     auto outElems = reinterpret_cast<std::complex<OutType> *>(out);
-    for (size_t i = 0; i < num; i++) outElems[i] = std::complex<OutType>(OutType(inElems[i].real()), OutType(inElems[i].imag()));
+    for (size_t i = 0; i < num; i++) outElems[i] = std::complex<OutType>(convertElem<OutType>(inElems[i].real()), convertElem<OutType>(inElems[i].imag()));
 }
 
 template <typename InType, typename OutType>
@@ -44,9 +69,339 @@ void rawConvertComponents(const void *in, void *outRe, void *outIm, size_t num)
     auto outElemsIm = reinterpret_cast<OutType *>(outIm);
     for (size_t i = 0; i < num; i++)
     {
-        outElemsRe[i] = OutType(inElems[i].real());
-        outElemsIm[i] = OutType(inElems[i].imag());
+        outElemsRe[i] = convertElem<OutType>(inElems[i].real());
+        outElemsIm[i] = convertElem<OutType>(inElems[i].imag());
+    }
+}
+
+/***********************************************************************
+ * SIMD conversions for common types:
+ * The kernels convert the bulk of the elements in vector-sized blocks,
+ * and the remainder is converted by the scalar template conversion.
+ * The integer outputs saturate for out of range floating point inputs,
+ * and NaN converts to zero, the same as the scalar convertElem().
+ * On x86 the truncation returns INT_MIN for any value out of range,
+ * so the input is clamped from below and the lanes at or above 2^31
+ * (which is not representable in the float clamp) are flipped to INT_MAX.
+ * The best kernel for the host CPU is selected once at registration.
+ **********************************************************************/
+typedef void (*ConvertFcn)(const void *, void *, const size_t);
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POTHOS_CONVERT_X86
+#define POTHOS_TARGET_SSE2 __attribute__((target("sse2")))
+#define POTHOS_TARGET_AVX2 __attribute__((target("avx2")))
+#define POTHOS_TARGET_AVX512 __attribute__((target("avx512f")))
+#include <immintrin.h>
+static bool cpuHasSse2(void) {return __builtin_cpu_supports("sse2");}
+static bool cpuHasAvx2(void) {return __builtin_cpu_supports("avx2");}
+static bool cpuHasAvx512(void) {return __builtin_cpu_supports("avx512f");}
+
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define POTHOS_CONVERT_X86
+#define POTHOS_TARGET_SSE2
+#define POTHOS_TARGET_AVX2
+#define POTHOS_TARGET_AVX512
+#include <immintrin.h>
+#include <intrin.h>
+static bool cpuHasSse2(void) {return true;}
+static bool cpuHasAvx2(void)
+{
+    int info[4]; __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0) return false; //osxsave
+    if ((_xgetbv(0) & 0x6) != 0x6) return false; //ymm state
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+static bool cpuHasAvx512(void)
+{
+    if (not cpuHasAvx2()) return false;
+    if ((_xgetbv(0) & 0xe6) != 0xe6) return false; //zmm state
+    int info[4]; __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 16)) != 0;
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define POTHOS_CONVERT_NEON
+#include <arm_neon.h>
+#endif
+
+/*!
+ * Define a kernel that converts in blocks of the vector width.
+ * The kernel body converts the elements at in + i to out + i.
+ */
+#define POTHOS_CONVERT_KERNEL(name, target, InType, OutType, width, ...) \
+    target static void name(const void *in_, void *out_, const size_t num) \
+    { \
+        auto in = reinterpret_cast<const InType *>(in_); \
+        auto out = reinterpret_cast<OutType *>(out_); \
+        size_t i = 0; \
+        for (; i + width <= num; i += width) {__VA_ARGS__} \
+        rawConvert<InType, OutType>(in + i, out + i, num - i); \
+    }
+
+template <typename InType, typename OutType>
+ConvertFcn getSimdConvert(void)
+{
+    return nullptr;
+}
+
+/*!
+ * Specialize the kernel lookup for a pair of types.
+ * Each pair defines kernels named with an ISA suffix.
+ */
+#if defined(POTHOS_CONVERT_X86)
+#define POTHOS_CONVERT_DISPATCH(InType, OutType, name) \
+    template <> ConvertFcn getSimdConvert<InType, OutType>(void) \
+    { \
+        if (cpuHasAvx512()) return &name ## Avx512; \
+        if (cpuHasAvx2()) return &name ## Avx2; \
+        if (cpuHasSse2()) return &name ## Sse2; \
+        return nullptr; \
+    }
+#elif defined(POTHOS_CONVERT_NEON)
+#define POTHOS_CONVERT_DISPATCH(InType, OutType, name) \
+    template <> ConvertFcn getSimdConvert<InType, OutType>(void) \
+    { \
+        return &name ## Neon; \
     }
+#endif
+
+#if defined(POTHOS_CONVERT_X86)
+
+/////////////////////////////// SSE2 ///////////////////////////////
+POTHOS_TARGET_SSE2 static inline __m128i cvtF32S32Sse2(__m128 x)
+{
+    x = _mm_and_ps(x, _mm_cmpord_ps(x, x)); //NaN -> 0
+    x = _mm_max_ps(x, _mm_set1_ps(-2147483648.0f));
+    const __m128i over = _mm_castps_si128(_mm_cmpge_ps(x, _mm_set1_ps(2147483648.0f)));
+    return _mm_xor_si128(_mm_cvttps_epi32(x), over); //INT_MIN -> INT_MAX
+}
+POTHOS_TARGET_SSE2 static inline __m128i cvtF64S32Sse2(__m128d x)
+{
+    x = _mm_and_pd(x, _mm_cmpord_pd(x, x)); //NaN -> 0
+    x = _mm_max_pd(_mm_min_pd(x, _mm_set1_pd(2147483647.0)), _mm_set1_pd(-2147483648.0));
+    return _mm_cvttpd_epi32(x);
+}
+POTHOS_CONVERT_KERNEL(convertS8F32Sse2, POTHOS_TARGET_SSE2, int8_t, float, 16,
+    const __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+    const __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+    const __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8);
+    _mm_storeu_ps(out + i + 0, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16)));
+    _mm_storeu_ps(out + i + 4, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16)));
+    _mm_storeu_ps(out + i + 8, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16)));
+    _mm_storeu_ps(out + i + 12, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16)));
+)
+POTHOS_CONVERT_KERNEL(convertS16F32Sse2, POTHOS_TARGET_SSE2, int16_t, float, 8,
+    const __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+    _mm_storeu_ps(out + i + 0, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16)));
+    _mm_storeu_ps(out + i + 4, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16)));
+)
+POTHOS_CONVERT_KERNEL(convertS32F32Sse2, POTHOS_TARGET_SSE2, int32_t, float, 4,
+    _mm_storeu_ps(out + i, _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF32S8Sse2, POTHOS_TARGET_SSE2, float, int8_t, 16,
+    const __m128i a = cvtF32S32Sse2(_mm_loadu_ps(in + i + 0));
+    const __m128i b = cvtF32S32Sse2(_mm_loadu_ps(in + i + 4));
+    const __m128i c = cvtF32S32Sse2(_mm_loadu_ps(in + i + 8));
+    const __m128i d = cvtF32S32Sse2(_mm_loadu_ps(in + i + 12));
+    _mm_storeu_si128((__m128i *)(out + i), _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+)
+POTHOS_CONVERT_KERNEL(convertF32S16Sse2, POTHOS_TARGET_SSE2, float, int16_t, 8,
+    const __m128i a = cvtF32S32Sse2(_mm_loadu_ps(in + i + 0));
+    const __m128i b = cvtF32S32Sse2(_mm_loadu_ps(in + i + 4));
+    _mm_storeu_si128((__m128i *)(out + i), _mm_packs_epi32(a, b));
+)
+POTHOS_CONVERT_KERNEL(convertF32S32Sse2, POTHOS_TARGET_SSE2, float, int32_t, 4,
+    _mm_storeu_si128((__m128i *)(out + i), cvtF32S32Sse2(_mm_loadu_ps(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertF32F64Sse2, POTHOS_TARGET_SSE2, float, double, 4,
+    const __m128 x = _mm_loadu_ps(in + i);
+    _mm_storeu_pd(out + i + 0, _mm_cvtps_pd(x));
+    _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+)
+POTHOS_CONVERT_KERNEL(convertF64F32Sse2, POTHOS_TARGET_SSE2, double, float, 4,
+    const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(in + i + 0));
+    const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2));
+    _mm_storeu_ps(out + i, _mm_movelh_ps(lo, hi));
+)
+POTHOS_CONVERT_KERNEL(convertS32F64Sse2, POTHOS_TARGET_SSE2, int32_t, double, 4,
+    const __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+    _mm_storeu_pd(out + i + 0, _mm_cvtepi32_pd(x));
+    _mm_storeu_pd(out + i + 2, _mm_cvtepi32_pd(_mm_srli_si128(x, 8)));
+)
+POTHOS_CONVERT_KERNEL(convertF64S32Sse2, POTHOS_TARGET_SSE2, double, int32_t, 4,
+    const __m128i lo = cvtF64S32Sse2(_mm_loadu_pd(in + i + 0));
+    const __m128i hi = cvtF64S32Sse2(_mm_loadu_pd(in + i + 2));
+    _mm_storeu_si128((__m128i *)(out + i), _mm_unpacklo_epi64(lo, hi));
+)
+
+/////////////////////////////// AVX2 ///////////////////////////////
+POTHOS_TARGET_AVX2 static inline __m256i cvtF32S32Avx2(__m256 x)
+{
+    x = _mm256_and_ps(x, _mm256_cmp_ps(x, x, _CMP_ORD_Q)); //NaN -> 0
+    x = _mm256_max_ps(x, _mm256_set1_ps(-2147483648.0f));
+    const __m256i over = _mm256_castps_si256(_mm256_cmp_ps(x, _mm256_set1_ps(2147483648.0f), _CMP_GE_OQ));
+    return _mm256_xor_si256(_mm256_cvttps_epi32(x), over); //INT_MIN -> INT_MAX
+}
+POTHOS_TARGET_AVX2 static inline __m128i cvtF64S32Avx2(__m256d x)
+{
+    x = _mm256_and_pd(x, _mm256_cmp_pd(x, x, _CMP_ORD_Q)); //NaN -> 0
+    x = _mm256_max_pd(_mm256_min_pd(x, _mm256_set1_pd(2147483647.0)), _mm256_set1_pd(-2147483648.0));
+    return _mm256_cvttpd_epi32(x);
+}
+POTHOS_CONVERT_KERNEL(convertS8F32Avx2, POTHOS_TARGET_AVX2, int8_t, float, 8,
+    const __m256i x = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(in + i)));
+    _mm256_storeu_ps(out + i, _mm256_cvtepi32_ps(x));
+)
+POTHOS_CONVERT_KERNEL(convertS16F32Avx2, POTHOS_TARGET_AVX2, int16_t, float, 8,
+    const __m256i x = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(in + i)));
+    _mm256_storeu_ps(out + i, _mm256_cvtepi32_ps(x));
+)
+POTHOS_CONVERT_KERNEL(convertS32F32Avx2, POTHOS_TARGET_AVX2, int32_t, float, 8,
+    _mm256_storeu_ps(out + i, _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *)(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF32S8Avx2, POTHOS_TARGET_AVX2, float, int8_t, 32,
+    const __m256i a = cvtF32S32Avx2(_mm256_loadu_ps(in + i + 0));
+    const __m256i b = cvtF32S32Avx2(_mm256_loadu_ps(in + i + 8));
+    const __m256i c = cvtF32S32Avx2(_mm256_loadu_ps(in + i + 16));
+    const __m256i d = cvtF32S32Avx2(_mm256_loadu_ps(in + i + 24));
+    const __m256i x = _mm256_packs_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7); //undo the in-lane packing
+    _mm256_storeu_si256((__m256i *)(out + i), _mm256_permutevar8x32_epi32(x, order));
+)
+POTHOS_CONVERT_KERNEL(convertF32S16Avx2, POTHOS_TARGET_AVX2, float, int16_t, 16,
+    const __m256i a = cvtF32S32Avx2(_mm256_loadu_ps(in + i + 0));
+    const __m256i b = cvtF32S32Avx2(_mm256_loadu_ps(in + i + 8));
+    _mm256_storeu_si256((__m256i *)(out + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xd8));
+)
+POTHOS_CONVERT_KERNEL(convertF32S32Avx2, POTHOS_TARGET_AVX2, float, int32_t, 8,
+    _mm256_storeu_si256((__m256i *)(out + i), cvtF32S32Avx2(_mm256_loadu_ps(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertF32F64Avx2, POTHOS_TARGET_AVX2, float, double, 4,
+    _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertF64F32Avx2, POTHOS_TARGET_AVX2, double, float, 4,
+    _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertS32F64Avx2, POTHOS_TARGET_AVX2, int32_t, double, 4,
+    _mm256_storeu_pd(out + i, _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF64S32Avx2, POTHOS_TARGET_AVX2, double, int32_t, 4,
+    _mm_storeu_si128((__m128i *)(out + i), cvtF64S32Avx2(_mm256_loadu_pd(in + i)));
+)
+
+/////////////////////////////// AVX-512 ///////////////////////////////
+POTHOS_TARGET_AVX512 static inline __m512i cvtF32S32Avx512(__m512 x)
+{
+    x = _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(x, x, _CMP_ORD_Q), x); //NaN -> 0
+    x = _mm512_max_ps(x, _mm512_set1_ps(-2147483648.0f));
+    const __mmask16 over = _mm512_cmp_ps_mask(x, _mm512_set1_ps(2147483648.0f), _CMP_GE_OQ);
+    return _mm512_mask_mov_epi32(_mm512_cvttps_epi32(x), over, _mm512_set1_epi32(0x7fffffff));
+}
+POTHOS_TARGET_AVX512 static inline __m256i cvtF64S32Avx512(__m512d x)
+{
+    x = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(x, x, _CMP_ORD_Q), x); //NaN -> 0
+    x = _mm512_max_pd(_mm512_min_pd(x, _mm512_set1_pd(2147483647.0)), _mm512_set1_pd(-2147483648.0));
+    return _mm512_cvttpd_epi32(x);
+}
+POTHOS_CONVERT_KERNEL(convertS8F32Avx512, POTHOS_TARGET_AVX512, int8_t, float, 16,
+    const __m512i x = _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *)(in + i)));
+    _mm512_storeu_ps(out + i, _mm512_cvtepi32_ps(x));
+)
+POTHOS_CONVERT_KERNEL(convertS16F32Avx512, POTHOS_TARGET_AVX512, int16_t, float, 16,
+    const __m512i x = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)(in + i)));
+    _mm512_storeu_ps(out + i, _mm512_cvtepi32_ps(x));
+)
+POTHOS_CONVERT_KERNEL(convertS32F32Avx512, POTHOS_TARGET_AVX512, int32_t, float, 16,
+    _mm512_storeu_ps(out + i, _mm512_cvtepi32_ps(_mm512_loadu_si512((const void *)(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF32S8Avx512, POTHOS_TARGET_AVX512, float, int8_t, 16,
+    _mm_storeu_si128((__m128i *)(out + i), _mm512_cvtsepi32_epi8(cvtF32S32Avx512(_mm512_loadu_ps(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF32S16Avx512, POTHOS_TARGET_AVX512, float, int16_t, 16,
+    _mm256_storeu_si256((__m256i *)(out + i), _mm512_cvtsepi32_epi16(cvtF32S32Avx512(_mm512_loadu_ps(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF32S32Avx512, POTHOS_TARGET_AVX512, float, int32_t, 16,
+    _mm512_storeu_si512((void *)(out + i), cvtF32S32Avx512(_mm512_loadu_ps(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertF32F64Avx512, POTHOS_TARGET_AVX512, float, double, 8,
+    _mm512_storeu_pd(out + i, _mm512_cvtps_pd(_mm256_loadu_ps(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertF64F32Avx512, POTHOS_TARGET_AVX512, double, float, 8,
+    _mm256_storeu_ps(out + i, _mm512_cvtpd_ps(_mm512_loadu_pd(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertS32F64Avx512, POTHOS_TARGET_AVX512, int32_t, double, 8,
+    _mm512_storeu_pd(out + i, _mm512_cvtepi32_pd(_mm256_loadu_si256((const __m256i *)(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF64S32Avx512, POTHOS_TARGET_AVX512, double, int32_t, 8,
+    _mm256_storeu_si256((__m256i *)(out + i), cvtF64S32Avx512(_mm512_loadu_pd(in + i)));
+)
+
+#endif //POTHOS_CONVERT_X86
+
+#if defined(POTHOS_CONVERT_NEON)
+
+/////////////////////////////// NEON ///////////////////////////////
+POTHOS_CONVERT_KERNEL(convertS8F32Neon, , int8_t, float, 8,
+    const int16x8_t x = vmovl_s8(vld1_s8(in + i));
+    vst1q_f32(out + i + 0, vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))));
+    vst1q_f32(out + i + 4, vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))));
+)
+POTHOS_CONVERT_KERNEL(convertS16F32Neon, , int16_t, float, 4,
+    vst1q_f32(out + i, vcvtq_f32_s32(vmovl_s16(vld1_s16(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertS32F32Neon, , int32_t, float, 4,
+    vst1q_f32(out + i, vcvtq_f32_s32(vld1q_s32(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertF32S8Neon, , float, int8_t, 8,
+    const int16x4_t a = vqmovn_s32(vcvtq_s32_f32(vld1q_f32(in + i + 0)));
+    const int16x4_t b = vqmovn_s32(vcvtq_s32_f32(vld1q_f32(in + i + 4)));
+    vst1_s8(out + i, vqmovn_s16(vcombine_s16(a, b)));
+)
+POTHOS_CONVERT_KERNEL(convertF32S16Neon, , float, int16_t, 4,
+    vst1_s16(out + i, vqmovn_s32(vcvtq_s32_f32(vld1q_f32(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF32S32Neon, , float, int32_t, 4,
+    vst1q_s32(out + i, vcvtq_s32_f32(vld1q_f32(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertF32F64Neon, , float, double, 2,
+    vst1q_f64(out + i, vcvt_f64_f32(vld1_f32(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertF64F32Neon, , double, float, 2,
+    vst1_f32(out + i, vcvt_f32_f64(vld1q_f64(in + i)));
+)
+POTHOS_CONVERT_KERNEL(convertS32F64Neon, , int32_t, double, 2,
+    vst1q_f64(out + i, vcvtq_f64_s64(vmovl_s32(vld1_s32(in + i))));
+)
+POTHOS_CONVERT_KERNEL(convertF64S32Neon, , double, int32_t, 2,
+    vst1_s32(out + i, vqmovn_s64(vcvtq_s64_f64(vld1q_f64(in + i))));
+)
+
+#endif //POTHOS_CONVERT_NEON
+
+#if defined(POTHOS_CONVERT_DISPATCH)
+POTHOS_CONVERT_DISPATCH(int8_t, float, convertS8F32)
+POTHOS_CONVERT_DISPATCH(int16_t, float, convertS16F32)
+POTHOS_CONVERT_DISPATCH(int32_t, float, convertS32F32)
+POTHOS_CONVERT_DISPATCH(float, int8_t, convertF32S8)
+POTHOS_CONVERT_DISPATCH(float, int16_t, convertF32S16)
+POTHOS_CONVERT_DISPATCH(float, int32_t, convertF32S32)
+POTHOS_CONVERT_DISPATCH(float, double, convertF32F64)
+POTHOS_CONVERT_DISPATCH(double, float, convertF64F32)
+POTHOS_CONVERT_DISPATCH(int32_t, double, convertS32F64)
+POTHOS_CONVERT_DISPATCH(double, int32_t, convertF64S32)
+#endif
+
+/*!
+ * Complex to complex conversions are real conversions
+ * on the interleaved components, twice the number of elements.
+ */
+static void simdConvertComplex(const ConvertFcn fcn, const void *in, void *out, const size_t num)
+{
+    fcn(in, out, num*2);
 }
 
 /***********************************************************************
@@ -103,14 +458,18 @@ private:
     {
         int h = 0;
 
+        const auto simdConvert = getSimdConvert<InType, OutType>();
+
         h = dtypeIOToHash(Pothos::DType(typeid(InType)), Pothos::DType(typeid(OutType)));
-        convertMap[h] = std::bind(&rawConvert<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+        if (simdConvert != nullptr) convertMap[h] = simdConvert;
+        else convertMap[h] = std::bind(&rawConvert<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
         h = dtypeIOToHash(Pothos::DType(typeid(InType)), Pothos::DType(typeid(std::complex<OutType>)));
         convertMap[h] = std::bind(&rawConvertRealToComplex<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
         h = dtypeIOToHash(Pothos::DType(typeid(std::complex<InType>)), Pothos::DType(typeid(std::complex<OutType>)));
-        convertMap[h] = std::bind(&rawConvertComplex<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+        if (simdConvert != nullptr) convertMap[h] = std::bind(&simdConvertComplex, simdConvert, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+        else convertMap[h] = std::bind(&rawConvertComplex<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
         h = dtypeIOToHash(Pothos::DType(typeid(std::complex<InType>)), Pothos::DType(typeid(OutType)));
         convertComplexMap[h] = std::bind(&rawConvertComponents<InType, OutType>, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
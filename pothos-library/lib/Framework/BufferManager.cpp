@@ -29,6 +29,7 @@ Pothos::BufferManager::Sptr Pothos::BufferManager::make(const std::string &name)
         auto plugin = Pothos::PluginRegistry::get(Pothos::PluginPath("/framework/buffer_manager").join(name));
         auto callable = plugin.getObject().extract<Pothos::Callable>();
         manager = callable.call<Sptr>();
+        manager->_name = name;
     }
     catch(const Exception &ex)
     {
@@ -44,13 +45,37 @@ Pothos::BufferManager::Sptr Pothos::BufferManager::make(const std::string &name,
     return manager;
 }
 
-void Pothos::BufferManager::init(const BufferManagerArgs &)
+void Pothos::BufferManager::init(const BufferManagerArgs &args)
 {
     if(_initialized) throw BufferManagerFactoryError("Pothos::BufferManager::init()", "already initialized");
     _initialized = true;
+    _args = args;
 }
 
 void Pothos::BufferManager::setCallback(const std::function<void(const ManagedBuffer &)> &callback)
 {
     _callback = callback;
 }
+
+#include <Pothos/Managed.hpp>
+
+static auto managedBufferManagerArgs = Pothos::ManagedClass()
+    .registerConstructor<Pothos::BufferManagerArgs>()
+    .registerField(POTHOS_FCN_TUPLE(Pothos::BufferManagerArgs, numBuffers))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::BufferManagerArgs, bufferSize))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::BufferManagerArgs, nodeAffinity))
+    .commit("Pothos/BufferManagerArgs");
+
+#include <Pothos/Object/Serialize.hpp>
+
+namespace Pothos { namespace serialization {
+template <class Archive>
+void serialize(Archive &ar, Pothos::BufferManagerArgs &t, const unsigned int)
+{
+    ar & t.numBuffers;
+    ar & t.bufferSize;
+    ar & t.nodeAffinity;
+}
+}}
+
+POTHOS_OBJECT_SERIALIZE(Pothos::BufferManagerArgs)
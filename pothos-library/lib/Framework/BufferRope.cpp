@@ -0,0 +1,137 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Framework/BufferRope.hpp>
+#include <Pothos/Exception.hpp>
+#include <Poco/Format.h>
+#include <cstring> //memcpy
+#include <algorithm> //min
+
+Pothos::BufferRope::BufferRope(void):
+    _chunks(16/*arbitrary*/),
+    _length(0)
+{
+    return;
+}
+
+void Pothos::BufferRope::append(const BufferChunk &buffer)
+{
+    if (buffer.length == 0) return;
+    _length += buffer.length;
+
+    //merge into the back chunk when this continues it in the same memory
+    if (not _chunks.empty())
+    {
+        auto &back = _chunks.back();
+        if (back.getEnd() == buffer.address and back.getBuffer() and back.getBuffer() == buffer.getBuffer() and
+            back.getManagedBuffer() == buffer.getManagedBuffer()) //hold every managed buffer
+        {
+            back.length += buffer.length;
+            return;
+        }
+    }
+
+    if (_chunks.full()) _chunks.set_capacity(_chunks.capacity()*2);
+    _chunks.push_back(buffer);
+}
+
+void Pothos::BufferRope::peek(void *dst, const size_t offset, const size_t numBytes) const
+{
+    if (offset + numBytes > _length) throw Pothos::RangeException("Pothos::BufferRope::peek()",
+        Poco::format("offset %z + %z bytes exceeds %z available", offset, numBytes, _length));
+
+    auto out = reinterpret_cast<char *>(dst);
+    size_t skipBytes = offset;
+    size_t bytesLeft = numBytes;
+    for (size_t i = 0; i < _chunks.size() and bytesLeft != 0; i++)
+    {
+        const auto &chunk = _chunks[i];
+        if (skipBytes >= chunk.length)
+        {
+            skipBytes -= chunk.length;
+            continue;
+        }
+        const size_t copyBytes = std::min(bytesLeft, chunk.length - skipBytes);
+        std::memcpy(out, chunk.as<const char *>() + skipBytes, copyBytes);
+        out += copyBytes;
+        bytesLeft -= copyBytes;
+        skipBytes = 0;
+    }
+}
+
+const Pothos::BufferChunk &Pothos::BufferRope::front(const size_t numBytes)
+{
+    if (numBytes > _length) throw Pothos::RangeException("Pothos::BufferRope::front()",
+        Poco::format("%z bytes exceeds %z available", numBytes, _length));
+    if (_chunks.empty()) return BufferChunk::null();
+    if (_chunks.front().length >= numBytes) return _chunks.front();
+
+    //copy just enough of the front chunks into a new contiguous chunk
+    BufferChunk newBuffer(numBytes);
+    newBuffer.dtype = _chunks.front().dtype;
+    size_t newLength = 0;
+    while (newLength < numBytes)
+    {
+        auto &f = _chunks.front();
+        const size_t copyBytes = std::min(numBytes - newLength, f.length);
+        std::memcpy(newBuffer.as<char *>() + newLength, f.as<const void *>(), copyBytes);
+        newLength += copyBytes;
+
+        //chunk is drained, pop it, otherwise its a partial
+        if (copyBytes == f.length) _chunks.pop_front();
+        else
+        {
+            f.address += copyBytes;
+            f.length -= copyBytes;
+        }
+    }
+
+    if (_chunks.full()) _chunks.set_capacity(_chunks.capacity()*2);
+    _chunks.push_front(newBuffer);
+    return _chunks.front();
+}
+
+Pothos::BufferChunk Pothos::BufferRope::split(const size_t numBytes)
+{
+    if (numBytes == 0) return BufferChunk();
+    auto result = this->front(numBytes);
+    result.length = numBytes;
+    this->pop(numBytes);
+    return result;
+}
+
+void Pothos::BufferRope::pop(const size_t numBytes)
+{
+    if (numBytes > _length) throw Pothos::RangeException("Pothos::BufferRope::pop()",
+        Poco::format("%z bytes exceeds %z available", numBytes, _length));
+    _length -= numBytes;
+
+    size_t bytesLeft = numBytes;
+    while (bytesLeft != 0)
+    {
+        auto &f = _chunks.front();
+        if (bytesLeft >= f.length)
+        {
+            bytesLeft -= f.length;
+            _chunks.pop_front();
+        }
+        else
+        {
+            f.address += bytesLeft;
+            f.length -= bytesLeft;
+            bytesLeft = 0;
+        }
+    }
+}
+
+Pothos::BufferChunk Pothos::BufferRope::flatten(void)
+{
+    if (_length == 0) return BufferChunk();
+    return this->front(_length);
+}
+
+void Pothos::BufferRope::clear(void)
+{
+    _chunks.clear();
+    _length = 0;
+}
@@ -14,7 +14,8 @@ class CircularBufferManager :
     public std::enable_shared_from_this<CircularBufferManager>
 {
 public:
-    CircularBufferManager(void):
+    CircularBufferManager(const bool hugePages):
+        _hugePages(hugePages),
         _frontAddress(0),
         _bufferSize(0),
         _bytesToPop(0)
@@ -27,8 +28,11 @@ public:
         Pothos::BufferManager::init(args);
 
         //create the circular buffer
-        _circBuff = Pothos::SharedBuffer::makeCirc(
-            args.bufferSize*args.numBuffers, args.nodeAffinity);
+        //(huge pages mode rounds the length up to the huge page size)
+        const size_t numBytes = args.bufferSize*args.numBuffers;
+        _circBuff = _hugePages?
+            Pothos::SharedBuffer::makeHugeCirc(numBytes, args.nodeAffinity):
+            Pothos::SharedBuffer::makeCirc(numBytes, args.nodeAffinity);
 
         //init the state variables
         _frontAddress = _circBuff.getAddress();
@@ -98,6 +102,7 @@ private:
         this->setFrontBuffer(buff);
     }
 
+    const bool _hugePages;
     size_t _frontAddress;
     size_t _bufferSize;
     size_t _bytesToPop;
@@ -110,7 +115,12 @@ private:
  **********************************************************************/
 Pothos::BufferManager::Sptr makeCircularBufferManager(void)
 {
-    return std::make_shared<CircularBufferManager>();
+    return std::make_shared<CircularBufferManager>(false);
+}
+
+Pothos::BufferManager::Sptr makeCircularHugeBufferManager(void)
+{
+    return std::make_shared<CircularBufferManager>(true);
 }
 
 pothos_static_block(pothosFrameworkRegisterCircularBufferManager)
@@ -118,4 +128,7 @@ pothos_static_block(pothosFrameworkRegisterCircularBufferManager)
     Pothos::PluginRegistry::addCall(
         "/framework/buffer_manager/circular",
         &makeCircularBufferManager);
+    Pothos::PluginRegistry::addCall(
+        "/framework/buffer_manager/circular_huge",
+        &makeCircularHugeBufferManager);
 }
@@ -14,7 +14,8 @@ class GenericBufferManager :
     public std::enable_shared_from_this<GenericBufferManager>
 {
 public:
-    GenericBufferManager(void)
+    GenericBufferManager(const bool hugePages):
+        _hugePages(hugePages)
     {
         return;
     }
@@ -23,10 +24,22 @@ public:
     {
         Pothos::BufferManager::init(args);
         _readyBuffs.set_capacity(args.numBuffers);
+
+        //huge pages mode: the buffers are divided from a single slab
+        //which avoids rounding up each buffer to the huge page size.
+        //Neighbouring buffers are contiguous in memory (up to the alignment padding)
+        //and share the slab container, so chunks of different managed buffers
+        //can be address adjacent; BufferChunk::append() must not merge them.
+        const size_t stride = ((args.bufferSize + SLAB_ALIGNMENT - 1)/SLAB_ALIGNMENT)*SLAB_ALIGNMENT;
+        Pothos::SharedBuffer slab;
+        if (_hugePages and stride != 0) slab = Pothos::SharedBuffer::makeHuge(
+            stride*args.numBuffers, args.nodeAffinity);
+
         for (size_t i = 0; i < args.numBuffers; i++)
         {
-            auto sharedBuff = Pothos::SharedBuffer::make(
-                args.bufferSize, args.nodeAffinity);
+            auto sharedBuff = slab?
+                Pothos::SharedBuffer(slab.getAddress() + i*stride, args.bufferSize, slab):
+                Pothos::SharedBuffer::make(args.bufferSize, args.nodeAffinity);
             Pothos::ManagedBuffer buffer;
             buffer.reset(this->shared_from_this(), sharedBuff);
         }
@@ -66,6 +79,8 @@ public:
 
 private:
 
+    static const size_t SLAB_ALIGNMENT = 64;
+    const bool _hugePages;
     Pothos::Util::RingDeque<Pothos::ManagedBuffer> _readyBuffs;
 };
 
@@ -74,7 +89,12 @@ private:
  **********************************************************************/
 Pothos::BufferManager::Sptr makeGenericBufferManager(void)
 {
-    return std::make_shared<GenericBufferManager>();
+    return std::make_shared<GenericBufferManager>(false);
+}
+
+Pothos::BufferManager::Sptr makeGenericHugeBufferManager(void)
+{
+    return std::make_shared<GenericBufferManager>(true);
 }
 
 pothos_static_block(pothosFrameworkRegisterGenericBufferManager)
@@ -82,4 +102,7 @@ pothos_static_block(pothosFrameworkRegisterGenericBufferManager)
     Pothos::PluginRegistry::addCall(
         "/framework/buffer_manager/generic",
         &makeGenericBufferManager);
+    Pothos::PluginRegistry::addCall(
+        "/framework/buffer_manager/generic_huge",
+        &makeGenericHugeBufferManager);
 }
@@ -7,6 +7,9 @@
 #include <random>
 #include <cstdint>
 #include <complex>
+#include <cstring>
+#include <cmath>
+#include <limits>
 #include <iostream>
 
 /***********************************************************************
@@ -160,3 +163,111 @@ POTHOS_TEST_BLOCK("/framework/tests", test_buffer_convert)
     dispatchTests<long long, unsigned int>();
     dispatchTests<unsigned int, long long>();
 }
+
+/***********************************************************************
+ * accelerated conversion test cases:
+ * Use lengths that are not a multiple of the vector width to cover
+ * the remainder, and values within the range of the output type.
+ **********************************************************************/
+template <typename InType, typename OutType>
+void testBufferConvertRange(const int64_t range)
+{
+    //values in [-range, range) computed in 64 bits so that 2*range cannot overflow
+    std::mt19937 gen;
+    std::uniform_int_distribution<int64_t> dist(-range, range-1);
+    for (const size_t numElems : {1, 3, 17, 1000+13})
+    {
+        Pothos::BufferChunk b0(typeid(InType), numElems);
+        for (size_t i = 0; i < numElems; i++)
+        {
+            b0.as<InType *>()[i] = InType(dist(gen));
+        }
+        const auto b1 = b0.convert(typeid(OutType), numElems);
+        for (size_t i = 0; i < numElems; i++)
+        {
+            const auto in = b0.as<const InType *>()[i];
+            const auto out = b1.as<const OutType *>()[i];
+            POTHOS_TEST_EQUAL(OutType(in), out);
+        }
+
+        //complex to complex uses the same conversion on the interleaved components
+        Pothos::BufferChunk c0(typeid(std::complex<InType>), numElems);
+        std::memcpy(c0.as<void *>(), b0.as<const void *>(), numElems*sizeof(InType));
+        std::memcpy(c0.as<InType *>()+numElems, b0.as<const void *>(), numElems*sizeof(InType));
+        const auto c1 = c0.convert(typeid(std::complex<OutType>), numElems);
+        for (size_t i = 0; i < numElems*2; i++)
+        {
+            const auto in = c0.as<const InType *>()[i];
+            const auto out = c1.as<const OutType *>()[i];
+            POTHOS_TEST_EQUAL(OutType(in), out);
+        }
+    }
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_convert_simd)
+{
+    //integer to float
+    testBufferConvertRange<int8_t, float>(128);
+    testBufferConvertRange<int16_t, float>(32768);
+    testBufferConvertRange<int32_t, float>(1 << 24);
+
+    //float to integer
+    testBufferConvertRange<float, int8_t>(128);
+    testBufferConvertRange<float, int16_t>(32768);
+    testBufferConvertRange<float, int32_t>(1 << 24);
+
+    //float and double
+    testBufferConvertRange<float, double>(1 << 24);
+    testBufferConvertRange<double, float>(1 << 24);
+    testBufferConvertRange<int32_t, double>(1 << 30);
+    testBufferConvertRange<double, int32_t>(1 << 30);
+}
+
+/***********************************************************************
+ * saturation test cases:
+ * Out of range floating point inputs saturate and NaN converts to zero,
+ * the same for the vector body and the scalar remainder of the buffer.
+ **********************************************************************/
+template <typename InType, typename OutType>
+OutType saturateExpected(const InType in)
+{
+    if (std::isnan(in)) return OutType(0);
+    const double t = std::trunc(double(in));
+    if (t <= double(std::numeric_limits<OutType>::min())) return std::numeric_limits<OutType>::min();
+    if (t >= double(std::numeric_limits<OutType>::max())) return std::numeric_limits<OutType>::max();
+    return OutType(t);
+}
+
+template <typename InType, typename OutType>
+void testBufferConvertSaturate(void)
+{
+    const InType values[] = {
+        InType(1e10), InType(-1e10), InType(300.7), InType(-300.7),
+        InType(127.9), InType(-128.9), InType(40000.5), InType(-40000.5),
+        InType(2147483648.0), InType(-2147483904.0), InType(0.5), InType(-0.5),
+        std::numeric_limits<InType>::infinity(), -std::numeric_limits<InType>::infinity(),
+        std::numeric_limits<InType>::quiet_NaN(), InType(42)};
+    const size_t numValues = sizeof(values)/sizeof(values[0]);
+
+    const size_t numElems = 100+13;
+    Pothos::BufferChunk b0(typeid(InType), numElems);
+    for (size_t i = 0; i < numElems; i++) b0.as<InType *>()[i] = values[(i*7)%numValues];
+    const auto b1 = b0.convert(typeid(OutType), numElems);
+    const auto c1 = b0.convert(typeid(std::complex<OutType>), numElems);
+    for (size_t i = 0; i < numElems; i++)
+    {
+        const auto expected = saturateExpected<InType, OutType>(b0.as<const InType *>()[i]);
+        POTHOS_TEST_EQUAL(b1.as<const OutType *>()[i], expected);
+        POTHOS_TEST_EQUAL(c1.as<const std::complex<OutType> *>()[i].real(), expected);
+    }
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_convert_saturate)
+{
+    testBufferConvertSaturate<float, int8_t>();
+    testBufferConvertSaturate<float, int16_t>();
+    testBufferConvertSaturate<float, int32_t>();
+    testBufferConvertSaturate<double, int32_t>();
+    testBufferConvertSaturate<double, uint16_t>();
+    testBufferConvertSaturate<float, int64_t>();
+}
@@ -0,0 +1,225 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Poco/JSON/Object.h>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+static Pothos::BufferChunk makeRamp(const size_t numBytes, const size_t start)
+{
+    Pothos::BufferChunk buff(numBytes);
+    for (size_t i = 0; i < numBytes; i++) buff.as<char *>()[i] = char(start+i);
+    return buff;
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_rope)
+{
+    Pothos::BufferRope rope;
+    POTHOS_TEST_TRUE(rope.empty());
+    POTHOS_TEST_EQUAL(rope.length(), 0);
+
+    //contiguous pieces of one buffer are merged
+    auto ramp0 = makeRamp(100, 0);
+    auto half0 = ramp0; half0.length = 50;
+    auto half1 = ramp0; half1.address += 50; half1.length = 50;
+    rope.append(half0);
+    rope.append(half1);
+    POTHOS_TEST_EQUAL(rope.getNumChunks(), 1);
+    POTHOS_TEST_EQUAL(rope.length(), 100);
+    POTHOS_TEST_EQUAL(rope.at(0).address, ramp0.address);
+
+    //separate buffers are held by reference
+    rope.append(makeRamp(100, 100));
+    rope.append(makeRamp(100, 200));
+    POTHOS_TEST_EQUAL(rope.getNumChunks(), 3);
+    POTHOS_TEST_EQUAL(rope.length(), 300);
+
+    //peek across chunks
+    char peeked[20];
+    rope.peek(peeked, 90, sizeof(peeked));
+    for (size_t i = 0; i < sizeof(peeked); i++) POTHOS_TEST_EQUAL(peeked[i], char(90+i));
+    POTHOS_TEST_THROWS(rope.peek(peeked, 290, sizeof(peeked)), Pothos::RangeException);
+
+    //split within the front chunk is zero-copy
+    auto split0 = rope.split(10);
+    POTHOS_TEST_EQUAL(split0.address, ramp0.address);
+    POTHOS_TEST_EQUAL(split0.length, 10);
+    POTHOS_TEST_EQUAL(rope.length(), 290);
+
+    //split across chunks copies just those bytes
+    auto split1 = rope.split(100);
+    POTHOS_TEST_EQUAL(split1.length, 100);
+    for (size_t i = 0; i < split1.length; i++) POTHOS_TEST_EQUAL(split1.as<const char *>()[i], char(10+i));
+    POTHOS_TEST_EQUAL(rope.length(), 190);
+    POTHOS_TEST_EQUAL(rope.at(0).as<const char *>()[0], char(110));
+
+    //contiguous front access
+    const auto &front = rope.front(150);
+    POTHOS_TEST_TRUE(front.length >= 150);
+    for (size_t i = 0; i < 150; i++) POTHOS_TEST_EQUAL(front.as<const char *>()[i], char(110+i));
+    POTHOS_TEST_THROWS(rope.front(191), Pothos::RangeException);
+
+    //pop and flatten the remainder
+    rope.pop(40);
+    auto flat = rope.flatten();
+    POTHOS_TEST_EQUAL(flat.length, 150);
+    for (size_t i = 0; i < flat.length; i++) POTHOS_TEST_EQUAL(flat.as<const char *>()[i], char(150+i));
+    POTHOS_TEST_EQUAL(rope.getNumChunks(), 1);
+    rope.clear();
+    POTHOS_TEST_TRUE(rope.empty());
+    POTHOS_TEST_TRUE(not rope.flatten());
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_chunk_append)
+{
+    //contiguous append extends without a copy
+    auto ramp = makeRamp(100, 0);
+    auto acc = ramp; acc.length = 30;
+    auto rest = ramp; rest.address += 30; rest.length = 70;
+    acc.append(rest);
+    POTHOS_TEST_EQUAL(acc.address, ramp.address);
+    POTHOS_TEST_EQUAL(acc.length, 100);
+
+    //repeated appends keep the contents
+    Pothos::BufferChunk accum;
+    for (size_t i = 0; i < 10; i++) accum.append(makeRamp(10, i*10));
+    POTHOS_TEST_EQUAL(accum.length, 100);
+    for (size_t i = 0; i < accum.length; i++) POTHOS_TEST_EQUAL(accum.as<const char *>()[i], char(i));
+
+    //a shared accumulation is not overwritten by later appends
+    auto copy = accum;
+    accum.append(makeRamp(10, 100));
+    POTHOS_TEST_EQUAL(copy.length, 100);
+    POTHOS_TEST_TRUE(copy.address != accum.address);
+    for (size_t i = 0; i < accum.length; i++) POTHOS_TEST_EQUAL(accum.as<const char *>()[i], char(i));
+}
+
+/***********************************************************************
+ * Accumulation of a stream: the same bytes by every algorithm
+ **********************************************************************/
+static Pothos::BufferChunk appendCopyEach(const std::vector<Pothos::BufferChunk> &chunks)
+{
+    //the previous append algorithm: a new slab and two copies per append
+    Pothos::BufferChunk naive;
+    for (const auto &chunk : chunks)
+    {
+        Pothos::BufferChunk next(naive.length + chunk.length);
+        std::memcpy(next.as<void *>(), naive.as<const void *>(), naive.length);
+        std::memcpy(next.as<char *>()+naive.length, chunk.as<const void *>(), chunk.length);
+        naive = next;
+    }
+    return naive;
+}
+
+static Pothos::BufferChunk appendChunks(const std::vector<Pothos::BufferChunk> &chunks)
+{
+    Pothos::BufferChunk appended;
+    for (const auto &chunk : chunks) appended.append(chunk);
+    return appended;
+}
+
+static Pothos::BufferChunk appendRope(const std::vector<Pothos::BufferChunk> &chunks)
+{
+    Pothos::BufferRope rope;
+    for (const auto &chunk : chunks) rope.append(chunk);
+    return rope.flatten();
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_rope_stream)
+{
+    const size_t chunkSize = 1024;
+    const size_t numChunks = 64;
+    std::vector<Pothos::BufferChunk> chunks;
+    for (size_t i = 0; i < numChunks; i++) chunks.push_back(makeRamp(chunkSize, i));
+
+    const auto naive = appendCopyEach(chunks);
+    const auto appended = appendChunks(chunks);
+    const auto flat = appendRope(chunks);
+    POTHOS_TEST_EQUAL(naive.length, numChunks*chunkSize);
+    POTHOS_TEST_EQUAL(appended.length, numChunks*chunkSize);
+    POTHOS_TEST_EQUAL(flat.length, numChunks*chunkSize);
+    POTHOS_TEST_EQUAL(std::memcmp(naive.as<const void *>(), appended.as<const void *>(), naive.length), 0);
+    POTHOS_TEST_EQUAL(std::memcmp(naive.as<const void *>(), flat.as<const void *>(), naive.length), 0);
+}
+
+/***********************************************************************
+ * Accumulation of 4 MiB in 16 KiB chunks,
+ * run with PothosUtil --bench=framework/buffer_rope_append
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchBufferRopeAppend(void)
+{
+    const size_t chunkSize = 16*1024;
+    const size_t numChunks = 256;
+    std::vector<Pothos::BufferChunk> chunks;
+    for (size_t i = 0; i < numChunks; i++) chunks.push_back(makeRamp(chunkSize, i));
+
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    const auto time = [&metrics, &chunks](const std::string &name, Pothos::BufferChunk (*fcn)(const std::vector<Pothos::BufferChunk> &))
+    {
+        const auto t0 = std::chrono::high_resolution_clock::now();
+        const auto result = fcn(chunks);
+        const auto t1 = std::chrono::high_resolution_clock::now();
+        metrics->set(name, result.length/std::chrono::duration<double>(t1-t0).count());
+    };
+    time("copyEachBytesPerSec", &appendCopyEach);
+    time("appendBytesPerSec", &appendChunks);
+    time("ropeFlattenBytesPerSec", &appendRope);
+    return metrics;
+}
+
+pothos_static_block(pothosFrameworkRegisterBenchBufferRope)
+{
+    Pothos::PluginRegistry::add("/bench/framework/buffer_rope_append", Pothos::Callable(&benchBufferRopeAppend));
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_buffer_append_slab)
+{
+    //the huge page manager carves adjacent buffers from one slab
+    Pothos::BufferManagerArgs args;
+    args.numBuffers = 2;
+    args.bufferSize = 4096;
+    auto manager = Pothos::BufferManager::make("generic_huge", args);
+    auto b0 = manager->front();
+    manager->pop(b0.length);
+    auto b1 = manager->front();
+    manager->pop(b1.length);
+    POTHOS_TEST_TRUE(manager->empty());
+    POTHOS_TEST_EQUAL(b0.getEnd(), b1.address);
+    POTHOS_TEST_TRUE(b0.getBuffer() == b1.getBuffer());
+    std::memset(b0.as<void *>(), 'a', b0.length);
+    std::memset(b1.as<void *>(), 'b', b1.length);
+
+    //the chunks of two managed buffers are not merged
+    Pothos::BufferRope rope;
+    rope.append(b0);
+    rope.append(b1);
+    POTHOS_TEST_EQUAL(rope.getNumChunks(), 2);
+    Pothos::BufferChunk accum;
+    accum.append(b0);
+    accum.append(b1);
+    POTHOS_TEST_EQUAL(accum.length, 2*args.bufferSize);
+
+    //the rope holds both buffers, so neither returns to the manager
+    b0 = Pothos::BufferChunk();
+    b1 = Pothos::BufferChunk();
+    POTHOS_TEST_TRUE(manager->empty());
+
+    //the appended chunk keeps its bytes once the buffers are reused
+    rope = Pothos::BufferRope();
+    std::vector<Pothos::BufferChunk> reused;
+    while (not manager->empty())
+    {
+        reused.push_back(manager->front());
+        manager->pop(reused.back().length);
+        std::memset(reused.back().as<void *>(), 'x', reused.back().length);
+    }
+    POTHOS_TEST_EQUAL(reused.size(), 2);
+    for (size_t i = 0; i < accum.length; i++)
+    {
+        POTHOS_TEST_EQUAL(accum.as<const char *>()[i], (i < args.bufferSize)?'a':'b');
+    }
+}
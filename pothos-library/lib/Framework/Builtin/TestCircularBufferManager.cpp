@@ -43,3 +43,36 @@ POTHOS_TEST_BLOCK("/framework/tests", test_circular_buffer_manager)
         manager->pop(buff.length);
     }
 }
+
+POTHOS_TEST_BLOCK("/framework/tests", test_circular_huge_buffer_manager)
+{
+    Pothos::BufferManagerArgs args;
+    args.numBuffers = 2;
+    auto manager = Pothos::BufferManager::make("circular_huge", args);
+    POTHOS_TEST_TRUE(not manager->empty());
+
+    std::vector<Pothos::BufferChunk> buffs(2);
+    buffs[0] = manager->front();
+    manager->pop(buffs[0].length);
+    POTHOS_TEST_TRUE(not manager->empty());
+    buffs[1] = manager->front();
+    manager->pop(buffs[1].length);
+    POTHOS_TEST_TRUE(manager->empty());
+    POTHOS_TEST_TRUE(not (buffs[0].getManagedBuffer() == buffs[1].getManagedBuffer()));
+
+    //the circular mapping is aliased at its length
+    auto circ = buffs[0].getBuffer();
+    POTHOS_TEST_TRUE(circ.getAlias() != 0);
+    auto p = reinterpret_cast<char *>(circ.getAddress());
+    auto a = reinterpret_cast<char *>(circ.getAlias());
+    p[0] = 'x';
+    POTHOS_TEST_EQUAL(a[0], 'x');
+
+    //run through the buffers to cycle through everything
+    buffs.clear(); //release any claimed buffers
+    for (size_t i = 0; i < 100; i++)
+    {
+        auto buff = manager->front();
+        manager->pop(buff.length);
+    }
+}
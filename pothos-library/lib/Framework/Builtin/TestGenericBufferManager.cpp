@@ -24,3 +24,27 @@ POTHOS_TEST_BLOCK("/framework/tests", test_generic_buffer_manager)
     buffs.clear();
     POTHOS_TEST_TRUE(not manager->empty());
 }
+
+POTHOS_TEST_BLOCK("/framework/tests", test_generic_huge_buffer_manager)
+{
+    Pothos::BufferManagerArgs args;
+    args.numBuffers = 2;
+    auto manager = Pothos::BufferManager::make("generic_huge", args);
+    POTHOS_TEST_TRUE(not manager->empty());
+
+    std::vector<Pothos::BufferChunk> buffs(2);
+    buffs[0] = manager->front();
+    manager->pop(buffs[0].length);
+    buffs[1] = manager->front();
+    manager->pop(buffs[1].length);
+    POTHOS_TEST_TRUE(manager->empty());
+    POTHOS_TEST_TRUE(not (buffs[0].getManagedBuffer() == buffs[1].getManagedBuffer()));
+
+    //the buffers are carved from one slab with an aligned stride
+    POTHOS_TEST_EQUAL(buffs[0].address%64, 0);
+    POTHOS_TEST_EQUAL(buffs[1].address%64, 0);
+    POTHOS_TEST_TRUE(buffs[0].getBuffer() == buffs[1].getBuffer());
+
+    buffs.clear();
+    POTHOS_TEST_TRUE(not manager->empty());
+}
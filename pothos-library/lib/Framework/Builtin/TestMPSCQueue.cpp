@@ -0,0 +1,148 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Testing.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Pothos/Util/MPSCQueue.hpp>
+#include <Pothos/Util/RingDeque.hpp>
+#include <Pothos/Util/SpinLock.hpp>
+#include <functional>
+#include <Poco/JSON/Object.h>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <mutex>
+
+POTHOS_TEST_BLOCK("/framework/tests", test_mpsc_queue_basic)
+{
+    //small ring to exercise the overflow path
+    Pothos::Util::MPSCQueue<int> queue(4);
+    POTHOS_TEST_TRUE(queue.empty());
+
+    for (int i = 0; i < 10; i++) queue.push(i);
+    POTHOS_TEST_TRUE(not queue.empty());
+
+    int value = -1;
+    for (int i = 0; i < 10; i++)
+    {
+        POTHOS_TEST_TRUE(queue.pop(value));
+        POTHOS_TEST_EQUAL(value, i);
+    }
+    POTHOS_TEST_TRUE(queue.empty());
+    POTHOS_TEST_TRUE(not queue.pop(value));
+
+    //the ring is usable again after the overflow drains
+    queue.push(42);
+    POTHOS_TEST_TRUE(queue.pop(value));
+    POTHOS_TEST_EQUAL(value, 42);
+
+    for (int i = 0; i < 10; i++) queue.push(i);
+    queue.clear();
+    POTHOS_TEST_TRUE(queue.empty());
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_mpsc_queue_producers)
+{
+    const size_t numProducers = 4;
+    const size_t numElements = 20000;
+    Pothos::Util::MPSCQueue<std::pair<size_t, size_t>> queue(16);
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < numProducers; p++)
+    {
+        producers.emplace_back([&queue, p, numElements]
+        {
+            for (size_t i = 0; i < numElements; i++) queue.push(std::make_pair(p, i));
+        });
+    }
+
+    //every element arrives once and in order per producer
+    std::vector<size_t> expected(numProducers, 0);
+    size_t total = 0;
+    std::pair<size_t, size_t> elem;
+    while (total < numProducers*numElements)
+    {
+        if (not queue.pop(elem))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        POTHOS_TEST_TRUE(elem.first < numProducers);
+        POTHOS_TEST_EQUAL(elem.second, expected[elem.first]);
+        expected[elem.first]++;
+        total++;
+    }
+
+    for (auto &t : producers) t.join();
+    POTHOS_TEST_TRUE(queue.empty());
+}
+
+/***********************************************************************
+ * Contention microbenchmark: spin-locked ring deque vs MPSC queue,
+ * run with PothosUtil --bench=framework/mpsc_queue_contention
+ **********************************************************************/
+static double timeProducers(
+    const size_t numProducers, const size_t numElements,
+    const std::function<void(size_t)> &push,
+    const std::function<bool(void)> &pop)
+{
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < numProducers; p++)
+    {
+        producers.emplace_back([&push, numElements]
+        {
+            for (size_t i = 0; i < numElements; i++) push(i);
+        });
+    }
+    size_t total = 0;
+    while (total < numProducers*numElements)
+    {
+        if (pop()) total++;
+        else std::this_thread::yield();
+    }
+    for (auto &t : producers) t.join();
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t1-t0).count();
+}
+
+static Poco::JSON::Object::Ptr benchMPSCQueueContention(void)
+{
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    const size_t numElements = 100000;
+    for (const size_t numProducers : {1, 2, 4})
+    {
+        Pothos::Util::SpinLock lock;
+        Pothos::Util::RingDeque<size_t> ring;
+        const auto lockedTime = timeProducers(numProducers, numElements,
+            [&](size_t i)
+            {
+                std::lock_guard<Pothos::Util::SpinLock> l(lock);
+                if (ring.full()) ring.set_capacity(ring.capacity()*2);
+                ring.push_back(i);
+            },
+            [&](void)
+            {
+                std::lock_guard<Pothos::Util::SpinLock> l(lock);
+                if (ring.empty()) return false;
+                ring.pop_front();
+                return true;
+            });
+
+        Pothos::Util::MPSCQueue<size_t> queue;
+        size_t elem = 0;
+        const auto queueTime = timeProducers(numProducers, numElements,
+            [&](size_t i){queue.push(i);},
+            [&](void){return queue.pop(elem);});
+
+        const auto suffix = std::to_string(numProducers);
+        metrics->set("spinLockPerSec"+suffix, numProducers*numElements/lockedTime);
+        metrics->set("mpscQueuePerSec"+suffix, numProducers*numElements/queueTime);
+    }
+    return metrics;
+}
+
+pothos_static_block(pothosFrameworkRegisterBenchMPSCQueue)
+{
+    Pothos::PluginRegistry::add("/bench/framework/mpsc_queue_contention", Pothos::Callable(&benchMPSCQueueContention));
+}
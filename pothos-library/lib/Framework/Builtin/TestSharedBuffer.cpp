@@ -4,6 +4,9 @@
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework/SharedBuffer.hpp>
 #include <Pothos/Framework/Exception.hpp>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Parser.h>
+#include <iostream>
 #include <cstdlib> //rand
 
 POTHOS_TEST_BLOCK("/framework/tests", test_generic_shared_buffer)
@@ -60,3 +63,46 @@ POTHOS_TEST_BLOCK("/framework/tests", test_circular_shared_buffer)
         POTHOS_TEST_EQUAL(p[i+alias], randNum);
     }
 }
+
+POTHOS_TEST_BLOCK("/framework/tests", test_huge_shared_buffer)
+{
+    //huge pages may be unavailable, the fallback must still work
+    auto b0 = Pothos::SharedBuffer::makeHuge(4096);
+    POTHOS_TEST_TRUE(b0.getAddress() != 0);
+    POTHOS_TEST_TRUE((b0.getAddress() & 0xf) == 0); //has alignment
+    POTHOS_TEST_EQUAL(b0.getLength(), 4096);
+    for (size_t i = 0; i < b0.getLength()/sizeof(int); i++)
+    {
+        int *p = reinterpret_cast<int *>(b0.getAddress());
+        const int randNum = std::rand();
+        p[i] = randNum;
+        POTHOS_TEST_EQUAL(p[i], randNum);
+    }
+
+    auto b1 = Pothos::SharedBuffer::makeHugeCirc(4096);
+    POTHOS_TEST_TRUE(b1.getAddress() != 0);
+    POTHOS_TEST_TRUE((b1.getAddress() & 0xf) == 0); //has alignment
+    POTHOS_TEST_TRUE(b1.getLength() >= 4096);
+    POTHOS_TEST_EQUAL(b1.getAlias(), b1.getAddress() + b1.getLength());
+
+    const size_t alias = b1.getLength()/sizeof(int);
+    for (size_t i = 0; i < b1.getLength()/sizeof(int); i++)
+    {
+        int *p = reinterpret_cast<int *>(b1.getAddress());
+        const int randNum = std::rand();
+        p[i] = randNum;
+        POTHOS_TEST_EQUAL(p[i], randNum);
+        POTHOS_TEST_EQUAL(p[i+alias], randNum);
+    }
+
+    //both allocations were counted under one of the backings
+    Poco::JSON::Parser p; p.parse(Pothos::SharedBuffer::getHugeAllocationStats());
+    const auto stats = p.getHandler()->asVar().extract<Poco::JSON::Object::Ptr>();
+    size_t numAllocations = 0;
+    for (const auto &backing : {"hugetlb", "thp", "fallback"})
+    {
+        std::cout << "  " << backing << ": " << stats->getObject(backing)->getValue<size_t>("allocations") << std::endl;
+        numAllocations += stats->getObject(backing)->getValue<size_t>("allocations");
+    }
+    POTHOS_TEST_TRUE(numAllocations >= 2);
+}
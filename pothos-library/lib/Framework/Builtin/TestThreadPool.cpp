@@ -3,6 +3,14 @@
 
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Poco/JSON/Object.h>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <ctime>
 
 POTHOS_TEST_BLOCK("/framework/tests", test_thread_pool)
 {
@@ -23,4 +31,273 @@ POTHOS_TEST_BLOCK("/framework/tests", test_thread_pool)
     Pothos::ThreadPoolArgs args4;
     args4.priority = -1e6;
     POTHOS_TEST_THROWS(Pothos::ThreadPool tp4(args4), Pothos::ThreadPoolError);
+
+    Pothos::ThreadPoolArgs args5;
+    args5.schedulerMode = "FAIL";
+    POTHOS_TEST_THROWS(Pothos::ThreadPool tp5(args5), Pothos::ThreadPoolError);
+
+    Pothos::ThreadPoolArgs args6("{\"numThreads\" : 2, \"schedulerMode\" : \"WORK_STEALING\"}");
+    POTHOS_TEST_EQUAL(args6.schedulerMode, "WORK_STEALING");
+    Pothos::ThreadPool tp6(args6);
+    POTHOS_TEST_TRUE(tp6);
+
+    Pothos::ThreadPoolArgs args7("{\"yieldMode\" : \"HYBRID\", \"spinDuration\" : 0.001, \"spinIterations\" : 100, \"spinYield\" : true}");
+    POTHOS_TEST_EQUAL(args7.yieldMode, "HYBRID");
+    POTHOS_TEST_EQUAL(args7.spinDuration, 0.001);
+    POTHOS_TEST_EQUAL(args7.spinIterations, 100);
+    POTHOS_TEST_TRUE(args7.spinYield);
+    Pothos::ThreadPool tp7(args7);
+    POTHOS_TEST_TRUE(tp7);
+
+    Pothos::ThreadPoolArgs args8;
+    args8.spinDuration = -1.0;
+    POTHOS_TEST_THROWS(Pothos::ThreadPool tp8(args8), Pothos::ThreadPoolError);
+
+    Pothos::ThreadPoolArgs args9;
+    args9.spinIterations = -1;
+    POTHOS_TEST_THROWS(Pothos::ThreadPool tp9(args9), Pothos::ThreadPoolError);
+
+    Pothos::ThreadPoolArgs args10("{\"spinIterations\" : -1}");
+    POTHOS_TEST_THROWS(Pothos::ThreadPool tp10(args10), Pothos::ThreadPoolError);
+
+    //the spin limits and scheduler mode survive serialization
+    std::stringstream ss;
+    Pothos::Object(args7).serialize(ss);
+    Pothos::Object obj11; obj11.deserialize(ss);
+    const auto &args11 = obj11.extract<Pothos::ThreadPoolArgs>();
+    POTHOS_TEST_EQUAL(args11.yieldMode, "HYBRID");
+    POTHOS_TEST_EQUAL(args11.spinDuration, 0.001);
+    POTHOS_TEST_EQUAL(args11.spinIterations, 100);
+    POTHOS_TEST_TRUE(args11.spinYield);
+}
+
+/***********************************************************************
+ * Helper blocks to test the scheduler modes
+ **********************************************************************/
+//! The byte at a stream offset, verified at the end of the chain
+static unsigned char poolTestByte(const size_t offset)
+{
+    return (unsigned char)(offset % 251);
+}
+
+struct PoolTestSource : Pothos::Block
+{
+    PoolTestSource(const size_t totalBytes):
+        remaining(totalBytes)
+    {
+        this->setupOutput(0);
+    }
+
+    void work(void)
+    {
+        auto out0 = this->output(0);
+        const size_t n = std::min(remaining, out0->elements());
+        if (n == 0) return;
+        auto p = out0->buffer().as<unsigned char *>();
+        for (size_t i = 0; i < n; i++) p[i] = poolTestByte(out0->totalElements()+i);
+        out0->produce(n);
+        remaining -= n;
+    }
+
+    size_t remaining;
+};
+
+struct PoolTestCopier : Pothos::Block
+{
+    PoolTestCopier(void)
+    {
+        this->setupInput(0);
+        this->setupOutput(0);
+    }
+
+    void work(void)
+    {
+        const size_t n = this->workInfo().minElements;
+        if (n == 0) return;
+        std::memcpy(this->output(0)->buffer().as<void *>(), this->input(0)->buffer().as<const void *>(), n);
+        this->input(0)->consume(n);
+        this->output(0)->produce(n);
+    }
+};
+
+struct PoolTestSink : Pothos::Block
+{
+    PoolTestSink(void):
+        total(0),
+        errors(0)
+    {
+        this->setupInput(0);
+    }
+
+    void work(void)
+    {
+        const size_t n = this->input(0)->elements();
+        if (n == 0) return;
+        auto p = this->input(0)->buffer().as<const unsigned char *>();
+        for (size_t i = 0; i < n; i++)
+        {
+            if (p[i] != poolTestByte(total+i)) errors++;
+        }
+        this->input(0)->consume(n);
+        total += n;
+    }
+
+    std::atomic<size_t> total;
+    std::atomic<size_t> errors;
+};
+
+/*!
+ * Stream bytes through a chain of copier blocks.
+ * \return the throughput in bytes per second
+ */
+static double poolTestThroughput(const Pothos::ThreadPoolArgs &args, const size_t numCopiers, const size_t totalBytes)
+{
+    Pothos::ThreadPool tp(args);
+    auto source = std::shared_ptr<PoolTestSource>(new PoolTestSource(totalBytes));
+    auto sink = std::shared_ptr<PoolTestSink>(new PoolTestSink());
+    std::vector<std::shared_ptr<PoolTestCopier>> copiers;
+    for (size_t i = 0; i < numCopiers; i++) copiers.emplace_back(new PoolTestCopier());
+
+    source->setThreadPool(tp);
+    sink->setThreadPool(tp);
+    for (auto &copier : copiers) copier->setThreadPool(tp);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    {
+        Pothos::Topology topology;
+        std::shared_ptr<Pothos::Block> last = source;
+        for (auto &copier : copiers)
+        {
+            topology.connect(last, 0, copier, 0);
+            last = copier;
+        }
+        topology.connect(last, 0, sink, 0);
+        topology.commit();
+
+        //wait for all the bytes to arrive with a generous timeout
+        const auto exitTime = start + std::chrono::seconds(30);
+        while (sink->total != totalBytes and std::chrono::high_resolution_clock::now() < exitTime)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    const auto stop = std::chrono::high_resolution_clock::now();
+
+    POTHOS_TEST_EQUAL(size_t(sink->total), totalBytes);
+    POTHOS_TEST_EQUAL(size_t(sink->errors), 0);
+    const auto seconds = std::chrono::duration<double>(stop - start).count();
+    return totalBytes/seconds;
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_thread_pool_scheduler_modes)
+{
+    //every byte arrives in order through the chain in each mode
+    for (const std::string schedulerMode : {"ROUND_ROBIN", "WORK_STEALING"})
+    {
+        Pothos::ThreadPoolArgs args(4/*threads*/);
+        args.schedulerMode = schedulerMode;
+        poolTestThroughput(args, 8/*copiers*/, 1024*1024);
+    }
+}
+
+/***********************************************************************
+ * Scheduler throughput, run with PothosUtil --bench=framework/thread_pool_throughput
+ **********************************************************************/
+static Poco::JSON::Object::Ptr benchThreadPoolThroughput(void)
+{
+    Poco::JSON::Object::Ptr metrics(new Poco::JSON::Object());
+    const size_t totalBytes = 64*1024*1024;
+
+    Pothos::ThreadPoolArgs args0(4/*threads*/);
+    args0.schedulerMode = "ROUND_ROBIN";
+    metrics->set("roundRobinBytesPerSec", poolTestThroughput(args0, 8/*copiers*/, totalBytes));
+
+    Pothos::ThreadPoolArgs args1(4/*threads*/);
+    args1.schedulerMode = "WORK_STEALING";
+    metrics->set("workStealingBytesPerSec", poolTestThroughput(args1, 8/*copiers*/, totalBytes));
+
+    Pothos::ThreadPoolArgs args2(4/*threads*/);
+    args2.yieldMode = "HYBRID";
+    metrics->set("hybridBytesPerSec", poolTestThroughput(args2, 8/*copiers*/, totalBytes));
+
+    return metrics;
+}
+
+pothos_static_block(pothosFrameworkRegisterBenchThreadPool)
+{
+    Pothos::PluginRegistry::add("/bench/framework/thread_pool_throughput", Pothos::Callable(&benchThreadPoolThroughput));
+}
+
+/***********************************************************************
+ * Check that idle blocks do not burn CPU in the waiting modes:
+ * With the blocks idle, the threads must block waiting for work,
+ * therefore the process CPU time should be a small fraction of wall time.
+ **********************************************************************/
+static void poolTestIdleCpu(const Pothos::ThreadPoolArgs &args)
+{
+    Pothos::ThreadPool tp(args);
+
+    //a long chain of blocks that goes idle after a single buffer
+    auto source = std::shared_ptr<PoolTestSource>(new PoolTestSource(1024));
+    auto sink = std::shared_ptr<PoolTestSink>(new PoolTestSink());
+    std::vector<std::shared_ptr<PoolTestCopier>> copiers;
+    for (size_t i = 0; i < 100; i++) copiers.emplace_back(new PoolTestCopier());
+
+    source->setThreadPool(tp);
+    sink->setThreadPool(tp);
+    for (auto &copier : copiers) copier->setThreadPool(tp);
+
+    Pothos::Topology topology;
+    std::shared_ptr<Pothos::Block> last = source;
+    for (auto &copier : copiers)
+    {
+        topology.connect(last, 0, copier, 0);
+        last = copier;
+    }
+    topology.connect(last, 0, sink, 0);
+    topology.commit();
+
+    //wait for the buffer to propagate through the chain
+    const auto exitTime = std::chrono::high_resolution_clock::now() + std::chrono::seconds(10);
+    while (sink->total != 1024 and std::chrono::high_resolution_clock::now() < exitTime)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    POTHOS_TEST_EQUAL(size_t(sink->total), 1024);
+
+    //measure the CPU time used by the idle topology
+    const auto clockStart = std::clock();
+    const auto timeStart = std::chrono::high_resolution_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    const auto cpuSeconds = double(std::clock() - clockStart)/CLOCKS_PER_SEC;
+    const auto wallSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - timeStart).count();
+    POTHOS_TEST_TRUE(cpuSeconds < wallSeconds/4);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_thread_pool_idle_cpu)
+{
+    Pothos::ThreadPoolArgs args(4/*threads*/);
+    args.schedulerMode = "WORK_STEALING";
+    poolTestIdleCpu(args);
+}
+
+POTHOS_TEST_BLOCK("/framework/tests", test_thread_pool_hybrid)
+{
+    //thread per block mode, the actors spin before waiting
+    Pothos::ThreadPoolArgs args0;
+    args0.yieldMode = "HYBRID";
+    poolTestIdleCpu(args0);
+
+    //work-stealing pool mode, the threads spin before waiting
+    Pothos::ThreadPoolArgs args1(4/*threads*/);
+    args1.yieldMode = "HYBRID";
+    args1.schedulerMode = "WORK_STEALING";
+    args1.spinIterations = 1000;
+    args1.spinYield = true;
+    poolTestIdleCpu(args1);
+
+    //hybrid stream with the default spin limits
+    Pothos::ThreadPoolArgs args2(4/*threads*/);
+    args2.yieldMode = "HYBRID";
+    poolTestThroughput(args2, 8/*copiers*/, 1024*1024);
 }
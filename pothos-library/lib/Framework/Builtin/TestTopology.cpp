@@ -4,6 +4,8 @@
 #include <Pothos/Testing.hpp>
 #include <Pothos/Framework.hpp>
 #include <iostream>
+#include <chrono>
+#include <thread>
 
 /***********************************************************************
  * Helper blocks to test the rendered flow of the topology
@@ -299,3 +301,128 @@ POTHOS_TEST_BLOCK("/framework/tests/topology", test_independent_passthrough)
     POTHOS_TEST_EQUAL(pongInner->triggered, 1);
     POTHOS_TEST_EQUAL(pongOuter->triggered, 1);
 }
+
+/***********************************************************************
+ * Test incremental commit
+ * Only the blocks in changed flows are activated or deactivated
+ **********************************************************************/
+struct ActivityCounter : Pothos::Block
+{
+    ActivityCounter(void):
+        activations(0),
+        deactivations(0)
+    {
+        this->setupInput("0");
+        this->setupOutput("0");
+    }
+
+    void activate(void)
+    {
+        activations++;
+    }
+
+    void deactivate(void)
+    {
+        deactivations++;
+    }
+
+    size_t activations;
+    size_t deactivations;
+};
+
+POTHOS_TEST_BLOCK("/framework/tests/topology", test_incremental_commit)
+{
+    auto a = std::shared_ptr<ActivityCounter>(new ActivityCounter());
+    auto b = std::shared_ptr<ActivityCounter>(new ActivityCounter());
+    auto c = std::shared_ptr<ActivityCounter>(new ActivityCounter());
+    auto d = std::shared_ptr<ActivityCounter>(new ActivityCounter());
+
+    Pothos::Topology topology;
+    topology.connect(a, "0", b, "0");
+    topology.connect(b, "0", c, "0");
+    topology.commit();
+    POTHOS_TEST_EQUAL(a->activations, 1);
+    POTHOS_TEST_EQUAL(b->activations, 1);
+    POTHOS_TEST_EQUAL(c->activations, 1);
+
+    //commit without changes
+    topology.commit();
+    POTHOS_TEST_EQUAL(a->activations, 1);
+    POTHOS_TEST_EQUAL(b->activations, 1);
+    POTHOS_TEST_EQUAL(c->activations, 1);
+
+    //re-route one connection through a new block
+    topology.disconnect(b, "0", c, "0");
+    topology.connect(b, "0", d, "0");
+    topology.connect(d, "0", c, "0");
+    topology.commit();
+    POTHOS_TEST_EQUAL(d->activations, 1);
+    POTHOS_TEST_EQUAL(a->activations, 1);
+    POTHOS_TEST_EQUAL(b->activations, 1);
+    POTHOS_TEST_EQUAL(c->activations, 1);
+    POTHOS_TEST_EQUAL(b->deactivations, 0);
+    POTHOS_TEST_EQUAL(c->deactivations, 0);
+
+    //remove the new block again
+    topology.disconnect(b, "0", d, "0");
+    topology.disconnect(d, "0", c, "0");
+    topology.connect(b, "0", c, "0");
+    topology.commit();
+    POTHOS_TEST_EQUAL(d->deactivations, 1);
+    POTHOS_TEST_EQUAL(a->deactivations, 0);
+    POTHOS_TEST_EQUAL(b->deactivations, 0);
+    POTHOS_TEST_EQUAL(c->deactivations, 0);
+
+    //tear down deactivates everything once
+    topology.disconnectAll();
+    topology.commit();
+    POTHOS_TEST_EQUAL(a->deactivations, 1);
+    POTHOS_TEST_EQUAL(b->deactivations, 1);
+    POTHOS_TEST_EQUAL(c->deactivations, 1);
+    POTHOS_TEST_EQUAL(d->deactivations, 1);
+}
+
+/***********************************************************************
+ * Test wait inactive
+ * The wait ends once the flows are idle for the idle duration,
+ * and a flow that never goes idle ends the wait at the timeout.
+ **********************************************************************/
+struct Chatter : Pothos::Block
+{
+    Chatter(void)
+    {
+        this->setupOutput("out0");
+    }
+
+    void work(void)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        this->output("out0")->postMessage(0);
+    }
+};
+
+POTHOS_TEST_BLOCK("/framework/tests/topology", test_wait_inactive)
+{
+    auto ping = std::shared_ptr<Ping>(new Ping());
+    auto pong = std::shared_ptr<Pong>(new Pong());
+    Pothos::Topology idleTopology;
+    idleTopology.connect(ping, "out0", pong, "in0");
+    idleTopology.commit();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    POTHOS_TEST_TRUE(idleTopology.waitInactive(0.05, 1.0));
+    auto elapsed = std::chrono::high_resolution_clock::now() - start;
+    POTHOS_TEST_TRUE(elapsed >= std::chrono::milliseconds(50));
+    POTHOS_TEST_EQUAL(pong->triggered, 1);
+
+    auto chatter = std::shared_ptr<Chatter>(new Chatter());
+    auto sink = std::shared_ptr<Pong>(new Pong());
+    Pothos::Topology busyTopology;
+    busyTopology.connect(chatter, "out0", sink, "in0");
+    busyTopology.commit();
+
+    start = std::chrono::high_resolution_clock::now();
+    POTHOS_TEST_TRUE(not busyTopology.waitInactive(0.05, 0.2));
+    elapsed = std::chrono::high_resolution_clock::now() - start;
+    POTHOS_TEST_TRUE(elapsed >= std::chrono::milliseconds(200));
+}
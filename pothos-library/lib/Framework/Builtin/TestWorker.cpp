@@ -125,3 +125,74 @@ POTHOS_TEST_BLOCK("/framework/tests", test_activate_throw)
         POTHOS_TEST_THROWS(t.commit(), Pothos::TopologyConnectError);
     }
 }
+
+struct IdleSource : Pothos::Block
+{
+    IdleSource(void)
+    {
+        this->setupOutput(0, "float32");
+    }
+
+    void work(void)
+    {
+        return;
+    }
+};
+
+struct ScatterGatherSink : Pothos::Block
+{
+    ScatterGatherSink(void):
+        numCalls(0),
+        numChunks(0),
+        frontElements(0),
+        totalConsumed(0)
+    {
+        this->setupInput(0, "float32");
+        this->input(0)->setScatterGather(true);
+        this->input(0)->setReserve(12);
+    }
+
+    void work(void)
+    {
+        auto inPort = this->input(0);
+        if (inPort->buffers().empty()) return;
+        numCalls++;
+        numChunks = inPort->buffers().size();
+        frontElements = inPort->elements();
+        size_t elems = 0;
+        for (const auto &buff : inPort->buffers()) elems += buff.elements();
+        inPort->consume(elems);
+        totalConsumed += elems;
+    }
+
+    size_t numCalls;
+    size_t numChunks;
+    size_t frontElements;
+    size_t totalConsumed;
+};
+
+POTHOS_TEST_BLOCK("/framework/tests", test_scatter_gather_input)
+{
+    auto w0 = std::shared_ptr<IdleSource>(new IdleSource());
+    auto w1 = std::shared_ptr<ScatterGatherSink>(new ScatterGatherSink());
+
+    //preload three separate buffers, only all of them together meet the reserve
+    for (const size_t numElems : {4, 5, 3})
+    {
+        w1->input(0)->pushBuffer(Pothos::BufferChunk(Pothos::DType("float32"), numElems));
+    }
+
+    {
+        Pothos::Topology t;
+        t.connect(w0, 0, w1, 0);
+        t.commit();
+        POTHOS_TEST_TRUE(t.waitInactive());
+    }
+
+    //one call saw the three buffers without copying them together,
+    //and one consume spanned all of them
+    POTHOS_TEST_EQUAL(w1->numCalls, 1);
+    POTHOS_TEST_EQUAL(w1->numChunks, 3);
+    POTHOS_TEST_EQUAL(w1->frontElements, 4);
+    POTHOS_TEST_EQUAL(w1->totalConsumed, 12);
+}
@@ -8,6 +8,7 @@ Pothos::InputPort::InputPort(void):
     _actor(nullptr),
     _isSlot(false),
     _index(-1),
+    _scatterGather(false),
     _elements(0),
     _totalElements(0),
     _totalBuffers(0),
@@ -57,45 +58,37 @@ void Pothos::InputPort::clear(void)
 void Pothos::InputPort::asyncMessagesPush(const Pothos::Object &message, const Pothos::BufferChunk &token)
 {
     assert(_actor != nullptr);
-    std::lock_guard<Util::SpinLock> lock(_asyncMessagesLock);
-    if (_asyncMessages.full()) _asyncMessages.set_capacity(_asyncMessages.capacity()*2);
-    _asyncMessages.push_back(std::make_pair(message, token));
+    _asyncMessages.push(std::make_pair(message, token));
     _actor->flagExternalChange();
 }
 
 void Pothos::InputPort::asyncMessagesClear(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_asyncMessagesLock);
     _asyncMessages.clear();
 }
 
 void Pothos::InputPort::slotCallsPush(const Pothos::Object &args, const Pothos::BufferChunk &token)
 {
     assert(_actor != nullptr);
-    std::lock_guard<Util::SpinLock> lock(_slotCallsLock);
-    if (_slotCalls.full()) _slotCalls.set_capacity(_slotCalls.capacity()*2);
-    _slotCalls.push_back(std::make_pair(args, token));
+    _slotCalls.push(std::make_pair(args, token));
     _actor->flagExternalChange();
 }
 
 bool Pothos::InputPort::slotCallsEmpty(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_slotCallsLock);
     return _slotCalls.empty();
 }
 
 Pothos::Object Pothos::InputPort::slotCallsPop(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_slotCallsLock);
-    assert(not _slotCalls.empty());
-    auto args = _slotCalls.front().first;
-    _slotCalls.pop_front();
-    return args;
+    std::pair<Object, BufferChunk> args;
+    const bool popped = _slotCalls.pop(args);
+    assert(popped); (void)popped;
+    return args.first;
 }
 
 void Pothos::InputPort::slotCallsClear(void)
 {
-    std::lock_guard<Util::SpinLock> lock(_slotCallsLock);
     _slotCalls.clear();
 }
 
@@ -118,7 +111,7 @@ void Pothos::InputPort::bufferAccumulatorPushNoLock(const BufferChunk &buffer_)
 
 void Pothos::InputPort::bufferAccumulatorPop(const size_t numBytes)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
+    this->bufferLabelDrain();
 
     if (numBytes > _bufferAccumulator.getTotalBytesAvailable())
     {
@@ -143,29 +136,50 @@ void Pothos::InputPort::bufferLabelPush(
     const Pothos::Util::RingDeque<Pothos::BufferChunk> &postedBuffers)
 {
     assert(_actor != nullptr);
-    std::lock_guard<Util::SpinLock> lock(_bufferAccumulatorLock);
 
-    const size_t currentBytes = _bufferAccumulator.getTotalBytesAvailable();
-    const size_t requiredLabelSize = _inputInlineMessages.size() + postedLabels.size();
-    if (_inputInlineMessages.capacity() < requiredLabelSize) _inputInlineMessages.set_capacity(requiredLabelSize);
-
-    //insert labels (in order) and adjust for the current offset
-    for (const auto &byteOffsetLabel : postedLabels)
+    //one item per post: the label offsets are relative to the bytes
+    //enqueued before its buffers, which another producer must not split
+    BufferLabelItem item;
+    item.kind = BufferLabelItem::POSTED;
+    for (const auto &label : postedLabels)
     {
-        auto label = byteOffsetLabel;
-        label.index += currentBytes; //increment by enqueued bytes
-        _inputInlineMessages.push_back(label);
+        if (item.numLabels < BufferLabelItem::INLINE_SIZE) item.labels[item.numLabels++] = label;
+        else item.moreLabels.push_back(label);
     }
-
-    //push all buffers into the accumulator
     for (size_t i = 0; i < postedBuffers.size(); i++)
     {
-        this->bufferAccumulatorPushNoLock(postedBuffers[i]);
+        if (item.numBuffers < BufferLabelItem::INLINE_SIZE) item.buffers[item.numBuffers++] = postedBuffers[i];
+        else item.moreBuffers.push_back(postedBuffers[i]);
     }
+    _bufferLabelItems.push(item);
 
     _actor->flagExternalChange();
 }
 
+void Pothos::InputPort::bufferLabelDrain(void)
+{
+    BufferLabelItem item;
+    while (_bufferLabelItems.pop(item))
+    {
+        //label offsets of a post are relative to the bytes enqueued before it,
+        //a label pushed on its own already has the absolute offset
+        const size_t offset = (item.kind == BufferLabelItem::POSTED)?
+            _bufferAccumulator.getTotalBytesAvailable() : 0;
+        const auto pushLabel = [this, offset](Label &label)
+        {
+            label.index += offset;
+            if (_inputInlineMessages.full()) _inputInlineMessages.set_capacity(_inputInlineMessages.capacity()*2);
+            _inputInlineMessages.push_back(label);
+        };
+        for (size_t i = 0; i < item.numLabels; i++) pushLabel(item.labels[i]);
+        for (auto &label : item.moreLabels) pushLabel(label);
+
+        if (item.kind == BufferLabelItem::PUSHED_BUFFER) _totalBuffers++;
+        for (size_t i = 0; i < item.numBuffers; i++) this->bufferAccumulatorPushNoLock(item.buffers[i]);
+        for (const auto &buffer : item.moreBuffers) this->bufferAccumulatorPushNoLock(buffer);
+    }
+}
+
 #include <Pothos/Managed.hpp>
 
 static auto managedInputPort = Pothos::ManagedClass()
@@ -24,7 +24,19 @@ Pothos::OutputPort::OutputPort(void):
 
 Pothos::OutputPort::~OutputPort(void)
 {
-    return;
+    //return pending buffers so their release does not call back into the queues
+    this->bufferManagerDrain(_bufferManagerReturns);
+    this->bufferManagerDrain(_tokenManagerReturns);
+}
+
+void Pothos::OutputPort::setBufferManagerArgs(const BufferManagerArgs &args)
+{
+    _bufferManagerArgs.reset(new BufferManagerArgs(args));
+}
+
+void Pothos::OutputPort::setBufferManagerType(const std::string &type)
+{
+    _bufferManagerType = type;
 }
 
 void Pothos::OutputPort::_postMessage(const Object &async)
@@ -45,24 +57,20 @@ void Pothos::OutputPort::_postMessage(const Object &async)
     _workEvents++;
 }
 
-void Pothos::OutputPort::bufferManagerPush(Pothos::Util::SpinLock *mutex, const Pothos::ManagedBuffer &buff)
+void Pothos::OutputPort::bufferManagerPush(Pothos::Util::MPSCQueue<ManagedBuffer> *returns, const Pothos::ManagedBuffer &buff)
 {
-    auto mgr = buff.getBufferManager();
-    if (mgr)
-    {
-        std::lock_guard<Pothos::Util::SpinLock> lock(*mutex);
-        mgr->push(buff);
-        assert(_actor != nullptr);
-        _actor->flagExternalChange();
-    }
+    //the actor pushes the buffer back into its manager on the next drain
+    returns->push(buff);
+    assert(_actor != nullptr);
+    _actor->flagExternalChange();
 }
 
 void Pothos::OutputPort::bufferManagerSetup(const Pothos::BufferManager::Sptr &manager)
 {
-    std::lock_guard<Util::SpinLock> lock(_bufferManagerLock);
+    this->bufferManagerDrain(_bufferManagerReturns);
     _bufferManager = manager;
     if (manager) manager->setCallback(std::bind(
-        &Pothos::OutputPort::bufferManagerPush, this, &_bufferManagerLock, std::placeholders::_1));
+        &Pothos::OutputPort::bufferManagerPush, this, &_bufferManagerReturns, std::placeholders::_1));
 }
 
 void Pothos::OutputPort::tokenManagerInit(void)
@@ -72,7 +80,7 @@ void Pothos::OutputPort::tokenManagerInit(void)
     tokenMgrArgs.bufferSize = 0;
     _tokenManager = BufferManager::make("generic", tokenMgrArgs);
     _tokenManager->setCallback(std::bind(
-        &Pothos::OutputPort::bufferManagerPush, this, &_tokenManagerLock, std::placeholders::_1));
+        &Pothos::OutputPort::bufferManagerPush, this, &_tokenManagerReturns, std::placeholders::_1));
 }
 
 #include <Pothos/Managed.hpp>
@@ -94,4 +102,6 @@ static auto managedOutputPort = Pothos::ManagedClass()
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::OutputPort, postBuffer))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::OutputPort, isSignal))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::OutputPort, setReadBeforeWrite))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::OutputPort, setBufferManagerArgs))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::OutputPort, setBufferManagerType))
     .commit("Pothos/OutputPort");
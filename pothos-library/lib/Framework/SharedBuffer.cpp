@@ -5,6 +5,10 @@
 #include <Pothos/Framework/Exception.hpp>
 #include <Poco/SingletonHolder.h>
 #include <Poco/NamedMutex.h>
+#include <Poco/JSON/Object.h>
+#include <sstream>
+#include <mutex>
+#include <map>
 
 /***********************************************************************
  * shared buffer implementation
@@ -70,3 +74,84 @@ Pothos::SharedBuffer Pothos::SharedBuffer::makeCirc(const size_t numBytes, const
     }
     throw SharedBufferError("Pothos::SharedBuffer::makeCirc()", "invalid code path");
 }
+
+/***********************************************************************
+ * huge page allocation stats
+ **********************************************************************/
+struct HugeAllocationStats
+{
+    std::mutex mutex;
+    std::map<std::string, std::pair<unsigned long long, unsigned long long>> entries;
+};
+
+static HugeAllocationStats &getHugeStats(void)
+{
+    static Poco::SingletonHolder<HugeAllocationStats> sh;
+    return *sh.get();
+}
+
+static void recordHugeAllocation(const std::string &backing, const size_t numBytes)
+{
+    auto &stats = getHugeStats();
+    std::lock_guard<std::mutex> lock(stats.mutex);
+    auto &entry = stats.entries[backing];
+    entry.first++;
+    entry.second += numBytes;
+}
+
+std::string Pothos::SharedBuffer::getHugeAllocationStats(void)
+{
+    Poco::JSON::Object::Ptr statsObj(new Poco::JSON::Object());
+    auto &stats = getHugeStats();
+    std::lock_guard<std::mutex> lock(stats.mutex);
+    for (const auto &backing : {"hugetlb", "thp", "fallback"})
+    {
+        const auto &entry = stats.entries[backing];
+        Poco::JSON::Object::Ptr entryObj(new Poco::JSON::Object());
+        entryObj->set("allocations", Poco::UInt64(entry.first));
+        entryObj->set("bytes", Poco::UInt64(entry.second));
+        statsObj->set(backing, entryObj);
+    }
+    std::stringstream ss;
+    statsObj->stringify(ss);
+    return ss.str();
+}
+
+/***********************************************************************
+ * huge page buffer implementation
+ **********************************************************************/
+Pothos::SharedBuffer Pothos::SharedBuffer::makeHuge(const size_t numBytes, const long nodeAffinity)
+{
+    std::string backing;
+    SharedBuffer buff = SharedBuffer::makeHugeUnprotected(numBytes, nodeAffinity, backing);
+
+    //huge pages are not available, use the regular allocation
+    if (not buff)
+    {
+        buff = SharedBuffer::make(numBytes, nodeAffinity);
+        backing = "fallback";
+    }
+
+    recordHugeAllocation(backing, buff.getLength());
+    return buff;
+}
+
+Pothos::SharedBuffer Pothos::SharedBuffer::makeHugeCirc(const size_t numBytes, const long nodeAffinity)
+{
+    std::string backing;
+    {
+        Poco::NamedMutex::ScopedLock lock(getCircMutex());
+        SharedBuffer buff = SharedBuffer::makeHugeCircUnprotected(numBytes, nodeAffinity, backing);
+        if (buff)
+        {
+            buff._alias = buff.getAddress() + buff.getLength();
+            recordHugeAllocation(backing, buff.getLength());
+            return buff;
+        }
+    }
+
+    //huge pages are not available, use the regular allocation
+    SharedBuffer buff = SharedBuffer::makeCirc(numBytes, nodeAffinity);
+    recordHugeAllocation("fallback", buff.getLength());
+    return buff;
+}
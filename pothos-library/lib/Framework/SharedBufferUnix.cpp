@@ -11,12 +11,22 @@
 #include <cerrno> //errno
 #include <cstring> //strerror
 #include <sys/mman.h> //mmap
+#include <fstream>
+
+#ifdef __linux__
+#include <sys/syscall.h> //memfd_create
+#endif
 
 //MAP_ANON is deprecated - this supports older headers
 #ifndef MAP_ANONYMOUS
 #define MAP_ANONYMOUS MAP_ANON
 #endif
 
+//memfd_create flags - this supports older headers
+#ifndef MFD_HUGETLB
+#define MFD_HUGETLB 0x0004U
+#endif
+
 #if HAVE_LIBNUMA
 #include <numa.h>
 #endif
@@ -193,6 +203,197 @@ CircularBufferContainer::CircularBufferContainer(const size_t numBytes):
     if (mapPtr1 == MAP_FAILED) this->errorOut("mmap(1)");
 }
 
+/***********************************************************************
+ * huge page configuration values
+ **********************************************************************/
+static size_t readHugePageSize(void)
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    size_t value = 0;
+    while (meminfo >> key >> value)
+    {
+        if (key == "Hugepagesize:") return value*1024;
+        meminfo.ignore(256, '\n');
+    }
+    return 2*1024*1024;
+}
+
+static size_t getHugePageSize(void)
+{
+    static const size_t hugePageSize = readHugePageSize();
+    return hugePageSize;
+}
+
+static size_t roundUpHugePage(const size_t numBytes)
+{
+    const size_t pageSize = getHugePageSize();
+    return ((numBytes + pageSize - 1)/pageSize)*pageSize;
+}
+
+/***********************************************************************
+ * huge page allocator for a memory slab
+ **********************************************************************/
+class HugeBufferContainer
+{
+public:
+    HugeBufferContainer(const size_t numBytes, const long nodeAffinity):
+        _mem(MAP_FAILED),
+        _len(roundUpHugePage(numBytes))
+    {
+        if (_len == 0) return;
+
+        //explicit huge pages from the reserved pool
+        #ifdef MAP_HUGETLB
+        _mem = mmap(nullptr, _len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, off_t(0));
+        if (_mem != MAP_FAILED) backing = "hugetlb";
+        #endif
+
+        //transparent huge pages on a huge page aligned region
+        #ifdef MADV_HUGEPAGE
+        if (_mem == MAP_FAILED) this->mapTransparent();
+        #endif
+
+        #if HAVE_LIBNUMA
+        if (_mem != MAP_FAILED and nodeAffinity >= 0 and numa_available() != -1)
+        {
+            numa_tonode_memory(_mem, _len, int(nodeAffinity));
+        }
+        #else
+        (void)nodeAffinity;
+        #endif
+    }
+
+    ~HugeBufferContainer(void)
+    {
+        if (_mem != MAP_FAILED) munmap(_mem, _len);
+    }
+
+    size_t getAddress(void) const
+    {
+        return (_mem == MAP_FAILED)? 0 : size_t(_mem);
+    }
+
+    std::string backing;
+
+private:
+    #ifdef MADV_HUGEPAGE
+    void mapTransparent(void)
+    {
+        //over-allocate and trim the ends to align the region
+        const size_t pageSize = getHugePageSize();
+        void *mem = mmap(nullptr, _len + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, off_t(0));
+        if (mem == MAP_FAILED) return;
+        const size_t addr = ((size_t(mem) + pageSize - 1)/pageSize)*pageSize;
+        const size_t head = addr - size_t(mem);
+        if (head != 0) munmap(mem, head);
+        if (pageSize != head) munmap((void *)(addr + _len), pageSize - head);
+        _mem = (void *)addr;
+
+        if (madvise(_mem, _len, MADV_HUGEPAGE) == 0) backing = "thp";
+        else
+        {
+            munmap(_mem, _len);
+            _mem = MAP_FAILED;
+        }
+    }
+    #endif
+
+    void *_mem;
+    const size_t _len;
+};
+
+/***********************************************************************
+ * huge page allocator for a circular memory slab
+ **********************************************************************/
+class HugeCircularBufferContainer
+{
+public:
+    HugeCircularBufferContainer(const size_t numBytes, const long nodeAffinity, const bool hugetlb):
+        _numBytes(numBytes),
+        _fd(-1),
+        _mapPtr0(MAP_FAILED),
+        _mapPtr1(MAP_FAILED)
+    {
+        if (this->setup(hugetlb)) backing = hugetlb?"hugetlb":"thp";
+        else this->cleanup();
+
+        //the policy of the shared mapping applies to the memfd pages,
+        //which are placed on the node when first touched through either view
+        #if HAVE_LIBNUMA
+        if (not backing.empty() and nodeAffinity >= 0 and numa_available() != -1)
+        {
+            numa_tonode_memory(_mapPtr0, _numBytes, int(nodeAffinity));
+        }
+        #else
+        (void)nodeAffinity;
+        #endif
+    }
+
+    ~HugeCircularBufferContainer(void)
+    {
+        this->cleanup();
+    }
+
+    size_t getAddress(void) const
+    {
+        return backing.empty()? 0 : size_t(_mapPtr0);
+    }
+
+    std::string backing;
+
+private:
+    bool setup(const bool hugetlb)
+    {
+        #if defined(__linux__) && defined(SYS_memfd_create) && defined(MADV_HUGEPAGE)
+        if (_numBytes == 0) return false;
+
+        //the memfd provides the physical memory without a temp file
+        _fd = int(syscall(SYS_memfd_create, "pothos_circular_buffer", hugetlb?MFD_HUGETLB:0));
+        if (_fd < 0) return false;
+        if (ftruncate(_fd, off_t(_numBytes)) != 0) return false;
+
+        //find a huge page aligned 2X chunk of virtual memory
+        const size_t pageSize = getHugePageSize();
+        void *virtualAddr = mmap(nullptr, _numBytes*2 + pageSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, off_t(0));
+        if (virtualAddr == MAP_FAILED) return false;
+        munmap(virtualAddr, _numBytes*2 + pageSize);
+        const size_t virtualAddr2X = ((size_t(virtualAddr) + pageSize - 1)/pageSize)*pageSize;
+
+        //perform overlapping virtual mappings
+        _mapPtr0 = mmap((void *)virtualAddr2X, _numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, off_t(0));
+        if (_mapPtr0 != (void *)virtualAddr2X) return false;
+        _mapPtr1 = mmap((void *)(virtualAddr2X + _numBytes), _numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, off_t(0));
+        if (_mapPtr1 != (void *)(virtualAddr2X + _numBytes)) return false;
+
+        //advise transparent huge pages for the regular memfd
+        if (hugetlb) return true;
+        return madvise(_mapPtr0, _numBytes, MADV_HUGEPAGE) == 0 and
+            madvise(_mapPtr1, _numBytes, MADV_HUGEPAGE) == 0;
+        #else
+        (void)hugetlb;
+        return false;
+        #endif
+    }
+
+    void cleanup(void)
+    {
+        if (_mapPtr1 != MAP_FAILED) munmap(_mapPtr1, _numBytes);
+        _mapPtr1 = MAP_FAILED;
+
+        if (_mapPtr0 != MAP_FAILED) munmap(_mapPtr0, _numBytes);
+        _mapPtr0 = MAP_FAILED;
+
+        if (_fd >= 0) close(_fd);
+        _fd = -1;
+    }
+
+    const size_t _numBytes;
+    int _fd;
+    void *_mapPtr0;
+    void *_mapPtr1;
+};
+
 /***********************************************************************
  * shared buffer implementation
  **********************************************************************/
@@ -226,3 +427,25 @@ Pothos::SharedBuffer Pothos::SharedBuffer::makeCircUnprotected(const size_t numB
     std::shared_ptr<CircularBufferContainer> container(new CircularBufferContainer(numBytes));
     return SharedBuffer(container->getAddress(), numBytes, container);
 }
+
+Pothos::SharedBuffer Pothos::SharedBuffer::makeHugeUnprotected(const size_t numBytes, const long nodeAffinity, std::string &backing)
+{
+    std::shared_ptr<HugeBufferContainer> container(new HugeBufferContainer(numBytes, nodeAffinity));
+    if (container->getAddress() == 0) return SharedBuffer();
+    backing = container->backing;
+    return SharedBuffer(container->getAddress(), numBytes, container);
+}
+
+Pothos::SharedBuffer Pothos::SharedBuffer::makeHugeCircUnprotected(const size_t numBytesIn, const long nodeAffinity, std::string &backing)
+{
+    //the mirrored mappings must be huge page aligned, so the length is rounded up
+    const size_t numBytes = roundUpHugePage(numBytesIn);
+    for (const bool hugetlb : {true, false})
+    {
+        std::shared_ptr<HugeCircularBufferContainer> container(new HugeCircularBufferContainer(numBytes, nodeAffinity, hugetlb));
+        if (container->getAddress() == 0) continue;
+        backing = container->backing;
+        return SharedBuffer(container->getAddress(), numBytes, container);
+    }
+    return SharedBuffer();
+}
@@ -192,3 +192,15 @@ Pothos::SharedBuffer Pothos::SharedBuffer::makeCircUnprotected(const size_t numB
     std::shared_ptr<CircularBufferContainer> container(new CircularBufferContainer(numBytes, nodeAffinity));
     return SharedBuffer(container->getAddress(), numBytes, container);
 }
+
+Pothos::SharedBuffer Pothos::SharedBuffer::makeHugeUnprotected(const size_t, const long, std::string &)
+{
+    //large pages require the SeLockMemoryPrivilege, use the fallback allocation
+    return SharedBuffer();
+}
+
+Pothos::SharedBuffer Pothos::SharedBuffer::makeHugeCircUnprotected(const size_t, const long, std::string &)
+{
+    //large pages cannot be used with mapped views, use the fallback allocation
+    return SharedBuffer();
+}
@@ -9,9 +9,20 @@
 ThreadEnvironment::ThreadEnvironment(const Pothos::ThreadPoolArgs &args):
     _args(args),
     _waitModeEnabled(_args.yieldMode != "SPIN"),
-    _configurationSignature(0)
+    _workStealingEnabled(_args.numThreads != 0 and _args.schedulerMode == "WORK_STEALING"),
+    _configurationSignature(0),
+    _numReadyTasks(0),
+    _nextRunQueue(0),
+    _numIdleThreads(0)
 {
-    return;
+    //one run queue per thread in work-stealing mode
+    if (_workStealingEnabled)
+    {
+        for (size_t i = 0; i < _args.numThreads; i++)
+        {
+            _runQueues.push_back(std::unique_ptr<RunQueue>(new RunQueue()));
+        }
+    }
 }
 
 ThreadEnvironment::~ThreadEnvironment(void)
@@ -23,14 +34,15 @@ ThreadEnvironment::~ThreadEnvironment(void)
     }
 }
 
-void ThreadEnvironment::registerTask(void *handle, TaskData::Task task, TaskData::Wake wake)
+TaskData::Notify ThreadEnvironment::registerTask(void *handle, TaskData::Task task, TaskData::Wake wake)
 {
     std::lock_guard<std::mutex> lock(_registrationMutex);
+    std::shared_ptr<TaskData> data(new TaskData(task, wake));
 
     //register the new task and bump the signature to notify threads
     {
         std::lock_guard<std::mutex> lock0(_handleUpdateMutex);
-        _handleToTask[handle].reset(new TaskData(task, wake));
+        _handleToTask[handle] = data;
     }
     _configurationSignature++;
 
@@ -46,10 +58,15 @@ void ThreadEnvironment::registerTask(void *handle, TaskData::Task task, TaskData
         if (_threadPool.size() < _args.numThreads)
         {
             size_t index = _threadPool.size();
-            _threadPool.push_back(std::thread(std::bind(&ThreadEnvironment::poolProcessLoop, this, index)));
+            _threadPool.push_back(std::thread(std::bind(_workStealingEnabled?
+                &ThreadEnvironment::stealingProcessLoop : &ThreadEnvironment::poolProcessLoop, this, index)));
         }
         assert(_threadPool.size() <= _args.numThreads);
     }
+
+    //work-stealing mode: the task is queued by the notifier when given work
+    if (not _workStealingEnabled) return TaskData::Notify();
+    return std::bind(&ThreadEnvironment::notifyTask, this, std::weak_ptr<TaskData>(data));
 }
 
 void ThreadEnvironment::unregisterTask(void *handle)
@@ -64,11 +81,19 @@ void ThreadEnvironment::unregisterTask(void *handle)
         _handleToTask.erase(handle);
     }
     _configurationSignature++;
+    data->active = false;
 
     //wake every known task to accept the new config state
     data->wake();
     for (const auto &pair : _handleToTask) pair.second->wake();
 
+    //wake idle threads in work-stealing mode to accept the new config state
+    if (_workStealingEnabled)
+    {
+        std::lock_guard<std::mutex> lock0(_idleMutex);
+        _idleCond.notify_all();
+    }
+
     //single task mode: stop the explicit task for this handle
     if (_args.numThreads == 0)
     {
@@ -88,7 +113,13 @@ void ThreadEnvironment::unregisterTask(void *handle)
     }
 
     //wait for all threads to relinquish the old configuration
-    while (not data.unique()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    //in work-stealing mode, a late notifier may re-queue the task
+    while (true)
+    {
+        if (_workStealingEnabled) this->purgeReadyTask(data);
+        if (data.unique()) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 }
 
 /*!
@@ -179,6 +210,173 @@ void ThreadEnvironment::poolProcessLoop(size_t index)
     }
 }
 
+/*!
+ * Work-stealing scheduler mechanics:
+ * Rather than polling every task, threads only process tasks
+ * that were placed into a run queue by the task's notifier,
+ * which is called when the actor is flagged with an external change.
+ * A thread services its own run queue first and steals from
+ * the run queues of the other threads when its queue is empty.
+ *
+ * A task that performed work is re-queued by the thread that
+ * processed it, because the actor may be able to perform more work.
+ * A task that could not be acquired is dropped from the queues
+ * until its notifier is called again with new work.
+ *
+ * When a thread pops a task that is busy in another thread,
+ * the pending flag hands the notification to the busy thread,
+ * which re-queues the task after releasing it.
+ */
+
+void ThreadEnvironment::stealingProcessLoop(size_t index)
+{
+    this->applyThreadConfig();
+    size_t localSignature = 0;
+    size_t localNumTasks = 0;
+
+    while (true)
+    {
+        //check for a configuration change and update the local state
+        if (_configurationSignature != localSignature)
+        {
+            std::lock_guard<std::mutex> lock(_handleUpdateMutex);
+            localNumTasks = _handleToTask.size();
+            localSignature = _configurationSignature;
+        }
+
+        //pool mode, index out of range
+        if (index >= localNumTasks) return;
+
+        //get a ready task or wait for one
+        auto data = this->popReadyTask(index);
+        if (not data)
+        {
+            this->waitReadyTask();
+            continue;
+        }
+
+        //the task was unregistered while in the queue
+        if (not data->active) continue;
+
+        //the task is busy in another thread, hand off the notification
+        if (data->flag.test_and_set())
+        {
+            data->pending = true;
+            if (data->flag.test_and_set()) continue;
+            data->pending = false;
+        }
+
+        //perform the task and re-queue it if there may be more work
+        const bool acquired = data->task(false);
+        data->flag.clear();
+        if (data->pending.exchange(false) or acquired) this->pushReadyTask(data, index);
+    }
+}
+
+void ThreadEnvironment::pushReadyTask(const std::shared_ptr<TaskData> &data, const size_t index)
+{
+    //already queued, the queued entry will service this notification
+    if (data->queued.exchange(true)) return;
+
+    {
+        auto &runQueue = *_runQueues[index];
+        std::lock_guard<std::mutex> lock(runQueue.mutex);
+        runQueue.tasks.push_back(data);
+        _numReadyTasks++;
+    }
+
+    //wake an idle thread to process the task
+    if (_numIdleThreads.load() != 0)
+    {
+        std::lock_guard<std::mutex> lock(_idleMutex);
+        _idleCond.notify_one();
+    }
+}
+
+std::shared_ptr<TaskData> ThreadEnvironment::popReadyTask(const size_t index)
+{
+    std::shared_ptr<TaskData> data;
+    if (_numReadyTasks.load() == 0) return data;
+
+    //check the local queue first, then steal from the others
+    for (size_t i = 0; i < _runQueues.size(); i++)
+    {
+        auto &runQueue = *_runQueues[(index + i) % _runQueues.size()];
+        std::lock_guard<std::mutex> lock(runQueue.mutex);
+        if (runQueue.tasks.empty()) continue;
+        if (i == 0)
+        {
+            data = runQueue.tasks.front();
+            runQueue.tasks.pop_front();
+        }
+        else
+        {
+            data = runQueue.tasks.back();
+            runQueue.tasks.pop_back();
+        }
+        _numReadyTasks--;
+        data->queued = false;
+        break;
+    }
+
+    return data;
+}
+
+void ThreadEnvironment::waitReadyTask(void)
+{
+    //spin mode: never block waiting for a task
+    if (not _waitModeEnabled) return;
+
+    //hybrid mode: spin for a task within the limits before blocking
+    if (_args.yieldMode == "HYBRID" and (_args.spinIterations != 0 or _args.spinDuration != 0.0))
+    {
+        const auto exitTime = std::chrono::high_resolution_clock::now() +
+            std::chrono::nanoseconds((long long)(_args.spinDuration*1e9));
+        for (size_t i = 0; _args.spinIterations == 0 or i < size_t(_args.spinIterations); i++)
+        {
+            if (_numReadyTasks.load() != 0) return;
+            if (_args.spinYield) std::this_thread::yield();
+            if ((i % 16) == 15 and _args.spinDuration != 0.0 and
+                std::chrono::high_resolution_clock::now() > exitTime) break;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(_idleMutex);
+    _numIdleThreads++;
+    if (_numReadyTasks.load() == 0)
+    {
+        //the timeout bounds the latency of configuration changes
+        _idleCond.wait_for(lock, std::chrono::milliseconds(10));
+    }
+    _numIdleThreads--;
+}
+
+void ThreadEnvironment::notifyTask(const std::weak_ptr<TaskData> &weakData)
+{
+    auto data = weakData.lock();
+    if (not data or not data->active) return;
+    if (data->queued.load()) return; //fast-check already queued
+    this->pushReadyTask(data, _nextRunQueue++ % _runQueues.size());
+}
+
+void ThreadEnvironment::purgeReadyTask(const std::shared_ptr<TaskData> &data)
+{
+    for (const auto &runQueue : _runQueues)
+    {
+        std::lock_guard<std::mutex> lock(runQueue->mutex);
+        auto &tasks = runQueue->tasks;
+        for (auto it = tasks.begin(); it != tasks.end();)
+        {
+            if (*it != data) it++;
+            else
+            {
+                it = tasks.erase(it);
+                _numReadyTasks--;
+            }
+        }
+    }
+}
+
 void ThreadEnvironment::singleProcessLoop(void *handle)
 {
     this->applyThreadConfig();
@@ -10,20 +10,27 @@
 #include <atomic>
 #include <thread>
 #include <vector>
+#include <deque>
 #include <map>
+#include <condition_variable>
 
 /*!
  * Storage container for a worker task and an atomic flag.
  * The flag is used for exclusive access in pool mode.
+ * The remaining state is used by the work-stealing scheduler.
  */
 struct TaskData
 {
     typedef std::function<bool(bool)> Task;
     typedef std::function<void(void)> Wake;
+    typedef std::function<void(void)> Notify;
 
     TaskData(const Task task, const Wake wake):
         task(task),
-        wake(wake)
+        wake(wake),
+        active(true),
+        queued(false),
+        pending(false)
     {
         flag.clear(std::memory_order_release);
     }
@@ -31,6 +38,25 @@ struct TaskData
     Task task;
     Wake wake;
     std::atomic_flag flag;
+
+    //! false once the task has been unregistered
+    std::atomic<bool> active;
+
+    //! true when the task is in a run queue
+    std::atomic<bool> queued;
+
+    //! true when a thread found the task busy
+    std::atomic<bool> pending;
+};
+
+/*!
+ * A run queue of ready tasks for the work-stealing scheduler.
+ * The owner thread pops from the front, thieves from the back.
+ */
+struct RunQueue
+{
+    std::mutex mutex;
+    std::deque<std::shared_ptr<TaskData>> tasks;
 };
 
 /*!
@@ -49,8 +75,9 @@ public:
      * \param handle a unique handle representing the caller
      * \param task a function pointer to the handle worker task
      * \param wake a function pointer to wake a worker task
+     * \return a notifier for the task to call when it has work (may be empty)
      */
-    void registerTask(void *handle, TaskData::Task task, TaskData::Wake wake);
+    TaskData::Notify registerTask(void *handle, TaskData::Task task, TaskData::Wake wake);
 
     /*!
      * Unregister the task from the thread environment.
@@ -66,10 +93,11 @@ public:
 
     /*!
      * Is waiting allowed within an task?
+     * The work-stealing scheduler waits outside of the tasks.
      */
     bool isWaitingEnabled(void) const
     {
-        return _waitModeEnabled;
+        return _waitModeEnabled and not _workStealingEnabled;
     }
 
 private:
@@ -81,6 +109,29 @@ private:
      */
     void poolProcessLoop(size_t index);
 
+    /*!
+     * Process loop used in work-stealing pool mode:
+     * The index specifies the thread index and run queue.
+     * If the index is out of range given
+     * the number of handles, the thread exits.
+     */
+    void stealingProcessLoop(size_t index);
+
+    //! Push a ready task onto a run queue (ignored if already queued)
+    void pushReadyTask(const std::shared_ptr<TaskData> &data, const size_t index);
+
+    //! Pop a ready task from the indexed run queue, or steal one from another
+    std::shared_ptr<TaskData> popReadyTask(const size_t index);
+
+    //! Wait for a task to become ready (when waiting is enabled)
+    void waitReadyTask(void);
+
+    //! The notifier bound for each task in work-stealing mode
+    void notifyTask(const std::weak_ptr<TaskData> &weakData);
+
+    //! Remove a task from all run queues
+    void purgeReadyTask(const std::shared_ptr<TaskData> &data);
+
     /*!
      * Process loop used in thread per task mode.
      * If the handle is removed, the thread exists.
@@ -108,6 +159,9 @@ private:
     //whether or not waiting is allowed based on args
     bool _waitModeEnabled;
 
+    //whether or not the work-stealing scheduler is used
+    bool _workStealingEnabled;
+
     //map of handle handles to tasks
     std::map<void *, std::shared_ptr<TaskData>> _handleToTask;
 
@@ -125,4 +179,14 @@ private:
 
     //per-thread process loop done flags (used in thread pool mode)
     std::vector<std::thread> _threadPool;
+
+    //per-thread run queues (used in work-stealing mode)
+    std::vector<std::unique_ptr<RunQueue>> _runQueues;
+    std::atomic<size_t> _numReadyTasks;
+    std::atomic<size_t> _nextRunQueue;
+
+    //idle thread wait and wake-up (used in work-stealing mode)
+    std::mutex _idleMutex;
+    std::condition_variable _idleCond;
+    std::atomic<size_t> _numIdleThreads;
 };
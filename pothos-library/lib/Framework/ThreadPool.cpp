@@ -3,6 +3,7 @@
 
 #include <Pothos/Framework/ThreadPool.hpp>
 #include <Pothos/Framework/Exception.hpp>
+#include <Pothos/Exception.hpp>
 #include "Framework/ThreadEnvironment.hpp"
 #include <Poco/JSON/Object.h>
 #include <Poco/JSON/Array.h>
@@ -10,21 +11,30 @@
 
 Pothos::ThreadPoolArgs::ThreadPoolArgs(void):
     numThreads(0),
-    priority(0.0)
+    priority(0.0),
+    spinDuration(100e-6),
+    spinIterations(0),
+    spinYield(false)
 {
     return;
 }
 
 Pothos::ThreadPoolArgs::ThreadPoolArgs(const size_t numThreads):
     numThreads(numThreads),
-    priority(0.0)
+    priority(0.0),
+    spinDuration(100e-6),
+    spinIterations(0),
+    spinYield(false)
 {
     return;
 }
 
 Pothos::ThreadPoolArgs::ThreadPoolArgs(const std::string &json):
     numThreads(0),
-    priority(0.0)
+    priority(0.0),
+    spinDuration(100e-6),
+    spinIterations(0),
+    spinYield(false)
 {
     //parse to JSON object
     Poco::JSON::Parser p;
@@ -36,6 +46,10 @@ Pothos::ThreadPoolArgs::ThreadPoolArgs(const std::string &json):
     this->priority = topObj->optValue<double>("priority", 0.0);
     this->affinityMode = topObj->optValue<std::string>("affinityMode", "");
     this->yieldMode = topObj->optValue<std::string>("yieldMode", "");
+    this->spinDuration = topObj->optValue<double>("spinDuration", 100e-6);
+    this->spinIterations = topObj->optValue<int>("spinIterations", 0);
+    this->spinYield = topObj->optValue<bool>("spinYield", false);
+    this->schedulerMode = topObj->optValue<std::string>("schedulerMode", "");
 
     //parse out the affinity list
     Poco::JSON::Array::Ptr affinityArray;
@@ -73,6 +87,22 @@ Pothos::ThreadPool::ThreadPool(const ThreadPoolArgs &args)
     else if (args.yieldMode == "SPIN"){}
     else throw ThreadPoolError("Pothos::ThreadPool()", "unknown yieldMode " + args.yieldMode);
 
+    //validate the scheduler strategy
+    if (args.schedulerMode.empty()){}
+    else if (args.schedulerMode == "ROUND_ROBIN"){}
+    else if (args.schedulerMode == "WORK_STEALING"){}
+    else throw ThreadPoolError("Pothos::ThreadPool()", "unknown schedulerMode " + args.schedulerMode);
+
+    //validate the spin budget
+    if (args.spinDuration < 0.0)
+    {
+        throw ThreadPoolError("Pothos::ThreadPool()", "spinDuration out of range " + std::to_string(args.spinDuration));
+    }
+    if (args.spinIterations < 0)
+    {
+        throw ThreadPoolError("Pothos::ThreadPool()", "spinIterations out of range " + std::to_string(args.spinIterations));
+    }
+
     //validate the thread priority
     if (args.priority > +1.0 or args.priority < -1.0)
     {
@@ -109,6 +139,10 @@ static auto managedThreadPoolArgs = Pothos::ManagedClass()
     .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, affinityMode))
     .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, affinity))
     .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, yieldMode))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, spinDuration))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, spinIterations))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, spinYield))
+    .registerField(POTHOS_FCN_TUPLE(Pothos::ThreadPoolArgs, schedulerMode))
     .commit("Pothos/ThreadPoolArgs");
 
 static auto managedThreadPool = Pothos::ManagedClass()
@@ -120,16 +154,25 @@ static auto managedThreadPool = Pothos::ManagedClass()
     .commit("Pothos/ThreadPool");
 
 #include <Pothos/Object/Serialize.hpp>
+#include <Pothos/serialization/version.hpp>
+
+//version 1 added the spin limits and the scheduler mode
+POTHOS_CLASS_VERSION(Pothos::ThreadPoolArgs, 1)
 
 namespace Pothos { namespace serialization {
 template <class Archive>
-void serialize(Archive &ar, Pothos::ThreadPoolArgs &t, const unsigned int)
+void serialize(Archive &ar, Pothos::ThreadPoolArgs &t, const unsigned int version)
 {
     ar & t.numThreads;
     ar & t.priority;
     ar & t.affinityMode;
     ar & t.affinity;
     ar & t.yieldMode;
+    if (version < 1) return;
+    ar & t.spinDuration;
+    ar & t.spinIterations;
+    ar & t.spinYield;
+    ar & t.schedulerMode;
 }
 }}
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "Framework/TopologyImpl.hpp"
+#include "Framework/WorkerActor.hpp"
 #include <Pothos/Framework/Block.hpp>
 #include <Pothos/Framework/Exception.hpp>
 #include <Pothos/Object.hpp>
@@ -71,6 +72,26 @@ const Pothos::ThreadPool &Pothos::Topology::getThreadPool(void) const
     return _impl->threadPool;
 }
 
+void Pothos::Topology::setBufferManagerArgs(const BufferManagerArgs &args)
+{
+    _impl->bufferManagerArgs = args;
+}
+
+const Pothos::BufferManagerArgs &Pothos::Topology::getBufferManagerArgs(void) const
+{
+    return _impl->bufferManagerArgs;
+}
+
+void Pothos::Topology::setBufferManagerType(const std::string &type)
+{
+    _impl->bufferManagerType = type;
+}
+
+const std::string &Pothos::Topology::getBufferManagerType(void) const
+{
+    return _impl->bufferManagerType;
+}
+
 std::vector<Pothos::PortInfo> Pothos::Topology::inputPortInfo(void)
 {
     std::vector<PortInfo> infos;
@@ -239,47 +260,53 @@ void Pothos::Topology::disconnectAll(const bool recursive)
     _impl->flows.clear();
 }
 
-bool Pothos::Topology::waitInactive(const double idleDuration, const double timeout)
+/*!
+ * The time since the last activity of the actors in a sub-topology.
+ * The actors publish their activity time stamps, so this call
+ * does not make calls into the actors or the blocks.
+ */
+static long long topologyQueryIdleDuration(const Pothos::Topology &topology)
 {
-    //how long to sleep between idle checks?
-    const std::chrono::nanoseconds idleDurationNs((long long)(idleDuration*1e9));
-    const std::chrono::nanoseconds pollSleepTime(idleDurationNs/3);
-
-    //get a list of blocks to poll for idle time
-    const auto blocks = getObjSetFromFlowList(_impl->activeFlatFlows);
+    const auto now = std::chrono::high_resolution_clock::now();
+    auto idleDuration = std::chrono::nanoseconds::max();
+    for (const auto &actor : topology._impl->activeActors)
+    {
+        const auto sinceActivity = std::chrono::duration_cast<std::chrono::nanoseconds>(now - actor->queryLastActivityTime());
+        idleDuration = std::min(idleDuration, sinceActivity);
+    }
+    return idleDuration.count();
+}
 
-    //track block activity indicators and activity time stamps
-    std::vector<std::chrono::high_resolution_clock::time_point> lastActivityTime(blocks.size());
-    std::vector<int> lastActivityIndicator(blocks.size(), 0);
+bool Pothos::Topology::waitInactive(const double idleDuration, const double timeout)
+{
+    //nothing is running when there are no active flows
+    if (_impl->activeFlatFlows.empty()) return true;
 
-    //loop until exit time
+    const std::chrono::nanoseconds idleDurationNs((long long)(idleDuration*1e9));
     const auto entryTime = std::chrono::high_resolution_clock::now();
     const auto exitTime = entryTime + std::chrono::nanoseconds((long long)(timeout*1e9));
-    do
+
+    //Each sub-topology reports the idle time of its actors in one call per environment.
+    //Activity can only postpone the time when the flows become idle,
+    //so sleep until the earliest possible time and check again.
+    while (true)
     {
-        //check each worker for idle time from the stats
-        for (size_t i = 0; i < blocks.size(); i++)
+        //the flows must be idle since the entry to this call
+        auto idleTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - entryTime);
+        for (const auto &pair : _impl->remoteTopologies)
         {
-            const auto &block = blocks[i];
-            const auto activityIndicator = block.callProxy("get:_actor").call<int>("queryActivityIndicator");
-            if (lastActivityIndicator[i] != activityIndicator)
-            {
-                lastActivityTime[i] = std::chrono::high_resolution_clock::now();
-                lastActivityIndicator[i] = activityIndicator;
-            }
-            const auto workerIdleDuration = std::chrono::high_resolution_clock::now() - std::max(entryTime, lastActivityTime[i]);
-            if (workerIdleDuration < idleDurationNs) goto pollSleep;
+            idleTime = std::min(idleTime, std::chrono::nanoseconds(pair.second.call<long long>("queryIdleDuration")));
         }
 
         //all workers reached the max idle time specified
-        return true;
+        if (idleTime >= idleDurationNs) return true;
 
-        //idle time not reached on any workers, therefore sleep
-        pollSleep: std::this_thread::sleep_for(pollSleepTime);
+        const auto now = std::chrono::high_resolution_clock::now();
+        if (timeout != 0.0 and now >= exitTime) return false; //timeout
+        auto wakeTime = now + (idleDurationNs - idleTime);
+        if (timeout != 0.0) wakeTime = std::min(wakeTime, exitTime);
+        std::this_thread::sleep_until(wakeTime);
     }
-    while (std::chrono::high_resolution_clock::now() < exitTime or timeout == 0.0);
-
-    return false; //timeout
 }
 
 void Pothos::Topology::registerCallable(const std::string &name, const Callable &call)
@@ -325,10 +352,15 @@ static auto managedTopology = Pothos::ManagedClass()
     .registerStaticMethod<const std::string &, std::shared_ptr<Pothos::Topology>>(POTHOS_FCN_TUPLE(Pothos::Topology, make))
     .registerMethod("getFlows", &getFlowsFromTopology)
     .registerMethod("subCommit", &topologySubCommit)
+    .registerMethod("queryIdleDuration", &topologyQueryIdleDuration)
     .registerMethod("resolvePorts", &resolvePortsFromTopology)
     .registerMethod("resolveFlows", &resolveFlowsFromTopology)
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, setThreadPool))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, getThreadPool))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, setBufferManagerArgs))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, getBufferManagerArgs))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, setBufferManagerType))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, getBufferManagerType))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, commit))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::Topology, disconnectAll))
     .registerMethod("disconnectAll", Pothos::Callable(&Pothos::Topology::disconnectAll).bind(false, 1))
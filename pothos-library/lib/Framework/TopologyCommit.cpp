@@ -2,36 +2,98 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "Framework/TopologyImpl.hpp"
+#include "Framework/WorkerActor.hpp"
 #include <Pothos/Framework/Block.hpp>
 #include <Pothos/Framework/Exception.hpp>
 #include <Poco/Format.h>
+#include <unordered_set>
+#include <algorithm>
+#include <exception>
 #include <iostream>
 #include <future>
+#include <thread>
+#include <atomic>
+#include <mutex>
 
-struct FutureInfo
+/***********************************************************************
+ * bounded parallel execution of topology tasks
+ **********************************************************************/
+void topologyParallelFor(const size_t numTasks, const std::function<void(const size_t)> &task)
 {
-    FutureInfo(const std::string &what, const Pothos::Proxy &block, const std::shared_future<void> &result):
-        what(what), block(block), result(result){}
+    //Most tasks are proxy calls which spend their time waiting on the actor
+    //or the remote server, so use more threads than processors, but not
+    //one thread per task, which does not scale to large topologies.
+    const size_t maxThreads = std::max<size_t>(16, 2*std::thread::hardware_concurrency());
+    const size_t numThreads = std::min(numTasks, maxThreads);
+
+    std::atomic<size_t> nextTask(0);
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+    auto worker = [&](void)
+    {
+        for (size_t i = nextTask++; i < numTasks; i = nextTask++)
+        {
+            try {task(i);}
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (not firstError) firstError = std::current_exception();
+            }
+        }
+    };
+
+    //the calling thread is one of the workers
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; i++) threads.push_back(std::thread(worker));
+    worker();
+    for (auto &thread : threads) thread.join();
+
+    if (firstError) std::rethrow_exception(firstError);
+}
+
+/***********************************************************************
+ * Named actor operations with error collection
+ **********************************************************************/
+struct TaskInfo
+{
+    TaskInfo(const std::string &what, const Pothos::Proxy &block, const std::function<void(void)> &call, const bool dedicated = false):
+        what(what), block(block), call(call), dedicated(dedicated){}
     std::string what;
     Pothos::Proxy block;
-    std::shared_future<void> result;
+    std::function<void(void)> call;
+    bool dedicated; //the task waits on another task and needs its own thread
 };
 
-std::string collectFutureInfoErrors(const std::vector<FutureInfo> infoFutures)
+static void runTaskInfos(const std::vector<TaskInfo> &tasks)
 {
-    std::string errors;
-    for (auto future : infoFutures)
+    std::vector<std::string> taskErrors(tasks.size());
+    const auto runTask = [&](const size_t i)
     {
         POTHOS_EXCEPTION_TRY
         {
-            future.result.get();
+            tasks[i].call();
         }
         POTHOS_EXCEPTION_CATCH (const Pothos::Exception &ex)
         {
-            errors.append(future.block.call<std::string>("getName")+"."+future.what+": "+ex.message()+"\n");
+            taskErrors[i] = tasks[i].block.call<std::string>("getName")+"."+tasks[i].what+": "+ex.message()+"\n";
         }
+    };
+
+    //the dedicated tasks start at once, the others run on the bounded threads meanwhile
+    std::vector<std::future<void>> dedicated;
+    std::vector<size_t> pooled;
+    for (size_t i = 0; i < tasks.size(); i++)
+    {
+        if (tasks[i].dedicated) dedicated.push_back(std::async(std::launch::async, runTask, i));
+        else pooled.push_back(i);
     }
-    return errors;
+    topologyParallelFor(pooled.size(), [&](const size_t j){runTask(pooled[j]);});
+    for (auto &future : dedicated) future.get();
+
+    //collect errors in the order of the tasks
+    std::string errors;
+    for (const auto &error : taskErrors) errors.append(error);
+    if (not errors.empty()) throw Pothos::TopologyConnectError(errors);
 }
 
 /***********************************************************************
@@ -42,71 +104,70 @@ static void setOutputBufferManager(const Port &src, const Pothos::Proxy &manager
     src.obj.callProxy("get:_actor").callVoid("setOutputBufferManager", src.name, manager);
 }
 
-static void installBufferManagers(const std::vector<Flow> &flatFlows)
+static Pothos::Proxy getBufferManager(const Port &src, const std::vector<Port> &dsts, const std::string &defaultType, const Pothos::BufferManagerArgs &defaultArgs)
 {
-    //map of a source port to all destination ports
-    std::unordered_map<Port, std::vector<Port>> srcs;
-    for (const auto &flow : flatFlows)
-    {
-        for (const auto &subFlow : flatFlows)
-        {
-            if (subFlow.src == flow.src) srcs[flow.src].push_back(subFlow.dst);
-        }
-    }
-
-    //result list is used to ack all install messages
-    std::vector<FutureInfo> infoFutures;
+    auto dst = dsts.at(0);
 
-    //for each source port -- install managers
-    for (const auto &pair : srcs)
-    {
-        auto src = pair.first;
-        auto dsts = pair.second;
-        auto dst = dsts.at(0);
-        Pothos::Proxy manager;
+    auto srcDomain = src.obj.callProxy("output", src.name).call<std::string>("domain");
+    auto dstDomain = dst.obj.callProxy("input", dst.name).call<std::string>("domain");
 
-        auto srcDomain = src.obj.callProxy("output", src.name).call<std::string>("domain");
-        auto dstDomain = dst.obj.callProxy("input", dst.name).call<std::string>("domain");
+    auto srcMode = src.obj.callProxy("get:_actor").call<std::string>("getOutputBufferMode", src.name, dstDomain);
+    auto dstMode = dst.obj.callProxy("get:_actor").call<std::string>("getInputBufferMode", dst.name, srcDomain);
 
-        auto srcMode = src.obj.callProxy("get:_actor").call<std::string>("getOutputBufferMode", src.name, dstDomain);
-        auto dstMode = dst.obj.callProxy("get:_actor").call<std::string>("getInputBufferMode", dst.name, srcDomain);
+    //the source port configuration or the topology defaults
+    auto type = src.obj.callProxy("get:_actor").call<std::string>("getOutputBufferManagerType", src.name, defaultType);
+    auto args = src.obj.callProxy("get:_actor").call<Pothos::BufferManagerArgs>("getOutputBufferManagerArgs", src.name, defaultArgs);
 
-        //check if the source provides a manager and install it to the source
-        if (srcMode == "CUSTOM")
-        {
-            manager = src.obj.callProxy("get:_actor").callProxy("getBufferManager", src.name, dstDomain, false);
-        }
+    //check if the source provides a manager and install it to the source
+    if (srcMode == "CUSTOM")
+    {
+        return src.obj.callProxy("get:_actor").callProxy("getBufferManager", src.name, dstDomain, false, type, args);
+    }
 
-        //check if the destination provides a manager and install it to the source
-        else if (dstMode == "CUSTOM")
+    //check if the destination provides a manager and install it to the source
+    if (dstMode == "CUSTOM")
+    {
+        for (const auto &otherDst : dsts)
         {
-            for (const auto &otherDst : dsts)
+            if (otherDst == dst) continue;
+            if (otherDst.obj.callProxy("get:_actor").call<std::string>("getInputBufferMode", dst.name, srcDomain) != "ABDICATE")
             {
-                if (otherDst == dst) continue;
-                if (otherDst.obj.callProxy("get:_actor").call<std::string>("getInputBufferMode", dst.name, srcDomain) != "ABDICATE")
-                {
-                    throw Pothos::Exception("Pothos::Topology::installBufferManagers",
-                        "rectifyDomainFlows() logic does not /yet/ handle multiple destinations w/ custom buffer managers");
-                }
+                throw Pothos::Exception("Pothos::Topology::installBufferManagers",
+                    "rectifyDomainFlows() logic does not /yet/ handle multiple destinations w/ custom buffer managers");
             }
-            manager = dst.obj.callProxy("get:_actor").callProxy("getBufferManager", dst.name, srcDomain, true);
         }
+        return dst.obj.callProxy("get:_actor").callProxy("getBufferManager", dst.name, srcDomain, true, type, args);
+    }
 
-        //otherwise create a generic manager and install it to the source
-        else
-        {
-            assert(srcMode == "ABDICATE"); //this must be true if the previous logic was good
-            assert(dstMode == "ABDICATE");
-            manager = src.obj.callProxy("get:_actor").callProxy("getBufferManager", src.name, dstDomain, false);
-        }
+    //otherwise create a generic manager and install it to the source
+    assert(srcMode == "ABDICATE"); //this must be true if the previous logic was good
+    assert(dstMode == "ABDICATE");
+    return src.obj.callProxy("get:_actor").callProxy("getBufferManager", src.name, dstDomain, false, type, args);
+}
 
-        std::shared_future<void> result(std::async(std::launch::async, setOutputBufferManager, src, manager));
-        infoFutures.push_back(FutureInfo(Poco::format("setOutputBufferManager(%s)", src.name), src.obj, result));
+static void installBufferManagers(const std::vector<Flow> &flatFlows, const std::string &defaultType, const Pothos::BufferManagerArgs &defaultArgs)
+{
+    //map of a source port to all destination ports
+    std::unordered_map<Port, std::vector<Port>> srcs;
+    std::vector<Port> srcOrder;
+    for (const auto &flow : flatFlows)
+    {
+        auto &dsts = srcs[flow.src];
+        if (dsts.empty()) srcOrder.push_back(flow.src);
+        dsts.push_back(flow.dst);
     }
 
-    //check all subscribe message results
-    const auto errors = collectFutureInfoErrors(infoFutures);
-    if (not errors.empty()) throw Pothos::TopologyConnectError(errors);
+    //for each source port -- create and install managers
+    std::vector<TaskInfo> tasks;
+    for (const auto &src : srcOrder)
+    {
+        const auto &dsts = srcs.at(src);
+        tasks.push_back(TaskInfo(Poco::format("setOutputBufferManager(%s)", src.name), src.obj, [=](void)
+        {
+            setOutputBufferManager(src, getBufferManager(src, dsts, defaultType, defaultArgs));
+        }));
+    }
+    runTaskInfos(tasks);
 }
 
 /***********************************************************************
@@ -126,19 +187,12 @@ static void subscribePort(const Port &src, const Port &dst, const std::string &a
 
 static void updateFlows(const std::vector<Flow> &flows, const std::string &action)
 {
-    //result list is used to ack all subscribe messages
-    std::vector<FutureInfo> infoFutures;
-
-    //add new data acceptors
+    std::vector<TaskInfo> tasks;
     for (const auto &flow : flows)
     {
-        std::shared_future<void> result(std::async(std::launch::async, subscribePort, flow.src, flow.dst, action));
-        infoFutures.push_back(FutureInfo(action, flow.src.obj, result));
+        tasks.push_back(TaskInfo(action, flow.src.obj, std::bind(&subscribePort, flow.src, flow.dst, action)));
     }
-
-    //check all subscribe message results
-    const auto errors = collectFutureInfoErrors(infoFutures);
-    if (not errors.empty()) throw Pothos::TopologyConnectError(errors);
+    runTaskInfos(tasks);
 }
 
 /***********************************************************************
@@ -150,25 +204,31 @@ static std::vector<Flow> completePassThroughFlows(const std::vector<Flow> &flows
     //std::cout << "completePassThroughFlows:" << std::endl;
     //for (const auto &flow : flows) std::cout << "  " << flow.toString() << std::endl;
 
+    //index the flows into a topology port by the topology port
+    std::unordered_map<Port, std::vector<const Flow *>> tailsBySrc, headsByDst;
+    for (const auto &flow : flows)
+    {
+        if (flow.dst.obj) tailsBySrc[flow.src].push_back(&flow);
+        if (flow.src.obj) headsByDst[flow.dst].push_back(&flow);
+    }
+
     //try to complete pass-through flows and add it to the out flow list
-    for (auto &flow : flows)
+    for (const auto &flow : flows)
     {
         if (flow.src.obj or flow.dst.obj) continue;
-        for (auto &flowTail : flows)
+        const auto tails = tailsBySrc.find(flow.src);
+        const auto heads = headsByDst.find(flow.dst);
+        if (tails == tailsBySrc.end() or heads == headsByDst.end()) continue;
+        for (const auto flowTail : tails->second)
         {
-            if (not flowTail.dst.obj) continue;
-            for (auto &flowHead : flows)
+            for (const auto flowHead : heads->second)
             {
-                if (not flowHead.src.obj) continue;
-                if (flow.src == flowTail.src and flow.dst == flowHead.dst)
-                {
-                    //create the new completed flow
-                    Flow newFlow;
-                    newFlow.src = flowHead.src;
-                    newFlow.dst = flowTail.dst;
-                    outFlows.push_back(newFlow);
-                    //std::cout << "NEW " << newFlow.toString() << std::endl;
-                }
+                //create the new completed flow
+                Flow newFlow;
+                newFlow.src = flowHead->src;
+                newFlow.dst = flowTail->dst;
+                outFlows.push_back(newFlow);
+                //std::cout << "NEW " << newFlow.toString() << std::endl;
             }
         }
     }
@@ -195,19 +255,28 @@ void topologySubCommit(Pothos::Topology &topology)
     auto &_impl = topology._impl;
     const auto &activeFlatFlows = _impl->activeFlatFlows;
     const auto &flatFlows = _impl->flows;
+    const std::unordered_set<Flow> activeFlowSet(activeFlatFlows.begin(), activeFlatFlows.end());
+    const std::unordered_set<Flow> flatFlowSet(flatFlows.begin(), flatFlows.end());
 
     //new flows are in flat flows but not in current
     std::vector<Flow> newFlows;
     for (const auto &flow : flatFlows)
     {
-        if (std::find(activeFlatFlows.begin(), activeFlatFlows.end(), flow) == activeFlatFlows.end()) newFlows.push_back(flow);
+        if (activeFlowSet.count(flow) == 0) newFlows.push_back(flow);
     }
 
     //old flows are in current and not in flat flows
     std::vector<Flow> oldFlows;
-    for (const auto &flow : _impl->activeFlatFlows)
+    for (const auto &flow : activeFlatFlows)
+    {
+        if (flatFlowSet.count(flow) == 0) oldFlows.push_back(flow);
+    }
+
+    //nothing changed, the actors are already configured
+    if (newFlows.empty() and oldFlows.empty())
     {
-        if (std::find(flatFlows.begin(), flatFlows.end(), flow) == flatFlows.end()) oldFlows.push_back(flow);
+        _impl->activeFlatFlows = flatFlows;
+        return;
     }
 
     //add new data acceptors
@@ -218,31 +287,43 @@ void topologySubCommit(Pothos::Topology &topology)
 
     //install buffer managers on sources for all new flows
     //Sometimes this will replace previous buffer managers.
-    installBufferManagers(newFlows);
+    installBufferManagers(newFlows, _impl->bufferManagerType, _impl->bufferManagerArgs);
 
-    //result list is used to ack all de/activate messages
-    std::vector<FutureInfo> infoFutures;
+    //the blocks to activate are new blocks not already in active flows,
+    //the blocks to deactivate are old blocks not in the new active flows
+    const auto activateBlocks = getObjSetFromFlowList(newFlows, activeFlatFlows);
+    const auto deactivateBlocks = getObjSetFromFlowList(oldFlows, flatFlows);
+    _impl->activeFlatFlows = flatFlows;
 
-    //send activate to all new blocks not already in active flows
-    for (auto block : getObjSetFromFlowList(newFlows, activeFlatFlows))
+    //A network endpoint waits in activate() and deactivate() on the handshake
+    //with its peer, which may be activated by this commit or by another process.
+    //These blocks get dedicated threads so that every peer is in progress at once.
+    std::vector<Pothos::Proxy> blocks(activateBlocks);
+    blocks.insert(blocks.end(), deactivateBlocks.begin(), deactivateBlocks.end());
+    std::vector<char> waitsOnPeer(blocks.size());
+    topologyParallelFor(blocks.size(), [&](const size_t i)
     {
-        std::shared_future<void> result(std::async(std::launch::async, setActiveState, block, true));
-        infoFutures.push_back(FutureInfo("activate()", block, result));
-    }
+        waitsOnPeer[i] = blocks[i].callProxy("get:_actor").call<bool>("getActivateWaitsOnPeer");
+    });
 
-    //update current flows
-    _impl->activeFlatFlows = flatFlows;
-
-    //send deactivate to all old blocks not in current active flows
-    for (auto block : getObjSetFromFlowList(oldFlows, _impl->activeFlatFlows))
+    //task list is used to ack all de/activate messages
+    std::vector<TaskInfo> tasks;
+    for (size_t i = 0; i < blocks.size(); i++)
     {
-        std::shared_future<void> result(std::async(std::launch::async, setActiveState, block, false));
-        infoFutures.push_back(FutureInfo("deactivate()", block, result));
+        const bool activate = i < activateBlocks.size();
+        tasks.push_back(TaskInfo(activate?"activate()":"deactivate()", blocks[i],
+            std::bind(&setActiveState, blocks[i], activate), waitsOnPeer[i] != 0));
     }
 
     //check all de/activate message results
-    const auto errors = collectFutureInfoErrors(infoFutures);
-    if (not errors.empty()) throw Pothos::TopologyConnectError(errors);
+    runTaskInfos(tasks);
+
+    //the actors watched by waitInactive()
+    _impl->activeActors.clear();
+    for (auto block : getObjSetFromFlowList(_impl->activeFlatFlows))
+    {
+        _impl->activeActors.push_back(block.callProxy("get:_actor").convert<std::shared_ptr<Pothos::WorkerActor>>());
+    }
 }
 
 /***********************************************************************
@@ -275,34 +356,94 @@ void Pothos::Topology::commit(void)
         _impl->remoteTopologies[upid] = obj.getEnvironment()->findProxy("Pothos/Topology").callProxy("make");
     }
 
-    //clear connections on old topologies
-    for (const auto &pair : _impl->remoteTopologies) pair.second.callVoid("disconnectAll");
-
-    //load each topology with connections from flat flows
+    //group the flat flows by environment, every sub-topology gets a flow list
+    std::map<std::string, std::vector<Flow>> envToFlows;
+    for (const auto &pair : _impl->remoteTopologies) envToFlows[pair.first];
     for (const auto &flow : flatFlows)
     {
         auto upid = flow.src.obj.getEnvironment()->getUniquePid();
         assert(upid == flow.dst.obj.getEnvironment()->getUniquePid());
-        _impl->remoteTopologies[upid].callVoid("connect", flow.src.obj, flow.src.name, flow.dst.obj, flow.dst.name);
+        envToFlows[upid].push_back(flow);
+    }
+
+    //load each sub-topology with the difference from the last commit,
+    //and only the sub-topologies with differences need to be committed
+    std::vector<std::string> changedTopologies;
+    for (const auto &pair : envToFlows)
+    {
+        const auto &remoteTopology = _impl->remoteTopologies.at(pair.first);
+        const auto &flows = pair.second;
+        try
+        {
+            //unknown contents (new or failed to load), clear the old connections
+            auto loadedIt = _impl->remoteTopologyFlows.find(pair.first);
+            bool changed = loadedIt == _impl->remoteTopologyFlows.end();
+            if (changed)
+            {
+                remoteTopology.callVoid("disconnectAll");
+                loadedIt = _impl->remoteTopologyFlows.emplace(pair.first, std::vector<Flow>()).first;
+            }
+
+            const auto &loadedFlows = loadedIt->second;
+            std::unordered_set<Flow> loadedSet(loadedFlows.begin(), loadedFlows.end());
+            const std::unordered_set<Flow> flowSet(flows.begin(), flows.end());
+            std::vector<const Flow *> removedFlows;
+            for (const auto &flow : loadedFlows)
+            {
+                if (flowSet.count(flow) == 0) removedFlows.push_back(&flow);
+            }
+
+            //disconnect the removed flows, or start over when most flows were removed
+            if (removedFlows.size() > loadedFlows.size() - removedFlows.size())
+            {
+                remoteTopology.callVoid("disconnectAll");
+                loadedSet.clear();
+            }
+            else for (const auto flow : removedFlows)
+            {
+                remoteTopology.callVoid("disconnect", flow->src.obj, flow->src.name, flow->dst.obj, flow->dst.name);
+            }
+            if (not removedFlows.empty()) changed = true;
+            for (const auto &flow : flows)
+            {
+                if (loadedSet.count(flow) != 0) continue;
+                remoteTopology.callVoid("connect", flow.src.obj, flow.src.name, flow.dst.obj, flow.dst.name);
+                changed = true;
+            }
+            loadedIt->second = flows;
+            if (not changed) continue;
+        }
+        catch (...)
+        {
+            _impl->remoteTopologyFlows.erase(pair.first);
+            throw;
+        }
+
+        //pass the buffer manager defaults to the sub-topology
+        remoteTopology.callVoid("setBufferManagerArgs", _impl->bufferManagerArgs);
+        remoteTopology.callVoid("setBufferManagerType", _impl->bufferManagerType);
+        changedTopologies.push_back(pair.first);
     }
 
-    //Call commit on all sub-topologies:
+    //Call commit on all changed sub-topologies:
     //Use futures so all sub-topologies commit at the same time,
     //which is important for network source/sink pairs to connect.
     std::vector<std::future<void>> futures;
-    for (const auto &pair : _impl->remoteTopologies)
+    for (const auto &upid : changedTopologies)
     {
-        futures.push_back(std::async(std::launch::async, &subCommitFutureTask, pair.second));
+        futures.push_back(std::async(std::launch::async, &subCommitFutureTask, _impl->remoteTopologies.at(upid)));
     }
 
     //wait on futures and collect errors
+    //a failed sub-topology is reloaded on the next commit
     std::string errors;
-    for (auto &future : futures)
+    for (size_t i = 0; i < futures.size(); i++)
     {
-        try {future.get();}
+        try {futures[i].get();}
         catch (const Exception &ex)
         {
             errors.append(ex.message()+"\n");
+            _impl->remoteTopologyFlows.erase(changedTopologies[i]);
         }
     }
     if (not errors.empty()) throw Pothos::TopologyConnectError("Pothos::Topology::commit()", errors);
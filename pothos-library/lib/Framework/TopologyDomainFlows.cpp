@@ -2,7 +2,7 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "Framework/TopologyImpl.hpp"
-#include <future>
+#include <unordered_set>
 #include <iostream>
 #include <algorithm>
 #include <map>
@@ -88,20 +88,39 @@ static Pothos::Proxy getCopierForDomainCrossing(
 }
 
 /*!
- * Get a future for each port to inspect it for domain crossing.
+ * Inspect each port for domain crossing and get the copier blocks.
+ * The result for a port is reused from the cache when its connected ports
+ * are unchanged, so that the same copier block stays in the flows.
  */
-static std::unordered_map<Port, std::shared_future<Pothos::Proxy>> domainInspection(
+static std::unordered_map<Port, Pothos::Proxy> domainInspection(
     const std::unordered_map<Port, std::vector<Port>> &ports,
+    std::unordered_map<Port, std::pair<std::vector<Port>, Pothos::Proxy>> &cache,
     const bool isInput
 )
 {
-    std::unordered_map<Port, std::shared_future<Pothos::Proxy>> copiers;
+    std::unordered_map<Port, std::pair<std::vector<Port>, Pothos::Proxy>> newCache;
+    std::vector<const std::pair<const Port, std::vector<Port>> *> uncached;
     for (const auto &pair : ports)
     {
-        copiers[pair.first] = std::async(std::launch::async,
-            &getCopierForDomainCrossing, pair.first, pair.second, isInput);
+        auto it = cache.find(pair.first);
+        if (it != cache.end() and it->second.first == pair.second) newCache.insert(*it);
+        else uncached.push_back(&pair);
     }
-    return copiers;
+
+    std::vector<Pothos::Proxy> copiers(uncached.size());
+    topologyParallelFor(uncached.size(), [&](const size_t i)
+    {
+        copiers[i] = getCopierForDomainCrossing(uncached[i]->first, uncached[i]->second, isInput);
+    });
+    for (size_t i = 0; i < uncached.size(); i++)
+    {
+        newCache[uncached[i]->first] = std::make_pair(uncached[i]->second, copiers[i]);
+    }
+    cache = newCache;
+
+    std::unordered_map<Port, Pothos::Proxy> portToCopier;
+    for (const auto &pair : cache) portToCopier[pair.first] = pair.second.second;
+    return portToCopier;
 }
 
 /***********************************************************************
@@ -113,22 +132,20 @@ std::vector<Flow> Pothos::Topology::Impl::rectifyDomainFlows(const std::vector<F
     std::unordered_map<Port, std::vector<Port>> srcs, dsts;
     for (const auto &flow : flatFlows)
     {
-        for (const auto &subFlow : flatFlows)
-        {
-            if (subFlow.src == flow.src) srcs[flow.src].push_back(subFlow.dst);
-            if (subFlow.dst == flow.dst) dsts[flow.dst].push_back(subFlow.src);
-        }
+        srcs[flow.src].push_back(flow.dst);
+        dsts[flow.dst].push_back(flow.src);
     }
 
     //get a list of ports with domain problems
-    auto badSrcsToCopier = domainInspection(srcs, false);
-    auto badDstsToCopier = domainInspection(dsts, true);
+    auto badSrcsToCopier = domainInspection(srcs, this->srcToCopierCache, false);
+    auto badDstsToCopier = domainInspection(dsts, this->dstToCopierCache, true);
 
     std::vector<Flow> domainSafeFlows;
+    std::unordered_set<Flow> domainSafeFlowSet;
     for (const auto &flow : flatFlows)
     {
-        auto srcCopier = badSrcsToCopier.at(flow.src).get();
-        auto dstCopier = badDstsToCopier.at(flow.dst).get();
+        auto srcCopier = badSrcsToCopier.at(flow.src);
+        auto dstCopier = badDstsToCopier.at(flow.dst);
         Pothos::Proxy copier;
         if (srcCopier) copier = srcCopier;
         if (dstCopier) copier = dstCopier;
@@ -144,8 +161,8 @@ std::vector<Flow> Pothos::Topology::Impl::rectifyDomainFlows(const std::vector<F
             dstFlow.dst = flow.dst;
 
             //add the network flows to the overall list
-            if (std::find(domainSafeFlows.begin(), domainSafeFlows.end(), srcFlow) == domainSafeFlows.end()) domainSafeFlows.push_back(srcFlow);
-            if (std::find(domainSafeFlows.begin(), domainSafeFlows.end(), dstFlow) == domainSafeFlows.end()) domainSafeFlows.push_back(dstFlow);
+            if (domainSafeFlowSet.insert(srcFlow).second) domainSafeFlows.push_back(srcFlow);
+            if (domainSafeFlowSet.insert(dstFlow).second) domainSafeFlows.push_back(dstFlow);
         }
         else
         {
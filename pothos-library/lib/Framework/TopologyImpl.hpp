@@ -3,8 +3,10 @@
 
 #pragma once
 #include <Pothos/Framework/Topology.hpp>
+#include <Pothos/Framework/InputPort.hpp> //WorkerActor declaration
 #include "Framework/PortsAndFlows.hpp"
 #include <unordered_map>
+#include <functional>
 #include <map>
 #include <vector>
 #include <string>
@@ -25,13 +27,26 @@ static inline Port envTagPort(const Port &port, const Port &other)
  **********************************************************************/
 struct Pothos::Topology::Impl
 {
-    Impl(Topology *self): self(self){}
+    Impl(Topology *self): self(self), bufferManagerType("generic"){}
     Topology *self;
     ThreadPool threadPool;
+    BufferManagerArgs bufferManagerArgs;
+    std::string bufferManagerType;
     std::vector<Flow> flows;
     std::vector<Flow> activeFlatFlows;
+
+    //! the actors of the blocks in the active flows of a sub-topology
+    std::vector<std::shared_ptr<Pothos::WorkerActor>> activeActors;
     std::unordered_map<Port, std::pair<Pothos::Proxy, Pothos::Proxy>> srcToNetgressCache;
+
+    //! domain inspection results per port, valid while the connected ports are unchanged
+    std::unordered_map<Port, std::pair<std::vector<Port>, Pothos::Proxy>> srcToCopierCache, dstToCopierCache;
     std::vector<Flow> squashFlows(const std::vector<Flow> &);
+
+    //! per object uid: is it a topology, and the internal block to connect
+    std::unordered_map<std::string, bool> uidIsTopologyCache;
+    std::unordered_map<std::string, Pothos::Proxy> uidToInternalCache;
+
     std::vector<Flow> createNetworkFlows(const std::vector<Flow> &);
     std::vector<Flow> rectifyDomainFlows(const std::vector<Flow> &);
     std::vector<std::string> inputPortNames;
@@ -43,12 +58,23 @@ struct Pothos::Topology::Impl
     //! remote topology per unique environment
     std::map<std::string, Pothos::Proxy> remoteTopologies;
 
+    //! the flows last loaded into each remote topology
+    std::map<std::string, std::vector<Flow>> remoteTopologyFlows;
+
     //! special utility function to make a port with knowledge of this topology
     Port makePort(const Pothos::Object &obj, const std::string &name) const;
     Port makePort(const Pothos::Proxy &obj, const std::string &name) const;
 };
 
 
+/***********************************************************************
+ * Run tasks 0 through numTasks-1 on a bounded number of threads.
+ * The calls are independent and may run in any order.
+ * The first exception thrown by a task is rethrown
+ * once all of the tasks have completed.
+ **********************************************************************/
+void topologyParallelFor(const size_t numTasks, const std::function<void(const size_t)> &task);
+
 /***********************************************************************
  * get a unique object set given flows + excludes
  **********************************************************************/
@@ -57,13 +57,28 @@ static std::vector<Pothos::Proxy> evalArgsArray(
     return args;
 }
 
+/***********************************************************************
+ * buffer manager args - load args fields from JSON object
+ **********************************************************************/
+static Pothos::BufferManagerArgs parseBufferManagerArgs(
+    const Poco::JSON::Object::Ptr &managerObj,
+    const Pothos::BufferManagerArgs &defaultArgs)
+{
+    Pothos::BufferManagerArgs args(defaultArgs);
+    args.numBuffers = managerObj->optValue<int>("numBuffers", int(args.numBuffers));
+    args.bufferSize = managerObj->optValue<int>("bufferSize", int(args.bufferSize));
+    args.nodeAffinity = managerObj->optValue<int>("nodeAffinity", int(args.nodeAffinity));
+    return args;
+}
+
 /***********************************************************************
  * block factory - make blocks from JSON object
  **********************************************************************/
 static Pothos::Proxy makeBlock(
     const Pothos::Proxy &registry,
     const Pothos::Proxy &evaluator,
-    const Poco::JSON::Object::Ptr &blockObj)
+    const Poco::JSON::Object::Ptr &blockObj,
+    const Pothos::BufferManagerArgs &defaultArgs)
 {
     const auto id = blockObj->getValue<std::string>("id");
 
@@ -90,6 +105,24 @@ static Pothos::Proxy makeBlock(
         block.getHandle()->call(name, callArgs.data(), callArgs.size());
     }
 
+    //configure the output port buffer managers
+    Poco::JSON::Object::Ptr managersObj;
+    if (blockObj->isObject("bufferManagers")) managersObj = blockObj->getObject("bufferManagers");
+    std::vector<std::string> portNames;
+    if (managersObj) managersObj->getNames(portNames);
+    for (const auto &portName : portNames)
+    {
+        if (not managersObj->isObject(portName)) throw Pothos::DataFormatException(
+            "Pothos::Topology::make()", "blocks["+id+"] bufferManagers["+portName+"] must be an object");
+        const auto managerObj = managersObj->getObject(portName);
+        auto port = block.callProxy("output", portName);
+        if (managerObj->has("type")) port.callVoid("setBufferManagerType", managerObj->getValue<std::string>("type"));
+        if (managerObj->has("numBuffers") or managerObj->has("bufferSize") or managerObj->has("nodeAffinity"))
+        {
+            port.callVoid("setBufferManagerArgs", parseBufferManagerArgs(managerObj, defaultArgs));
+        }
+    }
+
     return block;
 }
 
@@ -128,6 +161,14 @@ std::shared_ptr<Pothos::Topology> Pothos::Topology::make(const std::string &json
     blocks["this"] = env->makeProxy(topology);
     blocks[""] = env->makeProxy(topology);
 
+    //set the default buffer manager for the topology
+    if (topObj->isObject("bufferManager"))
+    {
+        const auto managerObj = topObj->getObject("bufferManager");
+        if (managerObj->has("type")) topology->setBufferManagerType(managerObj->getValue<std::string>("type"));
+        topology->setBufferManagerArgs(parseBufferManagerArgs(managerObj, topology->getBufferManagerArgs()));
+    }
+
     //create the blocks
     Poco::JSON::Array::Ptr blockArray;
     if (topObj->isArray("blocks")) blockArray = topObj->getArray("blocks");
@@ -139,7 +180,7 @@ std::shared_ptr<Pothos::Topology> Pothos::Topology::make(const std::string &json
         if (not blockObj->has("id")) throw Pothos::DataFormatException(
             "Pothos::Topology::make()", "blocks["+std::to_string(i)+"] missing 'id' field");
         const auto id = blockObj->getValue<std::string>("id");
-        blocks[id] = makeBlock(registry, evaluator, blockObj);
+        blocks[id] = makeBlock(registry, evaluator, blockObj, topology->getBufferManagerArgs());
 
         //set the thread pool
         const auto threadPoolName = blockObj->optValue<std::string>("threadPool", "default");
@@ -5,13 +5,47 @@
 #include <Pothos/System/HostInfo.hpp>
 #include <Pothos/Remote.hpp>
 #include <Poco/Format.h>
-#include <future>
+#include <Poco/Logger.h>
+
+/***********************************************************************
+ * helpers to create shared memory iogress flows
+ **********************************************************************/
+static std::pair<Pothos::Proxy, Pothos::Proxy> createSharedMemoryFlow(const Flow &flow)
+{
+    //the sink creates the ring, the source opens it by name
+    auto srcEnv = flow.src.obj.getEnvironment();
+    auto dstEnv = flow.dst.obj.getEnvironment();
+    auto shmSink = srcEnv->findProxy("Pothos/BlockRegistry").callProxy("/blocks/shared_memory_sink", 4*1024*1024);
+    auto ringName = shmSink.call<std::string>("getRingName");
+    auto shmSource = dstEnv->findProxy("Pothos/BlockRegistry").callProxy("/blocks/shared_memory_source", ringName);
+
+    //return the pair of shared memory blocks
+    const auto name = flow.src.obj.call<std::string>("getName")+"["+flow.src.name+"]";
+    shmSink.callVoid("setName", "ShmTo: "+name);
+    shmSource.callVoid("setName", "ShmFrom: "+name);
+    return std::make_pair(shmSource, shmSink);
+}
 
 /***********************************************************************
  * helpers to create network iogress flows
  **********************************************************************/
 std::pair<Pothos::Proxy, Pothos::Proxy> createNetworkFlow(const Flow &flow)
 {
+    //same host: use the shared memory transport when it is supported,
+    //opening the ring also confirms that both processes share the host
+    if (flow.src.obj.getEnvironment()->getNodeId() == flow.dst.obj.getEnvironment()->getNodeId())
+    {
+        POTHOS_EXCEPTION_TRY
+        {
+            return createSharedMemoryFlow(flow);
+        }
+        POTHOS_EXCEPTION_CATCH(const Pothos::Exception &ex)
+        {
+            poco_information(Poco::Logger::get("Pothos.Topology.createNetworkFlow"),
+                "shared memory transport unavailable, using network: " + ex.displayText());
+        }
+    }
+
     //default behaviour: the sink binds, the source connects
     auto bindEnv = flow.src.obj.getEnvironment();
     auto connEnv = flow.dst.obj.getEnvironment();
@@ -66,18 +100,22 @@ std::vector<Flow> Pothos::Topology::Impl::createNetworkFlows(const std::vector<F
         srcToFlows[envTagPort(flow.src, flow.dst)].push_back(flow);
     }
     //look in the cache or create network iogress for every source endpoint
-    std::unordered_map<Port, std::shared_future<std::pair<Pothos::Proxy, Pothos::Proxy>>> srcToFutures;
+    std::vector<const std::pair<const Port, std::vector<Flow>> *> uncached;
     for (const auto &pair : srcToFlows)
     {
         assert(not pair.second.empty());
-        if (this->srcToNetgressCache.count(pair.first) != 0) continue;
-        srcToFutures[pair.first] = std::async(std::launch::async, &createNetworkFlow, pair.second.at(0));
+        if (this->srcToNetgressCache.count(pair.first) == 0) uncached.push_back(&pair);
     }
+    std::vector<std::pair<Pothos::Proxy, Pothos::Proxy>> netgress(uncached.size());
+    topologyParallelFor(uncached.size(), [&](const size_t i)
+    {
+        netgress[i] = createNetworkFlow(uncached[i]->second.at(0));
+    });
 
-    //load all futures into the cache
-    for (const auto &pair : srcToFutures)
+    //load all results into the cache
+    for (size_t i = 0; i < uncached.size(); i++)
     {
-        this->srcToNetgressCache[pair.first] = pair.second.get();
+        this->srcToNetgressCache[uncached[i]->first] = netgress[i];
     }
 
     //append network flows from the cache
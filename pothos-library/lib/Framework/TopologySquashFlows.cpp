@@ -2,7 +2,8 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "Framework/TopologyImpl.hpp"
-#include <future>
+#include <unordered_map>
+#include <memory>
 
 /***********************************************************************
  * helpers to deal with recursive topology comprehension - ports
@@ -83,10 +84,8 @@ static Flow proxyToFlow(const Pothos::Proxy &flowProxy)
     return flow;
 }
 
-static std::vector<Flow> resolveFlows(const Pothos::Proxy &obj)
+static bool resolveFlows(const Pothos::Proxy &obj, std::vector<Flow> &flows)
 {
-    std::vector<Flow> flows;
-
     //resolve flows within the topology
     Pothos::Proxy subFlows;
     try
@@ -95,7 +94,7 @@ static std::vector<Flow> resolveFlows(const Pothos::Proxy &obj)
     }
     catch (const Pothos::Exception &)
     {
-        return flows;
+        return false; //its just a block
     }
 
     const auto len = subFlows.call<size_t>("size");
@@ -104,7 +103,7 @@ static std::vector<Flow> resolveFlows(const Pothos::Proxy &obj)
         flows.push_back(proxyToFlow(subFlows.callProxy("at", i)));
     }
 
-    return flows;
+    return true;
 }
 
 /***********************************************************************
@@ -112,8 +111,46 @@ static std::vector<Flow> resolveFlows(const Pothos::Proxy &obj)
  **********************************************************************/
 std::vector<Flow> Pothos::Topology::Impl::squashFlows(const std::vector<Flow> &flows)
 {
-    //spawn future to resolve ports per flow
-    std::vector<std::shared_future<std::vector<Port>>> future_srcs, future_dsts;
+    //get a list of objects
+    std::map<std::string, Pothos::Proxy> uidToObj;
+    for (const auto &flow : flows)
+    {
+        if (flow.src.obj) uidToObj[flow.src.uid] = flow.src.obj;
+        if (flow.dst.obj) uidToObj[flow.dst.uid] = flow.dst.obj;
+    }
+    std::vector<std::string> uids;
+    std::vector<Pothos::Proxy> objs;
+    for (const auto &pair : uidToObj)
+    {
+        uids.push_back(pair.first);
+        objs.push_back(pair.second);
+    }
+
+    //resolve sub-topology flows, which also tells the topologies from the blocks,
+    //objects already known to be blocks from a previous squash are skipped
+    std::vector<size_t> unknowns;
+    for (size_t i = 0; i < uids.size(); i++)
+    {
+        auto it = this->uidIsTopologyCache.find(uids[i]);
+        if (it == this->uidIsTopologyCache.end() or it->second) unknowns.push_back(i);
+    }
+    std::vector<std::vector<Flow>> objFlows(unknowns.size());
+    std::unique_ptr<bool[]> objIsTopology(new bool[unknowns.size()]);
+    topologyParallelFor(unknowns.size(), [&](const size_t i)
+    {
+        objIsTopology[i] = resolveFlows(objs[unknowns[i]], objFlows[i]);
+    });
+    std::unordered_map<std::string, bool> uidIsTopology;
+    for (const auto &uid : uids) uidIsTopology[uid] = false;
+    for (size_t i = 0; i < unknowns.size(); i++)
+    {
+        uidIsTopology[uids[unknowns[i]]] = objIsTopology[i];
+    }
+    this->uidIsTopologyCache = uidIsTopology;
+
+    //resolve the ports of sub-topologies, a block port resolves to itself
+    std::unordered_map<Port, std::vector<Port>> srcPorts, dstPorts;
+    std::vector<std::pair<Port, bool>> unresolved;
     for (const auto &flow : flows)
     {
         //ignore external flows
@@ -121,34 +158,33 @@ std::vector<Flow> Pothos::Topology::Impl::squashFlows(const std::vector<Flow> &f
         if (not flow.dst.obj) continue;
 
         //gather a list of sources and destinations on either end of this flow
-        future_srcs.push_back(std::async(std::launch::async, &resolvePorts, flow.src, true));
-        future_dsts.push_back(std::async(std::launch::async, &resolvePorts, flow.dst, false));
+        if (srcPorts.emplace(flow.src, std::vector<Port>(1, flow.src)).second and
+            uidIsTopology.at(flow.src.uid)) unresolved.emplace_back(flow.src, true);
+        if (dstPorts.emplace(flow.dst, std::vector<Port>(1, flow.dst)).second and
+            uidIsTopology.at(flow.dst.uid)) unresolved.emplace_back(flow.dst, false);
     }
-
-    //get a list of objects
-    std::map<std::string, Pothos::Proxy> uidToObj;
-    for (const auto &flow : flows)
+    std::vector<std::vector<Port>> resolved(unresolved.size());
+    topologyParallelFor(unresolved.size(), [&](const size_t i)
     {
-        if (flow.src.obj) uidToObj[flow.src.uid] = flow.src.obj;
-        if (flow.dst.obj) uidToObj[flow.dst.uid] = flow.dst.obj;
-    }
-
-    //spawn futures to resolve sub-topology flows
-    std::vector<std::shared_future<std::vector<Flow>>> futureFlows;
-    for (const auto &pair : uidToObj)
+        resolved[i] = resolvePorts(unresolved[i].first, unresolved[i].second);
+    });
+    for (size_t i = 0; i < unresolved.size(); i++)
     {
-        futureFlows.push_back(std::async(std::launch::async, &resolveFlows, pair.second));
+        auto &ports = unresolved[i].second?srcPorts:dstPorts;
+        ports[unresolved[i].first] = resolved[i];
     }
 
-    //create flat flows from futures
+    //create flat flows from the resolved ports
     std::vector<Flow> flatFlows;
-    assert(future_srcs.size() == future_dsts.size());
-    for (size_t i = 0; i < future_srcs.size(); i++)
+    for (const auto &flow : flows)
     {
+        if (not flow.src.obj) continue;
+        if (not flow.dst.obj) continue;
+
         //all combinations of srcs + dsts are flows
-        for (const auto &src : future_srcs[i].get())
+        for (const auto &src : srcPorts.at(flow.src))
         {
-            for (const auto &dst : future_dsts[i].get())
+            for (const auto &dst : dstPorts.at(flow.dst))
             {
                 Flow flatFlow;
                 flatFlow.src = src;
@@ -157,10 +193,9 @@ std::vector<Flow> Pothos::Topology::Impl::squashFlows(const std::vector<Flow> &f
             }
         }
     }
-    for (const auto &futureFlow : futureFlows)
+    for (const auto &subFlows : objFlows)
     {
-        const auto flows = futureFlow.get();
-        flatFlows.insert(flatFlows.end(), flows.begin(), flows.end());
+        flatFlows.insert(flatFlows.end(), subFlows.begin(), subFlows.end());
     }
 
     //insert flows that pass through this topology in -> out
@@ -170,12 +205,24 @@ std::vector<Flow> Pothos::Topology::Impl::squashFlows(const std::vector<Flow> &f
         if (not flow.src.obj and not flow.dst.obj) flatFlows.push_back(flow);
     }
 
-    //only store the actual blocks
+    //only store the actual blocks, looked up once per object
+    std::unordered_map<std::string, Pothos::Proxy> uidToInternal;
     for (auto &flow : flatFlows)
     {
-        flow.src.obj = getInternalBlock(flow.src.obj);
-        flow.dst.obj = getInternalBlock(flow.dst.obj);
+        for (auto port : {&flow.src, &flow.dst})
+        {
+            if (not port->obj) continue;
+            auto it = uidToInternal.find(port->uid);
+            if (it == uidToInternal.end())
+            {
+                auto cached = this->uidToInternalCache.find(port->uid);
+                const auto internal = (cached == this->uidToInternalCache.end())?getInternalBlock(port->obj):cached->second;
+                it = uidToInternal.emplace(port->uid, internal).first;
+            }
+            port->obj = it->second;
+        }
     }
+    this->uidToInternalCache = uidToInternal;
 
     return flatFlows;
 }
@@ -54,11 +54,26 @@ std::string Pothos::WorkerActor::getOutputBufferMode(const std::string &name, co
     return "ABDICATE";
 }
 
-Pothos::BufferManager::Sptr Pothos::WorkerActor::getBufferManager(const std::string &name, const std::string &domain, const bool isInput)
+std::string Pothos::WorkerActor::getOutputBufferManagerType(const std::string &name, const std::string &defaultType)
+{
+    ActorInterfaceLock lock(this);
+    const auto &type = outputs.at(name)->_bufferManagerType;
+    return type.empty()? defaultType : type;
+}
+
+Pothos::BufferManagerArgs Pothos::WorkerActor::getOutputBufferManagerArgs(const std::string &name, const BufferManagerArgs &defaultArgs)
+{
+    ActorInterfaceLock lock(this);
+    const auto &args = outputs.at(name)->_bufferManagerArgs;
+    return args? *args : defaultArgs;
+}
+
+Pothos::BufferManager::Sptr Pothos::WorkerActor::getBufferManager(const std::string &name, const std::string &domain, const bool isInput,
+    const std::string &type, const BufferManagerArgs &args)
 {
     auto m = isInput? block->getInputBufferManager(name, domain) : block->getOutputBufferManager(name, domain);
-    if (not m) m = BufferManager::make("generic", BufferManagerArgs());
-    else if (not m->isInitialized()) m->init(BufferManagerArgs()); //TODO pass this in from somewhere
+    if (not m) m = BufferManager::make(type, args);
+    else if (not m->isInitialized()) m->init(args);
     return m;
 }
 
@@ -131,6 +146,7 @@ void Pothos::WorkerActor::setActiveStateOn(void)
     POTHOS_EXCEPTION_TRY
     {
         this->activeState = true;
+        this->markActivity(std::chrono::high_resolution_clock::now());
         this->block->activate();
     }
     POTHOS_EXCEPTION_CATCH(const Exception &ex)
@@ -264,11 +280,18 @@ bool Pothos::WorkerActor::preWorkTasks(void)
             }
         }
         //perform minimum reserve accumulator require to recover from possible element fragmentation
-        const size_t requireElems = std::max<size_t>(1, port._reserveElements);
+        //scatter-gather ports only require one element, the reserve applies to all queued buffers
+        const size_t requireElems = port._scatterGather? 1 : std::max<size_t>(1, port._reserveElements);
         port.bufferAccumulatorRequire(requireElems*port.dtype().size());
         port.bufferAccumulatorFront(port._buffer);
         port._elements = port._buffer.length/port.dtype().size();
-        if (port._elements < port._reserveElements) allInputsReady = false;
+        if (port._scatterGather)
+        {
+            port.bufferAccumulatorGather();
+            const size_t totalElems = port._bufferAccumulator.getTotalBytesAvailable()/port.dtype().size();
+            if (totalElems < port._reserveElements) allInputsReady = false;
+        }
+        else if (port._elements < port._reserveElements) allInputsReady = false;
         if (not port.asyncMessagesEmpty()) hasInputMessage = true;
         port._pendingElements = 0;
         port._labelIter = port._inlineMessages;
@@ -337,6 +360,7 @@ void Pothos::WorkerActor::postWorkTasks(void)
             port.bufferAccumulatorPop(bytes);
         }
         port._buffer = BufferChunk::null(); //clear reference
+        port._buffers.clear();
 
         //move consumed elements into total
         port._totalElements += port._pendingElements;
@@ -349,6 +373,7 @@ void Pothos::WorkerActor::postWorkTasks(void)
         this->flagInternalChange();
         this->activityIndicator.fetch_add(1, std::memory_order_relaxed);
         this->timeLastConsumed = std::chrono::high_resolution_clock::now();
+        this->markActivity(this->timeLastConsumed);
     }
 
     ///////////////////// output handling ////////////////////////
@@ -415,6 +440,7 @@ void Pothos::WorkerActor::postWorkTasks(void)
         this->flagInternalChange();
         this->activityIndicator.fetch_add(1, std::memory_order_relaxed);
         this->timeLastProduced = std::chrono::high_resolution_clock::now();
+        this->markActivity(this->timeLastProduced);
     }
 }
 
@@ -472,6 +498,14 @@ Poco::JSON::Object::Ptr Pothos::WorkerActor::queryWorkStats(void)
         portStats->set("dtypeSize", Poco::UInt64(port.dtype().size()));
         portStats->set("dtypeMarkup", port.dtype().toMarkup());
         portStats->set("portName", name);
+        if (port._bufferManager)
+        {
+            const auto &args = port._bufferManager->getArgs();
+            portStats->set("bufferManagerType", port._bufferManager->getName());
+            portStats->set("numBuffers", Poco::UInt64(args.numBuffers));
+            portStats->set("bufferSize", Poco::UInt64(args.bufferSize));
+            portStats->set("nodeAffinity", Poco::Int64(args.nodeAffinity));
+        }
         outputStats->add(portStats);
     }
     if (outputStats->size() > 0) stats->set("outputStats", outputStats);
@@ -485,10 +519,13 @@ static auto managedWorkerActor = Pothos::ManagedClass()
     .registerClass<Pothos::WorkerActor>()
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, setActiveStateOn))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, setActiveStateOff))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, getActivateWaitsOnPeer))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, subscribeInput))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, subscribeOutput))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, getInputBufferMode))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, getOutputBufferMode))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, getOutputBufferManagerType))
+    .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, getOutputBufferManagerArgs))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, getBufferManager))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, setOutputBufferManager))
     .registerMethod(POTHOS_FCN_TUPLE(Pothos::WorkerActor, autoAllocateInput))
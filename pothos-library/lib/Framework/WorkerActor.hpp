@@ -22,7 +22,9 @@ public:
     WorkerActor(Block *block):
         block(block),
         activeState(false),
+        activateWaitsOnPeer(false),
         activityIndicator(0),
+        lastActivityTime(0),
         numTaskCalls(0),
         numWorkCalls(0)
     {
@@ -55,6 +57,23 @@ public:
         return this->activityIndicator;
     }
 
+    /*!
+     * Publish an activity transition: work() produced or consumed,
+     * or the actor was activated. The time stamp is read without
+     * locking the actor by the Topology's waitInactive() implementation.
+     */
+    void markActivity(const std::chrono::high_resolution_clock::time_point &now)
+    {
+        this->lastActivityTime.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    //! The time of the last activity transition
+    std::chrono::high_resolution_clock::time_point queryLastActivityTime(void) const
+    {
+        const std::chrono::high_resolution_clock::duration sinceEpoch(this->lastActivityTime.load(std::memory_order_relaxed));
+        return std::chrono::high_resolution_clock::time_point(sinceEpoch);
+    }
+
     /*!
      * Query the work stats as a JSON object.
      * This call blocks the work thread context.
@@ -66,7 +85,9 @@ public:
     ///////////////////// WorkerActor storage ///////////////////////
     Block *block;
     bool activeState;
+    bool activateWaitsOnPeer;
     std::atomic<int> activityIndicator;
+    std::atomic<std::chrono::high_resolution_clock::rep> lastActivityTime;
     std::map<std::string, std::unique_ptr<InputPort>> inputs;
     std::map<std::string, std::unique_ptr<OutputPort>> outputs;
 
@@ -107,11 +128,18 @@ public:
     ///////////////////// topology helper methods ///////////////////////
     void setActiveStateOn(void);
     void setActiveStateOff(void);
+    bool getActivateWaitsOnPeer(void) const
+    {
+        return this->activateWaitsOnPeer;
+    }
     void subscribeInput(const std::string &action, const std::string &myPortName, InputPort *subscriberPort);
     void subscribeOutput(const std::string &action, const std::string &myPortName, OutputPort *subscriberPort);
     std::string getInputBufferMode(const std::string &name, const std::string &domain);
     std::string getOutputBufferMode(const std::string &name, const std::string &domain);
-    BufferManager::Sptr getBufferManager(const std::string &name, const std::string &domain, const bool isInput);
+    std::string getOutputBufferManagerType(const std::string &name, const std::string &defaultType);
+    BufferManagerArgs getOutputBufferManagerArgs(const std::string &name, const BufferManagerArgs &defaultArgs);
+    BufferManager::Sptr getBufferManager(const std::string &name, const std::string &domain, const bool isInput,
+        const std::string &type, const BufferManagerArgs &args);
     void setOutputBufferManager(const std::string &name, const BufferManager::Sptr &manager);
 
     ///////////////////// work helper methods ///////////////////////
@@ -6,6 +6,8 @@
 #include <Pothos/Callable.hpp>
 #include <Pothos/Plugin.hpp>
 #include <Pothos/System/HostInfo.hpp>
+#include <Poco/Process.h>
+#include <mutex>
 
 Pothos::ProxyEnvironment::Sptr Pothos::ProxyEnvironment::make(const std::string &name, const ProxyEnvironmentArgs &args)
 {
@@ -40,8 +42,19 @@ std::string Pothos::ProxyEnvironment::getUniquePid(void) const
 
 std::string Pothos::ProxyEnvironment::getLocalUniquePid(void)
 {
-    const auto info = Pothos::System::HostInfo::get();
-    return info.nodeName + "/" + info.nodeId + "/" + info.pid;
+    //the host info lookup is slow and this is called per flow in a topology commit,
+    //so cache the result, the process id is checked in case of a fork
+    static std::mutex mutex;
+    static Poco::Process::PID cachedPid(0);
+    static std::string cachedUniquePid;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cachedPid != Poco::Process::id())
+    {
+        const auto info = Pothos::System::HostInfo::get();
+        cachedUniquePid = info.nodeName + "/" + info.nodeId + "/" + info.pid;
+        cachedPid = Poco::Process::id();
+    }
+    return cachedUniquePid;
 }
 
 std::string Pothos::ProxyEnvironment::getPeeringAddress(void)
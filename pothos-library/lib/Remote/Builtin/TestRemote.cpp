@@ -6,6 +6,7 @@
 #include <Pothos/Proxy.hpp>
 #include <Pothos/Remote.hpp>
 #include <Pothos/Managed.hpp>
+#include "Remote/RemoteProxyDatagram.hpp"
 #include <Poco/Pipe.h>
 #include <Poco/PipeStream.h>
 #include <Poco/URI.h>
@@ -15,6 +16,7 @@
 #include <cstdlib>
 #include <complex>
 #include <algorithm>
+#include <sstream>
 #include <cstdlib> //atoi
 
 class SuperBar
@@ -229,3 +231,59 @@ POTHOS_TEST_BLOCK("/proxy/remote/tests", test_multithread_safe)
     //therefore to be safe, we unregister these classes now
     Pothos::ManagedClass::unload("EchoTester");
 }
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_datagram_formats)
+{
+    //the binary format is negotiated by default, text is forced by the args
+    for (const std::string format : {"", "TEXT"})
+    {
+        Pothos::ProxyEnvironmentArgs args;
+        if (not format.empty()) args["datagramFormat"] = format;
+
+        Poco::Pipe p0, p1;
+        Poco::PipeInputStream is(p1);
+        Poco::PipeOutputStream os(p0);
+        std::thread t0(&runRemoteProxy, std::ref(p0), std::ref(p1));
+        {
+            auto env = Pothos::RemoteClient::makeEnvironment(is, os, "managed", args);
+            test_simple_runner(env);
+
+            //round trip a payload with every byte value
+            std::string bytes;
+            for (size_t i = 0; i < 1024; i++) bytes.push_back(char(i));
+            auto proxy = env->convertObjectToProxy(Pothos::Object(bytes));
+            POTHOS_TEST_TRUE(env->convertProxyToObject(proxy).extract<std::string>() == bytes);
+        }
+        t0.join();
+    }
+}
+
+POTHOS_TEST_BLOCK("/proxy/remote/tests", test_datagram_format_switch)
+{
+    //the handshake is text and the next datagram is binary,
+    //which must skip the rest of the text datagram for any length,
+    //and the binary frame header can start with any byte value
+    for (size_t length = 0; length < 256; length++)
+    {
+        Pothos::ObjectKwargs text, binary;
+        text["data"] = Pothos::Object(std::string(length, 't'));
+        binary["data"] = Pothos::Object(std::string(length, 'b'));
+
+        std::stringstream ss;
+        sendDatagram(ss, text, false);
+        sendDatagram(ss, binary, true, true);
+        sendDatagram(ss, binary, true);
+        POTHOS_TEST_TRUE(recvDatagram(ss, false).at("data").extract<std::string>() == std::string(length, 't'));
+        POTHOS_TEST_TRUE(recvDatagram(ss, true, true).at("data").extract<std::string>() == std::string(length, 'b'));
+        POTHOS_TEST_TRUE(recvDatagram(ss, true).at("data").extract<std::string>() == std::string(length, 'b'));
+    }
+
+    //a binary datagram without the marker is an error, not a misread frame
+    {
+        Pothos::ObjectKwargs binary;
+        binary["data"] = Pothos::Object(std::string("b"));
+        std::stringstream ss;
+        sendDatagram(ss, binary, true);
+        POTHOS_TEST_THROWS(recvDatagram(ss, true, true), Pothos::IOException);
+    }
+}
@@ -29,7 +29,8 @@ Pothos::ObjectKwargs RemoteProxyEnvironment::transact(const Pothos::ObjectKwargs
         //send request object over output stream
         {
             std::lock_guard<std::mutex> lock(osMutex);
-            sendDatagram(os, reqArgs);
+            sendDatagram(os, reqArgs, binaryDatagrams, binarySendMarker);
+            binarySendMarker = false;
         }
 
         //wait for reply object
@@ -47,7 +48,8 @@ Pothos::ObjectKwargs RemoteProxyEnvironment::transact(const Pothos::ObjectKwargs
             }
 
             //otherwise wait on input stream
-            const auto replyArgs = recvDatagram(is);
+            const auto replyArgs = recvDatagram(is, binaryDatagrams, binaryRecvMarker);
+            binaryRecvMarker = false;
             const auto replyTid = replyArgs.at("tid").convert<size_t>();
             if (replyTid == tid) return replyArgs;
             tidToReply[replyTid] = replyArgs;
@@ -60,13 +62,28 @@ Pothos::ObjectKwargs RemoteProxyEnvironment::transact(const Pothos::ObjectKwargs
         connectionActive = false;
         throw Pothos::IOException("RemoteProxyEnvironment::transact()", ex.message());
     }
+    catch (const Pothos::IOException &ex)
+    {
+        std::lock_guard<std::mutex> lock(isMutex);
+        tidToReply.erase(tid);
+        connectionActive = false;
+        throw Pothos::IOException("RemoteProxyEnvironment::transact()", ex.message());
+    }
+    catch (const Pothos::ObjectSerializeError &ex)
+    {
+        //the stream position is lost after a partial datagram
+        std::lock_guard<std::mutex> lock(isMutex);
+        tidToReply.erase(tid);
+        connectionActive = false;
+        throw Pothos::IOException("RemoteProxyEnvironment::transact()", ex.message());
+    }
 }
 
 RemoteProxyEnvironment::RemoteProxyEnvironment(
     std::istream &is, std::ostream &os,
     const std::string &name, const Pothos::ProxyEnvironmentArgs &args
 ):
-    is(is), os(os), name(name), connectionActive(true)
+    is(is), os(os), name(name), connectionActive(true), binaryDatagrams(false), binarySendMarker(false), binaryRecvMarker(false)
 {
     //create request
     Pothos::ObjectKwargs req;
@@ -77,6 +94,9 @@ RemoteProxyEnvironment::RemoteProxyEnvironment(
     req["action"] = Pothos::Object("RemoteProxyEnvironment");
     req["name"] = Pothos::Object(name);
 
+    //request the binary datagram format unless overridden by the args
+    if (args.count("datagramFormat") == 0) req["datagramFormat"] = Pothos::Object(binaryDatagramFormat());
+
     auto reply = this->transact(req);
 
     //check for an error
@@ -89,6 +109,12 @@ RemoteProxyEnvironment::RemoteProxyEnvironment(
     upid = reply["upid"].convert<std::string>();
     nodeId = reply["nodeId"].convert<std::string>();
     peerAddr = reply["peerAddr"].convert<std::string>();
+
+    //older servers do not reply with a format and continue in text
+    auto formatIt = reply.find("datagramFormat");
+    binaryDatagrams = formatIt != reply.end() and formatIt->second.extract<std::string>() == binaryDatagramFormat();
+    binarySendMarker = binaryDatagrams;
+    binaryRecvMarker = binaryDatagrams;
 }
 
 RemoteProxyEnvironment::~RemoteProxyEnvironment(void)
@@ -72,6 +72,9 @@ public:
     std::ostream &os;
     const std::string name;
     bool connectionActive;
+    bool binaryDatagrams;
+    bool binarySendMarker; //the first binary datagram each way follows a marker
+    bool binaryRecvMarker;
 
     std::mutex osMutex;
     std::mutex isMutex;
@@ -1,24 +1,143 @@
-// Copyright (c) 2013-2014 Josh Blum
+// Copyright (c) 2013-2015 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #pragma once
 #include <Pothos/Config.hpp>
+#include <Pothos/Exception.hpp>
 #include <Pothos/Object/Containers.hpp>
+#include <Pothos/Object/Serialize.hpp>
+#include <Pothos/Object/Exception.hpp>
+#include <Pothos/archive/polymorphic_binary_oarchive.hpp>
+#include <Pothos/archive/polymorphic_binary_iarchive.hpp>
 #include <Poco/Base64Encoder.h>
 #include <Poco/Base64Decoder.h>
+#include <sstream>
+#include <string>
+#include <cstdint>
+#include <cctype>
 
-inline void sendDatagram(std::ostream &os, const Pothos::ObjectKwargs &reqArgs)
+/***********************************************************************
+ * Datagram formats:
+ * The text format is the Base64 encoded text archive of the kwargs.
+ * It is used by default and remains the fallback for older peers.
+ * The binary format is a length-prefixed frame of the binary archive.
+ * The client requests the binary format in the environment handshake,
+ * and the server accepts it when the format name matches its own.
+ *
+ * The text decoder stops once the archive is read, which can leave the last
+ * Base64 group (the archive's trailing newline) or a line break in the stream.
+ * So the first binary datagram in each direction follows a marker,
+ * and the receiver discards the rest of the text handshake up to the marker.
+ * The marker starts with a character that is not in the Base64 alphabet.
+ **********************************************************************/
+static const char binaryDatagramMarker[] = "#POTHOS_BINARY#";
+
+/*!
+ * The binary format name encodes the byte order and primitive sizes,
+ * so that only peers with matching layouts negotiate the binary format.
+ */
+inline std::string binaryDatagramFormat(void)
+{
+    const int one = 1;
+    const bool little = *reinterpret_cast<const char *>(&one) == 1;
+    return std::string("BINARY_") + (little?"LE":"BE") +
+        "_I" + std::to_string(sizeof(int)) +
+        "L" + std::to_string(sizeof(long)) +
+        "Z" + std::to_string(sizeof(size_t)) +
+        "D" + std::to_string(sizeof(double));
+}
+
+/*!
+ * Send a datagram in either format.
+ * Set marker for the first binary datagram after the text handshake.
+ */
+inline void sendDatagram(std::ostream &os, const Pothos::ObjectKwargs &reqArgs, const bool binary = false, const bool marker = false)
 {
     Pothos::Object request(reqArgs);
-    Poco::Base64Encoder encoder(os);
-    request.serialize(encoder);
-    encoder.close();
+
+    if (not binary)
+    {
+        Poco::Base64Encoder encoder(os);
+        request.serialize(encoder);
+        encoder.close();
+        return;
+    }
+
+    std::ostringstream payload;
+    try
+    {
+        Pothos::archive::polymorphic_binary_oarchive oa(payload);
+        oa << request;
+    }
+    catch(const Pothos::archive::archive_exception &ex)
+    {
+        throw Pothos::ObjectSerializeError("sendDatagram()", ex.what());
+    }
+
+    //big endian 32-bit length prefix followed by the payload
+    const auto frame = payload.str();
+    const auto length = uint32_t(frame.size());
+    const char header[4] = {char(length >> 24), char(length >> 16), char(length >> 8), char(length >> 0)};
+    if (marker) os.write(binaryDatagramMarker, sizeof(binaryDatagramMarker)-1);
+    os.write(header, sizeof(header));
+    os.write(frame.data(), frame.size());
+    os.flush();
 }
 
-inline Pothos::ObjectKwargs recvDatagram(std::istream &is)
+/*!
+ * Receive a datagram in either format.
+ * Set marker for the first binary datagram after the text handshake.
+ */
+inline Pothos::ObjectKwargs recvDatagram(std::istream &is, const bool binary = false, const bool marker = false)
 {
-    Poco::Base64Decoder decoder(is);
     Pothos::Object reply;
-    reply.deserialize(decoder);
+
+    if (not binary)
+    {
+        Poco::Base64Decoder decoder(is);
+        reply.deserialize(decoder);
+        return reply.extract<Pothos::ObjectKwargs>();
+    }
+
+    if (marker)
+    {
+        //only the rest of the Base64 text can come before the marker
+        int ch = 0;
+        while ((ch = is.get()) != std::char_traits<char>::eof() and ch != binaryDatagramMarker[0])
+        {
+            if (std::isspace(ch) or std::isalnum(ch) or ch == '+' or ch == '/' or ch == '=') continue;
+            throw Pothos::IOException("recvDatagram()", "unexpected data before the binary marker");
+        }
+        const std::string expected(binaryDatagramMarker+1);
+        std::string rest(expected.size(), '\0');
+        if (ch == std::char_traits<char>::eof() or not is.read(&rest[0], rest.size()) or rest != expected)
+        {
+            throw Pothos::IOException("recvDatagram()", "failed to read the binary marker");
+        }
+    }
+
+    unsigned char header[4];
+    if (not is.read(reinterpret_cast<char *>(header), sizeof(header)))
+    {
+        throw Pothos::IOException("recvDatagram()", "failed to read frame header");
+    }
+    const auto length = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) | (uint32_t(header[2]) << 8) | (uint32_t(header[3]) << 0);
+
+    std::string frame(length, '\0');
+    if (not is.read(&frame[0], length))
+    {
+        throw Pothos::IOException("recvDatagram()", "failed to read frame payload");
+    }
+
+    std::istringstream payload(frame);
+    try
+    {
+        Pothos::archive::polymorphic_binary_iarchive ia(payload);
+        ia >> reply;
+    }
+    catch(const Pothos::archive::archive_exception &ex)
+    {
+        throw Pothos::ObjectSerializeError("recvDatagram()", ex.what());
+    }
     return reply.extract<Pothos::ObjectKwargs>();
 }
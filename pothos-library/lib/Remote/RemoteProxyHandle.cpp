@@ -5,6 +5,7 @@
 #include <Poco/Format.h>
 #include <Poco/Logger.h>
 #include <iostream>
+#include <vector>
 
 RemoteProxyHandle::RemoteProxyHandle(std::shared_ptr<RemoteProxyEnvironment> env, const size_t remoteID):
     env(env), remoteID(remoteID)
@@ -37,6 +38,9 @@ Pothos::Proxy RemoteProxyHandle::call(const std::string &name, const Pothos::Pro
     req["action"] = Pothos::Object("call");
     req["handleID"] = Pothos::Object(this->remoteID);
     req["name"] = Pothos::Object(name);
+
+    //converted args must outlive the transaction to keep the remote objects
+    std::vector<std::shared_ptr<RemoteProxyHandle>> handles;
     for (size_t i = 0; i < numArgs; i++)
     {
         std::shared_ptr<RemoteProxyHandle> handle;
@@ -50,6 +54,7 @@ Pothos::Proxy RemoteProxyHandle::call(const std::string &name, const Pothos::Pro
                 Poco::format("convert arg %d - %s", int(i), std::string(ex.what())));
         }
         req[std::to_string(i)] = Pothos::Object(handle->remoteID);
+        handles.push_back(handle);
     }
 
     auto reply = env->transact(req);
@@ -51,6 +51,30 @@ static void removeObjectAtId(const Pothos::Object &id)
     getObjectsMap().erase(key);
 }
 
+/***********************************************************************
+ * Datagram format of the connection:
+ * The format is kept on the streams of the connection,
+ * the receive state on the input and the send state on the output,
+ * because the input and output may be the same iostream.
+ **********************************************************************/
+enum
+{
+    DATAGRAM_BINARY = 1 << 0, //datagrams use the binary format
+    DATAGRAM_MARKER = 1 << 1, //the next datagram follows the binary marker
+};
+
+static int datagramRecvState(void)
+{
+    static const int index = std::ios_base::xalloc();
+    return index;
+}
+
+static int datagramSendState(void)
+{
+    static const int index = std::ios_base::xalloc();
+    return index;
+}
+
 /***********************************************************************
  * Handler implementation
  **********************************************************************/
@@ -59,7 +83,11 @@ bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
     bool done = false;
 
     //deserialize the request
-    const auto reqArgs = recvDatagram(is);
+    const long recvState = is.iword(datagramRecvState());
+    const bool binary = (recvState & DATAGRAM_BINARY) != 0;
+    const auto reqArgs = recvDatagram(is, binary, (recvState & DATAGRAM_MARKER) != 0);
+    is.iword(datagramRecvState()) = recvState & ~long(DATAGRAM_MARKER);
+    bool binaryDatagrams = binary;
 
     //process the request and form the reply
     Pothos::ObjectKwargs replyArgs;
@@ -73,6 +101,7 @@ bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
             for (const auto &entry : reqArgs)
             {
                 if (entry.second.type() != typeid(std::string)) continue;
+                if (entry.first == "datagramFormat") continue;
                 envArgs[entry.first] = entry.second.extract<std::string>();
             }
             const auto &name = reqArgs.at("name").extract<std::string>();
@@ -84,6 +113,12 @@ bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
             replyArgs["upid"] = Pothos::Object(Pothos::ProxyEnvironment::getLocalUniquePid());
             replyArgs["nodeId"] = Pothos::Object(info.nodeId);
             replyArgs["peerAddr"] = Pothos::Object(_peerAddr);
+
+            //accept the binary datagram format when the layouts match,
+            //the handshake reply is sent in text, and binary thereafter
+            auto formatIt = reqArgs.find("datagramFormat");
+            binaryDatagrams = formatIt != reqArgs.end() and formatIt->second.extract<std::string>() == binaryDatagramFormat();
+            if (binaryDatagrams) replyArgs["datagramFormat"] = Pothos::Object(binaryDatagramFormat());
         }
         else if (action == "~RemoteProxyEnvironment")
         {
@@ -171,7 +206,17 @@ bool Pothos::RemoteHandler::runHandlerOnce(std::istream &is, std::ostream &os)
     }
 
     //serialize the reply
-    sendDatagram(os, replyArgs);
+    const long sendState = os.iword(datagramSendState());
+    sendDatagram(os, replyArgs, (sendState & DATAGRAM_BINARY) != 0, (sendState & DATAGRAM_MARKER) != 0);
+    os.iword(datagramSendState()) = sendState & ~long(DATAGRAM_MARKER);
+
+    //the handshake switched the format, the first binary datagram each way follows a marker
+    if (binaryDatagrams != binary)
+    {
+        const long state = binaryDatagrams?(DATAGRAM_BINARY | DATAGRAM_MARKER):0;
+        is.iword(datagramRecvState()) = state;
+        os.iword(datagramSendState()) = state;
+    }
 
     return done;
 }
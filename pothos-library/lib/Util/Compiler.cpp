@@ -68,3 +68,8 @@ Pothos::Util::Compiler::Sptr Pothos::Util::Compiler::make(const std::string &nam
     }
     return compiler;
 }
+
+std::string Pothos::Util::Compiler::identity(void)
+{
+    return "";
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "CompilerVersion.hpp"
+#include <Poco/Pipe.h>
+#include <Poco/PipeStream.h>
+#include <Poco/Process.h>
+#include <Poco/Exception.h>
+#include <iterator>
+
+std::string compilerVersionBanner(const std::string &compiler)
+{
+    try
+    {
+        Poco::Process::Args args;
+        args.push_back("--version");
+        Poco::Process::Env env;
+        Poco::Pipe outPipe;
+        Poco::ProcessHandle ph(Poco::Process::launch(
+            compiler, args, nullptr, &outPipe, &outPipe, env));
+        Poco::PipeInputStream outStream(outPipe);
+        const std::string banner = std::string(
+            std::istreambuf_iterator<char>(outStream),
+            std::istreambuf_iterator<char>());
+        if (ph.wait() != 0) return "";
+        return compiler + " " + banner;
+    }
+    catch (const Poco::Exception &)
+    {
+        return "";
+    }
+}
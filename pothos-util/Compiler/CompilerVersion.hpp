@@ -0,0 +1,13 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <string>
+
+/*!
+ * Run the compiler with --version and return its banner
+ * prefixed by the executable name, which identifies the compiler.
+ * \param compiler the compiler executable, for example "g++"
+ * \return the banner, or empty when the compiler could not be run
+ */
+std::string compilerVersionBanner(const std::string &compiler);
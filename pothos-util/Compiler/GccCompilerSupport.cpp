@@ -1,6 +1,7 @@
 // Copyright (c) 2014-2014 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "CompilerVersion.hpp"
 #include <Pothos/Util/Compiler.hpp>
 #include <Pothos/Plugin.hpp>
 #include <Poco/Pipe.h>
@@ -44,6 +45,13 @@ public:
     }
 
     std::string compileCppModule(const Pothos::Util::CompilerArgs &args);
+
+    std::string identity(void)
+    {
+        //the version banner identifies the compiler, query it once per process
+        static const std::string id = compilerVersionBanner("g++");
+        return id;
+    }
 };
 
 std::string GccCompilerSupport::compileCppModule(const Pothos::Util::CompilerArgs &compilerArgs)
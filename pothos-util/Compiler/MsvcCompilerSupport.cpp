@@ -52,6 +52,12 @@ public:
 
     std::string compileCppModule(const Pothos::Util::CompilerArgs &args);
 
+    std::string identity(void)
+    {
+        //the install path contains the toolset version
+        return "msvc " + _vcvars_path;
+    }
+
 private:
     std::string _vcvars_path;
 };
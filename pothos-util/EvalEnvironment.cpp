@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "EvalEnvironment.hpp"
+#include "EvalModuleCache.hpp"
 #include <Pothos/Util/Compiler.hpp>
 #include <Pothos/Util/EvalInterface.hpp>
 #include <Pothos/Object.hpp>
@@ -17,6 +18,7 @@
 #include <Poco/Types.h>
 #include <Poco/RWLock.h>
 #include <Poco/String.h>
+#include <Poco/Logger.h>
 #include <string>
 #include <vector>
 #include <map>
@@ -199,23 +201,49 @@ Pothos::Object EvalEnvironment::evalNoCache(const std::string &expr)
     oss << "    POCO_EXPORT_CLASS(Eval_" << symName << ")" << std::endl;
     oss << "POCO_END_MANIFEST" << std::endl;
 
-    //perform compilation
+    //load the module from the persistent cache or perform compilation
     Pothos::Util::CompilerArgs args = Pothos::Util::CompilerArgs::defaultDevEnv();
     args.sources.push_back(oss.str());
-    auto outMod = compiler->compileCppModule(args);
-
-    //write module to file and load
-    const auto outPath = Poco::TemporaryFile::tempName() + Poco::SharedLibrary::suffix();
-    std::ofstream(outPath.c_str(), std::ios::binary).write(outMod.data(), outMod.size());
-    _impl->tmpModuleFiles.push_back(outPath);
+    auto &cache = EvalModuleCache::global();
+    const auto cacheKey = cache.makeKey(args, compiler->identity());
+    auto outPath = cache.lookup(cacheKey);
     Poco::ClassLoader<Pothos::Util::EvalInterface> loader;
-    try
+    if (not outPath.empty())
     {
-        loader.loadLibrary(outPath);
+        try
+        {
+            loader.loadLibrary(outPath);
+        }
+        catch (const Poco::Exception &ex)
+        {
+            //a truncated or stale module is evicted and compiled again
+            poco_warning_f2(Poco::Logger::get("EvalEnvironment"), "cached module %s: %s", outPath, ex.displayText());
+            cache.remove(cacheKey);
+            outPath.clear();
+        }
     }
-    catch (const Poco::Exception &ex)
+    if (outPath.empty())
     {
-        throw Pothos::Exception("EvalEnvironment::eval("+expr+")", ex.displayText());
+        auto outMod = compiler->compileCppModule(args);
+        outPath = cache.store(cacheKey, outMod);
+
+        //not cached: write module to a temporary file
+        if (outPath.empty())
+        {
+            outPath = Poco::TemporaryFile::tempName() + Poco::SharedLibrary::suffix();
+            std::ofstream(outPath.c_str(), std::ios::binary).write(outMod.data(), outMod.size());
+            _impl->tmpModuleFiles.push_back(outPath);
+        }
+
+        //load the module
+        try
+        {
+            loader.loadLibrary(outPath);
+        }
+        catch (const Poco::Exception &ex)
+        {
+            throw Pothos::Exception("EvalEnvironment::eval("+expr+")", ex.displayText());
+        }
     }
 
     //extract the symbol and call its evaluation routine
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "EvalModuleCache.hpp"
+#include <Pothos/System.hpp>
+#include <Poco/DigestEngine.h>
+#include <Poco/MD5Engine.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Environment.h>
+#include <Poco/SharedLibrary.h>
+#include <Poco/TemporaryFile.h>
+#include <Poco/Timestamp.h>
+#include <Poco/Exception.h>
+#include <Poco/Logger.h>
+#include <Poco/Path.h>
+#include <Poco/File.h>
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include <tuple>
+
+//bump the version when the layout or the generated module format changes
+static const std::string EVAL_CACHE_VERSION = "v1";
+
+static const unsigned long long EVAL_CACHE_DEFAULT_SIZE = 64*1024*1024;
+
+EvalModuleCache &EvalModuleCache::global(void)
+{
+    static EvalModuleCache cache(
+        Poco::Path(Poco::Path(Pothos::System::getUserDataPath(), "EvalCache"), EVAL_CACHE_VERSION).toString(),
+        Poco::NumberParser::parseUnsigned64(Poco::Environment::get("POTHOS_EVAL_CACHE_SIZE",
+            std::to_string(EVAL_CACHE_DEFAULT_SIZE))));
+    return cache;
+}
+
+EvalModuleCache::EvalModuleCache(const std::string &rootPath, const unsigned long long maxBytes):
+    _rootPath(rootPath),
+    _maxBytes(maxBytes)
+{
+    return;
+}
+
+std::string EvalModuleCache::makeKey(const Pothos::Util::CompilerArgs &args, const std::string &compilerId) const
+{
+    if (_maxBytes == 0 or compilerId.empty()) return "";
+
+    //hash each field with a terminator so that fields cannot run together
+    Poco::MD5Engine md5;
+    const auto update = [&md5](const std::string &field)
+    {
+        md5.update(field);
+        md5.update(std::string(1, '\0'));
+    };
+    update(EVAL_CACHE_VERSION);
+    update(Pothos::System::getAbiVersion());
+    update(compilerId);
+    for (const auto &flag : args.flags) update("flag:"+flag);
+    for (const auto &include : args.includes) update("include:"+include);
+    for (const auto &library : args.libraries) update("library:"+library);
+    for (const auto &source : args.sources) update("source:"+source);
+    return Poco::DigestEngine::digestToHex(md5.digest());
+}
+
+std::string EvalModuleCache::modulePath(const std::string &key) const
+{
+    return Poco::Path(_rootPath, key + Poco::SharedLibrary::suffix()).toString();
+}
+
+std::string EvalModuleCache::lookup(const std::string &key)
+{
+    if (key.empty()) return "";
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto path = this->modulePath(key);
+    try
+    {
+        Poco::File file(path);
+        if (not file.exists()) return "";
+        file.setLastModified(Poco::Timestamp()); //mark recently used
+    }
+    catch (const Poco::Exception &ex)
+    {
+        poco_warning_f2(Poco::Logger::get("Pothos.EvalModuleCache"), "lookup(%s) %s", path, ex.displayText());
+        return "";
+    }
+    poco_debug_f1(Poco::Logger::get("Pothos.EvalModuleCache"), "hit %s", path);
+    return path;
+}
+
+std::string EvalModuleCache::store(const std::string &key, const std::string &module)
+{
+    if (key.empty() or module.size() > _maxBytes) return "";
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto path = this->modulePath(key);
+    try
+    {
+        Poco::File(_rootPath).createDirectories();
+
+        //write to a temporary name and rename so readers never see a partial module
+        const auto tmpPath = Poco::Path(_rootPath, Poco::Path(Poco::TemporaryFile::tempName()).getFileName()).toString();
+        {
+            std::ofstream outFile(tmpPath.c_str(), std::ios::binary);
+            outFile.write(module.data(), module.size());
+            if (not outFile) throw Poco::WriteFileException(tmpPath);
+        }
+        Poco::File(tmpPath).renameTo(path);
+    }
+    catch (const Poco::Exception &ex)
+    {
+        poco_warning_f2(Poco::Logger::get("Pothos.EvalModuleCache"), "store(%s) %s", path, ex.displayText());
+        return "";
+    }
+
+    this->evict(path);
+    return path;
+}
+
+void EvalModuleCache::remove(const std::string &key)
+{
+    if (key.empty()) return;
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto path = this->modulePath(key);
+    try
+    {
+        Poco::File file(path);
+        if (file.exists()) file.remove();
+    }
+    catch (const Poco::Exception &ex)
+    {
+        poco_warning_f2(Poco::Logger::get("Pothos.EvalModuleCache"), "remove(%s) %s", path, ex.displayText());
+    }
+}
+
+void EvalModuleCache::evict(const std::string &keep)
+{
+    //gather the modules with their last used time and size
+    std::vector<std::tuple<Poco::Timestamp, unsigned long long, std::string>> entries;
+    unsigned long long totalBytes = 0;
+    std::vector<std::string> names;
+    try
+    {
+        Poco::File(_rootPath).list(names);
+        for (const auto &name : names)
+        {
+            const auto path = Poco::Path(_rootPath, name).toString();
+            Poco::File file(path);
+            if (not file.isFile()) continue;
+            entries.emplace_back(file.getLastModified(), file.getSize(), path);
+            totalBytes += file.getSize();
+        }
+    }
+    catch (const Poco::Exception &ex)
+    {
+        poco_warning_f2(Poco::Logger::get("Pothos.EvalModuleCache"), "evict(%s) %s", _rootPath, ex.displayText());
+        return;
+    }
+
+    //remove the least recently used modules until under the limit
+    std::sort(entries.begin(), entries.end());
+    for (const auto &entry : entries)
+    {
+        if (totalBytes <= _maxBytes) break;
+        const auto &path = std::get<2>(entry);
+        if (path == keep) continue;
+        try
+        {
+            Poco::File(path).remove();
+            totalBytes -= std::get<1>(entry);
+            poco_debug_f1(Poco::Logger::get("Pothos.EvalModuleCache"), "evicted %s", path);
+        }
+        catch (const Poco::Exception &){} //may be in use
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Util/Compiler.hpp>
+#include <string>
+#include <mutex>
+
+/*!
+ * A persistent on-disk cache of compiled expression modules.
+ * Modules are keyed by a hash of the sources, compiler arguments,
+ * compiler identity, and the Pothos ABI version, so that a change
+ * to any of these results in a new compilation.
+ * The least recently used modules are evicted to bound the total size.
+ */
+class EvalModuleCache
+{
+public:
+
+    /*!
+     * The cache under the Pothos user data directory.
+     * The POTHOS_EVAL_CACHE_SIZE environment variable sets
+     * the maximum size in bytes, and 0 disables the cache.
+     */
+    static EvalModuleCache &global(void);
+
+    /*!
+     * Create a cache in the given directory.
+     * \param rootPath the directory for the cached modules
+     * \param maxBytes the maximum total size of the modules
+     */
+    EvalModuleCache(const std::string &rootPath, const unsigned long long maxBytes);
+
+    /*!
+     * Make a key from the compiler arguments and compiler identity.
+     * \return the key, or empty when the module should not be cached
+     */
+    std::string makeKey(const Pothos::Util::CompilerArgs &args, const std::string &compilerId) const;
+
+    /*!
+     * Lookup a module in the cache and mark it as recently used.
+     * \return the path of the module, or empty when not found
+     */
+    std::string lookup(const std::string &key);
+
+    /*!
+     * Store a module into the cache and evict old modules.
+     * \return the path of the module, or empty when not stored
+     */
+    std::string store(const std::string &key, const std::string &module);
+
+    /*!
+     * Remove a module from the cache, such as a module that failed to load.
+     */
+    void remove(const std::string &key);
+
+private:
+    std::string modulePath(const std::string &key) const;
+    void evict(const std::string &keep);
+    const std::string _rootPath;
+    const unsigned long long _maxBytes;
+    std::mutex _mutex;
+};
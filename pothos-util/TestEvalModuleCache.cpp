@@ -0,0 +1,66 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "EvalModuleCache.hpp"
+#include <Pothos/Testing.hpp>
+#include <Poco/TemporaryFile.h>
+#include <Poco/File.h>
+#include <fstream>
+#include <iostream>
+
+POTHOS_TEST_BLOCK("/util/tests", test_eval_module_cache)
+{
+    const auto rootPath = Poco::TemporaryFile::tempName();
+    EvalModuleCache cache(rootPath, 250);
+
+    //the key depends on the sources, flags, and compiler identity
+    Pothos::Util::CompilerArgs args;
+    args.sources.push_back("int foo;");
+    const auto keyA = cache.makeKey(args, "gcc 1.0");
+    POTHOS_TEST_TRUE(not keyA.empty());
+    POTHOS_TEST_EQUAL(keyA, cache.makeKey(args, "gcc 1.0"));
+    POTHOS_TEST_TRUE(keyA != cache.makeKey(args, "gcc 2.0"));
+    POTHOS_TEST_TRUE(cache.makeKey(args, "").empty());
+    args.flags.push_back("-O2");
+    const auto keyB = cache.makeKey(args, "gcc 1.0");
+    POTHOS_TEST_TRUE(keyA != keyB);
+    args.sources.push_back("int bar;");
+    const auto keyC = cache.makeKey(args, "gcc 1.0");
+    POTHOS_TEST_TRUE(keyB != keyC);
+
+    //store and lookup a module
+    POTHOS_TEST_TRUE(cache.lookup(keyA).empty());
+    const std::string moduleA(100, 'A');
+    const auto pathA = cache.store(keyA, moduleA);
+    POTHOS_TEST_TRUE(not pathA.empty());
+    POTHOS_TEST_EQUAL(cache.lookup(keyA), pathA);
+    {
+        std::ifstream file(pathA.c_str(), std::ios::binary);
+        const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        POTHOS_TEST_EQUAL(contents, moduleA);
+    }
+
+    //exceed the size limit, the newest module is kept
+    POTHOS_TEST_TRUE(not cache.store(keyB, std::string(100, 'B')).empty());
+    POTHOS_TEST_TRUE(not cache.store(keyC, std::string(100, 'C')).empty());
+    POTHOS_TEST_TRUE(not cache.lookup(keyC).empty());
+    size_t numCached = 0;
+    for (const auto &key : {keyA, keyB, keyC})
+    {
+        if (not cache.lookup(key).empty()) numCached++;
+    }
+    POTHOS_TEST_EQUAL(numCached, 2);
+
+    //modules larger than the cache are not stored
+    const auto keyD = cache.makeKey(args, "gcc 3.0");
+    POTHOS_TEST_TRUE(cache.store(keyD, std::string(300, 'D')).empty());
+    POTHOS_TEST_TRUE(cache.lookup(keyD).empty());
+
+    //a removed module is compiled and stored again
+    cache.remove(keyC);
+    POTHOS_TEST_TRUE(cache.lookup(keyC).empty());
+    POTHOS_TEST_TRUE(not cache.store(keyC, std::string(100, 'C')).empty());
+    POTHOS_TEST_TRUE(not cache.lookup(keyC).empty());
+
+    Poco::File(rootPath).remove(true);
+}